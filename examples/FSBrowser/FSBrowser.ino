@@ -43,6 +43,7 @@
 #include <ESP8266mDNS.h>
 #include <SPI.h>
 #include <AutoConnect.h>
+#include "FSBrowserCache.h"
 
 #ifdef INCLUDE_FALLBACK_INDEX_HTM
 #include "extras/index_htm.h"
@@ -88,6 +89,11 @@ String unsupportedFiles = String();
 
 File uploadFile;
 
+// Validators of the responses. The generation counts the changes made
+// through this sketch, and the boot tells the generations of each boot apart.
+uint32_t fsBoot;
+uint32_t fsGeneration;
+
 // Additional lines as the below to apply AutoConnect
 AutoConnect       portal(server);
 AutoConnectConfig config;
@@ -95,6 +101,7 @@ AutoConnectConfig config;
 static const char TEXT_PLAIN[] PROGMEM = "text/plain";
 static const char FS_INIT_ERROR[] PROGMEM = "FS INIT ERROR";
 static const char FILE_NOT_FOUND[] PROGMEM = "FileNotFound";
+static const char* CONDITIONAL_HEADERS[] = { "If-None-Match", "If-Modified-Since" };
 
 ////////////////////////////////
 // Utils to return HTTP codes, and determine content-type
@@ -121,6 +128,23 @@ void replyServerError(String msg) {
   server.send(500, FPSTR(TEXT_PLAIN), msg + "\r\n");
 }
 
+/*
+   Add the validators to the response, and reply 304 if the request already
+   holds the same version. Browsers revalidate with each request.
+*/
+bool replyNotModified(const char* etag, const char* lastModified) {
+  server.sendHeader(F("ETag"), etag);
+  server.sendHeader(F("Cache-Control"), F("no-cache"));
+  if (lastModified) {
+    server.sendHeader(F("Last-Modified"), lastModified);
+  }
+  if (FSBrowserCache::notModified(server.header(CONDITIONAL_HEADERS[0]).c_str(), server.header(CONDITIONAL_HEADERS[1]).c_str(), etag, lastModified)) {
+    server.send(304);
+    return true;
+  }
+  return false;
+}
+
 #ifdef USE_SPIFFS
 /*
    Checks filename for character combinations that are not supported by FSBrowser (alhtough valid on SPIFFS).
@@ -177,7 +201,8 @@ void handleStatus() {
 
 /*
    Return the list of files in the directory specified by the "dir" query string parameter.
-   Also demonstrates the use of chuncked responses.
+   The entries are sent in chunks as the directory is walked, and the listing is not walked
+   at all if the browser holds the listing of the current generation.
 */
 void handleFileList() {
   if (!fsOK) {
@@ -193,6 +218,12 @@ void handleFileList() {
     return replyBadRequest("BAD PATH");
   }
 
+  char etag[32];
+  FSBrowserCache::makeListETag(etag, sizeof(etag), fsBoot, fsGeneration);
+  if (replyNotModified(etag, nullptr)) {
+    return;
+  }
+
   DBG_OUTPUT_PORT.println(String("handleFileList: ") + path);
   Dir dir = fileSystem->openDir(path);
   path.clear();
@@ -203,48 +234,26 @@ void handleFileList() {
     return;
   }
 
-  // use the same string for every line
-  String output;
-  output.reserve(64);
-  while (dir.next()) {
+  // The entries are gathered into chunks of a fixed size
+  auto sendChunk = [](const char* chunk, size_t len) {
+    server.sendContent(chunk, len);
+  };
+  bool empty = true;
+  {
+    FSBrowserCache::ChunkWriter<512, decltype(sendChunk)> output(sendChunk);
+    while (dir.next()) {
 #ifdef USE_SPIFFS
-    String error = checkForUnsupportedPath(dir.fileName());
-    if (error.length() > 0) {
-      DBG_OUTPUT_PORT.println(String("Ignoring ") + error + dir.fileName());
-      continue;
-    }
+      String error = checkForUnsupportedPath(dir.fileName());
+      if (error.length() > 0) {
+        DBG_OUTPUT_PORT.println(String("Ignoring ") + error + dir.fileName());
+        continue;
+      }
 #endif
-    if (output.length()) {
-      // send string from previous iteration
-      // as an HTTP chunk
-      server.sendContent(output);
-      output = ',';
-    } else {
-      output = '[';
-    }
-
-    output += "{\"type\":\"";
-    if (dir.isDirectory()) {
-      output += "dir";
-    } else {
-      output += F("file\",\"size\":\"");
-      output += dir.fileSize();
-    }
-
-    output += F("\",\"name\":\"");
-    // Always return names without leading "/"
-    if (dir.fileName()[0] == '/') {
-      output += &(dir.fileName()[1]);
-    } else {
-      output += dir.fileName();
+      FSBrowserCache::writeEntry(output, empty, dir.isDirectory(), dir.fileName().c_str(), dir.fileSize());
+      empty = false;
     }
-
-    output += "\"}";
+    FSBrowserCache::writeEnd(output, empty);
   }
-
-  // send last string
-  output += "]";
-  server.sendContent(output);
   server.chunkedResponseFinalize();
 }
 
@@ -274,8 +283,17 @@ bool handleFileRead(String path) {
     // File not found, try gzip version
     path = path + ".gz";
   }
-  if (fileSystem->exists(path)) {
-    File file = fileSystem->open(path, "r");
+  File file = fileSystem->open(path, "r");
+  if (file) {
+    char etag[40];
+    char lastModified[32];
+    time_t mtime = file.getLastWrite();
+    FSBrowserCache::makeETag(etag, sizeof(etag), file.size(), mtime, fsBoot, fsGeneration);
+    bool hasDate = FSBrowserCache::httpDate(lastModified, sizeof(lastModified), mtime);
+    if (replyNotModified(etag, hasDate ? lastModified : nullptr)) {
+      file.close();
+      return true;
+    }
     if (server.streamFile(file, contentType) != file.size()) {
       DBG_OUTPUT_PORT.println("Sent less data than expected!");
     }
@@ -357,6 +375,7 @@ void handleFileCreate() {
         return replyServerError(F("CREATE FAILED"));
       }
     }
+    fsGeneration++;
     if (path.lastIndexOf('/') > -1) {
       path = path.substring(0, path.lastIndexOf('/'));
     }
@@ -381,6 +400,7 @@ void handleFileCreate() {
     if (!fileSystem->rename(src, path)) {
       return replyServerError(F("RENAME FAILED"));
     }
+    fsGeneration++;
     replyOKWithMsg(lastExistingParent(src));
   }
 }
@@ -440,6 +460,7 @@ void handleFileDelete() {
     return replyNotFound(FPSTR(FILE_NOT_FOUND));
   }
   deleteRecursive(path);
+  fsGeneration++;
 
   replyOKWithMsg(lastExistingParent(path));
 }
@@ -479,6 +500,7 @@ void handleFileUpload() {
     if (uploadFile) {
       uploadFile.close();
     }
+    fsGeneration++;
     DBG_OUTPUT_PORT.println(String("Upload: END, Size: ") + upload.totalSize);
   }
 }
@@ -596,6 +618,11 @@ void setup(void) {
   ////////////////////////////////
   // WEB SERVER INIT
 
+  // Keep the conditional headers of the requests. Declare them before
+  // portal.begin, AutoConnect adds the headers it needs to them.
+  fsBoot = ESP.random();
+  server.collectHeaders(CONDITIONAL_HEADERS, sizeof(CONDITIONAL_HEADERS) / sizeof(CONDITIONAL_HEADERS[0]));
+
   // Filesystem status
   server.on("/status", HTTP_GET, handleStatus);
 
@@ -0,0 +1,201 @@
+/*
+  FSBrowserCache - Validators and streaming listing for the FSBrowser
+
+  The listing is written into a small buffer that is flushed as an HTTP chunk
+  whenever it fills, so the memory it takes does not grow with the number of
+  files. The files are served with an ETag and a Last-Modified, and a request
+  that already holds the same version is answered with 304 Not Modified.
+
+  This header depends only on the C library, so it can be exercised against
+  a directory tree on the host with extras/fscache_host.cpp.
+*/
+
+#ifndef _FSBROWSERCACHE_H_
+#define _FSBROWSERCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+namespace FSBrowserCache {
+
+// Timestamps before 2000-01-01 mean the clock was not set when the file
+// was written, so they are not sent as the Last-Modified.
+static const time_t VALID_TIME = 946684800;
+
+/*
+   Buffers the output and passes it to the flush function in chunks of N
+   bytes at most. The flush function is called as flush(const char*, size_t).
+*/
+template<size_t N, typename Flush>
+class ChunkWriter {
+ public:
+  explicit ChunkWriter(Flush flush) : _flush(flush), _len(0) {}
+  ~ChunkWriter() {
+    flush();
+  }
+
+  void write(const char* s, size_t len) {
+    while (len) {
+      size_t n = N - _len < len ? N - _len : len;
+      memcpy(_buf + _len, s, n);
+      _len += n;
+      s += n;
+      len -= n;
+      if (_len == N) {
+        flush();
+      }
+    }
+  }
+
+  void write(const char* s) {
+    write(s, strlen(s));
+  }
+
+  void write(char c) {
+    write(&c, 1);
+  }
+
+  // Write the string as the content of a JSON string
+  void writeEscaped(const char* s) {
+    for (; *s; s++) {
+      unsigned char c = *s;
+      if (c == '"' || c == '\\') {
+        write('\\');
+        write((char)c);
+      } else if (c < 0x20) {
+        char u[7];
+        snprintf(u, sizeof(u), "\\u%04x", c);
+        write(u, 6);
+      } else {
+        write((char)c);
+      }
+    }
+  }
+
+  void flush() {
+    if (_len) {
+      _flush(_buf, _len);
+      _len = 0;
+    }
+  }
+
+ private:
+  Flush  _flush;
+  char   _buf[N];
+  size_t _len;
+};
+
+/*
+   Write an entry of the listing. A leading "/" of the name is dropped.
+*/
+template<typename Writer>
+void writeEntry(Writer& out, bool first, bool isDir, const char* name, size_t size) {
+  char s[12];
+  out.write(first ? "[{\"type\":\"" : ",{\"type\":\"");
+  if (isDir) {
+    out.write("dir");
+  } else {
+    out.write("file\",\"size\":\"");
+    snprintf(s, sizeof(s), "%lu", (unsigned long)size);
+    out.write(s);
+  }
+  out.write("\",\"name\":\"");
+  out.writeEscaped(name[0] == '/' ? name + 1 : name);
+  out.write("\"}");
+}
+
+/*
+   Write the end of the listing.
+*/
+template<typename Writer>
+void writeEnd(Writer& out, bool empty) {
+  out.write(empty ? "[]" : "]");
+}
+
+/*
+   Make the ETag of a file. The size and the last write time identify the
+   version of the file. A filesystem that does not keep the time, such as
+   SPIFFS, falls back to the boot and the generation of the changes made
+   through the FSBrowser.
+*/
+inline void makeETag(char* buf, size_t len, size_t size, time_t mtime, uint32_t boot, uint32_t generation) {
+  if (mtime) {
+    snprintf(buf, len, "W/\"%lx-%lx\"", (unsigned long)size, (unsigned long)mtime);
+  } else {
+    snprintf(buf, len, "W/\"%lx-%lx-%lx\"", (unsigned long)size, (unsigned long)boot, (unsigned long)generation);
+  }
+}
+
+/*
+   Make the ETag of a listing. The listing changes only through the FSBrowser,
+   so the generation of the changes identifies it without walking the
+   directory.
+*/
+inline void makeListETag(char* buf, size_t len, uint32_t boot, uint32_t generation) {
+  snprintf(buf, len, "W/\"%lx-%lx\"", (unsigned long)boot, (unsigned long)generation);
+}
+
+/*
+   Format the time as an HTTP date. Returns false if the time is not valid.
+*/
+inline bool httpDate(char* buf, size_t len, time_t t) {
+  struct tm tm;
+  if (t < VALID_TIME || !gmtime_r(&t, &tm)) {
+    return false;
+  }
+  return strftime(buf, len, "%a, %d %b %Y %H:%M:%S GMT", &tm) > 0;
+}
+
+/*
+   Whether the If-None-Match lists the ETag. The comparison is weak.
+*/
+inline bool matchETag(const char* ifNoneMatch, const char* etag) {
+  if (!strncmp(etag, "W/", 2)) {
+    etag += 2;
+  }
+  const size_t len = strlen(etag);
+  const char* p = ifNoneMatch;
+  while (*p) {
+    while (*p == ' ' || *p == ',') {
+      p++;
+    }
+    if (*p == '*') {
+      return true;
+    }
+    if (!strncmp(p, "W/", 2)) {
+      p += 2;
+    }
+    const char* e = strchr(p, ',');
+    size_t n = e ? (size_t)(e - p) : strlen(p);
+    while (n && p[n - 1] == ' ') {
+      n--;
+    }
+    if (n == len && !strncmp(p, etag, len)) {
+      return true;
+    }
+    if (!e) {
+      break;
+    }
+    p = e;
+  }
+  return false;
+}
+
+/*
+   Whether the request already holds the current version. The If-None-Match
+   takes precedence over the If-Modified-Since, which matches only the same
+   date as the Last-Modified that was sent.
+*/
+inline bool notModified(const char* ifNoneMatch, const char* ifModifiedSince, const char* etag, const char* lastModified) {
+  if (ifNoneMatch && *ifNoneMatch) {
+    return matchETag(ifNoneMatch, etag);
+  }
+  return ifModifiedSince && *ifModifiedSince && lastModified && !strcmp(ifModifiedSince, lastModified);
+}
+
+}
+
+#endif // !_FSBROWSERCACHE_H_
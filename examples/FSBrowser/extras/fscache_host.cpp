@@ -0,0 +1,83 @@
+/*
+  fscache_host - Runs the listing and the validators of FSBrowserCache.h
+  against a directory tree on the host.
+
+  Build:
+    g++ -std=c++11 -I.. -o fscache_host fscache_host.cpp
+
+  Usage:
+    fscache_host list DIR
+      Prints the listing of DIR as the FSBrowser sends it. The size of each
+      chunk is printed to stderr.
+    fscache_host read FILE [IF-NONE-MATCH [IF-MODIFIED-SINCE]]
+      Prints the status and the validators that the FSBrowser replies to a
+      request for FILE with the given conditional headers.
+*/
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "FSBrowserCache.h"
+
+static int list(const char* path) {
+  DIR* dir = opendir(path);
+  if (!dir) {
+    perror(path);
+    return 1;
+  }
+  auto sendChunk = [](const char* chunk, size_t len) {
+    fprintf(stderr, "chunk %lu\n", (unsigned long)len);
+    fwrite(chunk, 1, len, stdout);
+  };
+  bool empty = true;
+  {
+    FSBrowserCache::ChunkWriter<512, decltype(sendChunk)> output(sendChunk);
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+      if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) {
+        continue;
+      }
+      struct stat st;
+      std::string name = std::string(path) + '/' + entry->d_name;
+      if (stat(name.c_str(), &st)) {
+        continue;
+      }
+      FSBrowserCache::writeEntry(output, empty, S_ISDIR(st.st_mode), entry->d_name, st.st_size);
+      empty = false;
+    }
+    FSBrowserCache::writeEnd(output, empty);
+  }
+  closedir(dir);
+  putchar('\n');
+  return 0;
+}
+
+static int read(const char* path, const char* ifNoneMatch, const char* ifModifiedSince) {
+  struct stat st;
+  if (stat(path, &st) || S_ISDIR(st.st_mode)) {
+    printf("404\n");
+    return 1;
+  }
+  char etag[40];
+  char lastModified[32];
+  FSBrowserCache::makeETag(etag, sizeof(etag), st.st_size, st.st_mtime, 0, 0);
+  bool hasDate = FSBrowserCache::httpDate(lastModified, sizeof(lastModified), st.st_mtime);
+  printf("%d\nETag: %s\n", FSBrowserCache::notModified(ifNoneMatch, ifModifiedSince, etag, hasDate ? lastModified : nullptr) ? 304 : 200, etag);
+  if (hasDate) {
+    printf("Last-Modified: %s\n", lastModified);
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc >= 3 && !strcmp(argv[1], "list")) {
+    return list(argv[2]);
+  }
+  if (argc >= 3 && !strcmp(argv[1], "read")) {
+    return read(argv[2], argc > 3 ? argv[3] : "", argc > 4 ? argv[4] : "");
+  }
+  fprintf(stderr, "usage: %s list DIR | read FILE [IF-NONE-MATCH [IF-MODIFIED-SINCE]]\n", argv[0]);
+  return 2;
+}
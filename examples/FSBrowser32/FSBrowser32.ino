@@ -41,6 +41,7 @@
 #endif
 
 #include <AutoConnect.h>
+#include "FSBrowserCache.h"
 
 const char* ssid = "wifi-ssid";
 const char* password = "wifi-password";
@@ -48,6 +49,11 @@ const char* host = "esp32fs";
 WebServer server(80);
 //holds the current upload
 File fsUploadFile;
+//validators of the responses; the generation counts the changes made through
+//this sketch, and the boot tells the generations of each boot apart
+uint32_t fsBoot;
+uint32_t fsGeneration;
+const char* conditionalHeaders[] = { "If-None-Match", "If-Modified-Since" };
 
 // Additional lines as the below to apply AutoConnect
 AutoConnect       portal(server);
@@ -107,19 +113,41 @@ bool exists(String path){
   return yes;
 }
 
+//add the validators to the response, and reply 304 if the request already
+//holds the same version
+bool replyNotModified(const char* etag, const char* lastModified) {
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (lastModified) {
+    server.sendHeader("Last-Modified", lastModified);
+  }
+  if (FSBrowserCache::notModified(server.header(conditionalHeaders[0]).c_str(), server.header(conditionalHeaders[1]).c_str(), etag, lastModified)) {
+    server.send(304);
+    return true;
+  }
+  return false;
+}
+
 bool handleFileRead(String path) {
   DBG_OUTPUT_PORT.println("handleFileRead: " + path);
   if (path.endsWith("/")) {
     path += "index.htm";
   }
   String contentType = getContentType(path);
-  String pathWithGz = path + ".gz";
-  if (exists(pathWithGz) || exists(path)) {
-    if (exists(pathWithGz)) {
-      path += ".gz";
+  //open the file once, the gzip version first
+  File file = FILESYSTEM.open(path + ".gz", "r");
+  if (!file || file.isDirectory()) {
+    file = FILESYSTEM.open(path, "r");
+  }
+  if (file && !file.isDirectory()) {
+    char etag[40];
+    char lastModified[32];
+    time_t mtime = file.getLastWrite();
+    FSBrowserCache::makeETag(etag, sizeof(etag), file.size(), mtime, fsBoot, fsGeneration);
+    bool hasDate = FSBrowserCache::httpDate(lastModified, sizeof(lastModified), mtime);
+    if (!replyNotModified(etag, hasDate ? lastModified : nullptr)) {
+      server.streamFile(file, contentType);
     }
-    File file = FILESYSTEM.open(path, "r");
-    server.streamFile(file, contentType);
     file.close();
     return true;
   }
@@ -148,6 +176,7 @@ void handleFileUpload() {
     if (fsUploadFile) {
       fsUploadFile.close();
     }
+    fsGeneration++;
     DBG_OUTPUT_PORT.print("handleFileUpload Size: "); DBG_OUTPUT_PORT.println(upload.totalSize);
   }
 }
@@ -165,6 +194,7 @@ void handleFileDelete() {
     return server.send(404, "text/plain", "FileNotFound");
   }
   FILESYSTEM.remove(path);
+  fsGeneration++;
   server.send(200, "text/plain", "");
   path = String();
 }
@@ -187,16 +217,25 @@ void handleFileCreate() {
   } else {
     return server.send(500, "text/plain", "CREATE FAILED");
   }
+  fsGeneration++;
   server.send(200, "text/plain", "");
   path = String();
 }
 
+//send the listing in chunks as the directory is walked, unless the browser
+//holds the listing of the current generation
 void handleFileList() {
   if (!server.hasArg("dir")) {
     server.send(500, "text/plain", "BAD ARGS");
     return;
   }
 
+  char etag[32];
+  FSBrowserCache::makeListETag(etag, sizeof(etag), fsBoot, fsGeneration);
+  if (replyNotModified(etag, nullptr)) {
+    return;
+  }
+
   String path = server.arg("dir");
   DBG_OUTPUT_PORT.println("handleFileList: " + path);
 
@@ -204,23 +243,25 @@ void handleFileList() {
   File root = FILESYSTEM.open(path);
   path = String();
 
-  String output = "[";
-  if(root.isDirectory()){
-      File file = root.openNextFile();
-      while(file){
-          if (output != "[") {
-            output += ',';
-          }
-          output += "{\"type\":\"";
-          output += (file.isDirectory()) ? "dir" : "file";
-          output += "\",\"name\":\"";
-          output += String(file.name()).substring(1);
-          output += "\"}";
-          file = root.openNextFile();
-      }
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/json", "");
+  auto sendChunk = [](const char* chunk, size_t len) {
+    server.sendContent(chunk, len);
+  };
+  bool empty = true;
+  {
+    FSBrowserCache::ChunkWriter<512, decltype(sendChunk)> output(sendChunk);
+    if(root.isDirectory()){
+        File file = root.openNextFile();
+        while(file){
+            FSBrowserCache::writeEntry(output, empty, file.isDirectory(), file.name(), file.size());
+            empty = false;
+            file = root.openNextFile();
+        }
+    }
+    FSBrowserCache::writeEnd(output, empty);
   }
-  output += "]";
-  server.send(200, "text/json", output);
+  server.sendContent("");
 }
 
 void setup(void) {
@@ -265,6 +306,10 @@ void setup(void) {
 
 
   //SERVER INIT
+  //keep the conditional headers of the requests; declare them before
+  //portal.begin, AutoConnect adds the headers it needs to them
+  fsBoot = esp_random();
+  server.collectHeaders(conditionalHeaders, sizeof(conditionalHeaders) / sizeof(conditionalHeaders[0]));
   //list directory
   server.on("/list", HTTP_GET, handleFileList);
   //load editor
@@ -37,7 +37,7 @@ const char ESP32Cam::_mountProbe[]= { ESP32CAM_FS_MOUNTPROBE };
 /**
  * ESP32Cam constractor
  */
-ESP32Cam::ESP32Cam() : _sdFile(nullptr), _mounted(MOUNT_NONE), _cameraId(CAMERA_MODEL_UNKNOWN), _pins(nullptr), _sensor(nullptr), _hwTimer(nullptr) {
+ESP32Cam::ESP32Cam() : _sdFile(nullptr), _mounted(MOUNT_NONE), _cameraId(CAMERA_MODEL_UNKNOWN), _pins(nullptr), _fbCount(0), _sensor(nullptr), _hwTimer(nullptr) {
   ESP32Cam_internal::esp32cam = nullptr;
 }
 
@@ -47,7 +47,7 @@ ESP32Cam::ESP32Cam() : _sdFile(nullptr), _mounted(MOUNT_NONE), _cameraId(CAMERA_
  * pin assignment.
  * @param  model  The model ID of the sensor to be used.
  */
-ESP32Cam::ESP32Cam(const CameraId model) : _sdFile(nullptr), _mounted(MOUNT_NONE), _cameraId(model), _pins(nullptr), _hwTimer(nullptr) {
+ESP32Cam::ESP32Cam(const CameraId model) : _sdFile(nullptr), _mounted(MOUNT_NONE), _cameraId(model), _pins(nullptr), _fbCount(0), _hwTimer(nullptr) {
   ESP32Cam_internal::esp32cam = nullptr;
 }
 
@@ -114,7 +114,9 @@ esp_err_t ESP32Cam::init(const CameraId model) {
     _psram = true;
     config.frame_size = FRAMESIZE_UXGA;
     config.jpeg_quality = 10;
-    config.fb_count = 2;
+    // One of the buffers is kept for the driver to capture into, and the
+    // other two let a slow streaming client lag without holding the rest.
+    config.fb_count = 3;
 #if defined(ESP_IDF_VERSION_MAJOR) && ESP_IDF_VERSION_MAJOR>=4
     config.fb_location = CAMERA_FB_IN_PSRAM;
     config.grab_mode = CAMERA_GRAB_LATEST;
@@ -139,6 +141,7 @@ esp_err_t ESP32Cam::init(const CameraId model) {
   // Camera initialization
   esp_err_t err = esp_camera_init(&config);
   if (err == ESP_OK) {
+    _fbCount = config.fb_count;
     _sensor = esp_camera_sensor_get();
     if (_sensor->id.PID == OV3660_PID) {
       _sensor->set_vflip(_sensor, 1); // flip it back
@@ -82,6 +82,7 @@ class ESP32Cam {
   framesize_t getFramesize(void);
   uint16_t  getFrameHeight(void);
   uint16_t  getFrameWidth(void);
+  uint8_t   getFrameBufferCount(void) const { return _fbCount; }
   esp_err_t init(void) { return init(_cameraId); }
   esp_err_t init(const CameraId model);
   esp_err_t loadSettings(const char* key = nullptr);
@@ -147,6 +148,7 @@ class ESP32Cam {
   CameraId      _cameraId;    /**< Type of sensor modules */
   const _pins_t*  _pins;      /**< GPIO pins assignment index */
   bool          _psram;       /**< Whether PSRAM is actually installed or not */
+  uint8_t       _fbCount;     /**< Frame buffers allocated by the camera driver */
   sensor_t*     _sensor;      /**< The currnet sensor characteristics */
   hw_timer_t*   _hwTimer;     /**< HW Timer for Timer-Shot */
   String  _captureName;       /**< Name of the file where the captured image will be saved. */
@@ -25,6 +25,7 @@
 */
 
 #include <esp32-hal.h>
+#include <esp_idf_version.h>
 #include <FS.h>
 #include <SD.h>
 #include <SD_MMC.h>
@@ -47,13 +48,21 @@ const char  ESP32WebCam::_CONTENT_TYPE[] = "multipart/x-mixed-replace;boundary=%
 const char  ESP32WebCam::_CONTENT_BOUNDARY[] = "\r\n--%s\r\n";
 const char  ESP32WebCam::_CONTENT_PARTHEADER[] = "Content-Type:image/jpeg\r\nContent-Length:%u\r\n\r\n";
 
+// A streaming client holds its own boundary string, which the headers of
+// the response refer to until the streaming ends.
+struct ESP32WebCam::_streamClient_t {
+  httpd_req_t*  req;
+  char  mime[sizeof(_CONTENT_TYPE) + 33];
+  char  contentBoundary[33 + 6];
+};
+
 /**
  * ESP32WebCam constractor
  * Depending on the sensor device type, determine the ESP32 module's wiring
  * pin assignment.
  * @param  model  The model ID of the sensor to be used.
  */
-ESP32WebCam::ESP32WebCam(const uint16_t port) : _port(port), _stream_d(nullptr) {
+ESP32WebCam::ESP32WebCam(const uint16_t port) : _port(port), _producer(nullptr), _stream_d(nullptr) {
   _esp32cam.reset(new ESP32Cam);
 }
 
@@ -63,7 +72,7 @@ ESP32WebCam::ESP32WebCam(const uint16_t port) : _port(port), _stream_d(nullptr)
  * pin assignment.
  * @param  model  The model ID of the sensor to be used.
  */
-ESP32WebCam::ESP32WebCam(const ESP32Cam::CameraId model, const uint16_t port) : _port(port), _stream_d(nullptr) {
+ESP32WebCam::ESP32WebCam(const ESP32Cam::CameraId model, const uint16_t port) : _port(port), _producer(nullptr), _stream_d(nullptr) {
   _esp32cam.reset(new ESP32Cam(model));
 }
 
@@ -78,8 +87,16 @@ ESP32WebCam::~ESP32WebCam() {
 
 /**
  * Shutdown the Web server
+ * The streaming clients and the producer leave the fan-out before the
+ * httpd stops, since they still refer to the requests.
  */
 void ESP32WebCam::stopCameraServer(void) {
+  if (_fanout) {
+    _fanout->end();
+    unsigned long tm = millis();
+    while ((_producer || _fanout->subscribers()) && millis() - tm < ESP32CAM_STREAM_TIMEOUT)
+      delay(10);
+  }
   if (_stream_d) {
     httpd_stop(_stream_d);
     _stream_d = nullptr;
@@ -144,6 +161,9 @@ esp_err_t ESP32WebCam::startCameraServer(const char* streamPath, const char* cap
   // The default stack size 4096 of the httpd task is insufficient to restart the SD
   // file system. Increase the stack size.
   serverConfig.stack_size = 8192;
+  // The streaming clients hold their sockets. Let a new client purge the
+  // least recently used one rather than be refused.
+  serverConfig.lru_purge_enable = true;
 
   // Start httpd with the port number
   rc = httpd_start(&_stream_d, &serverConfig);
@@ -188,6 +208,24 @@ esp_err_t ESP32WebCam::startCameraServer(const char* streamPath, const char* cap
     rc = httpd_register_uri_handler(_stream_d, &streamUri);
     if (rc != ESP_OK)
       log_e("%s handler could not register 0x%04x\n", _streamPath.c_str(), rc);
+
+    // Start the producer that captures the frames for all streaming clients.
+    // It stays idle while no client is streaming.
+    // The driver needs a frame buffer of its own to capture the next frame
+    // into, so the frames in flight are limited to fb_count - 1, but at
+    // least one.
+    if (!_fanout) {
+      const uint8_t fbCount = sensor().getFrameBufferCount();
+      const uint8_t poolLimit = fbCount > 1 ? fbCount - 1 : 1;
+      const uint8_t poolSize = ESP32CAM_STREAM_POOLSIZE && ESP32CAM_STREAM_POOLSIZE < poolLimit ? ESP32CAM_STREAM_POOLSIZE : poolLimit;
+      _fanout.reset(new ESP32WebCamFanout(poolSize));
+    }
+    _fanout->begin(ESP32WebCam::_captureFrame, ESP32WebCam::_releaseFrame);
+    if (xTaskCreateUniversal(ESP32WebCam::_produceTask, "ESP32WebCamProducer", ESP32CAM_STREAM_STACKSIZE, this, 1, &_producer, CONFIG_ARDUINO_RUNNING_CORE) != pdPASS) {
+      _producer = nullptr;
+      rc = ESP_ERR_NO_MEM;
+      log_e("Producer task could not start\n");
+    }
   }
   else
     log_e("httpd could not start 0x%04x\n", rc);
@@ -385,6 +423,10 @@ esp_err_t ESP32WebCam::_promptHandler(httpd_req_t* req) {
 /**
  * The URL handler for streaming repeatedly sends the image data captured by
  * the sensor as a series of JPEG frames (Motion-JPEG) of multipart content.
+ * The frames come from the producer shared by all streaming clients. Each
+ * client streams in its own task so that the httpd task can accept the other
+ * clients meanwhile. Without the asynchronous request of ESP-IDF 5.1, the
+ * client streams in the httpd task.
  * @param  req      The httpd_req_t structure passed from httpd.
  * @return ESP_OK   Image data has sent
  * @return ESP_FAIL
@@ -392,8 +434,7 @@ esp_err_t ESP32WebCam::_promptHandler(httpd_req_t* req) {
 esp_err_t ESP32WebCam::_streamHandler(httpd_req_t* req) {
   static const char bcharsnospace[] = "'()+,-./0123456789:=?abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ";
   char  boundary[33];
-  char  mime[sizeof(_CONTENT_TYPE) + sizeof(boundary)];
-  char  contentBoundary[sizeof(boundary) + 6];
+  std::unique_ptr<_streamClient_t> client(new _streamClient_t);
 
   // Assemble a boundary string from pseudo-random numbers.
   srand(esp_timer_get_time());
@@ -401,51 +442,67 @@ esp_err_t ESP32WebCam::_streamHandler(httpd_req_t* req) {
   while (c < sizeof(boundary) - 1)
     boundary[c++] = bcharsnospace[(int)_random(sizeof(bcharsnospace) - 1)];
   boundary[c] = '\0';
-  sprintf(mime, _CONTENT_TYPE, (const char*)boundary);
-  sprintf(contentBoundary, _CONTENT_BOUNDARY, (const char*)boundary);
+  sprintf(client->mime, _CONTENT_TYPE, (const char*)boundary);
+  sprintf(client->contentBoundary, _CONTENT_BOUNDARY, (const char*)boundary);
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  if (httpd_req_async_handler_begin(req, &client->req) == ESP_OK) {
+    if (xTaskCreateUniversal(ESP32WebCam::_streamTask, "ESP32WebCamStream", ESP32CAM_STREAM_STACKSIZE, client.get(), 1, NULL, CONFIG_ARDUINO_RUNNING_CORE) == pdPASS) {
+      client.release();
+      return ESP_OK;
+    }
+    httpd_req_async_handler_complete(client->req);
+  }
+  log_w("Streaming continues in the httpd task\n");
+#endif
+  client->req = req;
+  return _streamFrames(client.get());
+}
+
+/**
+ * The task of a streaming client that owns an asynchronous request.
+ * @param  pvParameters  _streamClient_t of the client
+ */
+void ESP32WebCam::_streamTask(void* pvParameters) {
+  _streamClient_t*  client = reinterpret_cast<_streamClient_t*>(pvParameters);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  _streamFrames(client);
+  httpd_req_async_handler_complete(client->req);
+#endif
+  delete client;
+  vTaskDelete(NULL);
+}
+
+/**
+ * Send the frames of the fan-out to the client until the client leaves or
+ * the fan-out ends. A client that is slow to send skips the frames that
+ * were captured in the meantime.
+ * @param  client   The streaming client.
+ * @return ESP_OK   The fan-out has ended.
+ * @return ESP_FAIL
+ */
+esp_err_t ESP32WebCam::_streamFrames(_streamClient_t* client) {
+  ESP32WebCamFanout&  fanout = *(ESP32WebCam_internal::esp32webcam->_fanout.get());
+  httpd_req_t*  req = client->req;
 
   // Send headers
   // HTTP/1.1 200
   // Content-Type: multipart/x-mixed-replace;boundary={contentBoundary}
   // Access-Control-Allow-Origin: *
   // X-Framerate: 60
-  httpd_resp_set_type(req, mime);
+  httpd_resp_set_type(req, client->mime);
   httpd_resp_set_hdr(req, ESP32WebCam::_ACCESS_CONTROL_ALLOW_ORIGIN, "*");
   httpd_resp_set_hdr(req, "X-Framerate", "60");
 
   // Repeated transmission of captured JPEG frames
   esp_err_t rc = ESP_OK;
+  uint32_t  seq = 0;
+  fanout.subscribe();
   while (rc == ESP_OK) {
-    uint8_t*  jpegBuffer;
-    size_t    jpegSize;
-
-    // Indicates the output buffer of the image sensor.
-    camera_fb_t*  fb = esp_camera_fb_get();
-
-    if (fb) {
-      if (fb->format == PIXFORMAT_JPEG) {
-        // If the pixel format of the image sensor is JPEG, it can be read
-        // directly from the frame buffer.
-        jpegBuffer = fb->buf;
-        jpegSize = fb->len;
-      }
-      else {
-        // If the scene is not in JPEG format, it will attempt to revert to
-        // JPEG, but this does not always work. Since most of the failures are
-        // due to lack of memory, you can avoid conversion errors by reducing
-        // the JPEG quality of the resulting image.
-        bool  jpegcc = frame2jpg(fb, 80, &jpegBuffer, &jpegSize);
-        esp_camera_fb_return(fb);
-        fb = nullptr;
-        if (!jpegcc) {
-          _sendResponse(req, 500, "text/plain", "_streamHandler failed to frame2jpg");
-          rc = ESP_FAIL;
-          break;
-        }
-      }
-    }
-    else {
-      _sendResponse(req, 500, "text/plain", "_streamHandler failed to esp_camera_fb_get");
+    const int slot = fanout.acquire(seq, ESP32CAM_STREAM_TIMEOUT);
+    if (slot < 0) {
+      // The producer has stopped or the sensor has not responded.
+      log_w("_streamHandler no more frames\n");
       rc = ESP_FAIL;
       break;
     }
@@ -457,31 +514,93 @@ esp_err_t ESP32WebCam::_streamHandler(httpd_req_t* req) {
     // Content-Type: image/jpeg
     // Content-Length: {jpegSize}
     // [CRLF]
-    // JPEG Frame - One shot from {jpegBuffer}
+    // JPEG Frame - One shot from the shared frame
     // REPEAT IMMEDIATELY FROM [CRLF]--{contentBoundary}
-    if (ESP32Cam::enq(5000) == pdTRUE) {
-      if ((rc = httpd_resp_send_chunk(req, contentBoundary, sizeof(contentBoundary))) == ESP_OK) {
-        char  partialHeader[sizeof(_CONTENT_PARTHEADER) + 12];
-        int   hdrSize = sprintf(partialHeader, _CONTENT_PARTHEADER, jpegSize);
-        if ((rc = httpd_resp_send_chunk(req, (const char*)partialHeader, hdrSize)) == ESP_OK) {
-          rc = httpd_resp_send_chunk(req, (const char*)jpegBuffer, jpegSize);
-        }
-      }
-      ESP32Cam::deq();
+    const ESP32WebCamFanout::Frame_t& frame = fanout.frame(slot);
+    if ((rc = httpd_resp_send_chunk(req, client->contentBoundary, strlen(client->contentBoundary))) == ESP_OK) {
+      char  partialHeader[sizeof(_CONTENT_PARTHEADER) + 12];
+      int   hdrSize = sprintf(partialHeader, _CONTENT_PARTHEADER, frame.len);
+      if ((rc = httpd_resp_send_chunk(req, (const char*)partialHeader, hdrSize)) == ESP_OK)
+        rc = httpd_resp_send_chunk(req, (const char*)frame.buf, frame.len);
     }
+    fanout.release(slot);
+  }
+  fanout.unsubscribe();
+  return rc;
+}
+
+/**
+ * Capture a frame for the fan-out. The frame buffer of a JPEG sensor is
+ * handed to the clients as it is, and the other formats are converted to
+ * JPEG once here for all clients. The sensor is reserved only during the
+ * capture.
+ * @param  frame  The frame to be filled.
+ * @return true   The frame has captured.
+ */
+bool ESP32WebCam::_captureFrame(ESP32WebCamFanout::Frame_t& frame) {
+  bool  captured = false;
 
+  if (ESP32Cam::enq(ESP32CAM_STREAM_TIMEOUT) == pdTRUE) {
+    camera_fb_t*  fb = esp_camera_fb_get();
     if (fb) {
-      esp_camera_fb_return(fb);
-      fb = nullptr;
-      jpegBuffer = nullptr;
-    }
-    else if (jpegBuffer) {
-      free(jpegBuffer);
-      jpegBuffer = nullptr;
+      if (fb->format == PIXFORMAT_JPEG) {
+        frame.buf = fb->buf;
+        frame.len = fb->len;
+        frame.handle = fb;
+        captured = true;
+      }
+      else {
+        // If the scene is not in JPEG format, it will attempt to revert to
+        // JPEG, but this does not always work. Since most of the failures are
+        // due to lack of memory, you can avoid conversion errors by reducing
+        // the JPEG quality of the resulting image.
+        uint8_t*  jpegBuffer;
+        size_t    jpegSize;
+        captured = frame2jpg(fb, 80, &jpegBuffer, &jpegSize);
+        esp_camera_fb_return(fb);
+        if (captured) {
+          frame.buf = jpegBuffer;
+          frame.len = jpegSize;
+          frame.handle = nullptr;
+        }
+        else
+          log_e("_captureFrame failed to frame2jpg\n");
+      }
     }
+    else
+      log_e("_captureFrame failed to esp_camera_fb_get\n");
+    ESP32Cam::deq();
   }
+  return captured;
+}
 
-  return rc;
+/**
+ * Give back the frame that all clients have sent.
+ * @param  frame  The frame to be released.
+ */
+void ESP32WebCam::_releaseFrame(ESP32WebCamFanout::Frame_t& frame) {
+  if (frame.handle)
+    esp_camera_fb_return(reinterpret_cast<camera_fb_t*>(frame.handle));
+  else
+    free(const_cast<uint8_t*>(frame.buf));
+}
+
+/**
+ * The producer task captures the frames while any client is streaming, and
+ * ends along with the fan-out.
+ * @param  pvParameters  Current instance of ESP32WebCam
+ */
+void ESP32WebCam::_produceTask(void* pvParameters) {
+  ESP32WebCam*  webcam = reinterpret_cast<ESP32WebCam*>(pvParameters);
+  ESP32WebCamFanout::Produce_t  rc;
+
+  while ((rc = webcam->_fanout->produce(ESP32CAM_STREAM_TIMEOUT)) != ESP32WebCamFanout::PRODUCE_END) {
+    // Give the sensor a break after the failure of the capture.
+    if (rc == ESP32WebCamFanout::PRODUCE_FAIL)
+      delay(100);
+  }
+  webcam->_producer = nullptr;
+  vTaskDelete(NULL);
 }
 
 /**
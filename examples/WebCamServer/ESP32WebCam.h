@@ -30,6 +30,7 @@
 
 #include <memory>
 #include "ESP32Cam.h"
+#include "ESP32WebCamFanout.h"
 
 // Default HTTP Server port
 #ifndef ESP32CAM_DEFAULT_HTTPPORT
@@ -51,6 +52,23 @@
 #define ESP32CAM_DEFAULT_PATH_STREAM   "/_stream"
 #endif // !ESP32CAM_DEFAULT_PATH_STREAM
 
+// Number of the frames in flight for the streaming clients. 0 follows the
+// frame buffers of the camera driver, fb_count - 1 but at least 1. A larger
+// value is capped to it.
+#ifndef ESP32CAM_STREAM_POOLSIZE
+#define ESP32CAM_STREAM_POOLSIZE      0
+#endif // !ESP32CAM_STREAM_POOLSIZE
+
+// Time in milliseconds to wait for the next frame of streaming
+#ifndef ESP32CAM_STREAM_TIMEOUT
+#define ESP32CAM_STREAM_TIMEOUT       5000
+#endif // !ESP32CAM_STREAM_TIMEOUT
+
+// Stack size of the tasks for capturing frames and for each streaming client
+#ifndef ESP32CAM_STREAM_STACKSIZE
+#define ESP32CAM_STREAM_STACKSIZE     4096
+#endif // !ESP32CAM_STREAM_STACKSIZE
+
 // Definition of operand for remote command to be executed by prompt handler
 #define ESP32CAM_PROMPT_OPERAND_KEY_FILENAME        "filename"
 #define ESP32CAM_PROMPT_OPERAND_KEY_FILESYSTEM      "fs"
@@ -98,15 +116,23 @@ class ESP32WebCam {
   static esp_err_t _streamHandler(httpd_req_t* req);
   static esp_err_t _sendResponse(httpd_req_t* req, const uint16_t status, const char* mime, const char* body, ssize_t bodyLen = 0);
   std::unique_ptr<ESP32Cam>  _esp32cam;
+  std::unique_ptr<ESP32WebCamFanout> _fanout; /**< Frames shared by the streaming clients */
 
  private:
   typedef struct {
     httpd_req_t*  req;
     size_t  len;
   } _jpgChunking_t;
+  struct _streamClient_t;
   static size_t _jpgEncodeStream(void* arg, size_t index, const void* data, size_t len);
   static long _random(long max);
+  static bool _captureFrame(ESP32WebCamFanout::Frame_t& frame);
+  static void _releaseFrame(ESP32WebCamFanout::Frame_t& frame);
+  static void _produceTask(void* pvParameters);
+  static void _streamTask(void* pvParameters);
+  static esp_err_t  _streamFrames(_streamClient_t* client);
   uint16_t        _port;      /**< HTTP Server port */
+  TaskHandle_t    _producer;  /**< Task capturing the frames for streaming */
   httpd_handle_t  _stream_d;  /**< HTTP Server it activated */
   String _capturePath;        /**< Pathname to reply with a one-shot JPEG image */
   String _promptPath;         /**< Pathname to prompt the ESP32Cam instance to perform the function */
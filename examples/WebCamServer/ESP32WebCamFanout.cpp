@@ -0,0 +1,205 @@
+/*
+  Frame fan-out for the Motion-JPEG streaming of ESP32WebCam implementation.
+  Date: 2025-08-30
+
+  Copyright (c) 2025 Hieromon Ikasamo.
+  This software is released under the MIT License.
+  https://opensource.org/licenses/MIT
+*/
+
+#include <chrono>
+#include "ESP32WebCamFanout.h"
+
+/**
+ * ESP32WebCamFanout constructor
+ * @param  poolSize  Number of the frames that can be in flight at once. For
+ * a JPEG sensor the slot holds the frame buffer of the camera driver, so it
+ * should not exceed the fb_count of the camera configuration minus one.
+ */
+ESP32WebCamFanout::ESP32WebCamFanout(const uint8_t poolSize)
+: _pool(poolSize ? poolSize : 1), _latest(-1), _seq(0), _subscribers(0), _active(false) {
+  for (_slot_t& slot : _pool) {
+    slot.frame = { nullptr, 0, nullptr };
+    slot.seq = 0;
+    slot.refs = 0;
+  }
+}
+
+/**
+ * Start the fan-out with the frame source.
+ * @param  capture  Function to capture and encode a frame.
+ * @param  release  Function to give back the buffer of the frame.
+ */
+void ESP32WebCamFanout::begin(Capture_ft capture, Release_ft release) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _capture = capture;
+  _release = release;
+  _latest = -1;
+  _active = true;
+}
+
+/**
+ * End the fan-out. The producer and the clients waiting for a frame return
+ * immediately. The frames that clients are still sending are disposed of
+ * as they are released.
+ */
+void ESP32WebCamFanout::end(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _active = false;
+  _latest = -1;
+  for (_slot_t& slot : _pool)
+    if (slot.seq && !slot.refs)
+      _dispose(slot);
+  _cond.notify_all();
+}
+
+/**
+ * A turn of the producer. It waits for a streaming client and a free slot,
+ * then captures a frame into the slot and publishes it as the latest.
+ * The capture runs outside the lock so that the clients can keep sending
+ * the previous frame meanwhile.
+ * @param  timeout  Time in milliseconds to wait for a client or a slot.
+ * @return The result of the turn.
+ */
+ESP32WebCamFanout::Produce_t ESP32WebCamFanout::produce(const unsigned long timeout) {
+  std::unique_lock<std::mutex>  lock(_mutex);
+  const auto  limit = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+  if (!_cond.wait_until(lock, limit, [this] { return !_active || _subscribers; }))
+    return PRODUCE_IDLE;
+  if (!_active)
+    return PRODUCE_END;
+
+  int slot;
+  if (!_cond.wait_until(lock, limit, [this, &slot] { return !_active || (slot = _reserve()) >= 0; }))
+    return PRODUCE_NOSLOT;
+  if (!_active)
+    return PRODUCE_END;
+
+  Frame_t frame = { nullptr, 0, nullptr };
+  Capture_ft  capture = _capture;
+  lock.unlock();
+  const bool  captured = capture(frame);
+  lock.lock();
+  if (!captured)
+    return PRODUCE_FAIL;
+  if (!_active) {
+    _release(frame);
+    return PRODUCE_END;
+  }
+  // The last client left during the capture.
+  if (!_subscribers) {
+    _release(frame);
+    return PRODUCE_IDLE;
+  }
+
+  // The sequence number 0 marks a free slot.
+  if (!++_seq)
+    ++_seq;
+  _pool[slot].frame = frame;
+  _pool[slot].seq = _seq;
+  _pool[slot].refs = 0;
+  if (_latest >= 0 && !_pool[_latest].refs)
+    _dispose(_pool[_latest]);
+  _latest = slot;
+  _cond.notify_all();
+  return PRODUCE_OK;
+}
+
+/**
+ * Register a streaming client. The producer captures frames while any
+ * client is registered.
+ */
+void ESP32WebCamFanout::subscribe(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _subscribers++;
+  _cond.notify_all();
+}
+
+/**
+ * Unregister a streaming client. When the last client leaves, the latest
+ * frame is given back to its owner so that the idle producer does not hold
+ * the buffer of the camera driver.
+ */
+void ESP32WebCamFanout::unsubscribe(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_subscribers && !--_subscribers && _latest >= 0) {
+    // A frame still being sent is disposed of as it is released.
+    if (!_pool[_latest].refs)
+      _dispose(_pool[_latest]);
+    _latest = -1;
+  }
+}
+
+/**
+ * Get the number of the streaming clients.
+ */
+uint8_t ESP32WebCamFanout::subscribers(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _subscribers;
+}
+
+/**
+ * Acquire the latest frame newer than the one the client sent last. The
+ * frames published while the client was sending are skipped.
+ * @param  seq      Sequence number of the frame sent last, 0 for the first.
+ * It is updated with the sequence number of the acquired frame.
+ * @param  timeout  Time in milliseconds to wait for a new frame.
+ * @return The slot of the frame, which must be released after sending.
+ * @return -1 Timed out or the fan-out has ended.
+ */
+int ESP32WebCamFanout::acquire(uint32_t& seq, const unsigned long timeout) {
+  std::unique_lock<std::mutex>  lock(_mutex);
+
+  if (!_cond.wait_for(lock, std::chrono::milliseconds(timeout), [this, seq] { return !_active || (_latest >= 0 && _pool[_latest].seq != seq); }))
+    return -1;
+  if (!_active)
+    return -1;
+  _pool[_latest].refs++;
+  seq = _pool[_latest].seq;
+  return _latest;
+}
+
+/**
+ * Release the frame that the client has sent. The last client to release
+ * a frame that is no longer the latest gives it back to its owner.
+ * @param  slot  The slot returned by acquire.
+ */
+void ESP32WebCamFanout::release(const int slot) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _slot_t&  s = _pool[slot];
+  if (s.refs && !--s.refs) {
+    if (slot != _latest)
+      _dispose(s);
+    // The producer may be waiting for the slot.
+    _cond.notify_all();
+  }
+}
+
+/**
+ * Give back the buffer of the slot and make it free.
+ */
+void ESP32WebCamFanout::_dispose(_slot_t& slot) {
+  if (_release)
+    _release(slot.frame);
+  slot.frame = { nullptr, 0, nullptr };
+  slot.seq = 0;
+}
+
+/**
+ * Reserve a slot for the next frame. When the pool is exhausted, the
+ * latest frame that no client is sending gives way to the new one.
+ * @return The index of the slot, -1 if all slots are in use.
+ */
+int ESP32WebCamFanout::_reserve(void) {
+  for (size_t i = 0; i < _pool.size(); i++)
+    if (!_pool[i].seq && !_pool[i].refs)
+      return static_cast<int>(i);
+  if (_latest >= 0 && !_pool[_latest].refs) {
+    const int slot = _latest;
+    _dispose(_pool[slot]);
+    _latest = -1;
+    return slot;
+  }
+  return -1;
+}
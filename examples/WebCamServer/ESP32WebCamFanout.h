@@ -0,0 +1,84 @@
+/*
+  Frame fan-out for the Motion-JPEG streaming of ESP32WebCam.
+  Date: 2025-08-30
+
+  Copyright (c) 2025 Hieromon Ikasamo.
+  This software is released under the MIT License.
+  https://opensource.org/licenses/MIT
+
+  A single producer captures and encodes each frame once into a slot of the
+  pool, and every streaming client sends the same slot. The slot is reference
+  counted and is returned to the producer when the last client has sent it.
+  A client that is still sending the previous frame when a new one arrives
+  does not hold up the producer; it just picks up the latest frame on its next
+  turn and skips the ones in between.
+
+  This class depends only on the C++ standard library, so the fan-out can be
+  exercised on the host with a synthetic frame source.
+*/
+
+#ifndef _ESP32WEBCAMFANOUT_H_
+#define _ESP32WEBCAMFANOUT_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class ESP32WebCamFanout {
+ public:
+  // A frame held by the slot.
+  typedef struct {
+    const uint8_t*  buf;    /**< Encoded JPEG image */
+    size_t  len;            /**< Length of the image */
+    void*   handle;         /**< Owner of the buffer, such as camera_fb_t */
+  } Frame_t;
+  // Fills the frame. Returns false if the capture failed.
+  typedef std::function<bool(Frame_t&)>  Capture_ft;
+  // Gives back the buffer of the frame to its owner.
+  typedef std::function<void(Frame_t&)>  Release_ft;
+
+  // Result of a turn of the producer.
+  typedef enum {
+    PRODUCE_OK,     /**< A new frame was published */
+    PRODUCE_IDLE,   /**< No client is streaming */
+    PRODUCE_NOSLOT, /**< All slots are held by the clients */
+    PRODUCE_FAIL,   /**< The capture failed */
+    PRODUCE_END     /**< The fan-out has ended */
+  } Produce_t;
+
+  explicit ESP32WebCamFanout(const uint8_t poolSize = 2);
+  ~ESP32WebCamFanout() { end(); }
+  void  begin(Capture_ft capture, Release_ft release);
+  void  end(void);
+  Produce_t produce(const unsigned long timeout);
+  void  subscribe(void);
+  void  unsubscribe(void);
+  uint8_t subscribers(void);
+  int   acquire(uint32_t& seq, const unsigned long timeout);
+  const Frame_t&  frame(const int slot) const { return _pool[slot].frame; }
+  void  release(const int slot);
+
+ private:
+  typedef struct {
+    Frame_t   frame;
+    uint32_t  seq;    /**< Sequence number of the frame, 0 while the slot is free */
+    uint8_t   refs;   /**< Number of the clients sending the frame */
+  } _slot_t;
+  void  _dispose(_slot_t& slot);
+  int   _reserve(void);
+
+  std::vector<_slot_t>  _pool;
+  std::mutex  _mutex;
+  std::condition_variable _cond;
+  Capture_ft  _capture;
+  Release_ft  _release;
+  int       _latest;      /**< Slot of the latest frame */
+  uint32_t  _seq;         /**< Sequence number of the latest frame */
+  uint8_t   _subscribers; /**< Number of the streaming clients */
+  bool      _active;      /**< The fan-out has begun */
+};
+
+#endif // !_ESP32WEBCAMFANOUT_H_
@@ -0,0 +1,154 @@
+/*
+  acjsonpeak - Measures the peak of the AutoConnectJsonArena while the
+  custom web pages are deserialized.
+
+  Build:
+    g++ -std=c++11 -I<ArduinoJson>/src -I../../src -o acjsonpeak acjsonpeak.cpp
+
+  Usage:
+    acjsonpeak [-c CAPACITY] FILE...
+      A .json file is loaded as a whole. From any other file, such as a
+      sketch, each raw string literal that holds a JSON document is loaded.
+      The peak of each document is printed along with the bytes spilled
+      over the CAPACITY of the arena, which defaults to 8192.
+*/
+
+#include <algorithm>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AutoConnectJsonArena.h"
+
+struct Page {
+  std::string source;
+  std::string json;
+};
+
+static bool isIdent(char c) {
+  return isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static size_t skipSpace(const std::string& s, size_t p) {
+  while (p < s.size() && isspace(static_cast<unsigned char>(s[p])))
+    p++;
+  return p;
+}
+
+// Parse the string literal at p into out. Returns the position after the
+// literal, or std::string::npos if p is not at a string literal.
+static size_t literal(const std::string& s, size_t p, std::string& out) {
+  if (s.compare(p, 2, "R\"") == 0) {
+    size_t open = s.find('(', p + 2);
+    if (open == std::string::npos)
+      return std::string::npos;
+    const std::string close = ")" + s.substr(p + 2, open - p - 2) + "\"";
+    size_t end = s.find(close, open + 1);
+    if (end == std::string::npos)
+      return std::string::npos;
+    out += s.substr(open + 1, end - open - 1);
+    return end + close.size();
+  }
+  if (p < s.size() && s[p] == '"') {
+    for (p++; p < s.size() && s[p] != '"'; p++) {
+      if (s[p] == '\\' && p + 1 < s.size())
+        p++;
+      out += s[p];
+    }
+    return p < s.size() ? p + 1 : std::string::npos;
+  }
+  return std::string::npos;
+}
+
+// Find the string value of the macro in the source.
+static bool macro(const std::string& s, const std::string& name, std::string& out) {
+  const std::string directive = "#define " + name;
+  for (size_t p = s.find(directive); p != std::string::npos; p = s.find(directive, p + 1)) {
+    size_t q = p + directive.size();
+    if (q < s.size() && isIdent(s[q]))
+      continue;
+    return literal(s, skipSpace(s, q), out) != std::string::npos;
+  }
+  return false;
+}
+
+// Extract the JSON documents held by the raw string literals. The adjacent
+// literals and the macros of a string between them are concatenated.
+static void extract(const std::string& path, const std::string& s, std::vector<Page>& pages) {
+  for (size_t p = s.find("R\""); p != std::string::npos; p = s.find("R\"", p + 1)) {
+    if (p && isIdent(s[p - 1]))
+      continue;
+    const size_t  line = std::count(s.begin(), s.begin() + p, '\n') + 1;
+    std::string text;
+    size_t q = literal(s, p, text);
+    if (q == std::string::npos)
+      continue;
+    for (;;) {
+      size_t r = skipSpace(s, q);
+      std::string more;
+      size_t next = literal(s, r, more);
+      if (next == std::string::npos) {
+        size_t e = r;
+        while (e < s.size() && isIdent(s[e]))
+          e++;
+        if (e == r || !macro(s, s.substr(r, e - r), more))
+          break;
+        next = e;
+      }
+      text += more;
+      q = next;
+    }
+    p = q - 1;
+    size_t first = skipSpace(text, 0);
+    if (first < text.size() && (text[first] == '{' || text[first] == '['))
+      pages.push_back({ path + ":" + std::to_string(line), text });
+  }
+}
+
+int main(int argc, char* argv[]) {
+  size_t capacity = 8192;
+  std::vector<Page> pages;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+      capacity = strtoul(argv[++i], nullptr, 0);
+      continue;
+    }
+    std::ifstream in(argv[i], std::ios::binary);
+    if (!in) {
+      perror(argv[i]);
+      return 1;
+    }
+    std::stringstream buf;
+    buf << in.rdbuf();
+    const std::string path(argv[i]);
+    if (path.size() > 5 && path.compare(path.size() - 5, 5, ".json") == 0)
+      pages.push_back({ path, buf.str() });
+    else
+      extract(path, buf.str(), pages);
+  }
+  if (pages.empty()) {
+    fprintf(stderr, "usage: %s [-c CAPACITY] FILE...\n", argv[0]);
+    return 2;
+  }
+
+  int rc = 0;
+  printf("%-48s %8s %8s %8s  %s\n", "page", "json", "peak", "spilled", "result");
+  for (const Page& page : pages) {
+    AutoConnectJsonArena  arena(capacity);
+    DeserializationError  err;
+    {
+      JsonDocument  doc(static_cast<ArduinoJson::Allocator*>(&arena));
+      err = deserializeJson(doc, page.json.c_str(), page.json.size());
+      if (!err && doc.overflowed())
+        err = DeserializationError::NoMemory;
+    }
+    printf("%-48s %8lu %8lu %8lu  %s\n", page.source.c_str(), (unsigned long)page.json.size(), (unsigned long)arena.peak(), (unsigned long)arena.spilled(), err.c_str());
+    if (err)
+      rc = 1;
+  }
+  return rc;
+}
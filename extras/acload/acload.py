@@ -0,0 +1,412 @@
+#!python3.*
+
+"""captive portal load generator.
+"""
+
+import argparse
+import csv
+import http.client
+import http.server
+import ipaddress
+import json
+import logging
+import math
+import random
+import socket
+import socketserver
+import struct
+import sys
+import threading
+import time
+import urllib.parse
+
+# The captive probes of each OS. The phone resolves the host with the DNS
+# of the SoftAP, which answers the address of the portal, and requests the
+# path expecting the redirection to the portal.
+PROBES = {
+    'android': ('connectivitycheck.gstatic.com', '/generate_204'),
+    'apple': ('captive.apple.com', '/hotspot-detect.html'),
+    'windows': ('www.msftconnecttest.com', '/connecttest.txt')
+}
+STEPS = ('dns', 'probe', 'portal', 'config', 'scan', 'connect')
+REPORT_FIELDS = ('clients', 'step', 'requests', 'errors', 'p50', 'p90', 'p99', 'max')
+SCAN_PAGE = 5
+# The stand-in of the portal marks its responses with the header, and the
+# report labels the figures measured against it as synthetic.
+STANDIN_HEADER = 'X-AutoConnect-Standin'
+
+logger = logging.getLogger(__name__)
+
+
+def split_address(address, port):
+    host, _, p = address.partition(':')
+    return host, int(p) if p else port
+
+
+def dns_query(server, name, timeout):
+    """Resolves the name with the A query and returns the answered address."""
+    qid = random.getrandbits(16)
+    question = b''.join(bytes([len(label)]) + label.encode('ascii') for label in name.split('.')) + b'\0'
+    packet = struct.pack('>HHHHHH', qid, 0x0100, 1, 0, 0, 0) + question + struct.pack('>HH', 1, 1)
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+        sock.settimeout(timeout)
+        sock.sendto(packet, server)
+        while True:
+            reply, _ = sock.recvfrom(512)
+            rid, flags, _, ancount, _, _ = struct.unpack('>HHHHHH', reply[:12])
+            if rid == qid:
+                break
+    if flags & 0x000f or not ancount:
+        raise OSError('no answer for {0}, rcode {1}'.format(name, flags & 0x000f))
+    pos = 12 + len(question) + 4
+    # The name of the answer is a pointer or the labels.
+    if reply[pos] & 0xc0 == 0xc0:
+        pos += 2
+    else:
+        while reply[pos]:
+            pos += reply[pos] + 1
+        pos += 1
+    rtype, _, _, rdlength = struct.unpack('>HHIH', reply[pos:pos + 10])
+    if rtype != 1 or rdlength != 4:
+        raise OSError('unexpected answer type {0} for {1}'.format(rtype, name))
+    return socket.inet_ntoa(reply[pos + 10:pos + 14])
+
+
+class Phone:
+    """A client that goes through the onboarding sequence of a phone."""
+
+    def __init__(self, index, os_name, target, dns, timeout, source, credential):
+        self.index = index
+        self.os_name = os_name
+        self.target = target
+        self.dns = dns
+        self.timeout = timeout
+        self.source = (source, 0) if source else None
+        self.credential = credential
+        self.conn = None
+        self.samples = []
+        self.synthetic = False
+
+    def __request(self, step, method, uri, host, expect, body=None):
+        headers = {'Host': host, 'User-Agent': 'acload/{0}'.format(self.os_name)}
+        if body is not None:
+            body = urllib.parse.urlencode(body).encode('ascii')
+            headers['Content-Type'] = 'application/x-www-form-urlencoded'
+        if self.conn is None:
+            self.conn = http.client.HTTPConnection(self.target[0], self.target[1], timeout=self.timeout, source_address=self.source)
+        start = time.monotonic()
+        try:
+            self.conn.request(method, uri, body=body, headers=headers)
+            response = self.conn.getresponse()
+            content = response.read()
+            if response.getheader(STANDIN_HEADER):
+                self.synthetic = True
+        except (OSError, http.client.HTTPException) as e:
+            self.conn.close()
+            self.conn = None
+            self.__record(step, start, 'error', str(e) or type(e).__name__)
+            return None, None
+        if response.getheader('Connection', '').lower() == 'close':
+            self.conn.close()
+            self.conn = None
+        if response.status not in expect:
+            self.__record(step, start, 'error', 'status {0}'.format(response.status))
+            return None, None
+        self.__record(step, start, 'ok', response.status)
+        return response, content
+
+    def __record(self, step, start, result, detail):
+        latency = round((time.monotonic() - start) * 1000, 1)
+        self.samples.append({'step': step, 'latency': latency, 'result': result})
+        if result != 'ok':
+            logger.debug('phone {0} {1} {2}: {3}'.format(self.index, self.os_name, step, detail))
+
+    def onboard(self, connect):
+        """Runs the sequence and returns whether every step succeeded."""
+        probe_host, probe_path = PROBES[self.os_name]
+        if self.dns:
+            start = time.monotonic()
+            try:
+                dns_query(self.dns, probe_host, self.timeout)
+                self.__record('dns', start, 'ok', '')
+            except (OSError, IndexError, struct.error) as e:
+                self.__record('dns', start, 'error', str(e) or type(e).__name__)
+                return False
+
+        # The captive portal redirects the probe to the portal.
+        response, _ = self.__request('probe', 'GET', probe_path, probe_host, (302,))
+        if response is None:
+            return False
+        location = urllib.parse.urlsplit(response.getheader('Location', ''))
+        portal = location.path or '/_ac'
+        host = '{0}:{1}'.format(*self.target) if self.target[1] != 80 else self.target[0]
+
+        if self.__request('portal', 'GET', portal, host, (200,))[0] is None:
+            return False
+        if self.__request('config', 'GET', '/_ac/config', host, (200,))[0] is None:
+            return False
+        # The Configure new AP page fills the SSID list from the scan results.
+        response, content = self.__request('scan', 'GET', '/_ac/scan?cursor=0&count={0}&rescan=1'.format(SCAN_PAGE), host, (200,))
+        if response is None:
+            return False
+        try:
+            json.loads(content.decode('utf-8'))
+        except ValueError:
+            self.samples[-1]['result'] = 'error'
+            return False
+        if connect:
+            form = {'SSID': self.credential[0], 'Passphrase': self.credential[1], 'dhcp': 'en'}
+            if self.__request('connect', 'POST', '/_ac/connect', host, (200,), form)[0] is None:
+                return False
+        return True
+
+    def close(self):
+        if self.conn is not None:
+            self.conn.close()
+            self.conn = None
+
+
+def percentile(values, rate):
+    """Returns the nearest-rank percentile of the sorted values."""
+    if not values:
+        return ''
+    rank = max(1, math.ceil(rate / 100 * len(values)))
+    return values[rank - 1]
+
+
+def summarize(clients, samples):
+    rows = []
+    for step in STEPS + ('all',):
+        picked = [s for s in samples if step in ('all', s['step'])]
+        if not picked:
+            continue
+        latency = sorted(s['latency'] for s in picked if s['result'] == 'ok')
+        rows.append({
+            'clients': clients,
+            'step': step,
+            'requests': len(picked),
+            'errors': sum(1 for s in picked if s['result'] != 'ok'),
+            'p50': percentile(latency, 50),
+            'p90': percentile(latency, 90),
+            'p99': percentile(latency, 99),
+            'max': latency[-1] if latency else ''
+        })
+    return rows
+
+
+def load(target, dns, levels, rounds, oses, timeout, connect, sources, credential):
+    """Onboards the phones of each level at once and reports each step."""
+    report = []
+    for clients in levels:
+        phones = []
+        for i in range(clients):
+            source = str(sources + i) if sources else None
+            phones.append(Phone(i, oses[i % len(oses)], target, dns, timeout, source, credential))
+        barrier = threading.Barrier(clients + 1)
+        onboarded = []
+
+        def proc(phone):
+            barrier.wait()
+            for _ in range(rounds):
+                if phone.onboard(connect):
+                    onboarded.append(phone.index)
+                phone.close()
+
+        threads = [threading.Thread(target=proc, args=(phone,), daemon=True) for phone in phones]
+        for t in threads:
+            t.start()
+        barrier.wait()
+        start = time.monotonic()
+        for t in threads:
+            t.join()
+        elapsed = time.monotonic() - start
+
+        samples = [s for phone in phones for s in phone.samples]
+        rows = summarize(clients, samples)
+        total = rows[-1]
+        logger.info('{0} clients: {1}/{2} onboarded, {3} requests, {4} errors in {5:.2f}s, {6:.1f} req/s, {7:.2f} onboard/s, p50 {8} p99 {9} ms'.format(
+            clients, len(onboarded), clients * rounds, total['requests'], total['errors'], elapsed,
+            total['requests'] / elapsed if elapsed else 0, len(onboarded) / elapsed if elapsed else 0, total['p50'], total['p99']))
+        synthetic = any(phone.synthetic for phone in phones)
+        if synthetic:
+            logger.info('{0} clients: the figures are synthetic, measured against the stand-in'.format(clients))
+        for row in rows:
+            row['seconds'] = round(elapsed, 3)
+            row['onboarded'] = len(onboarded)
+            row['synthetic'] = 'yes' if synthetic else 'no'
+        report.extend(rows)
+    return report
+
+
+def write_report(report, output):
+    fields = REPORT_FIELDS + ('onboarded', 'seconds', 'synthetic')
+    f = open(output, 'w', newline='', encoding='utf-8') if output else sys.stdout
+    writer = csv.DictWriter(f, fieldnames=fields, restval='')
+    writer.writeheader()
+    writer.writerows(report)
+    if output:
+        f.close()
+
+
+class PortalDNSHandler(socketserver.BaseRequestHandler):
+    """Answers every A query with the address of the portal as the DNSServer of AutoConnect."""
+
+    def handle(self):
+        data, sock = self.request
+        if len(data) < 12:
+            return
+        qid, flags, qdcount = struct.unpack('>HHH', data[:6])
+        pos = 12
+        while pos < len(data) and data[pos]:
+            pos += data[pos] + 1
+        question = data[12:pos + 5]
+        answer = struct.pack('>HHHIH', 0xc00c, 1, 1, 60, 4) + socket.inet_aton(self.server.portal.address)
+        reply = struct.pack('>HHHHHH', qid, 0x8180 | (flags & 0x0100), qdcount, 1, 0, 0) + question + answer
+        sock.sendto(reply, self.client_address)
+
+
+class PortalHTTPRequestHandler(http.server.BaseHTTPRequestHandler):
+    """Responds as the captive portal of AutoConnect. The requests are
+    served one at a time as the WebServer of the device does."""
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, format, *args):
+        logger.debug('%s - %s' % (self.address_string(), format % args))
+
+    def do_GET(self):
+        self.__serve()
+
+    def do_POST(self):
+        self.__serve()
+
+    def __serve(self):
+        length = int(self.headers.get('Content-Length', 0))
+        if length:
+            self.rfile.read(length)
+        portal = self.server.portal
+        with portal.lock:
+            time.sleep(portal.service / 1000)
+            host = self.headers.get('Host', '').split(':')[0]
+            uri = urllib.parse.urlsplit(self.path)
+            if host != portal.address and not host.endswith('.local'):
+                # The request to another host is the captive probe.
+                location = 'http://{0}/_ac'.format(portal.host)
+                self.__respond(302, 'text/plain', b'', {'Location': location, 'Connection': 'close'})
+                self.close_connection = True
+            elif uri.path in ('/_ac', '/_ac/config') and self.command == 'GET':
+                self.__respond(200, 'text/html', portal.page)
+            elif uri.path == '/_ac/scan' and self.command == 'GET':
+                args = urllib.parse.parse_qs(uri.query)
+                if 'rescan' in args:
+                    time.sleep(portal.scan / 1000)
+                    portal.generation += 1
+                cursor = int(args.get('cursor', ['0'])[0])
+                count = int(args.get('count', [str(SCAN_PAGE)])[0])
+                aps = portal.aps[cursor:cursor + count]
+                body = {
+                    'gen': portal.generation, 'total': len(portal.aps), 'hidden': 0, 'cursor': cursor,
+                    'prev': max(cursor - count, 0) if cursor else -1,
+                    'next': cursor + count if cursor + count < len(portal.aps) else -1,
+                    'aps': aps
+                }
+                self.__respond(200, 'application/json', json.dumps(body).encode('utf-8'))
+            elif uri.path == '/_ac/connect' and self.command == 'POST':
+                self.__respond(200, 'text/html', portal.page[:len(portal.page) // 2])
+            else:
+                self.__respond(404, 'text/html', b'<html><body>404 Not found</body></html>')
+
+    def __respond(self, status, content_type, body, headers=None):
+        self.send_response(status)
+        self.send_header('Content-Type', content_type)
+        self.send_header('Content-Length', str(len(body)))
+        self.send_header(STANDIN_HEADER, '1')
+        for k, v in (headers or {}).items():
+            self.send_header(k, v)
+        self.end_headers()
+        try:
+            self.wfile.write(body)
+        except (BrokenPipeError, ConnectionResetError):
+            # The phone has given up waiting for the response.
+            logger.debug('%s - gone away' % self.address_string())
+            self.close_connection = True
+
+
+class Portal:
+    """Stand-in of the captive portal that runs on the loopback."""
+
+    def __init__(self, bind, port, dns_port, service, scan, page_size):
+        self.address = bind
+        self.host = '{0}:{1}'.format(bind, port) if port != 80 else bind
+        self.service = service
+        self.scan = scan
+        self.lock = threading.Lock()
+        self.generation = 0
+        self.page = (b'<html><body>' + b'x' * max(0, page_size - 26) + b'</body></html>')[:max(page_size, 26)]
+        self.aps = [{'ssid': 'AP{0:02d}'.format(i), 'rssi': -40 - i * 3, 'quality': max(0, min(100, 2 * (40 - i * 3))), 'ch': i % 13 + 1, 'lock': bool(i % 3)} for i in range(12)]
+        http_server = http.server.ThreadingHTTPServer((bind, port), PortalHTTPRequestHandler)
+        http_server.daemon_threads = True
+        http_server.portal = self
+        dns_server = socketserver.UDPServer((bind, dns_port), PortalDNSHandler)
+        dns_server.portal = self
+        self.servers = (http_server, dns_server)
+
+    def serve(self):
+        threading.Thread(target=self.servers[1].serve_forever, daemon=True).start()
+        logger.info('portal starting {0}, dns {1}:{2}'.format(self.host, self.address, self.servers[1].server_address[1]))
+        try:
+            self.servers[0].serve_forever()
+        except KeyboardInterrupt:
+            logger.info('Shutting down...')
+        for server in self.servers:
+            server.server_close()
+
+
+def run(args):
+    if args.command == 'run':
+        target = split_address(args.target, 80)
+        dns = None if args.no_dns else split_address(args.dns or target[0], 53)
+        levels = [int(n) for n in args.clients.split(',')]
+        oses = args.os.split(',')
+        for os_name in oses:
+            if os_name not in PROBES:
+                raise ValueError('Unknown OS: {0}'.format(os_name))
+        sources = ipaddress.IPv4Address(args.sources) if args.sources else None
+        report = load(target, dns, levels, args.rounds, oses, args.timeout, not args.no_connect, sources, (args.ssid, args.passphrase))
+        write_report(report, args.output)
+        return 1 if any(row['errors'] for row in report) else 0
+    elif args.command == 'portal':
+        Portal(args.bind, args.port, args.dns_port, args.service, args.scan, args.page_size).serve()
+    return 0
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='AutoConnect captive portal load generator')
+    parser.add_argument('--log', '-l', action='store', default='INFO', help='Logging level')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+    p = sub.add_parser('run', help='onboard the phones at once and measure each step')
+    p.add_argument('target', help='address of the portal such as 192.168.4.1 or 127.0.0.1:8080')
+    p.add_argument('--clients', '-n', default='1,2,4,8', help='comma separated numbers of the phones of each level [default:1,2,4,8]')
+    p.add_argument('--rounds', '-r', default=1, type=int, help='onboarding sequences of each phone [default:1]')
+    p.add_argument('--os', default='android,apple,windows', help='captive probes assigned to the phones in turn [default:android,apple,windows]')
+    p.add_argument('--dns', help='address of the DNS server [default:target:53]')
+    p.add_argument('--no-dns', action='store_true', help='skip the DNS query')
+    p.add_argument('--no-connect', action='store_true', help='skip the POST of /_ac/connect')
+    p.add_argument('--ssid', default='acload', help='SSID posted to /_ac/connect [default:acload]')
+    p.add_argument('--passphrase', default='', help='passphrase posted to /_ac/connect')
+    p.add_argument('--sources', nargs='?', const='127.0.1.1', metavar='FIRST', help='bind each phone to its own address from FIRST upward [default FIRST:127.0.1.1]')
+    p.add_argument('--timeout', '-t', default=10, type=float, help='response timeout in seconds [default:10]')
+    p.add_argument('--output', '-o', help='report CSV file [default:stdout]')
+    p = sub.add_parser('portal', help='run the stand-in of the portal on the loopback')
+    p.add_argument('--bind', '-b', default='127.0.0.1', help='Specifies address to which it should bind. [default:127.0.0.1]')
+    p.add_argument('--port', '-p', default=8080, type=int, help='HTTP port number [default:8080]')
+    p.add_argument('--dns-port', default=8053, type=int, help='DNS port number [default:8053]')
+    p.add_argument('--service', default=5.0, type=float, help='time in ms to serve a request [default:5]')
+    p.add_argument('--scan', default=2000.0, type=float, help='time in ms that a scan occupies the portal [default:2000]')
+    p.add_argument('--page-size', default=6000, type=int, help='bytes of a page [default:6000]')
+    args = parser.parse_args()
+    loglevel = getattr(logging, args.log.upper(), None)
+    if not isinstance(loglevel, int):
+        raise ValueError('Invalid log level: %s' % args.log)
+    logging.basicConfig(level=loglevel)
+    sys.exit(run(args))
@@ -0,0 +1,357 @@
+#!python3.*
+
+"""portal traffic recorder and replayer.
+"""
+
+import argparse
+import base64
+import csv
+import http.client
+import http.server
+import json
+import logging
+import re
+import statistics
+import sys
+import time
+import urllib.parse
+
+TRACE_VERSION = 1
+HEAP_HEADER = 'X-AutoConnect-Heap'
+HOP_HEADERS = ('connection', 'keep-alive', 'proxy-connection', 'te', 'trailer', 'transfer-encoding', 'upgrade', 'host', 'content-length')
+TRACE_LINE = re.compile(r'TRACE,(\d+),([A-Z]+),(\d+),([^,]*),(.*)$')
+REPORT_FIELDS = ('index', 'method', 'uri', 'status', 'latency', 'ttfb', 'bytes', 'heap', 'heap_delta')
+REDACTED = '***'
+SECRET_HEADERS = ('authorization', 'cookie')
+
+logger = logging.getLogger(__name__)
+
+
+def write_trace(f, entry):
+    f.write(json.dumps(entry, ensure_ascii=False) + '\n')
+    f.flush()
+
+
+def read_trace(filename):
+    """Returns the header and the requests of the trace file."""
+    header = {}
+    requests = []
+    with open(filename, encoding='utf-8') as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            entry = json.loads(line)
+            if 'trace' in entry:
+                header = entry
+            else:
+                requests.append(entry)
+    if header.get('trace', TRACE_VERSION) != TRACE_VERSION:
+        raise ValueError('{0} unsupported trace version {1}'.format(filename, header['trace']))
+    return header, requests
+
+
+def is_secret(name):
+    """The argument is a credential, such as the Passphrase and the psk."""
+    name = urllib.parse.unquote_plus(name).lower()
+    return 'pass' in name or name == 'psk'
+
+
+def redact(query, secret=REDACTED):
+    """Replaces the values of the credentials in the urlencoded arguments.
+    The other arguments are left as they are encoded."""
+    args = []
+    for arg in query.split('&'):
+        name, sep, _ = arg.partition('=')
+        args.append(name + '=' + urllib.parse.quote_plus(secret, safe='*') if sep and is_secret(name) else arg)
+    return '&'.join(args)
+
+
+def redact_uri(uri, secret=REDACTED):
+    path, sep, query = uri.partition('?')
+    return path + sep + redact(query, secret) if sep else uri
+
+
+def trace_header(source):
+    return {'trace': TRACE_VERSION, 'source': source, 'recorded': time.strftime('%Y-%m-%dT%H:%M:%S')}
+
+
+class RecordHttpServer:
+    def __init__(self, port, bind, target, trace):
+        def handler(*args):
+            RecordHTTPRequestHandler(target, trace, *args)
+        httpd = http.server.HTTPServer((bind, port), handler)
+        sa = httpd.socket.getsockname()
+        logger.info('recording proxy starting {0}:{1} -> {2}'.format(sa[0], sa[1], target))
+        try:
+            httpd.serve_forever()
+        except KeyboardInterrupt:
+            logger.info('Shutting down...')
+            httpd.socket.close()
+
+
+class RecordHTTPRequestHandler(http.server.BaseHTTPRequestHandler):
+    """Forwards the request to the device and records it into the trace."""
+    protocol_version = 'HTTP/1.1'
+
+    def __init__(self, target, trace, *args):
+        self.target = target
+        self.trace = trace
+        http.server.BaseHTTPRequestHandler.__init__(self, *args)
+
+    def do_GET(self):
+        self.__forward()
+
+    def do_HEAD(self):
+        self.__forward()
+
+    def do_POST(self):
+        self.__forward()
+
+    def do_PUT(self):
+        self.__forward()
+
+    def do_DELETE(self):
+        self.__forward()
+
+    def __forward(self):
+        length = int(self.headers.get('Content-Length', 0))
+        body = self.rfile.read(length) if length else b''
+        headers = {k: v for k, v in self.headers.items() if k.lower() not in HOP_HEADERS}
+        # The trace keeps no credentials, the request to the device does.
+        recorded = body
+        if self.headers.get('Content-Type', '').startswith('application/x-www-form-urlencoded'):
+            recorded = redact(body.decode('utf-8', errors='replace')).encode('utf-8')
+        entry = {
+            't': round(time.monotonic() - self.trace['start'], 3),
+            'method': self.command,
+            'uri': redact_uri(self.path),
+            'headers': {k: REDACTED if k.lower() in SECRET_HEADERS else v for k, v in headers.items()},
+            'body': base64.b64encode(recorded).decode('ascii')
+        }
+        try:
+            result = send(self.trace['conn'], self.command, self.path, headers, body)
+        except (OSError, http.client.HTTPException) as e:
+            logger.error('{0} {1}: {2}'.format(self.command, self.path, str(e)))
+            self.trace['conn'].close()
+            self.send_error(502, str(e))
+            return
+        entry['status'] = result['status']
+        entry['latency'] = result['latency']
+        entry['bytes'] = len(result['content'])
+        write_trace(self.trace['file'], entry)
+        logger.debug('{0} {1} {2} {3}ms'.format(self.command, self.path, result['status'], result['latency']))
+
+        self.send_response(result['status'])
+        for k, v in result['headers']:
+            if k.lower() in HOP_HEADERS:
+                continue
+            if k.lower() == 'location':
+                v = v.replace('//' + self.target, '//' + self.headers.get('Host', self.target))
+            self.send_header(k, v)
+        self.send_header('Content-Length', str(len(result['content'])))
+        self.end_headers()
+        if self.command != 'HEAD':
+            self.wfile.write(result['content'])
+
+
+def send(conn, method, uri, headers, body):
+    """Issues a request over the persistent connection and measures it."""
+    start = time.monotonic()
+    conn.request(method, uri, body=body if body else None, headers=headers)
+    response = conn.getresponse()
+    ttfb = time.monotonic()
+    content = response.read()
+    end = time.monotonic()
+    if response.getheader('Connection', '').lower() == 'close':
+        conn.close()
+    return {
+        'status': response.status,
+        'headers': response.getheaders(),
+        'content': content,
+        'latency': round((end - start) * 1000, 1),
+        'ttfb': round((ttfb - start) * 1000, 1),
+        'heap': response.getheader(HEAP_HEADER)
+    }
+
+
+def record(port, bind, target, output):
+    with open(output, 'w', encoding='utf-8') as f:
+        write_trace(f, trace_header('proxy:' + target))
+        trace = {
+            'file': f,
+            'start': time.monotonic(),
+            'conn': http.client.HTTPConnection(target, timeout=30)
+        }
+        RecordHttpServer(port, bind, target, trace)
+
+
+def import_log(source, output):
+    """Converts the TRACE lines of the debug log into the trace file."""
+    count = 0
+    base = None
+    with open(source, encoding='utf-8', errors='replace') as log, open(output, 'w', encoding='utf-8') as f:
+        write_trace(f, trace_header('log:' + source))
+        for line in log:
+            m = TRACE_LINE.search(line.rstrip('\r\n'))
+            if not m:
+                continue
+            millis, method, heap, uri, args = m.groups()
+            # The firmware redacts the credentials, and so does the older log.
+            args = redact(args)
+            if base is None:
+                base = int(millis)
+            entry = {
+                't': (int(millis) - base) / 1000,
+                'method': method,
+                'uri': uri,
+                'headers': {},
+                'body': '',
+                'heap': int(heap)
+            }
+            if method in ('POST', 'PUT'):
+                entry['headers']['Content-Type'] = 'application/x-www-form-urlencoded'
+                entry['body'] = base64.b64encode(args.encode('utf-8')).decode('ascii')
+            elif args:
+                entry['uri'] = uri + '?' + args
+            write_trace(f, entry)
+            count += 1
+    logger.info('{0} requests imported from {1}'.format(count, source))
+
+
+def replay(trace_file, target, output, speed=0.0, repeat=1, timeout=30, secret=None):
+    """Replays the trace and writes the report of each request. The
+    redacted credentials are sent as recorded unless the secret is given."""
+    _, requests = read_trace(trace_file)
+    conn = http.client.HTTPConnection(target, timeout=timeout)
+    results = []
+    heap = None
+    for n in range(repeat):
+        start = time.monotonic()
+        for i, entry in enumerate(requests):
+            if speed > 0:
+                wait = entry['t'] / speed - (time.monotonic() - start)
+                if wait > 0:
+                    time.sleep(wait)
+            headers = {k: v for k, v in entry['headers'].items() if k.lower() not in HOP_HEADERS and v != REDACTED}
+            headers['Host'] = target
+            body = base64.b64decode(entry['body']) if entry['body'] else b''
+            uri = entry['uri']
+            if secret is not None:
+                uri = redact_uri(uri, secret)
+                if headers.get('Content-Type', '').startswith('application/x-www-form-urlencoded'):
+                    body = redact(body.decode('utf-8'), secret).encode('utf-8')
+            try:
+                result = send(conn, entry['method'], uri, headers, body)
+            except (OSError, http.client.HTTPException) as e:
+                logger.error('{0} {1}: {2}'.format(entry['method'], entry['uri'], str(e)))
+                conn.close()
+                results.append({'index': i, 'method': entry['method'], 'uri': entry['uri'], 'status': 0})
+                continue
+            current = int(result['heap']) if result['heap'] else None
+            results.append({
+                'index': i,
+                'method': entry['method'],
+                'uri': entry['uri'],
+                'status': result['status'],
+                'latency': result['latency'],
+                'ttfb': result['ttfb'],
+                'bytes': len(result['content']),
+                'heap': current if current is not None else '',
+                'heap_delta': current - heap if current is not None and heap is not None else ''
+            })
+            heap = current if current is not None else heap
+            if 'status' in entry and entry['status'] != result['status']:
+                logger.warning('{0} {1} status {2}, recorded {3}'.format(entry['method'], entry['uri'], result['status'], entry['status']))
+            logger.debug('{0} {1} {2} {3}ms {4} bytes'.format(entry['method'], entry['uri'], result['status'], result['latency'], len(result['content'])))
+        logger.info('pass {0}: {1} requests in {2:.1f}s'.format(n + 1, len(requests), time.monotonic() - start))
+    conn.close()
+
+    f = open(output, 'w', newline='', encoding='utf-8') if output else sys.stdout
+    writer = csv.DictWriter(f, fieldnames=REPORT_FIELDS, restval='')
+    writer.writeheader()
+    writer.writerows(results)
+    if output:
+        f.close()
+    return results
+
+
+def summarize(rows):
+    """Returns the median latency and the bytes of each request."""
+    summary = {}
+    for row in rows:
+        if not row.get('latency') or int(row['status']) == 0:
+            continue
+        key = (row['method'], row['uri'])
+        s = summary.setdefault(key, {'latency': [], 'bytes': []})
+        s['latency'].append(float(row['latency']))
+        s['bytes'].append(int(row['bytes']))
+    return {k: {'latency': statistics.median(v['latency']), 'bytes': statistics.median(v['bytes'])} for k, v in summary.items()}
+
+
+def compare(baseline, current, threshold, margin):
+    """Reports the requests that regressed beyond the threshold."""
+    def load(filename):
+        with open(filename, newline='', encoding='utf-8') as f:
+            return summarize(list(csv.DictReader(f)))
+    base = load(baseline)
+    cur = load(current)
+    regressed = 0
+    for key in sorted(cur):
+        if key not in base:
+            continue
+        for metric in ('latency', 'bytes'):
+            b = base[key][metric]
+            c = cur[key][metric]
+            rate = (c - b) / b * 100 if b else 0
+            if rate > threshold and (metric != 'latency' or c - b > margin):
+                regressed += 1
+                logger.warning('{0} {1} {2} {3} -> {4} (+{5:.1f}%)'.format(key[0], key[1], metric, b, c, rate))
+    logger.info('{0} requests compared, {1} regressions'.format(len(set(base) & set(cur)), regressed))
+    return regressed
+
+
+def run(args):
+    if args.command == 'record':
+        record(args.port, args.bind, args.target, args.output)
+    elif args.command == 'import':
+        import_log(args.source, args.output)
+    elif args.command == 'replay':
+        replay(args.trace, args.target, args.output, args.speed, args.repeat, args.timeout, args.secret)
+    elif args.command == 'compare':
+        return 1 if compare(args.baseline, args.current, args.threshold, args.margin) else 0
+    return 0
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='AutoConnect portal traffic recorder and replayer')
+    parser.add_argument('--log', '-l', action='store', default='INFO', help='Logging level')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+    p = sub.add_parser('record', help='record the traffic through the proxy')
+    p.add_argument('target', help='address of the device such as 192.168.4.1')
+    p.add_argument('--port', '-p', default=8080, type=int, help='Port number of the proxy [default:8080]')
+    p.add_argument('--bind', '-b', default='127.0.0.1', help='Specifies address to which it should bind. [default:127.0.0.1]')
+    p.add_argument('--output', '-o', default='portal.trace', help='trace file [default:portal.trace]')
+    p = sub.add_parser('import', help='import the TRACE lines of the debug log')
+    p.add_argument('source', help='debug log captured from the serial port')
+    p.add_argument('--output', '-o', default='portal.trace', help='trace file [default:portal.trace]')
+    p = sub.add_parser('replay', help='replay the trace and measure each request')
+    p.add_argument('trace', help='trace file')
+    p.add_argument('target', help='address of the device such as 192.168.4.1')
+    p.add_argument('--output', '-o', help='report CSV file [default:stdout]')
+    p.add_argument('--speed', '-s', default=0.0, type=float, help='pace relative to the recorded timing, 0 for back to back [default:0]')
+    p.add_argument('--repeat', '-r', default=1, type=int, help='number of passes [default:1]')
+    p.add_argument('--timeout', '-t', default=30, type=float, help='response timeout in seconds [default:30]')
+    p.add_argument('--secret', help='value sent in place of the redacted credentials such as the passphrase')
+    p = sub.add_parser('compare', help='compare the report with the baseline')
+    p.add_argument('baseline', help='report CSV of the baseline firmware')
+    p.add_argument('current', help='report CSV of the firmware under test')
+    p.add_argument('--threshold', default=20.0, type=float, help='allowed increase in percent [default:20]')
+    p.add_argument('--margin', '-m', default=5.0, type=float, help='latency increase in ms ignored as the noise [default:5]')
+    args = parser.parse_args()
+    loglevel = getattr(logging, args.log.upper(), None)
+    if not isinstance(loglevel, int):
+        raise ValueError('Invalid log level: %s' % args.log)
+    logging.basicConfig(level=loglevel)
+    sys.exit(run(args))
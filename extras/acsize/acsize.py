@@ -0,0 +1,220 @@
+#!python3.*
+
+"""footprint reporter of the AutoConnect subsystems.
+"""
+
+import argparse
+import glob
+import itertools
+import logging
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# Bits of AC_FEATURES that affect the build, declared in AutoConnectDefs.h.
+FEATURES = {
+    'OTA': 1 << 0,
+    'UPDATE': 1 << 1,
+    'JSON': 1 << 3,
+    'TICKER': 1 << 6,
+    'UPLOAD': 1 << 8,
+    'CONFIGAUX': 1 << 9,
+    'MENU': 1 << 10
+}
+FEATURES_FULL = 0x7FF
+
+# Presets of AC_FEATURES declared in AutoConnectDefs.h, which are built
+# in addition to the combinations.
+PRESETS = {
+    'DEFAULT': 0x038,
+    'MINIMAL': 0x030
+}
+
+# Symbols of each subsystem. The first match classifies the symbol.
+SUBSYSTEMS = (
+    ('OTA', re.compile(r'AutoConnectOTA')),
+    ('UPDATE', re.compile(r'AutoConnectUpdate|HTTPUpdate')),
+    ('UPLOAD', re.compile(r'AutoConnectUpload|\bSDClass\b|\bSDFS\b')),
+    ('TICKER', re.compile(r'AutoConnectTicker|\bTicker::')),
+    ('CONFIGAUX', re.compile(r'AutoConnectConfigAux')),
+    ('MENU', re.compile(r'_CSS_LUXBAR|_ELM_MENU|_token_MENU|_attachMenuItem|_mold_MENU')),
+    ('JSON', re.compile(r'ArduinoJson|AutoConnectElementJson|AutoConnectAux::_load|JsonDocument')),
+    ('CORE', re.compile(r'AutoConnect|PageBuilder|PageElement|PageArgument'))
+)
+FLASH_TYPES = 'tTrRwWvV'
+RAM_TYPES = 'dDbBsSgG'
+NM_LINE = re.compile(r'^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(\w)\s+(.*)$')
+
+logger = logging.getLogger(__name__)
+
+
+def classify(name):
+    for subsystem, pattern in SUBSYSTEMS:
+        if pattern.search(name):
+            return subsystem
+    return 'OTHERS'
+
+
+def footprint(elf, nm):
+    """Returns the flash and the RAM size of each subsystem of the ELF."""
+    output = subprocess.run([nm, '-S', '-C', '--size-sort', elf], stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    sizes = {}
+    for line in output.splitlines():
+        m = NM_LINE.match(line)
+        if not m:
+            continue
+        size = int(m.group(2), 16)
+        stype = m.group(3)
+        s = sizes.setdefault(classify(m.group(4)), {'flash': 0, 'ram': 0})
+        if stype in FLASH_TYPES:
+            s['flash'] += size
+        elif stype in RAM_TYPES:
+            s['ram'] += size
+            if stype in 'dD':
+                # The initial values of the data are also stored in the flash.
+                s['flash'] += size
+    return sizes
+
+
+def report(elf, nm, baseline=None):
+    sizes = footprint(elf, nm)
+    base = footprint(baseline, nm) if baseline else {}
+    print('{0:<10} {1:>10} {2:>10} {3:>10} {4:>10}'.format('subsystem', 'flash', 'ram', 'Δflash', 'Δram'))
+    for subsystem in sorted(set(sizes) | set(base)):
+        s = sizes.get(subsystem, {'flash': 0, 'ram': 0})
+        b = base.get(subsystem, s)
+        print('{0:<10} {1:>10} {2:>10} {3:>+10} {4:>+10}'.format(subsystem, s['flash'], s['ram'], s['flash'] - b['flash'], s['ram'] - b['ram']))
+    return 0
+
+
+def features_value(names):
+    """Converts the subsystem names to be stripped into the AC_FEATURES."""
+    value = FEATURES_FULL
+    for name in names:
+        value &= ~FEATURES[name]
+    return value
+
+
+def combinations(names, depth):
+    """Enumerates the subsystems to be stripped up to the depth at once."""
+    yield ()
+    for n in range(1, depth + 1):
+        for c in itertools.combinations(names, n):
+            yield c
+
+
+def resolve_nm(cli, fqbn, sketch):
+    """Resolves nm of the toolchain from the build properties of the core.
+    The name of the toolchain differs between the cores and between the
+    versions of a core, such as xtensa-esp32-elf and xtensa-esp-elf of the
+    ESP32 core 3.x, so it is derived from the compiler that the core uses."""
+    for option in ('--show-properties=expanded', '--show-properties'):
+        result = subprocess.run([cli, 'compile', '--fqbn', fqbn, option, sketch], stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+        if not result.returncode:
+            break
+    else:
+        raise RuntimeError('No build properties of {0}\n{1}'.format(fqbn, result.stderr))
+    props = {}
+    for line in result.stdout.splitlines():
+        key, sep, value = line.partition('=')
+        if sep:
+            props[key.strip()] = value.strip()
+    gcc = props.get('compiler.c.cmd', '')
+    if not gcc.endswith('gcc'):
+        raise RuntimeError('Unknown compiler of {0}: {1}'.format(fqbn, gcc))
+    nm = os.path.join(props.get('compiler.path', ''), gcc[:-len('gcc')] + 'nm')
+    if not os.path.isfile(nm):
+        raise RuntimeError('{0} not found'.format(nm))
+    logger.info('nm: {0}'.format(nm))
+    return nm
+
+
+def compile_sketch(cli, fqbn, sketch, features, workdir):
+    """Compiles the sketch with AC_FEATURES and returns the ELF."""
+    build = os.path.join(workdir, '{0:03X}'.format(features))
+    flags = '-DAC_FEATURES=0x{0:X}'.format(features)
+    cmd = [cli, 'compile', '--fqbn', fqbn, '--build-path', build,
+           '--build-property', 'compiler.cpp.extra_flags=' + flags,
+           '--build-property', 'compiler.c.extra_flags=' + flags, sketch]
+    logger.debug(' '.join(cmd))
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode:
+        logger.error('AC_FEATURES=0x{0:X} build failed\n{1}'.format(features, result.stdout))
+        return None
+    elf = glob.glob(os.path.join(build, '*.elf'))
+    return elf[0] if elf else None
+
+
+def matrix(cli, fqbn, sketch, nm, names, depth, presets, keep):
+    """Builds the sketch for each combination of the stripped subsystems,
+    and then each preset."""
+    if not nm:
+        nm = resolve_nm(cli, fqbn, sketch)
+    builds = [('+'.join(stripped) or 'none', features_value(stripped)) for stripped in combinations(names, depth)]
+    builds += [(preset, PRESETS[preset]) for preset in presets]
+    workdir = tempfile.mkdtemp(prefix='acsize')
+    failed = 0
+    full = None
+    print('{0:<24} {1:>8} {2:>10} {3:>10} {4:>10} {5:>10}'.format('stripped', 'features', 'flash', 'ram', 'Δflash', 'Δram'))
+    try:
+        for label, features in builds:
+            elf = compile_sketch(cli, fqbn, sketch, features, workdir)
+            if not elf:
+                failed += 1
+                print('{0:<24} {1:>8} {2:>10}'.format(label, '0x{0:03X}'.format(features), 'FAILED'))
+                continue
+            sizes = footprint(elf, nm)
+            flash = sum(s['flash'] for s in sizes.values())
+            ram = sum(s['ram'] for s in sizes.values())
+            if full is None:
+                full = (flash, ram)
+            print('{0:<24} {1:>8} {2:>10} {3:>10} {4:>+10} {5:>+10}'.format(label, '0x{0:03X}'.format(features), flash, ram, flash - full[0], ram - full[1]))
+    finally:
+        if keep:
+            logger.info('build directory {0} is retained'.format(workdir))
+        else:
+            shutil.rmtree(workdir, ignore_errors=True)
+    if failed:
+        logger.error('{0} combinations failed to build'.format(failed))
+    return 1 if failed else 0
+
+
+def run(args):
+    if args.command == 'report':
+        return report(args.elf, args.nm or 'nm', args.baseline)
+    elif args.command == 'matrix':
+        names = args.strip if args.strip else list(FEATURES)
+        for name in names:
+            if name not in FEATURES:
+                raise ValueError('Unknown subsystem: {0}'.format(name))
+        presets = list(PRESETS) if args.presets is None else args.presets
+        return matrix(args.cli, args.fqbn, args.sketch, args.nm, names, args.depth, presets, args.keep)
+    return 0
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='AutoConnect subsystem footprint reporter')
+    parser.add_argument('--log', '-l', action='store', default='INFO', help='Logging level')
+    parser.add_argument('--nm', help='nm of the toolchain such as xtensa-lx106-elf-nm [default:nm for report, resolved from the core for matrix]')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+    p = sub.add_parser('report', help='report the footprint of each subsystem in the ELF')
+    p.add_argument('elf', help='ELF file of the sketch')
+    p.add_argument('--baseline', '-b', help='ELF file to be compared')
+    p = sub.add_parser('matrix', help='build the sketch with each combination of AC_FEATURES')
+    p.add_argument('sketch', help='sketch directory')
+    p.add_argument('--fqbn', '-b', required=True, help='fully qualified board name such as esp8266:esp8266:generic')
+    p.add_argument('--cli', default='arduino-cli', help='arduino-cli command [default:arduino-cli]')
+    p.add_argument('--strip', '-s', nargs='+', choices=list(FEATURES), help='subsystems to be stripped [default:all]')
+    p.add_argument('--depth', '-d', default=1, type=int, help='number of subsystems stripped at once [default:1]')
+    p.add_argument('--presets', '-p', nargs='*', choices=list(PRESETS), help='presets to be built, none without the names [default:all]')
+    p.add_argument('--keep', '-k', action='store_true', help='retain the build directory')
+    args = parser.parse_args()
+    loglevel = getattr(logging, args.log.upper(), None)
+    if not isinstance(loglevel, int):
+        raise ValueError('Invalid log level: %s' % args.log)
+    logging.basicConfig(level=loglevel)
+    sys.exit(run(args))
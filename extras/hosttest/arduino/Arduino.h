@@ -0,0 +1,52 @@
+/*
+  Arduino.h - The least of the Arduino core that the host test drivers
+  need to build the parts of the library which include it. The flash
+  memory is the same as the RAM on the host.
+*/
+
+#ifndef _HOSTTEST_ARDUINO_H_
+#define _HOSTTEST_ARDUINO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <algorithm>
+#include <string>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define F(s)  (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(p)  (*reinterpret_cast<const uint8_t*>(p))
+#define pgm_read_word(p)  (*reinterpret_cast<const uint16_t*>(p))
+#define pgm_read_dword(p) (*reinterpret_cast<const uint32_t*>(p))
+#define memcpy_P  memcpy
+#define strcmp_P  strcmp
+#define strlen_P  strlen
+#define strncasecmp_P strncasecmp
+
+class __FlashStringHelper;
+
+class String : public std::string {
+ public:
+  String() {}
+  String(const char* s) : std::string(s) {}
+  String(const __FlashStringHelper* s) : std::string(reinterpret_cast<const char*>(s)) {}
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t  write(uint8_t c) = 0;
+  virtual size_t  write(const uint8_t* buf, size_t size) {
+    size_t  n = 0;
+    while (size-- && write(*buf++))
+      n++;
+    return n;
+  }
+};
+
+#endif // !_HOSTTEST_ARDUINO_H_
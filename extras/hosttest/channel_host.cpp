@@ -0,0 +1,58 @@
+/*
+  channel_host - Checks the scores and the choice of AutoConnectChannel
+  against canned scan tables on the host.
+
+  Build:
+    g++ -std=c++11 -I../../src -o channel_host channel_host.cpp ../../src/AutoConnectChannel.cpp
+
+  Usage:
+    channel_host
+      Prints each check and exits with the status 1 when any has failed.
+*/
+
+#include <stdio.h>
+#include "AutoConnectChannel.h"
+#include "hosttest.h"
+
+typedef AutoConnectChannel::AP_t  AP_t;
+
+int main(void) {
+  // The contribution of an AP is (apWeight + (100 + rssi)) weighted by the
+  // overlap (22 - distance) / 22, where the distance is in MHz.
+  const uint8_t apWeight = 10;
+
+  // Channel 14 is 2484MHz, 12MHz above the channel 13 at 2472MHz.
+  const AP_t  ch14[] = { { 14, -50 } };
+  expectEqual("ch14 onto ch13", AutoConnectChannel::score(ch14, 1, 13, apWeight), 60 * 10 / 22);
+  expectEqual("ch14 onto ch12", AutoConnectChannel::score(ch14, 1, 12, apWeight), 60 * 5 / 22);
+  expectEqual("ch14 onto ch11", AutoConnectChannel::score(ch14, 1, 11, apWeight), 0);
+  expectEqual("ch14 onto ch14", AutoConnectChannel::score(ch14, 1, 14, apWeight), 60);
+
+  const AP_t  ch13[] = { { 13, -50 } };
+  expectEqual("ch13 onto ch14", AutoConnectChannel::score(ch13, 1, 14, apWeight), 60 * 10 / 22);
+
+  // Channels 5 apart overlap by 17MHz, 25 apart not at all.
+  const AP_t  ch6[] = { { 6, -70 } };
+  expectEqual("ch6 onto ch7", AutoConnectChannel::score(ch6, 1, 7, apWeight), 40 * 17 / 22);
+  expectEqual("ch6 onto ch1", AutoConnectChannel::score(ch6, 1, 1, apWeight), 0);
+  expectEqual("ch6 onto ch11", AutoConnectChannel::score(ch6, 1, 11, apWeight), 0);
+
+  // Out of band entries are ignored.
+  const AP_t  bogus[] = { { 0, -30 }, { 36, -30 } };
+  expectEqual("out of band", AutoConnectChannel::score(bogus, 2, 1, apWeight), 0);
+
+  // Without any AP, the preferred channel wins the tie, then 1, 6 and 11.
+  expectEqual("empty, preferred 6", AutoConnectChannel::select(nullptr, 0, 13, 6, apWeight), 6);
+  expectEqual("empty, preferred 0", AutoConnectChannel::select(nullptr, 0, 13, 0, apWeight), 1);
+
+  // With 1 and 6 taken, 11 is clear and precedes 12 and 13.
+  const AP_t  busy[] = { { 1, -40 }, { 6, -40 } };
+  expectEqual("1 and 6 busy", AutoConnectChannel::select(busy, 2, 13, 0, apWeight), 11);
+
+  // With 1, 6 and 11 taken, the limit of the channel decides the choice.
+  const AP_t  crowd[] = { { 1, -40 }, { 6, -40 }, { 11, -40 } };
+  expectEqual("1, 6, 11 busy up to 13", AutoConnectChannel::select(crowd, 3, 13, 0, apWeight), 13);
+  expectEqual("1, 6, 11 busy up to 14", AutoConnectChannel::select(crowd, 3, 14, 0, apWeight), 14);
+
+  return hosttest_result();
+}
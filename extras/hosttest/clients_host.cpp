@@ -0,0 +1,276 @@
+/*
+  clients_host - Runs AutoConnectClients on the host with fake clients whose
+  requests interleave, and checks that each keeps its own portal state. It
+  also binds the clients to a fake portal in the same way as
+  AutoConnectCore::_bindClient, _resolveConnect and _invokeResult do, and
+  checks the page rendered for each and the result it is led to.
+
+  Build:
+    g++ -std=c++11 -I../../src -o clients_host clients_host.cpp
+
+  Usage:
+    clients_host [CLIENTS [REQUESTS]]
+      Interleaves REQUESTS requests (default 10000) of CLIENTS clients
+      (default 8) at random, prints each check and exits with the status 1
+      when any has failed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AutoConnectClients.h"
+#include "hosttest.h"
+
+static const size_t CAPACITY = 4;
+
+/**
+ * The state of a client as AC_CLIENTSTATE_t holds it. The page is only
+ * movable, as the page built for the client is.
+ */
+struct State {
+  std::string uri;
+  std::unique_ptr<std::string>  page;
+  std::string redirectURI;
+  unsigned  step = 0;
+};
+
+typedef AutoConnectClients<State, CAPACITY> Clients;
+
+/**
+ * A fake client, which walks the pages of the portal in turn. It tells
+ * whether the state it got back is the one it left.
+ */
+struct Client {
+  uint32_t  addr;
+  unsigned  step = 0;       /**< Steps taken since the state was made */
+  uint32_t  last = 0;       /**< The last time of the request */
+  unsigned  restarts = 0;   /**< The state was made anew */
+  unsigned  mixed = 0;      /**< The state of another client was given */
+
+  void  request(Clients& clients, const uint32_t now) {
+    State&  s = clients.acquire(addr, now);
+    if (!s.step) {
+      if (step)
+        restarts++;
+      step = 0;
+    }
+    else if (s.step != step || s.uri != uri(step) || !s.page || *s.page != uri(step))
+      mixed++;
+    step++;
+    s.step = step;
+    s.uri = uri(step);
+    s.page.reset(new std::string(uri(step)));
+    s.redirectURI = step % 3 == 0 ? "/_ac/result?" + std::to_string(addr) : "";
+    last = now;
+  }
+
+  std::string uri(const unsigned n) const {
+    static const char*  pages[] = { "/_ac", "/_ac/config", "/_ac/connect", "/_ac/result" };
+    return std::string(pages[n % 4]) + "?" + std::to_string(addr);
+  }
+};
+
+/**
+ * The portal that holds the page of the bound client as the core does with
+ * _uri and _currentPageElement. A request binds the client, builds the page
+ * unless the client has been given it already, and renders it.
+ */
+struct Portal {
+  std::string request(const uint32_t addr, const std::string& requested, const uint32_t now) {
+    clients.bind(addr, now, [this](State& bound) {
+      bound.uri = uri;
+      bound.page = std::move(page);
+    }, [this](State& state) {
+      uri = state.uri;
+      page = std::move(state.page);
+    });
+    if (requested != uri || !page) {
+      page.reset(new std::string(requested + " for " + std::to_string(addr)));
+      uri = requested;
+      built++;
+    }
+    return *page;
+  }
+
+  // As _induceConnect, _resolveConnect and _invokeResult do.
+  void  connect(const uint32_t addr) {
+    State*  state = clients.bound();
+    if (state) {
+      state->redirectURI.clear();
+      clients.pin(addr);
+    }
+    resultURI.clear();
+  }
+  void  resolve(const std::string& redirectURI) {
+    resultURI = redirectURI;
+    clients.unpin([&redirectURI](uint32_t, State& state) { state.redirectURI = redirectURI; });
+  }
+  std::string result(void) {
+    State*  state = clients.bound();
+    if (state && state->redirectURI.size())
+      return state->redirectURI;
+    return resultURI.size() ? resultURI : "/_ac/result";
+  }
+
+  Clients clients;
+  std::string uri;
+  std::unique_ptr<std::string>  page;
+  std::string resultURI;
+  unsigned  built = 0;
+};
+
+int main(int argc, char* argv[]) {
+  const unsigned  population = argc > 1 ? atoi(argv[1]) : 8;
+  const unsigned  requests = argc > 2 ? atoi(argv[2]) : 10000;
+
+  {
+    // The clients within the capacity keep their own states however their
+    // requests interleave.
+    Clients clients;
+    std::vector<Client> phones(CAPACITY);
+    for (size_t i = 0; i < phones.size(); i++)
+      phones[i].addr = 0xc0a80402 + i;
+    srand(1);
+    uint32_t  now = 0xfffff000;   // across the wrap of millis
+    unsigned  mixed = 0, restarts = 0;
+    for (unsigned r = 0; r < requests; r++) {
+      now += rand() % 50;
+      phones[rand() % phones.size()].request(clients, now);
+    }
+    for (const Client& c : phones) {
+      mixed += c.mixed;
+      restarts += c.restarts;
+    }
+    expect("interleaved within the capacity, no state mixed", !mixed);
+    expect("interleaved within the capacity, no state lost", !restarts);
+    expect("table holds all", clients.size() == CAPACITY);
+  }
+
+  {
+    // More clients than the capacity evict the idle ones, but the state
+    // given to a client is never that of another.
+    Clients clients;
+    std::vector<Client> phones(population);
+    for (size_t i = 0; i < phones.size(); i++)
+      phones[i].addr = 0x0a000002 + i;
+    srand(2);
+    uint32_t  now = 0;
+    unsigned  mixed = 0, restarts = 0;
+    for (unsigned r = 0; r < requests; r++) {
+      now += 1 + rand() % 50;
+      phones[rand() % phones.size()].request(clients, now);
+    }
+    for (const Client& c : phones) {
+      mixed += c.mixed;
+      restarts += c.restarts;
+    }
+    printf("  %u clients, %u requests, %u states evicted\n", population, requests, restarts);
+    expect("over the capacity, no state mixed", !mixed);
+    expect("over the capacity, evicted", population <= CAPACITY || restarts > 0);
+    expect("table is full", clients.size() == (population < CAPACITY ? population : CAPACITY));
+  }
+
+  {
+    // The client idle the longest gives up its entry.
+    Clients clients;
+    for (uint32_t a = 1; a <= CAPACITY; a++)
+      clients.acquire(a, a * 10).step = a;
+    clients.acquire(1, 100);            // 2 is now the idle the longest
+    clients.find(2);                    // find does not mark it
+    clients.acquire(99, 110).step = 99;
+    expect("LRU evicted", !clients.find(2) && clients.find(1) && clients.find(3) && clients.find(4) && clients.find(99));
+    expect("new client state", clients.acquire(2, 120).step == 0);
+    expect("next LRU evicted", !clients.find(3));
+  }
+
+  {
+    // A free entry precedes the idle one.
+    Clients clients;
+    for (uint32_t a = 1; a <= CAPACITY; a++)
+      clients.acquire(a, 1000 + a);
+    clients.evict(4);
+    clients.acquire(50, 2000);
+    expect("free entry taken", clients.find(1) && clients.find(50) && !clients.find(4) && clients.size() == CAPACITY);
+    size_t  n = 0;
+    clients.forEach([&n](uint32_t, State&) { n++; });
+    expect("forEach visits all", n == CAPACITY);
+    clients.clear();
+    expect("cleared", clients.size() == 0 && !clients.find(1));
+  }
+
+  {
+    // A pinned client outlasts the clients that are idle for less time.
+    Clients clients;
+    for (uint32_t a = 1; a <= CAPACITY; a++)
+      clients.acquire(a, a);
+    clients.pin(1);
+    clients.acquire(50, 100);
+    clients.acquire(51, 101);
+    expect("pinned kept", clients.find(1) && clients.pinned(1) && !clients.find(2) && !clients.find(3));
+    for (uint32_t a = 1; a <= CAPACITY; a++)
+      clients.pin(a);
+    for (uint32_t a = 60; a < 60 + CAPACITY; a++) {
+      clients.acquire(a, 200 + a);
+      clients.pin(a);
+    }
+    expect("all pinned, the idle the longest evicted", !clients.find(1) && clients.find(60) && !clients.pinned(1));
+    unsigned  n = 0;
+    clients.unpin([&n](uint32_t, State&) { n++; });
+    expect("unpinned all", n == CAPACITY && !clients.pinned(60));
+  }
+
+  {
+    // Each client is rendered its own page however the requests of the
+    // clients interleave, and a page given already is not built again.
+    Portal  portal;
+    std::string rendered;
+    unsigned  mismatched = 0;
+    uint32_t  now = 0;
+    for (unsigned r = 0; r < 3; r++)
+      for (uint32_t a = 1; a <= CAPACITY; a++) {
+        const std::string uri = r ? "/_ac/config" : "/_ac";
+        if (portal.request(a, uri, now++) != uri + " for " + std::to_string(a))
+          mismatched++;
+      }
+    expect("own page rendered", !mismatched);
+    expect("built once per page", portal.built == CAPACITY * 2);
+  }
+
+  {
+    // The client that requested the connection is led to its result even
+    // if more clients than the capacity have come meanwhile.
+    Portal  portal;
+    uint32_t  now = 0;
+    portal.request(1, "/_ac/connect", now++);
+    portal.connect(1);
+    for (uint32_t a = 2; a < 2 + CAPACITY * 2; a++)
+      portal.request(a, "/_ac", now++);
+    expect("connecting client kept", portal.clients.pinned(1));
+    portal.request(1, "/_ac/result", now++);
+    expectEqual("pending result re-queried", portal.result(), "/_ac/result");
+    portal.resolve("/_ac/success");
+    portal.request(1, "/_ac/result", now++);
+    expectEqual("own result kept", portal.result(), "/_ac/success");
+  }
+
+  {
+    // A client evicted even though pinned takes the last result rather
+    // than re-querying the result page for good.
+    Portal  portal;
+    uint32_t  now = 0;
+    for (uint32_t a = 1; a <= CAPACITY; a++) {
+      portal.request(a, "/_ac/connect", now++);
+      portal.connect(a);
+    }
+    portal.request(99, "/_ac/connect", now++);
+    portal.connect(99);
+    portal.resolve("/_ac/fail");
+    portal.request(1, "/_ac/result", now++);
+    expect("evicted client not pinned", !portal.clients.pinned(1));
+    expectEqual("evicted client led to the last result", portal.result(), "/_ac/fail");
+  }
+
+  return hosttest_result();
+}
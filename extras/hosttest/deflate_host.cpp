@@ -0,0 +1,177 @@
+/*
+  deflate_host - Compresses canned contents with AutoConnectDeflate on the
+  host, and inflates them back with zlib to check the round trip of both
+  the gzip and the zlib formats.
+
+  Build:
+    g++ -std=c++11 -Iarduino -I../../src -D_AUTOCONNECTDEFS_H_ -DAUTOCONNECT_USE_DEFLATE -DAUTOCONNECT_DEFLATE_WINDOW=1024 -DAUTOCONNECT_DEFLATE_HASHBITS=9 -o deflate_host deflate_host.cpp ../../src/AutoConnectDeflate.cpp -lz
+
+  The guard of AutoConnectDefs.h keeps the rest of it, which needs the
+  Arduino core, out, and the defaults that the compressor refers to are
+  given instead.
+
+  Usage:
+    deflate_host [FILE...]
+      Round-trips the canned contents and each FILE (default the page
+      molds of the library) written in several sizes of the pieces, prints
+      each check and exits with the status 1 when any has failed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include "AutoConnectDeflate.h"
+#include "hosttest.h"
+
+typedef AutoConnectDeflate::AC_DEFLATEFORMAT_t  AC_DEFLATEFORMAT_t;
+
+/**
+ * The destination of the compressed stream.
+ */
+struct Sink : public Print {
+  size_t  write(uint8_t c) override {
+    bytes.push_back(c);
+    return 1;
+  }
+  size_t  write(const uint8_t* buf, size_t size) override {
+    bytes.insert(bytes.end(), buf, buf + size);
+    return size;
+  }
+  std::string bytes;
+};
+
+/**
+ * Compresses the content written in pieces of the size.
+ */
+static std::string deflate(const std::string& content, const AC_DEFLATEFORMAT_t format, const size_t piece, const bool progmem = false) {
+  Sink  sink;
+  AutoConnectDeflate  encoder(sink, format);
+  for (size_t i = 0; i < content.size(); i += piece) {
+    const size_t  n = std::min(piece, content.size() - i);
+    if (progmem)
+      encoder.write_P(content.data() + i, n);
+    else
+      encoder.write(reinterpret_cast<const uint8_t*>(content.data()) + i, n);
+  }
+  encoder.end();
+  return sink.bytes;
+}
+
+/**
+ * Inflates the stream with zlib, which also checks the header and the
+ * trailer of the format. Returns false if zlib has rejected it.
+ */
+static bool inflate(const std::string& stream, const AC_DEFLATEFORMAT_t format, std::string& content) {
+  z_stream  zs = {};
+  if (inflateInit2(&zs, format == AutoConnectDeflate::AC_DEFLATE_GZIP ? 16 + MAX_WBITS : MAX_WBITS) != Z_OK)
+    return false;
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(stream.data()));
+  zs.avail_in = stream.size();
+  content.clear();
+  int rc;
+  do {
+    char  buf[4096];
+    zs.next_out = reinterpret_cast<Bytef*>(buf);
+    zs.avail_out = sizeof(buf);
+    rc = ::inflate(&zs, Z_NO_FLUSH);
+    content.append(buf, sizeof(buf) - zs.avail_out);
+  } while (rc == Z_OK);
+  const bool  whole = rc == Z_STREAM_END && zs.avail_in == 0;
+  inflateEnd(&zs);
+  return whole;
+}
+
+static bool readFile(const char* path, std::string& content) {
+  FILE* fp = fopen(path, "rb");
+  if (!fp)
+    return false;
+  char  buf[4096];
+  size_t  n;
+  content.clear();
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    content.append(buf, n);
+  fclose(fp);
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  struct Content {
+    std::string name;
+    std::string bytes;
+  };
+  std::vector<Content>  contents;
+  contents.push_back({ "empty", "" });
+  contents.push_back({ "one byte", "a" });
+  contents.push_back({ "runs longer than the longest match", std::string(5000, 'x') + std::string(700, 'y') });
+  {
+    // Repeats farther apart than the window, which slides over them.
+    std::string s;
+    srand(1);
+    for (int i = 0; i < 1500; i++)
+      s += static_cast<char>('a' + rand() % 26);
+    contents.push_back({ "repeats beyond the window", s + s + s + s });
+  }
+  {
+    std::string s;
+    srand(2);
+    for (int i = 0; i < 8000; i++)
+      s += static_cast<char>(rand());
+    contents.push_back({ "incompressible", s });
+  }
+  {
+    std::string s;
+    srand(3);
+    for (int i = 0; i < 20000; i++)
+      s += rand() % 2 ? 'a' : 'b';
+    contents.push_back({ "two letters", s });
+  }
+
+  static const char*  molds[] = { "../../src/AutoConnectPageImpl.hpp", "../../src/AutoConnectAux.cpp" };
+  std::vector<const char*>  files(molds, molds + sizeof(molds) / sizeof(molds[0]));
+  if (argc > 1)
+    files.assign(argv + 1, argv + argc);
+  for (const char* fn : files) {
+    Content c = { fn, "" };
+    if (!readFile(fn, c.bytes)) {
+      printf("%s can not be read\n", fn);
+      return 1;
+    }
+    contents.push_back(c);
+  }
+
+  for (const Content& c : contents) {
+    unsigned  failed = 0;
+    for (const AC_DEFLATEFORMAT_t format : { AutoConnectDeflate::AC_DEFLATE_GZIP, AutoConnectDeflate::AC_DEFLATE_ZLIB }) {
+      for (const size_t piece : { 1, 7, 64, 4096 }) {
+        std::string inflated;
+        if (!inflate(deflate(c.bytes, format, piece), format, inflated) || inflated != c.bytes)
+          failed++;
+      }
+      std::string inflated;
+      if (!inflate(deflate(c.bytes, format, 100, true), format, inflated) || inflated != c.bytes)
+        failed++;
+    }
+    const std::string gz = deflate(c.bytes, AutoConnectDeflate::AC_DEFLATE_GZIP, 4096);
+    printf("  %s: %zu bytes, gzip %zu bytes\n", c.name.c_str(), c.bytes.size(), gz.size());
+    expect(("round trip of " + c.name).c_str(), !failed);
+  }
+
+  {
+    // The page of the library shrinks to less than half.
+    const std::string&  page = contents[contents.size() - files.size()].bytes;
+    expect("page compressed", deflate(page, AutoConnectDeflate::AC_DEFLATE_GZIP, 4096).size() * 2 < page.size());
+  }
+
+  {
+    // The gzip takes precedence, and the coding of q=0 is refused.
+    expect("gzip preferred", AutoConnectDeflate::negotiate("deflate, gzip, br") == AutoConnectDeflate::AC_DEFLATE_GZIP);
+    expect("deflate alone", AutoConnectDeflate::negotiate("deflate") == AutoConnectDeflate::AC_DEFLATE_ZLIB);
+    expect("gzip refused", AutoConnectDeflate::negotiate("gzip;q=0, deflate;q=0.5") == AutoConnectDeflate::AC_DEFLATE_ZLIB);
+    expect("none accepted", AutoConnectDeflate::negotiate("identity") == AutoConnectDeflate::AC_DEFLATE_NONE);
+    expect("no header", AutoConnectDeflate::negotiate("") == AutoConnectDeflate::AC_DEFLATE_NONE);
+  }
+
+  return hosttest_result();
+}
@@ -0,0 +1,177 @@
+/*
+  fanout_host - Runs ESP32WebCamFanout on the host with a synthetic frame
+  source that mimics the frame buffers of the camera driver, and several
+  viewer threads that send the frames at different speeds.
+
+  Build:
+    g++ -std=c++11 -pthread -I../../examples/WebCamServer -o fanout_host fanout_host.cpp ../../examples/WebCamServer/ESP32WebCamFanout.cpp
+  With ThreadSanitizer:
+    g++ -std=c++11 -pthread -g -fsanitize=thread -I../../examples/WebCamServer -o fanout_host fanout_host.cpp ../../examples/WebCamServer/ESP32WebCamFanout.cpp
+
+  Usage:
+    fanout_host [VIEWERS [FB_COUNT]]
+      Streams for a while with VIEWERS viewers (default 4) from a driver that
+      has FB_COUNT frame buffers (default 3), prints the frames that each
+      viewer sent and exits with the status 1 when any check has failed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "ESP32WebCamFanout.h"
+#include "hosttest.h"
+
+static const size_t FRAMESIZE = 1024;
+
+/**
+ * The frame buffers of the camera driver. A capture fails while all the
+ * buffers are out, as esp_camera_fb_get does. Each frame is filled with its
+ * own number, and it is overwritten as it is given back so that a viewer
+ * sending a frame already given back sees the garbage.
+ */
+struct Driver {
+  explicit Driver(const unsigned fbCount) : fbCount(fbCount) {}
+  bool  capture(ESP32WebCamFanout::Frame_t& frame) {
+    if (out.load() >= fbCount) {
+      exhausted++;
+      return false;
+    }
+    const unsigned  n = ++out;
+    unsigned  m = maxOut.load();
+    while (n > m && !maxOut.compare_exchange_weak(m, n))
+      ;
+    uint8_t*  buf = static_cast<uint8_t*>(malloc(FRAMESIZE));
+    memset(buf, static_cast<uint8_t>(++captured), FRAMESIZE);
+    frame.buf = buf;
+    frame.len = FRAMESIZE;
+    frame.handle = nullptr;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return true;
+  }
+  void  release(ESP32WebCamFanout::Frame_t& frame) {
+    uint8_t*  buf = const_cast<uint8_t*>(frame.buf);
+    memset(buf, 0xa5, FRAMESIZE);
+    free(buf);
+    out--;
+  }
+  const unsigned  fbCount;
+  std::atomic<unsigned> out{0};       /**< Buffers held by the fan-out */
+  std::atomic<unsigned> maxOut{0};    /**< The most buffers held at once */
+  std::atomic<unsigned> captured{0};
+  std::atomic<unsigned> exhausted{0}; /**< Captures with no buffer left */
+};
+
+/**
+ * A viewer sends the frames as _streamFrames does, taking its own time for
+ * each frame.
+ */
+struct Viewer {
+  void  run(ESP32WebCamFanout& fanout, const std::atomic<bool>& leave) {
+    uint32_t  seq = 0;
+    fanout.subscribe();
+    while (!leave) {
+      const uint32_t  last = seq;
+      const int slot = fanout.acquire(seq, 200);
+      if (slot < 0)
+        break;
+      if (last && seq <= last)
+        outOfOrder++;
+      const ESP32WebCamFanout::Frame_t&  frame = fanout.frame(slot);
+      const uint8_t first = frame.buf[0];
+      std::this_thread::sleep_for(std::chrono::milliseconds(sendTime));
+      for (size_t i = 0; i < frame.len; i++)
+        if (frame.buf[i] != first) {
+          corrupted++;
+          break;
+        }
+      fanout.release(slot);
+      sent++;
+      skipped += last ? seq - last - 1 : 0;
+    }
+    fanout.unsubscribe();
+  }
+  unsigned  sendTime = 1;
+  unsigned  sent = 0;
+  unsigned  skipped = 0;
+  unsigned  outOfOrder = 0;
+  unsigned  corrupted = 0;
+};
+
+int main(int argc, char* argv[]) {
+  const unsigned  viewers = argc > 1 ? atoi(argv[1]) : 4;
+  const unsigned  fbCount = argc > 2 ? atoi(argv[2]) : 3;
+  // The pool size as ESP32WebCam::startCameraServer sizes it.
+  const uint8_t poolSize = fbCount > 1 ? fbCount - 1 : 1;
+
+  Driver  driver(fbCount);
+  ESP32WebCamFanout fanout(poolSize);
+  fanout.begin([&driver](ESP32WebCamFanout::Frame_t& frame) { return driver.capture(frame); },
+               [&driver](ESP32WebCamFanout::Frame_t& frame) { driver.release(frame); });
+
+  std::atomic<int> produced{0};
+  std::atomic<int> ended{0};
+  std::thread producer([&] {
+    ESP32WebCamFanout::Produce_t  rc;
+    while ((rc = fanout.produce(50)) != ESP32WebCamFanout::PRODUCE_END)
+      if (rc == ESP32WebCamFanout::PRODUCE_OK)
+        produced++;
+    ended++;
+  });
+
+  // The viewers stream at different speeds for a while, and leave.
+  std::atomic<bool> leave{false};
+  std::vector<Viewer> v(viewers);
+  std::vector<std::thread>  threads;
+  for (unsigned i = 0; i < viewers; i++) {
+    v[i].sendTime = 1 + i * 5;
+    threads.emplace_back(&Viewer::run, &v[i], std::ref(fanout), std::cref(leave));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  leave = true;
+  for (std::thread& t : threads)
+    t.join();
+
+  printf("%d frames produced from %u buffers with the pool of %u\n", produced.load(), fbCount, (unsigned)poolSize);
+  bool  ordered = true;
+  bool  intact = true;
+  bool  sent = true;
+  for (unsigned i = 0; i < viewers; i++) {
+    printf("  viewer %u: %ums per frame, %u sent, %u skipped\n", i, v[i].sendTime, v[i].sent, v[i].skipped);
+    ordered &= !v[i].outOfOrder;
+    intact &= !v[i].corrupted;
+    sent &= v[i].sent > 0;
+  }
+  expect("every viewer sent frames", sent);
+  expect("frames in order", ordered);
+  expect("no frame given back while sent", intact);
+  // With a single slot, the viewers go in lockstep.
+  expect("a slow viewer skips frames", viewers < 2 || poolSize < 2 || v[viewers - 1].skipped > 0);
+  expect("the driver keeps a buffer to capture into", fbCount < 2 || driver.maxOut.load() <= fbCount - 1);
+  expect("no capture starved of a buffer", fbCount < 2 || driver.exhausted.load() == 0);
+
+  // The last viewer to leave gives back the latest frame while the
+  // producer stays idle.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  expect("no subscriber", fanout.subscribers() == 0);
+  expect("no buffer held while idle", driver.out.load() == 0);
+
+  // The producer picks up again with a new viewer.
+  leave = false;
+  Viewer  again;
+  std::thread late(&Viewer::run, &again, std::ref(fanout), std::cref(leave));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  leave = true;
+  late.join();
+  expect("a new viewer gets frames", again.sent > 0);
+
+  fanout.end();
+  producer.join();
+  expect("the producer ends", ended.load() == 1);
+  expect("no buffer held after end", driver.out.load() == 0);
+
+  return hosttest_result();
+}
@@ -0,0 +1,59 @@
+/*
+  hosttest.h - The checks shared by the host test drivers. Each driver is
+  a single translation unit that includes this header once, counts the
+  failed checks and returns hosttest_result() from main.
+*/
+
+#ifndef _HOSTTEST_H_
+#define _HOSTTEST_H_
+
+#include <stdio.h>
+#include <string>
+
+static int  hosttest_failed = 0;
+
+/**
+ * Prints the result of a check and counts it if it has failed.
+ * @param  name  Name of the check
+ * @param  ok    The check has passed
+ */
+static inline void expect(const char* name, const bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok)
+    hosttest_failed++;
+}
+
+/**
+ * Checks that a number is as expected and prints both.
+ * @param  name      Name of the check
+ * @param  actual    The number obtained
+ * @param  expected  The number expected
+ */
+static inline void expectEqual(const char* name, const long actual, const long expected) {
+  const bool  ok = actual == expected;
+  printf("%s %s: %ld (expected %ld)\n", ok ? "PASS" : "FAIL", name, actual, expected);
+  if (!ok)
+    hosttest_failed++;
+}
+
+/**
+ * Checks that a string is as expected, and prints both if not.
+ * @param  name      Name of the check
+ * @param  actual    The string obtained
+ * @param  expected  The string expected
+ */
+static inline void expectEqual(const char* name, const std::string& actual, const std::string& expected) {
+  expect(name, actual == expected);
+  if (actual != expected)
+    printf("  actual:   %s\n  expected: %s\n", actual.c_str(), expected.c_str());
+}
+
+/**
+ * The exit status of the driver.
+ * @return 1 if any check has failed, 0 otherwise.
+ */
+static inline int hosttest_result(void) {
+  return hosttest_failed ? 1 : 0;
+}
+
+#endif // !_HOSTTEST_H_
@@ -0,0 +1,199 @@
+/*
+  retry_host - Runs the schedule of AutoConnectRetry against a fake WiFi
+  driver and a fake clock on the host, the same way connectToWiFi does.
+
+  Build:
+    g++ -std=c++11 -I../../src -o retry_host retry_host.cpp ../../src/AutoConnectRetry.cpp
+
+  Usage:
+    retry_host
+      Prints each attempt of the scenarios and exits with the status 1 when
+      any check has failed.
+*/
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "AutoConnectRetry.h"
+#include "hosttest.h"
+
+typedef AutoConnectRetry::AC_ATTEMPT_t  AC_ATTEMPT_t;
+
+static const uint32_t BASEDELAY = 500;
+static const uint32_t MAXDELAY = 8000;
+static const uint32_t ATTEMPTTIME = 300;
+
+/**
+ * An access point of the fake driver. Each attempt consumes the next
+ * result of the script, and the last result repeats.
+ */
+struct FakeAP {
+  std::string ssid;
+  int8_t  rssi;
+  std::vector<AC_ATTEMPT_t> script;
+  size_t  attempted;
+};
+
+struct Attempt {
+  std::string ssid;
+  uint32_t  at;
+  AC_ATTEMPT_t  result;
+};
+
+static const char* resultName(const AC_ATTEMPT_t result) {
+  switch (result) {
+  case AutoConnectRetry::AC_ATTEMPT_CONNECTED: return "CONNECTED";
+  case AutoConnectRetry::AC_ATTEMPT_AUTHFAIL: return "AUTHFAIL";
+  case AutoConnectRetry::AC_ATTEMPT_FAILED: return "FAILED";
+  case AutoConnectRetry::AC_ATTEMPT_NOTFOUND: return "NOTFOUND";
+  default: return "TIMEOUT";
+  }
+}
+
+/**
+ * The loop of connectToWiFi with the fake driver. The clock advances by
+ * 1ms while the next attempt is not due, and by ATTEMPTTIME per attempt.
+ */
+static std::vector<Attempt> run(AutoConnectRetry& retry, std::vector<FakeAP>& aps, const uint32_t timeout) {
+  for (const FakeAP& ap : aps)
+    retry.add(ap.rssi);
+
+  std::vector<Attempt>  attempts;
+  uint32_t  now = 1000;
+  const uint32_t  start = now;
+  retry.begin(now);
+  while (now - start < timeout) {
+    const int16_t id = retry.next(now);
+    if (id == AutoConnectRetry::AC_RETRY_GIVEUP)
+      break;
+    if (id == AutoConnectRetry::AC_RETRY_WAIT) {
+      now++;
+      continue;
+    }
+    FakeAP& ap = aps[id];
+    const AC_ATTEMPT_t  result = ap.script[ap.attempted < ap.script.size() ? ap.attempted : ap.script.size() - 1];
+    ap.attempted++;
+    attempts.push_back({ ap.ssid, now, result });
+    printf("  %6u %-6s %s\n", (unsigned)(now - start), ap.ssid.c_str(), resultName(result));
+    now += ATTEMPTTIME;
+    retry.report(id, result, now);
+    if (result == AutoConnectRetry::AC_ATTEMPT_CONNECTED)
+      break;
+  }
+  return attempts;
+}
+
+static std::string order(const std::vector<Attempt>& attempts) {
+  std::string s;
+  for (const Attempt& a : attempts)
+    s += (s.empty() ? "" : ",") + a.ssid;
+  return s;
+}
+
+int main(void) {
+  const AC_ATTEMPT_t  CONNECTED = AutoConnectRetry::AC_ATTEMPT_CONNECTED;
+  const AC_ATTEMPT_t  AUTHFAIL = AutoConnectRetry::AC_ATTEMPT_AUTHFAIL;
+  const AC_ATTEMPT_t  FAILED = AutoConnectRetry::AC_ATTEMPT_FAILED;
+  const AC_ATTEMPT_t  NOTFOUND = AutoConnectRetry::AC_ATTEMPT_NOTFOUND;
+  const AC_ATTEMPT_t  TIMEOUT = AutoConnectRetry::AC_ATTEMPT_TIMEOUT;
+
+  {
+    // The candidates are interleaved by the signal strength and the ties
+    // keep the order of the addition.
+    puts("interleave:");
+    std::vector<FakeAP> aps = {
+      { "weak", -80, { TIMEOUT }, 0 },
+      { "strong", -40, { TIMEOUT }, 0 },
+      { "mid1", -60, { TIMEOUT }, 0 },
+      { "mid2", -60, { TIMEOUT }, 0 }
+    };
+    AutoConnectRetry  retry(8, BASEDELAY, MAXDELAY, 1);
+    const std::vector<Attempt>  attempts = run(retry, aps, 60000);
+    expect("ordered by rssi", order(attempts) == "strong,mid1,mid2,weak,strong,mid1,mid2,weak");
+    expect("no wait within a round", attempts[1].at - attempts[0].at == ATTEMPTTIME && attempts[3].at - attempts[2].at == ATTEMPTTIME);
+    const uint32_t  gap = attempts[4].at - (attempts[3].at + ATTEMPTTIME);
+    expect("first backoff within [base/2, base]", gap >= BASEDELAY / 2 && gap <= BASEDELAY);
+  }
+
+  {
+    // A rejection by the authentication is never retried, and the other
+    // failures are retried after the backoff.
+    puts("authfail and failed:");
+    std::vector<FakeAP> aps = {
+      { "badpsk", -40, { AUTHFAIL }, 0 },
+      { "flaky", -50, { FAILED, FAILED, CONNECTED }, 0 },
+      { "absent", -70, { NOTFOUND }, 0 }
+    };
+    AutoConnectRetry  retry(10, BASEDELAY, MAXDELAY, 7);
+    const std::vector<Attempt>  attempts = run(retry, aps, 60000);
+    expect("authfail attempted once", aps[0].attempted == 1);
+    expect("failed retried until connected", aps[1].attempted == 3 && attempts.back().ssid == "flaky" && attempts.back().result == CONNECTED);
+    expect("notfound retried", aps[2].attempted == 2);
+    expect("schedule", order(attempts) == "badpsk,flaky,absent,flaky,absent,flaky");
+  }
+
+  {
+    // The backoff doubles for each round up to the upper limit.
+    puts("backoff:");
+    std::vector<FakeAP> aps = { { "only", -50, { TIMEOUT }, 0 } };
+    AutoConnectRetry  retry(8, BASEDELAY, MAXDELAY, 3);
+    const std::vector<Attempt>  attempts = run(retry, aps, 600000);
+    bool  ok = attempts.size() == 8;
+    for (size_t i = 1; ok && i < attempts.size(); i++) {
+      uint32_t  delay = BASEDELAY << (i - 1);
+      if (delay > MAXDELAY)
+        delay = MAXDELAY;
+      const uint32_t  gap = attempts[i].at - (attempts[i - 1].at + ATTEMPTTIME);
+      ok = gap >= delay / 2 && gap <= delay;
+      if (!ok)
+        printf("  round %u waited %u for %u\n", (unsigned)i, (unsigned)gap, (unsigned)delay);
+    }
+    expect("delay of each round within [d/2, d]", ok);
+    expect("stops at the limit of the attempts", attempts.size() == 8);
+  }
+
+  {
+    // The same seed reproduces the same schedule, another seed jitters.
+    puts("reproducible:");
+    std::vector<FakeAP> a1 = { { "x", -50, { TIMEOUT }, 0 }, { "y", -60, { FAILED }, 0 } };
+    std::vector<FakeAP> a2 = a1;
+    std::vector<FakeAP> a3 = a1;
+    AutoConnectRetry  retry1(8, BASEDELAY, MAXDELAY, 42);
+    const std::vector<Attempt>  r1 = run(retry1, a1, 600000);
+    AutoConnectRetry  retry2(8, BASEDELAY, MAXDELAY, 42);
+    const std::vector<Attempt>  r2 = run(retry2, a2, 600000);
+    AutoConnectRetry  retry3(8, BASEDELAY, MAXDELAY, 43);
+    const std::vector<Attempt>  r3 = run(retry3, a3, 600000);
+    bool  same = r1.size() == r2.size();
+    for (size_t i = 0; same && i < r1.size(); i++)
+      same = r1[i].ssid == r2[i].ssid && r1[i].at == r2[i].at;
+    bool  differ = r1.size() != r3.size();
+    for (size_t i = 0; !differ && i < r1.size(); i++)
+      differ = r1[i].at != r3[i].at;
+    expect("same seed, same schedule", same);
+    expect("other seed, other schedule", differ);
+  }
+
+  {
+    // All the candidates rejected give up at once.
+    puts("rejected:");
+    std::vector<FakeAP> aps = { { "a", -50, { AUTHFAIL }, 0 }, { "b", -60, { AUTHFAIL }, 0 } };
+    AutoConnectRetry  retry(8, BASEDELAY, MAXDELAY, 5);
+    const std::vector<Attempt>  attempts = run(retry, aps, 60000);
+    expect("each attempted once", attempts.size() == 2);
+    expect("rejected", retry.rejected());
+    expect("gives up", retry.next(0) == AutoConnectRetry::AC_RETRY_GIVEUP);
+  }
+
+  {
+    // A failure other than the authentication is not a rejection.
+    puts("not rejected:");
+    std::vector<FakeAP> aps = { { "a", -50, { FAILED }, 0 } };
+    AutoConnectRetry  retry(3, BASEDELAY, MAXDELAY, 5);
+    const std::vector<Attempt>  attempts = run(retry, aps, 60000);
+    expect("retried up to the limit", attempts.size() == 3);
+    expect("not rejected", !retry.rejected());
+  }
+
+  return hosttest_result();
+}
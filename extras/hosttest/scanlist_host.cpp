@@ -0,0 +1,135 @@
+/*
+  scanlist_host - Runs AutoConnectScanList on the host against a canned scan,
+  and checks the pages of the JSON response of /_ac/scan.
+
+  Build:
+    g++ -std=c++11 -I../../src -o scanlist_host scanlist_host.cpp
+
+  Usage:
+    scanlist_host
+      Prints each page and check, and exits with the status 1 when any
+      check has failed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "AutoConnectScanList.h"
+#include "hosttest.h"
+
+
+/**
+ * The scan results in the order that the driver reports them.
+ */
+typedef struct {
+  const char* ssid;
+  int32_t rssi;
+  unsigned int  quality;
+  int32_t channel;
+  bool  secure;
+} Canned_t;
+
+static const Canned_t canned[] = {
+  { "office", -67, 66, 6, true },
+  { "", -50, 100, 11, true },               // hidden
+  { "cafe \"free\"", -80, 40, 1, false },
+  { "office", -45, 100, 11, true },
+  { "back\\slash\ttab", -67, 66, 3, true },
+  { "zeta", -90, 20, 13, false },
+  { "0123456789abcdef0123456789abcdefXYZ", -70, 60, 1, true },  // longer than 32
+  { "", -85, 30, 6, false },                // hidden
+  { "alpha", -67, 66, 9, true }
+};
+
+static void load(AutoConnectScanList& list) {
+  list.reserve(sizeof(canned) / sizeof(canned[0]));
+  for (const Canned_t& c : canned)
+    list.add(c.ssid, c.rssi, c.quality, c.channel, c.secure);
+}
+
+static std::string page(const AutoConnectScanList& list, const size_t cursor, const size_t count, const uint16_t generation = 1) {
+  std::string json;
+  list.toJson([&json](const char* s, size_t len) { json.append(s, len); }, cursor, count, generation);
+  return json;
+}
+
+int main(void) {
+  {
+    AutoConnectScanList list;
+    load(list);
+    expect("total counts all", list.total() == 9);
+    expect("hidden counted, not listed", list.hidden() == 2 && list.size() == 7);
+    expect("SSID truncated to 32", std::string(list[5].ssid) == "0123456789abcdef0123456789abcdef");
+  }
+
+  {
+    // The strongest first, the ties in the order of the scan.
+    AutoConnectScanList list;
+    load(list);
+    list.sort(AutoConnectScanList::AC_SCANSORT_RSSI);
+    std::vector<std::string>  pages;
+    for (long cursor = 0; cursor >= 0; ) {
+      pages.push_back(page(list, static_cast<size_t>(cursor), 3));
+      puts(pages.back().c_str());
+      const size_t  at = pages.back().find("\"next\":");
+      cursor = strtol(pages.back().c_str() + at + 7, nullptr, 10);
+    }
+    expect("3 pages", pages.size() == 3);
+    expectEqual("first page", pages[0],
+      "{\"gen\":1,\"total\":9,\"hidden\":2,\"cursor\":0,\"prev\":-1,\"next\":3,\"aps\":["
+      "{\"ssid\":\"office\",\"rssi\":-45,\"quality\":100,\"ch\":11,\"lock\":true},"
+      "{\"ssid\":\"office\",\"rssi\":-67,\"quality\":66,\"ch\":6,\"lock\":true},"
+      "{\"ssid\":\"back\\\\slash\\u0009tab\",\"rssi\":-67,\"quality\":66,\"ch\":3,\"lock\":true}]}");
+    expectEqual("second page", pages[1],
+      "{\"gen\":1,\"total\":9,\"hidden\":2,\"cursor\":3,\"prev\":0,\"next\":6,\"aps\":["
+      "{\"ssid\":\"alpha\",\"rssi\":-67,\"quality\":66,\"ch\":9,\"lock\":true},"
+      "{\"ssid\":\"0123456789abcdef0123456789abcdef\",\"rssi\":-70,\"quality\":60,\"ch\":1,\"lock\":true},"
+      "{\"ssid\":\"cafe \\\"free\\\"\",\"rssi\":-80,\"quality\":40,\"ch\":1,\"lock\":false}]}");
+    expectEqual("last page", pages[2],
+      "{\"gen\":1,\"total\":9,\"hidden\":2,\"cursor\":6,\"prev\":3,\"next\":-1,\"aps\":["
+      "{\"ssid\":\"zeta\",\"rssi\":-90,\"quality\":20,\"ch\":13,\"lock\":false}]}");
+  }
+
+  {
+    // In the order of SSID, then the strongest first.
+    AutoConnectScanList list;
+    load(list);
+    list.sort(AutoConnectScanList::AC_SCANSORT_SSID);
+    std::string order;
+    for (size_t i = 0; i < list.size(); i++)
+      order += std::string(i ? "," : "") + list[i].ssid + "/" + std::to_string(list[i].rssi);
+    expectEqual("ssid order", order, "0123456789abcdef0123456789abcdef/-70,alpha/-67,back\\slash\ttab/-67,cafe \"free\"/-80,office/-45,office/-67,zeta/-90");
+  }
+
+  {
+    // The cursor out of the list and a page of no count.
+    AutoConnectScanList list;
+    load(list);
+    list.sort(AutoConnectScanList::AC_SCANSORT_RSSI);
+    expectEqual("cursor beyond the end", page(list, 100, 3), "{\"gen\":1,\"total\":9,\"hidden\":2,\"cursor\":7,\"prev\":4,\"next\":-1,\"aps\":[]}");
+    expectEqual("count 0 takes 1", page(list, 6, 0),
+      "{\"gen\":1,\"total\":9,\"hidden\":2,\"cursor\":6,\"prev\":5,\"next\":-1,\"aps\":["
+      "{\"ssid\":\"zeta\",\"rssi\":-90,\"quality\":20,\"ch\":13,\"lock\":false}]}");
+    const std::string head = "{\"gen\":1,\"total\":9,\"hidden\":2,\"cursor\":1,\"prev\":0,\"next\":4,\"aps\":[";
+    expectEqual("prev clamps to 0", page(list, 1, 3).substr(0, head.length()), head);
+  }
+
+  {
+    // The generation of the scan heads the page, and the largest one fits
+    // in the buffer of the head.
+    AutoConnectScanList list;
+    load(list);
+    list.sort(AutoConnectScanList::AC_SCANSORT_RSSI);
+    const std::string head = "{\"gen\":65535,\"total\":9,\"hidden\":2,\"cursor\":6,\"prev\":3,\"next\":-1,\"aps\":[";
+    expectEqual("generation", page(list, 6, 3, 65535).substr(0, head.length()), head);
+  }
+
+  {
+    // No access point in sight.
+    AutoConnectScanList list;
+    expectEqual("empty scan", page(list, 0, 5), "{\"gen\":1,\"total\":0,\"hidden\":0,\"cursor\":0,\"prev\":-1,\"next\":-1,\"aps\":[]}");
+  }
+
+  return hosttest_result();
+}
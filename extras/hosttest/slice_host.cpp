@@ -0,0 +1,223 @@
+/*
+  slice_host - Runs AutoConnectSlice with a mocked clock on the host, and
+  resumes a seeking of the saved credentials across the slices with
+  AutoConnectSeek in the same way as AutoConnectCore::_resumeSeekCredential
+  does.
+
+  Build:
+    g++ -std=c++11 -I../../src -o slice_host slice_host.cpp
+
+  Usage:
+    slice_host
+      Prints each check and exits with the status 1 when any has failed.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AutoConnectSeek.h"
+#include "AutoConnectSlice.h"
+#include "hosttest.h"
+
+/**
+ * The clock that advances only by the cost of each step.
+ */
+static uint32_t now;
+static uint32_t clock_ms(void) { return now; }
+
+/**
+ * A step that costs the time and finishes the operation at the limit.
+ */
+struct Operation {
+  Operation(const uint32_t cost, const unsigned limit) : cost(cost), limit(limit), done(0) {}
+  bool  operator()(void) {
+    now += cost;
+    return ++done < limit;
+  }
+  uint32_t  cost;
+  unsigned  limit;
+  unsigned  done;
+};
+
+/**
+ * The scan results of the fake driver. Each scan advances the generation,
+ * as AutoConnectCore::_scanNetworks does.
+ */
+struct AP {
+  std::string ssid;
+  int32_t rssi;
+};
+
+struct Scanner {
+  void  scan(const std::vector<AP>& found) {
+    aps = found;
+    generation++;
+  }
+  std::vector<AP> aps;
+  uint16_t  generation = 0;
+};
+
+/**
+ * The seeking resumed across the slices, which takes the strongest access
+ * point of the saved credentials with AutoConnectSeek.
+ */
+struct Seeker {
+  struct State {
+    State(const int16_t scanned, const uint16_t generation) : collation(true, scanned, generation) {}
+    size_t  credential = 0;
+    AutoConnectSeek collation;
+    std::string found;
+  };
+
+  Seeker(Scanner& scanner, const std::vector<std::string>& credentials, const uint32_t cost, const bool byGeneration)
+    : scanner(scanner), credentials(credentials), cost(cost), byGeneration(byGeneration) {}
+
+  // Returns 1 if found, 0 if not found and -1 while pending. Without
+  // byGeneration, the generation stays 0 to see what the count alone
+  // would miss.
+  int resume(void) {
+    const int16_t nn = static_cast<int16_t>(scanner.aps.size());
+    const uint16_t  generation = byGeneration ? scanner.generation : 0;
+    if (state && state->collation.stale(nn, generation))
+      state.reset();
+    if (!state) {
+      state.reset(new State(nn, generation));
+      restarts++;
+    }
+    State&  seek = *state;
+    AutoConnectSlice  slice(10);
+    const bool  done = slice.run([&]() {
+      if (seek.credential >= credentials.size())
+        return false;
+      const std::string&  entry = credentials[seek.credential++];
+      now += cost;
+      if (seek.collation.collate([&](const int16_t n) { return scanner.aps[n].ssid == entry; }, [&](const int16_t n) { return scanner.aps[n].rssi; }))
+        seek.found = entry;
+      return !seek.collation.settled();
+    }, clock_ms);
+    slices++;
+    if (!done)
+      return -1;
+    int rc = 0;
+    if (seek.collation.found()) {
+      found = seek.found;
+      foundAP = seek.collation.ap();
+      rc = 1;
+    }
+    state.reset();
+    return rc;
+  }
+
+  Scanner&  scanner;
+  std::vector<std::string>  credentials;
+  uint32_t  cost;
+  bool      byGeneration;
+  std::unique_ptr<State>  state;
+  unsigned  slices = 0;
+  unsigned  restarts = 0;
+  std::string found;
+  int16_t   foundAP = -1;
+};
+
+int main(void) {
+  {
+    // The slice ends with the step that uses up the duration.
+    now = 1000;
+    AutoConnectSlice  slice(10);
+    Operation op(3, 100);
+    const bool  done = slice.run(std::ref(op), clock_ms);
+    expect("paused", !done);
+    expect("4 steps of 3ms in a slice of 10ms", slice.steps() == 4 && op.done == 4);
+    expect("elapsed 12ms", slice.elapsed() == 12);
+  }
+
+  {
+    // A step longer than the slice still runs once per slice.
+    now = 0;
+    AutoConnectSlice  slice(10);
+    Operation op(50, 3);
+    unsigned  slices = 0;
+    while (!slice.run(std::ref(op), clock_ms))
+      slices++;
+    expect("one step per slice", slices == 2 && slice.steps() == 1 && op.done == 3);
+  }
+
+  {
+    // The operation that ends within the slice finishes it.
+    now = 0;
+    AutoConnectSlice  slice(100);
+    Operation op(1, 5);
+    expect("finished", slice.run(std::ref(op), clock_ms));
+    expect("5 steps", slice.steps() == 5);
+  }
+
+  {
+    // The slice measures the time across the wrap of the clock.
+    now = 0xfffffff8;
+    AutoConnectSlice  slice(10);
+    Operation op(4, 100);
+    slice.run(std::ref(op), clock_ms);
+    expect("wrap around", slice.steps() == 3 && slice.elapsed() == 12);
+  }
+
+  {
+    // The seeking resumes across the slices up to the strongest one.
+    now = 0;
+    Scanner scanner;
+    scanner.scan({ { "a", -70 }, { "b", -50 }, { "c", -60 } });
+    const std::vector<std::string>  credentials = { "x", "c", "y", "b", "z", "a" };
+    Seeker  seeker(scanner, credentials, 4, true);
+    int rc;
+    while ((rc = seeker.resume()) < 0)
+      ;
+    expect("resumed over slices", seeker.slices == 3 && seeker.restarts == 1);
+    expect("strongest found", rc == 1 && seeker.found == "b" && seeker.foundAP == 1);
+  }
+
+  {
+    // A rescan with as many access points as before in another order
+    // restarts the seeking. With the count alone, the index of the best
+    // access point found before the rescan points to another one.
+    const std::vector<AP> first = { { "a", -70 }, { "b", -40 }, { "c", -60 } };
+    const std::vector<AP> second = { { "b", -80 }, { "a", -75 }, { "c", -50 } };
+    const std::vector<std::string>  credentials = { "b", "x", "y", "c" };
+    for (const bool byGeneration : { false, true }) {
+      now = 0;
+      Scanner scanner;
+      scanner.scan(first);
+      Seeker  seeker(scanner, credentials, 4, byGeneration);
+      int rc = seeker.resume();
+      scanner.scan(second);
+      while (rc < 0)
+        rc = seeker.resume();
+      const bool  right = rc == 1 && seeker.found == "c" && seeker.foundAP == 2;
+      if (byGeneration) {
+        expect("rescan restarts the seeking", seeker.restarts == 2);
+        expect("rescan finds the strongest of the new scan", right);
+      }
+      else
+        expect("the count alone misses the rescan", !right);
+    }
+  }
+
+  {
+    // The first access point of the scan results without the strongest,
+    // and the earlier index on a tie of RSSI with the strongest.
+    const std::vector<AP> aps = { { "a", -60 }, { "b", -50 }, { "b", -50 } };
+    auto  rssi = [&aps](const int16_t n) { return aps[n].rssi; };
+    AutoConnectSeek recent(false, 3, 1);
+    recent.collate([&aps](const int16_t n) { return aps[n].ssid == "b"; }, rssi);
+    expect("recent takes the first one", recent.ap() == 1 && !recent.settled());
+    recent.collate([&aps](const int16_t n) { return aps[n].ssid == "a"; }, rssi);
+    expect("recent settles at the top", recent.ap() == 0 && recent.settled());
+    AutoConnectSeek strongest(true, 3, 1);
+    strongest.collate([&aps](const int16_t n) { return aps[n].ssid != "a"; }, rssi);
+    expect("tie taken by the earlier index", strongest.ap() == 1 && strongest.rssi() == -50 && !strongest.settled());
+    expect("stale by the generation or the count", strongest.stale(3, 2) && strongest.stale(2, 1) && !strongest.stale(3, 1));
+  }
+
+  return hosttest_result();
+}
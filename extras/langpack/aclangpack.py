@@ -0,0 +1,156 @@
+#!python3.*
+
+"""language pack generator.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'ACLP'
+VERSION = 1
+TOKENREF = 0x01
+TAGLEN = 15
+MAX_TOKENS = 255
+MIN_TOKEN = 3
+MAX_TOKEN = 32
+
+
+def load_ids(strings_header):
+    """Returns the IDs of the string table in the order of AC_STR_t."""
+    with open(strings_header, encoding='utf-8') as f:
+        source = f.read()
+    table = re.search(r'#define\s+AUTOCONNECT_STRINGTABLE\(X\)(.*?)\n\n', source, re.S)
+    if not table:
+        raise ValueError('AUTOCONNECT_STRINGTABLE not found in {0}'.format(strings_header))
+    return re.findall(r'X\((\w+)\s*,', table.group(1))
+
+
+def load_texts(source):
+    """Loads the translation, which is a JSON object such as
+    {"lang": "ja", "strings": {"MENU_CONFIGNEW": "...", ...}}."""
+    with open(source, encoding='utf-8') as f:
+        translation = json.load(f)
+    lang = translation['lang'].lower()
+    if not re.fullmatch(r'[a-z0-9-]{1,' + str(TAGLEN) + '}', lang):
+        raise ValueError('{0} invalid language tag'.format(lang))
+    return lang, translation['strings']
+
+
+def tokenize(texts):
+    """Extracts the common byte sequences as the tokens greedily by the
+    saved size. Each text becomes a list of the literal bytes and the
+    token indexes."""
+    parts = [[text] for text in texts]
+    tokens = []
+    while len(tokens) < MAX_TOKENS:
+        counts = {}
+        for text in parts:
+            for part in text:
+                if not isinstance(part, bytes):
+                    continue
+                for length in range(MIN_TOKEN, min(MAX_TOKEN, len(part)) + 1):
+                    for i in range(len(part) - length + 1):
+                        seq = part[i:i + length]
+                        counts[seq] = counts.get(seq, 0) + 1
+        best, gain = None, 0
+        for seq, count in counts.items():
+            # A reference saves the token length minus two bytes, and the
+            # token costs its length byte and the offset.
+            g = count * (len(seq) - 2) - (len(seq) + 3)
+            if g > gain or (g == gain and best is not None and len(seq) > len(best)):
+                best, gain = seq, g
+        if best is None:
+            break
+        index = len(tokens)
+        tokens.append(best)
+        for text in parts:
+            split = []
+            for part in text:
+                if not isinstance(part, bytes):
+                    split.append(part)
+                    continue
+                pieces = part.split(best)
+                for n, piece in enumerate(pieces):
+                    if n:
+                        split.append(index)
+                    if piece:
+                        split.append(piece)
+            text[:] = split
+    return tokens, parts
+
+
+def build(lang, ids, strings):
+    unknown = set(strings) - set(ids)
+    if unknown:
+        raise ValueError('unknown IDs: {0}'.format(', '.join(sorted(unknown))))
+    texts = []
+    for sid in ids:
+        text = strings.get(sid, '').encode('utf-8')
+        if b'\x00' in text or bytes([TOKENREF]) in text:
+            raise ValueError('{0} contains a control character'.format(sid))
+        texts.append(text)
+
+    present = [i for i, text in enumerate(texts) if text]
+    tokens, parts = tokenize([texts[i] for i in present])
+
+    tag = lang.encode('ascii')
+    head = MAGIC + struct.pack('<BB', VERSION, len(tag)) + tag + struct.pack('<HB', len(ids), len(tokens))
+    base = len(head) + len(ids) * 2 + len(tokens) * 2
+    token_area = b''
+    token_offsets = []
+    for token in tokens:
+        token_offsets.append(base + len(token_area))
+        token_area += bytes([len(token)]) + token
+    base += len(token_area)
+    entry_area = b''
+    entry_offsets = [0] * len(ids)
+    for i, text in zip(present, parts):
+        entry_offsets[i] = base + len(entry_area)
+        for part in text:
+            entry_area += part if isinstance(part, bytes) else bytes([TOKENREF, part])
+        entry_area += b'\x00'
+    image = head + b''.join(struct.pack('<H', o) for o in entry_offsets + token_offsets) + token_area + entry_area
+    if len(image) > 0xffff:
+        raise ValueError('language pack exceeds 64KiB')
+    return image
+
+
+def write_header(image, name, out):
+    out.write('// Generated by aclangpack.py, do not edit.\n')
+    out.write('const uint8_t {0}[] PROGMEM = {{\n'.format(name))
+    for i in range(0, len(image), 16):
+        out.write('  ' + ', '.join('0x{0:02x}'.format(b) for b in image[i:i + 16]) + ',\n')
+    out.write('};\n')
+
+
+if __name__ == '__main__':
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description='AutoConnect language pack generator')
+    parser.add_argument('source', help='translation JSON file')
+    parser.add_argument('-o', '--output', help='output file (Default: <lang>.aclp or <lang>.h)')
+    parser.add_argument('-f', '--format', choices=['bin', 'header'], default='bin', help='bin for the file system, header for PROGMEM (Default: bin)')
+    parser.add_argument('-n', '--name', help='array name of the header (Default: langpack_<lang>)')
+    parser.add_argument('-s', '--strings', default=os.path.join(here, '..', '..', 'src', 'AutoConnectStrings.h'), help='path of AutoConnectStrings.h')
+    args = parser.parse_args()
+
+    try:
+        lang, strings = load_texts(args.source)
+        ids = load_ids(args.strings)
+        image = build(lang, ids, strings)
+    except (OSError, KeyError, ValueError) as e:
+        print('aclangpack: {0}'.format(e), file=sys.stderr)
+        sys.exit(1)
+
+    if args.format == 'bin':
+        path = args.output or lang + '.aclp'
+        with open(path, 'wb') as f:
+            f.write(image)
+    else:
+        path = args.output or lang + '.h'
+        with open(path, 'w', encoding='utf-8') as f:
+            write_header(image, args.name or 'langpack_' + lang.replace('-', '_'), f)
+    print('{0}: {1} bytes, {2}/{3} texts'.format(path, len(image), len(strings), len(ids)))
@@ -13,22 +13,9 @@
 #include "AutoConnectConfigBase.h"
 #include "AutoConnectError.h"
 
-/**
- * Feature flags to enable/disable functionality for memory optimization
- */
-#define AC_FEATURE_OTA          (1U << 0)
-#define AC_FEATURE_UPDATE       (1U << 1)
-#define AC_FEATURE_FILESYSTEM   (1U << 2)
-#define AC_FEATURE_JSON         (1U << 3)
-#define AC_FEATURE_CREDENTIALS  (1U << 4)
-#define AC_FEATURE_PORTAL       (1U << 5)
-#define AC_FEATURE_TICKER       (1U << 6)
-#define AC_FEATURE_DEBUG        (1U << 7)
-
-// Default features for most use cases
-#define AC_FEATURES_DEFAULT     (AC_FEATURE_CREDENTIALS | AC_FEATURE_PORTAL | AC_FEATURE_JSON)
-#define AC_FEATURES_MINIMAL     (AC_FEATURE_CREDENTIALS | AC_FEATURE_PORTAL)
-#define AC_FEATURES_FULL        (0xFFU)
+// The feature flags AC_FEATURE_* are declared in AutoConnectDefs.h.
+// The features stripped from the build by AC_FEATURES cannot be enabled.
+#define AC_FEATURES_AVAILABLE   (AC_FEATURES | AC_FEATURE_FILESYSTEM | AC_FEATURE_CREDENTIALS | AC_FEATURE_PORTAL | AC_FEATURE_DEBUG)
 
 /**
  * Network configuration with validation
@@ -45,13 +32,17 @@ struct NetworkConfig {
     bool useStaticIP;
     bool validateCertificates;
     uint32_t connectionTimeoutMs;
-    uint8_t maxRetries;
+    uint8_t maxRetries;             // Attempts over all the candidates
+    bool useSavedCredentials;       // Interleave the saved credentials in sight as the candidates
+    bool startPortalOnFail;         // Start the captive portal on failure as begin does, if autoRise
     
     NetworkConfig() 
         : useStaticIP(false)
         , validateCertificates(false)
         , connectionTimeoutMs(30000)
-        , maxRetries(3) {}
+        , maxRetries(3)
+        , useSavedCredentials(true)
+        , startPortalOnFail(true) {}
     
     ACResult validate() const {
         if (!InputSanitizer::isValidSSID(ssid)) {
@@ -227,7 +218,7 @@ public:
     
     AutoConnectAdvancedConfig(uint32_t features = AC_FEATURES_DEFAULT)
         : AutoConnectConfigBase()
-        , enabledFeatures(features)
+        , enabledFeatures(features & AC_FEATURES_AVAILABLE)
         , taskStackSize(4096)
         , taskPriority(1)
         , watchdogTimeoutMs(30000)
@@ -281,10 +272,10 @@ public:
     }
     
     /**
-     * Enable a feature
+     * Enable a feature, unless it is stripped from the build
      */
     void enableFeature(uint32_t feature) {
-        enabledFeatures |= feature;
+        enabledFeatures |= feature & AC_FEATURES_AVAILABLE;
     }
     
     /**
@@ -343,6 +334,14 @@ public:
         portalTimeout = portal.timeoutMs;
         
         ticker = hasFeature(AC_FEATURE_TICKER);
+
+#ifdef AUTOCONNECT_USE_LOGGER
+        // The logger is shared by all instances, the last applied wins.
+        AutoConnectLog::level(debug.logLevel);
+        AutoConnectLog::serial(debug.enableSerial);
+        AutoConnectLog::file(debug.enableFile, debug.logFilePath.c_str(), debug.maxLogFileSize);
+        AutoConnectLog::timestamp(debug.timestampLogs);
+#endif
     }
 };
 
@@ -0,0 +1,170 @@
+/**
+ * AutoConnectAuthSession class implementation.
+ * @file AutoConnectAuthSession.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectDefs.h"
+
+#ifdef AUTOCONNECT_USE_AUTHSESSION
+#include "AutoConnectAuthSession.h"
+#if defined(ARDUINO_ARCH_ESP8266)
+extern "C" {
+#include <user_interface.h>
+}
+#include <bearssl/bearssl.h>
+#elif defined(ARDUINO_ARCH_ESP32)
+#include <esp_system.h>
+#if __has_include(<esp_random.h>)
+#include <esp_random.h>
+#endif
+#include <mbedtls/md.h>
+#endif
+
+/**
+ * Issue a new session token for the authenticated client.
+ * @param  user      User name that has passed the authentication
+ * @param  password  Password of the user
+ * @param  client    IP address of the client
+ * @return A value of the Set-Cookie header.
+ */
+String AutoConnectAuthSession::issue(const char* user, const char* password, const IPAddress& client) {
+  if (!_keyed) {
+#if defined(ARDUINO_ARCH_ESP8266)
+    os_get_random(_key, sizeof(_key));
+#elif defined(ARDUINO_ARCH_ESP32)
+    esp_fill_random(_key, sizeof(_key));
+#endif
+    _keyed = true;
+  }
+
+  const uint32_t  issued = _now();
+  uint8_t mac[_MACLEN];
+  _sign(issued, user, password, client, mac);
+
+  char  token[_TOKENLEN + 1];
+  snprintf_P(token, sizeof(token), PSTR("%08" PRIx32), issued);
+  for (size_t i = 0; i < _MACLEN; i++)
+    snprintf_P(&token[8 + i * 2], 3, PSTR("%02x"), mac[i]);
+  AC_DBG("Session issued to %s\n", client.toString().c_str());
+
+  String  cookie(F(AUTOCONNECT_AUTHSESSION_COOKIE "="));
+  cookie += token;
+  cookie += F("; Max-Age=");
+  cookie += String(AUTOCONNECT_AUTHSESSION_LIFETIME);
+  cookie += F("; Path=/; HttpOnly; SameSite=Strict");
+  return cookie;
+}
+
+/**
+ * Verify the session token contained in the Cookie header. The token is
+ * bound to the credentials and the client IP, so changing the credentials
+ * invalidates the sessions issued before.
+ * @param  cookies   A value of the Cookie header
+ * @param  user      User name currently required
+ * @param  password  Password currently required
+ * @param  client    IP address of the client
+ * @return true   The session is valid.
+ * @return false  No session, expired or forged.
+ */
+bool AutoConnectAuthSession::verify(const String& cookies, const char* user, const char* password, const IPAddress& client) {
+  if (!_keyed || !cookies.length())
+    return false;
+
+  // Find the session cookie among the cookies separated by a semicolon.
+  static const char name[] PROGMEM = AUTOCONNECT_AUTHSESSION_COOKIE "=";
+  const char* cp = cookies.c_str();
+  const char* token = nullptr;
+  while (*cp) {
+    while (*cp == ' ' || *cp == ';')
+      cp++;
+    if (!strncmp_P(cp, name, sizeof(name) - 1)) {
+      token = cp + sizeof(name) - 1;
+      break;
+    }
+    cp = strchr(cp, ';');
+    if (!cp)
+      break;
+  }
+  if (!token || strspn(token, "0123456789abcdef") != _TOKENLEN)
+    return false;
+
+  char  hex[9];
+  memcpy(hex, token, 8);
+  hex[8] = '\0';
+  const uint32_t  issued = strtoul(hex, nullptr, 16);
+  // The issued time in the future also becomes huge elapsed time.
+  if (_now() - issued >= AUTOCONNECT_AUTHSESSION_LIFETIME)
+    return false;
+
+  uint8_t mac[_MACLEN];
+  _sign(issued, user, password, client, mac);
+  uint8_t diff = 0;
+  for (size_t i = 0; i < _MACLEN; i++) {
+    const char* hp = &token[8 + i * 2];
+    const uint8_t hi = hp[0] <= '9' ? hp[0] - '0' : hp[0] - 'a' + 10;
+    const uint8_t lo = hp[1] <= '9' ? hp[1] - '0' : hp[1] - 'a' + 10;
+    diff |= mac[i] ^ static_cast<uint8_t>((hi << 4) | lo);
+  }
+  return diff == 0;
+}
+
+/**
+ * Discard the signing key. All the sessions issued so far become invalid.
+ */
+void AutoConnectAuthSession::revoke(void) {
+  memset(_key, 0, sizeof(_key));
+  _keyed = false;
+}
+
+/**
+ * Calculate the MAC of the session with HMAC-SHA256.
+ * @param  issued    Issued time in seconds
+ * @param  user      User name
+ * @param  password  Password
+ * @param  client    IP address of the client
+ * @param  mac       Receives the truncated MAC of _MACLEN bytes
+ */
+void AutoConnectAuthSession::_sign(const uint32_t issued, const char* user, const char* password, const IPAddress& client, uint8_t* mac) {
+  uint8_t head[8];
+  for (uint8_t i = 0; i < 4; i++) {
+    head[i] = static_cast<uint8_t>(issued >> (i * 8));
+    head[4 + i] = client[i];
+  }
+  // A null separates the user and the password to prevent the
+  // ambiguity of their concatenation.
+  const size_t  ul = user ? strlen(user) + 1 : 0;
+  const size_t  pl = password ? strlen(password) : 0;
+  uint8_t out[32];
+
+#if defined(ARDUINO_ARCH_ESP8266)
+  br_hmac_key_context kc;
+  br_hmac_context hc;
+  br_hmac_key_init(&kc, &br_sha256_vtable, _key, sizeof(_key));
+  br_hmac_init(&hc, &kc, 0);
+  br_hmac_update(&hc, head, sizeof(head));
+  if (ul)
+    br_hmac_update(&hc, user, ul);
+  if (pl)
+    br_hmac_update(&hc, password, pl);
+  br_hmac_out(&hc, out);
+#elif defined(ARDUINO_ARCH_ESP32)
+  mbedtls_md_context_t  ctx;
+  mbedtls_md_init(&ctx);
+  mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 1);
+  mbedtls_md_hmac_starts(&ctx, _key, sizeof(_key));
+  mbedtls_md_hmac_update(&ctx, head, sizeof(head));
+  if (ul)
+    mbedtls_md_hmac_update(&ctx, reinterpret_cast<const uint8_t*>(user), ul);
+  if (pl)
+    mbedtls_md_hmac_update(&ctx, reinterpret_cast<const uint8_t*>(password), pl);
+  mbedtls_md_hmac_finish(&ctx, out);
+  mbedtls_md_free(&ctx);
+#endif
+  memcpy(mac, out, _MACLEN);
+}
+
+#endif // !AUTOCONNECT_USE_AUTHSESSION
@@ -0,0 +1,41 @@
+/**
+ * Declaration of AutoConnectAuthSession class.
+ * AutoConnectAuthSession issues a short-lived session cookie signed with
+ * HMAC-SHA256 to the client that has passed the HTTP authentication.
+ * The subsequent requests carrying the cookie are admitted by one HMAC
+ * comparison without repeating the verification of the credentials.
+ * @file AutoConnectAuthSession.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTAUTHSESSION_H_
+#define _AUTOCONNECTAUTHSESSION_H_
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "AutoConnectDefs.h"
+
+class AutoConnectAuthSession {
+ public:
+  AutoConnectAuthSession() : _keyed(false) {}
+  ~AutoConnectAuthSession() { revoke(); }
+  String  issue(const char* user, const char* password, const IPAddress& client);
+  bool    verify(const String& cookies, const char* user, const char* password, const IPAddress& client);
+  void    revoke(void);
+
+ protected:
+  // The token is the issued time in seconds followed by the truncated
+  // MAC, both in hexadecimal.
+  static constexpr size_t _MACLEN = 16;
+  static constexpr size_t _TOKENLEN = 8 + _MACLEN * 2;
+  void  _sign(const uint32_t issued, const char* user, const char* password, const IPAddress& client, uint8_t* mac);
+  static uint32_t _now(void) { return millis() / 1000; }
+
+  uint8_t _key[32];         /**< Signing key generated at the first issue */
+  bool    _keyed;           /**< The key is available */
+};
+
+#endif // !_AUTOCONNECTAUTHSESSION_H_
@@ -9,7 +9,9 @@
 #include <algorithm>
 #include "AutoConnectExt.hpp"
 #include "AutoConnectAux.h"
+#ifdef AUTOCONNECT_USE_UPLOAD
 #include "AutoConnectUploadImpl.h"
+#endif
 #include "AutoConnectElementBasisImpl.h"
 #ifdef AUTOCONNECT_USE_JSON
 #include "AutoConnectElementJsonImpl.h"
@@ -81,6 +83,7 @@ const char AutoConnectAux::_PAGE_AUX[] PROGMEM = {
   "</html>"
 };
 
+#ifndef AUTOCONNECT_ASSETS_ONFS
 const char AutoConnectAux::_PAGE_SCRIPT_MA[] PROGMEM = {
   "function " AUTOCONNECT_AUXSCRIPT_RANGEVALUE "(el,pos) {"
   "let mag=pos=='p'?el.previousElementSibling:el.nextElementSibling;"
@@ -138,6 +141,7 @@ const char AutoConnectAux::_PAGE_SCRIPT_FE[] PROGMEM = {
     "}"
   "}"
 };
+#endif // !AUTOCONNECT_ASSETS_ONFS
 
 /**
  * AutoConnectAux default constructor.
@@ -647,14 +651,24 @@ const String AutoConnectAux::_insertScript(PageArgument& args) {
   AC_UNUSED(args);
   String  postscript;
 
+#ifdef AUTOCONNECT_USE_ASSETS
+  // The scripts are loaded from the assets. The script elements break
+  // out of the inline script block of the page template temporarily.
+  static const char rangeScript[] PROGMEM = "</script><script src=\"" AUTOCONNECT_URI_ASSETS "/" AUTOCONNECT_ASSET_RANGEJS "?v=" AUTOCONNECT_ASSETS_REVISION "\"></script><script>";
+  static const char fetchScript[] PROGMEM = "</script><script src=\"" AUTOCONNECT_URI_ASSETS "/" AUTOCONNECT_ASSET_FETCHJS "?v=" AUTOCONNECT_ASSETS_REVISION "\"></script><script>";
+#else
+  const char* rangeScript = _PAGE_SCRIPT_MA;
+  const char* fetchScript = _PAGE_SCRIPT_FE;
+#endif
+
   // Insert a script that advances the progress bar of uploading progress.
   if ((_contains >> (uint16_t)AC_Range) & 0b1)
-    postscript += String(FPSTR(_PAGE_SCRIPT_MA));
+    postscript += String(FPSTR(rangeScript));
 
   // Insert Fetch
   for (AutoConnectElement& elm : _addonElm)
     if (elm.canHandle()) {
-      postscript += String(FPSTR(_PAGE_SCRIPT_FE));
+      postscript += String(FPSTR(fetchScript));
       break;
     }
 
@@ -709,8 +723,8 @@ const String AutoConnectAux::_insertStyle(PageArgument& args) {
  * @param  uri   An uri of the auxiliary page.
  * @return A PageElement of auxiliary page.
  */
-PageElement* AutoConnectAux::_setupPage(const String& uri) {
-  PageElement*  elm = nullptr;
+AutoConnectPageElement* AutoConnectAux::_setupPage(const String& uri) {
+  AutoConnectPageElement*  elm = nullptr;
 
   if (_ac) {
     if (uri != _uri) {
@@ -723,7 +737,7 @@ PageElement* AutoConnectAux::_setupPage(const String& uri) {
       if (_title.length())
         mother->_menuTitle = _title;
 
-      elm = new PageElement();
+      elm = new AutoConnectPageElement();
       // Construct the auxiliary page
       elm->setMold(FPSTR(_PAGE_AUX));
 
@@ -770,6 +784,8 @@ PageElement* AutoConnectAux::_setupPage(const String& uri) {
         // AutoConnect uses the HEAD token that first appears in the
         // AutoConnectAux template to call the AUX handler.
         elm->addToken(FPSTR("HEAD"), std::bind(&AutoConnectAux::_nonResponseExit, this, std::placeholders::_1));
+        // The response is up to the handler.
+        elm->setDeflatable(false);
       }
     }
   }
@@ -864,7 +880,14 @@ String AutoConnectAux::_fetchEndpoint(PageArgument& args) {
     responseContent = PSTR("Invalid interface");
 
   AC_DBG(AUTOCONNECT_URI_FETCH "(%d) %s\n", responseCode, responseContent);
-  _ac->_webServer->send(responseCode, responseCode == 200 ? "application/json" : "text/plain", responseContent);
+  const char* contentType = responseCode == 200 ? "application/json" : "text/plain";
+  bool  sent = false;
+#ifdef AUTOCONNECT_USE_DEFLATE
+  const PGM_P parts[] = { responseContent };
+  sent = _ac->_sendDeflate(responseCode, String(contentType), parts, 1);
+#endif
+  if (!sent)
+    _ac->_webServer->send(responseCode, contentType, responseContent);
   _ac->_responsePage->cancel();
   if (res)
     delete[] res;
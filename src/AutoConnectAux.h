@@ -19,6 +19,7 @@
 #endif // !AUTOCONNECT_USE_JSON
 #include <PageBuilder.h>
 #include "AutoConnectDefs.h"
+#include "AutoConnectPageElement.h"
 #include "AutoConnectTypes.h"
 #include "AutoConnectElement.h"
 #include "AutoConnectConfigExt.h"
@@ -136,7 +137,7 @@ class AutoConnectAux : public PageBuilder {
   const String  _insertStyle(PageArgument& args);                       /**< Insert CSS style */
   virtual void  _join(AutoConnectExt<AutoConnectConfigExt>& ac);         /**< Make a link to AutoConnect */
   const String  _nonResponseExit(PageArgument& args);                   /**< Exit for responsive=false setting */
-  PageElement*  _setupPage(const String& uri);                          /**< AutoConnectAux page builder */
+  virtual AutoConnectPageElement* _setupPage(const String& uri);        /**< AutoConnectAux page builder */
   void  _storeElements(WebServer* webServer);                           /**< Store element values from contained in request arguments */
   template<typename T>
   bool  _isCompatible(const AutoConnectElement* element) const;         /**< Validate a type of AutoConnectElement entity conformity */
@@ -161,8 +162,12 @@ class AutoConnectAux : public PageBuilder {
    */
   template<typename T>
   bool _parseJson(T in, const size_t size) {
+#ifdef AUTOCONNECT_USE_JSONARENA
+    ArduinoJsonLoadBuffer jsonBuffer(size);
+#else
     AC_UNUSED(size);
-    ArduinoJsonBuffer jsonBuffer(AUTOCONNECT_JSONBUFFER_PRIMITIVE_SIZE);
+    ArduinoJsonLoadBuffer jsonBuffer(AUTOCONNECT_JSONBUFFER_PRIMITIVE_SIZE);
+#endif
     DeserializationError  err = deserializeJson(jsonBuffer, in);
     if (err) {
       AC_DBG("Deserialize:%s\n", err.c_str());
@@ -182,7 +187,7 @@ class AutoConnectAux : public PageBuilder {
   template<typename T, typename U,
   typename std::enable_if<std::is_same<U, const String&>::value || std::is_same<U, std::vector<String> const&>::value>::type* = nullptr>
   bool _parseElement(T in, U name, const size_t size) {
-    ArduinoJsonBuffer jsonBuffer(size);
+    ArduinoJsonLoadBuffer jsonBuffer(size);
     JsonVariant jb;
     DeserializationError  err = deserializeJson(jsonBuffer, in);
     if (err) {
@@ -208,8 +213,10 @@ class AutoConnectAux : public PageBuilder {
   PageBuilder::UploadFuncT  _uploadHandler;   /**< The AutoConnectFile corresponding to current upload */
   AutoConnectFile*      _currentUpload;       /**< AutoConnectFile handling the current upload */
   static const char _PAGE_AUX[] PROGMEM;      /**< Auxiliary page template */
+#ifndef AUTOCONNECT_ASSETS_ONFS
   static const char _PAGE_SCRIPT_MA[] PROGMEM; /**< Auxiliary page javascript for ACRange */
   static const char _PAGE_SCRIPT_FE[] PROGMEM; /**< Auxiliary page javascript for Fetch */
+#endif
 
   // Protected members can be used from AutoConnect which handles AutoConnectAux pages.
   friend class AutoConnectExt<AutoConnectConfigExt>;
@@ -0,0 +1,92 @@
+/**
+ * AutoConnectChannel class implementation.
+ * @file AutoConnectChannel.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectChannel.h"
+
+/**
+ * Score the congestion of the channel. Each access point contributes
+ * the fixed weight plus its signal strength above -100dBm, and the
+ * contribution is scaled by the spectrum overlap of the 22MHz wide
+ * channels with the 5MHz spacing. So the access point four channels
+ * apart still counts slightly, and the one five channels apart does
+ * not. The access points outside the 2.4GHz band are not counted.
+ * @param  aps       Scan table
+ * @param  count     Number of the access points in the scan table
+ * @param  channel   The channel to be scored
+ * @param  apWeight  Weight of the presence of an access point
+ * @return The score, the lower is the less congested.
+ */
+uint32_t AutoConnectChannel::score(const AP_t* aps, const size_t count, const uint8_t channel, const uint8_t apWeight) {
+  uint32_t  total = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t ch = aps[i].channel;
+    if (!ch || ch > _MAXCHANNEL)
+      continue;
+    const uint16_t  freq = _frequency(ch);
+    const uint16_t  target = _frequency(channel);
+    const uint16_t  distance = freq > target ? freq - target : target - freq;
+    if (distance >= _WIDTH)
+      continue;
+    const int16_t strength = aps[i].rssi + 100;
+    const uint32_t  contribution = apWeight + (strength < 0 ? 0 : strength > 100 ? 100 : strength);
+    total += contribution * (_WIDTH - distance) / _WIDTH;
+  }
+  return total;
+}
+
+/**
+ * Choose the least congested channel from 1 to maxChannel. The ties are
+ * broken in favor of the preferred channel, then the non-overlapping
+ * channels 1, 6 and 11, then the lower channel.
+ * @param  aps         Scan table
+ * @param  count       Number of the access points in the scan table
+ * @param  maxChannel  The highest channel allowed in the region
+ * @param  preferred   The channel preferred when it ties
+ * @param  apWeight    Weight of the presence of an access point
+ * @return The channel chosen.
+ */
+uint8_t AutoConnectChannel::select(const AP_t* aps, const size_t count, const uint8_t maxChannel, const uint8_t preferred, const uint8_t apWeight) {
+  const uint8_t limit = !maxChannel || maxChannel > _MAXCHANNEL ? _MAXCHANNEL : maxChannel;
+  uint8_t   best = 0;
+  uint32_t  bestScore = 0;
+
+  for (uint8_t ch = 1; ch <= limit; ch++) {
+    const uint32_t  s = score(aps, count, ch, apWeight);
+    if (!best || s < bestScore || (s == bestScore && _rank(ch, preferred) < _rank(best, preferred))) {
+      best = ch;
+      bestScore = s;
+    }
+  }
+  return best;
+}
+
+/**
+ * Position of the center frequency on the scale of the channel spacing.
+ * Channel 14 is placed 12MHz above the channel 13, not at the spacing.
+ * @param  channel  The channel
+ * @return The position in MHz from the origin of the scale.
+ */
+uint16_t AutoConnectChannel::_frequency(const uint8_t channel) {
+  return channel == 14 ? 13 * _SPACING + 12 : channel * _SPACING;
+}
+
+/**
+ * Precedence of the channel when the scores tie.
+ * @param  channel    The channel
+ * @param  preferred  The channel preferred
+ * @return The precedence, the lower takes precedence.
+ */
+uint8_t AutoConnectChannel::_rank(const uint8_t channel, const uint8_t preferred) {
+  if (channel == preferred)
+    return 0;
+  if (channel == 1 || channel == 6 || channel == 11)
+    return 1;
+  return 2;
+}
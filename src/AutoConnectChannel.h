@@ -0,0 +1,39 @@
+/**
+ * Declaration of AutoConnectChannel class.
+ * AutoConnectChannel scores the congestion of the 2.4GHz channels from
+ * the result of the WiFi scan and chooses the channel for the SoftAP.
+ * It depends only on the given scan table, not on the WiFi driver.
+ * @file AutoConnectChannel.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTCHANNEL_H_
+#define _AUTOCONNECTCHANNEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+class AutoConnectChannel {
+ public:
+  /**< An access point in the scan result */
+  typedef struct {
+    uint8_t channel;          /**< Primary channel */
+    int8_t  rssi;             /**< Signal strength in dBm */
+  } AP_t;
+
+  static uint32_t score(const AP_t* aps, const size_t count, const uint8_t channel, const uint8_t apWeight);
+  static uint8_t  select(const AP_t* aps, const size_t count, const uint8_t maxChannel, const uint8_t preferred, const uint8_t apWeight);
+
+ protected:
+  static constexpr uint8_t  _MAXCHANNEL = 14;   /**< Upper limit of the 2.4GHz band */
+  static constexpr uint8_t  _WIDTH = 22;        /**< Channel width in MHz */
+  static constexpr uint8_t  _SPACING = 5;       /**< Channel spacing in MHz */
+
+  static uint16_t _frequency(const uint8_t channel);
+  static uint8_t  _rank(const uint8_t channel, const uint8_t preferred);
+};
+
+#endif // !_AUTOCONNECTCHANNEL_H_
@@ -0,0 +1,209 @@
+/**
+ * Declaration of AutoConnectClients class template.
+ * A fixed-capacity table of the portal state of each client, keyed by
+ * the IPv4 address of the station. When the table is full, the client
+ * that has been idle the longest gives up its entry, except a client
+ * pinned while it waits for the result of its connection request. It
+ * depends only on the time given by the caller, so the eviction is
+ * verified on the host.
+ * @file AutoConnectClients.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTCLIENTS_H_
+#define _AUTOCONNECTCLIENTS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Table of the state of each client with the LRU eviction.
+ * @param  S  State of a client. It must be default constructible and
+ * move assignable, a default constructed S is the state of a new client.
+ * @param  N  Number of the clients held at once.
+ */
+template<typename S, size_t N>
+class AutoConnectClients {
+  static_assert(N >= 1, "AutoConnectClients needs one entry at least");
+
+ public:
+  AutoConnectClients() { clear(); }
+  ~AutoConnectClients() {}
+
+  /**
+   * Get the state of a client and mark it as the most recent. A client
+   * not in the table takes a free entry, or the entry of the client that
+   * has been idle the longest, with the state of a new client.
+   * @param  addr   Address of the client.
+   * @param  now    Current time. Only the difference is used so that it
+   * may wrap around.
+   * @return The state of the client.
+   */
+  S&  acquire(const uint32_t addr, const uint32_t now) {
+    _entry_t* slot = nullptr;
+    for (_entry_t& entry : _entries) {
+      if (entry.used && entry.addr == addr) {
+        entry.active = now;
+        return entry.state;
+      }
+      if (!slot || _older(entry, *slot, now))
+        slot = &entry;
+    }
+    slot->state = S();
+    slot->addr = addr;
+    slot->active = now;
+    slot->used = true;
+    slot->pinned = false;
+    return slot->state;
+  }
+
+  /**
+   * Bind the state of the requesting client. The state of the client
+   * bound until now is handed to the stow, and the state of the
+   * requesting client, which is acquired, is handed to the take.
+   * @param  addr   Address of the requesting client.
+   * @param  now    Current time.
+   * @param  stow   Callable that takes the state of the client bound
+   * until now. It is not called if that client has been evicted.
+   * @param  take   Callable that takes the state of the requesting client.
+   * @retval true   Another client has been bound.
+   * @retval false  The client has been bound already.
+   */
+  template<typename F, typename G>
+  bool  bind(const uint32_t addr, const uint32_t now, F stow, G take) {
+    if (_bound && addr == _bound) {
+      acquire(addr, now);
+      return false;
+    }
+    S*  bound = this->bound();
+    if (bound)
+      stow(*bound);
+    take(acquire(addr, now));
+    _bound = addr;
+    return true;
+  }
+
+  /**
+   * Get the state of the bound client.
+   * @return The state of the bound client, nullptr if none.
+   */
+  S*  bound(void) { return _bound ? find(_bound) : nullptr; }
+
+  /**
+   * Pin a client so that it is not evicted while it waits for the result
+   * of its connection request. When all the entries are pinned, the one
+   * idle the longest is evicted still.
+   * @param  addr  Address of the client.
+   */
+  void  pin(const uint32_t addr) {
+    for (_entry_t& entry : _entries)
+      if (entry.used && entry.addr == addr)
+        entry.pinned = true;
+  }
+
+  /**
+   * Call a function for the state of each pinned client and unpin it.
+   * @param  fn  Callable that takes the address and the state.
+   */
+  template<typename F>
+  void  unpin(F fn) {
+    for (_entry_t& entry : _entries)
+      if (entry.used && entry.pinned) {
+        entry.pinned = false;
+        fn(entry.addr, entry.state);
+      }
+  }
+
+  bool  pinned(const uint32_t addr) const {
+    for (const _entry_t& entry : _entries)
+      if (entry.used && entry.addr == addr)
+        return entry.pinned;
+    return false;
+  }
+
+  /**
+   * Get the state of a client without marking it.
+   * @param  addr  Address of the client.
+   * @return The state of the client, nullptr if it is not in the table.
+   */
+  S*  find(const uint32_t addr) {
+    for (_entry_t& entry : _entries)
+      if (entry.used && entry.addr == addr)
+        return &entry.state;
+    return nullptr;
+  }
+
+  /**
+   * Call a function for the state of each client in the table.
+   * @param  fn  Callable that takes the address and the state.
+   */
+  template<typename F>
+  void  forEach(F fn) {
+    for (_entry_t& entry : _entries)
+      if (entry.used)
+        fn(entry.addr, entry.state);
+  }
+
+  /**
+   * Drop the state of a client.
+   * @param  addr  Address of the client.
+   */
+  void  evict(const uint32_t addr) {
+    for (_entry_t& entry : _entries)
+      if (entry.used && entry.addr == addr) {
+        entry.state = S();
+        entry.used = false;
+        entry.pinned = false;
+      }
+    if (addr == _bound)
+      _bound = 0;
+  }
+
+  /**
+   * Drop the state of all the clients.
+   */
+  void  clear(void) {
+    for (_entry_t& entry : _entries) {
+      entry.state = S();
+      entry.addr = 0;
+      entry.active = 0;
+      entry.used = false;
+      entry.pinned = false;
+    }
+    _bound = 0;
+  }
+
+  size_t  size(void) const {
+    size_t  n = 0;
+    for (const _entry_t& entry : _entries)
+      n += entry.used ? 1 : 0;
+    return n;
+  }
+  static constexpr size_t capacity(void) { return N; }
+
+ protected:
+  typedef struct {
+    uint32_t  addr;     /**< IPv4 address of the client */
+    uint32_t  active;   /**< The last time the client acquired the entry */
+    bool      used;     /**< The entry holds a client */
+    bool      pinned;   /**< The client waits for the result of its connection request */
+    S         state;    /**< State of the client */
+  } _entry_t;
+
+  /** A free entry precedes, then an unpinned one, then the entry idle the longest. */
+  static bool _older(const _entry_t& a, const _entry_t& b, const uint32_t now) {
+    if (a.used != b.used)
+      return !a.used;
+    if (a.pinned != b.pinned)
+      return !a.pinned;
+    return now - a.active > now - b.active;
+  }
+
+  _entry_t  _entries[N];  /**< Entries of the clients */
+  uint32_t  _bound = 0;   /**< Address of the bound client, 0 for none */
+};
+
+#endif // !_AUTOCONNECTCLIENTS_H_
@@ -16,6 +16,7 @@
 #ifdef AUTOCONNECT_USE_CONFIGAUX
 
 #include "AutoConnectFS.h"
+#include "AutoConnectStrings.h"
 #if defined(ARDUINO_ARCH_ESP32) && (AC_USE_FILESYSTEM == 1)
 extern "C" {
 #include <esp_spiffs.h>
@@ -69,6 +70,43 @@ extern "C" {
 #define AUTOCONNECT_CONFIGAUX_ELM_TICKERPORT      "tio"
 #define AUTOCONNECT_CONFIGAUX_ELM_USER            "usr"
 
+// Binary settings snapshot layout
+// [magic:4][version:1][reserved:1][body length:2][body][crc32:4]
+// The body is a sequence of records as [id:1][length:1][data:length].
+// Numbers are little-endian int32, booleans are one byte, IP addresses
+// are four bytes and strings are raw bytes without the terminator.
+// Unknown IDs are skipped so that the newer firmware can read older files.
+#define AUTOCONNECT_CONFIGAUX_SNAPSHOT_EXT      ".bin"
+#define AUTOCONNECT_CONFIGAUX_SNAPSHOT_MAGIC    "ACCB"
+#define AUTOCONNECT_CONFIGAUX_SNAPSHOT_VERSION  1
+#define AUTOCONNECT_CONFIGAUX_SNAPSHOT_HEADER   8
+#define AUTOCONNECT_CONFIGAUX_SNAPSHOT_MAXSIZE  2048
+
+// The body contains only the fields that have been changed on the page,
+// the other fields follow AutoConnect::config of the sketch.
+#define AUTOCONNECT_CONFIGAUX_FIELD(id)     (1ULL << AutoConnectConfigAux::id)
+#define AUTOCONNECT_CONFIGAUX_ALLFIELDS     (~0ULL)
+static_assert(AutoConnectConfigAux::AC_CFGID_END <= 64, "AC_CFGID_t exceeds the field mask");
+
+// The fields that are applied only at AutoConnect::begin or at the
+// start of the SoftAP. Changing them requires a reboot, the others are
+// applied to the running AutoConnect immediately.
+#define AUTOCONNECT_CONFIGAUX_REBOOTFIELDS  ( \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_APID) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_PSK) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_CHANNEL) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_HIDDEN) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_APIP) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_GATEWAY) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_NETMASK) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_STAIP) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_STAGATEWAY) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_STANETMASK) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_DNS1) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_DNS2) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_HOSTNAME) | \
+  AUTOCONNECT_CONFIGAUX_FIELD(AC_CFGID_BOUNDARYOFFSET))
+
 const char AutoConnectConfigAux::_ELM_APGATEWAY[] PROGMEM       = AUTOCONNECT_CONFIGAUX_ELM_APGATEWAY;
 const char AutoConnectConfigAux::_ELM_APIP[] PROGMEM            = AUTOCONNECT_CONFIGAUX_ELM_APIP;
 const char AutoConnectConfigAux::_ELM_APNETMASK[] PROGMEM       = AUTOCONNECT_CONFIGAUX_ELM_APNETMASK;
@@ -164,9 +202,11 @@ const char* const AutoConnectConfigAux::_elmNames[] PROGMEM = {
 };
 
 // AutoConnectConfigAux page definition
-// The labels appearing in the definitions below are quoted from the
-// literal definitions by AutoConnectLabels.h, which allows the sketch
-// to change the display language on the page.
+// The labels and the section headings are not quoted in the definitions
+// below. _applyLabels sets them from the string table of
+// AutoConnectStrings, which takes them from the literal definitions by
+// AutoConnectLabels.h and allows the sketch to change the display
+// language on the page.
 // Refer to https://hieromon.github.io/AutoConnect/changelabel.html for
 // a detailed explanation of changing the label literals.
 const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
@@ -178,25 +218,21 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": "sep1",
-  "type": "ACElement",
-  "value": "<div class=\"shd\">)" AUTOCONNECT_PAGELABEL_SOFTAPSETTINGS R"(</div>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_SSID R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_SSID R"(",
   "placeholder": ")" AUTOCONNECT_APID R"("
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PSK R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_PASSPHRASE R"(",
   "placeholder": ")" AUTOCONNECT_PSK R"("
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_CHANNEL R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGESTATS_CHANNEL R"(",
   "placeholder": ")" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_AP_CH) R"(",
   "style": "width:3em",
   "apply": "number"
@@ -205,54 +241,45 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_HIDDEN R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_HIDDEN R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_HIDDENSSID R"(",
   "labelposition": "infront"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_APIP R"(",
-  "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_IPADDRESS R"("
+  "type": "ACInput"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_APGATEWAY R"(",
-  "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_GATEWAY R"("
+  "type": "ACInput"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_APNETMASK R"(",
-  "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGESTATS_SUBNETMASK R"("
+  "type": "ACInput"
 },
 {
   "name": "sep2",
-  "type": "ACElement",
-  "value": "<div class=\"shd\">)" AUTOCONNECT_PAGELABEL_CPCONTROL R"(</div>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTORISE R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTORISE R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_AUTOPOPUP R"(",
   "labelposition": "infront"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_IMMEDIATESTART R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_IMMEDIATESTART R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_IMMEDIATESTART R"(",
   "labelposition": "infront"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_RETAINPORTAL R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_RETAINPORTAL R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_RETAINPORTAL R"(",
   "labelposition": "infront"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PORTALTIMEOUT R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_CPTIMEOUT R"(",
   "placeholder": ")" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT) R"(",
   "apply": "number",
   "style": "width:5em",
@@ -266,13 +293,11 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": "sep3",
-  "type": "ACElement",
-  "value": "<div class=\"shd\">)" AUTOCONNECT_PAGELABEL_CONNECTIONCONTROL R"(</div>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PRINCIPLE R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\" for=\")" AUTOCONNECT_CONFIGAUX_ELM_PRINCIPLE R"(\">)" AUTOCONNECT_PAGECONFIG_PRINCIPLE R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PRINCIPLE R"(O",
@@ -297,7 +322,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MINRSSI R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_MINRSSI R"(",
   "placeholder": ")" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_MIN_RSSI) R"(",
   "apply": "number",
   "style": "width:5em"
@@ -305,7 +329,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_BEGINTIMEOUT R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_BEGINTIMEOUT R"(",
   "placeholder": ")" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_TIMEOUT) R"(",
   "apply": "number",
   "style": "width:5em",
@@ -321,13 +344,11 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTORECONNECT R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTORECONNECT R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_AUTORECONNECT R"(",
   "labelposition": "infront"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_RECONNECTINT R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_RECONNECTINTERVAL R"(",
   "apply": "number",
   "style": "width:3em",
   "posterior": "none"
@@ -340,8 +361,7 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTOSAVE R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\" for=\")" AUTOCONNECT_CONFIGAUX_ELM_AUTOSAVE R"(\">)" AUTOCONNECT_PAGECONFIG_SAVECREDENTIAL R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTOSAVE R"(O",
@@ -368,19 +388,16 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTORESTART R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTORESTART R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_AUTORESTART R"(",
   "labelposition": "infront"
 },
 {
   "name": "sep4",
-  "type": "ACElement",
-  "value": "<div class=\"shd\">)" AUTOCONNECT_PAGELABEL_STATIONSETTINGS R"(</div>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PRESERVEAPMODE R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_PRESERVEAPMODE R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_PRESERVEAPMODE R"(",
   "labelposition": "infront"
 },
 {
@@ -392,7 +409,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_ENABLEDHCP R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_ENABLEDHCP R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_ENABLEDHCP R"(",
   "labelposition": "infront",
   "posterior": "none"
 },
@@ -404,35 +420,30 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_STAIP R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_IPADDRESS R"(",
   "placeholder": "0.0.0.0",
   "posterior": "div"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_STAGATEWAY R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_GATEWAY R"(",
   "placeholder": "0.0.0.0",
   "posterior": "div"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_STANETMASK R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGESTATS_SUBNETMASK R"(",
   "placeholder": "0.0.0.0",
   "posterior": "div"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PRIMARYDNS R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_PRIMARYDNS R"(",
   "placeholder": "0.0.0.0",
   "posterior": "div"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_SECONDARYDNS R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_SECONDARYDNS R"(",
   "placeholder": "0.0.0.0",
   "posterior": "div"
 },
@@ -443,19 +454,16 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_HOSTNAME R"(",
-  "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_HOSTNAME R"("
+  "type": "ACInput"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_HOMEURI R"(",
   "type": "ACInput",
-  "placeholder": ")" AUTOCONNECT_HOMEURI R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_HOMEURI R"("
+  "placeholder": ")" AUTOCONNECT_HOMEURI R"("
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_BOOTURI R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\">)" AUTOCONNECT_PAGECONFIG_ONBOOTURI R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_BOOTURI R"(O",
@@ -479,13 +487,11 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": "sep5",
-  "type": "ACElement",
-  "value": "<div class=\"shd\">)" AUTOCONNECT_PAGELABEL_AUTHSETTINGS R"(</div>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTH R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\" for=\")" AUTOCONNECT_CONFIGAUX_ELM_AUTH R"(\">)" AUTOCONNECT_PAGECONFIG_AUTHENTICATION R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTH R"(O",
@@ -510,8 +516,7 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTHSCOPE R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\" for=\")" AUTOCONNECT_CONFIGAUX_ELM_AUTHSCOPE R"(\">)" AUTOCONNECT_PAGECONFIG_AUTHSCOPE R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_AUTHSCOPE R"(O",
@@ -538,30 +543,25 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_USER R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_USERNAME R"(",
   "placeholder": ")" AUTOCONNECT_APID R"("
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_PASSWORD R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_PASSWORD R"(",
   "placeholder": ")" AUTOCONNECT_PSK R"("
 },
 {
   "name": "sep6",
-  "type": "ACElement",
-  "value": "<div class=\"shd\">)" AUTOCONNECT_PAGELABEL_MISCELLANEOUS R"(</div>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUTITLE R"(",
   "type": "ACInput",
-  "placeholder": ")" AUTOCONNECT_MENU_TITLE R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_MENUTITLE R"("
+  "placeholder": ")" AUTOCONNECT_MENU_TITLE R"("
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENU R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\" for=\")" AUTOCONNECT_CONFIGAUX_ELM_MENU R"(\">)" AUTOCONNECT_PAGECONFIG_MENUSUSE R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENU R"(O",
@@ -572,7 +572,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUCONFIGNEW R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUCONFIGNEW R"(",
-  "label": ")" AUTOCONNECT_MENULABEL_CONFIGNEW R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -580,7 +579,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUOPENSSIDS R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUOPENSSIDS R"(",
-  "label": ")" AUTOCONNECT_MENULABEL_OPENSSIDS R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -588,7 +586,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUDISCONNECT R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUDISCONNECT R"(",
-  "label": ")" AUTOCONNECT_MENULABEL_DISCONNECT R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -596,7 +593,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENURESET R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_MENURESET R"(",
-  "label": ")" AUTOCONNECT_MENULABEL_RESET R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -604,7 +600,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUHOME R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUHOME R"(",
-  "label": ")" AUTOCONNECT_MENULABEL_HOME R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -612,7 +607,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUUPDATE R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_MENUUPDATE R"(",
-  "label": ")" AUTOCONNECT_MENULABEL_UPDATE R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -623,8 +617,7 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKER R"(L",
-  "type": "ACElement",
-  "value": "<label class=\"fll\" for=\")" AUTOCONNECT_CONFIGAUX_ELM_TICKER R"(\">)" AUTOCONNECT_PAGECONFIG_TICKER R"(</label>"
+  "type": "ACElement"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKER R"(O",
@@ -635,7 +628,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKER R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKER R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_TICKERON R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
@@ -643,14 +635,12 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKERON R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKERON R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_TICKERACTIVE R"(",
   "labelposition": "infront",
   "posterior": "div"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_TICKERPORT R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_TICKERPORT R"(",
   "apply": "number",
   "style": "width:2.5em",
   "posterior": "div"
@@ -664,13 +654,11 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_BUILTINOTA R"(",
   "type": "ACCheckbox",
   "value": ")" AUTOCONNECT_CONFIGAUX_ELM_BUILTINOTA R"(",
-  "label": ")" AUTOCONNECT_PAGECONFIG_BUILTINOTA R"(",
   "labelposition": "infront"
 },
 {
   "name": ")" AUTOCONNECT_CONFIGAUX_ELM_BOUNDARYOFFSET R"(",
   "type": "ACInput",
-  "label": ")" AUTOCONNECT_PAGECONFIG_BOUNDARY R"(",
   "placeholder": ")" AUTOCONNECT_STRING_DEPLOY(AC_IDENTIFIER_OFFSET) R"(",
   "apply": "number",
   "style": "width:5em"
@@ -678,7 +666,6 @@ const char AutoConnectConfigAux::_ui[] PROGMEM = R"(
 {
   "name": "apply",
   "type": "ACSubmit",
-  "value": ")" AUTOCONNECT_PAGECONFIG_APPLY R"(",
   "uri": ")" AUTOCONNECT_URI_CONFIGAUX R"("
 }
 ]
@@ -688,6 +675,10 @@ const char AutoConnectConfigAux::_rdlg[] PROGMEM = R"(
 <script type="text/javascript">window.onload=function(){window.location.replace('#rdlg');};</script>
 )";
 
+const char AutoConnectConfigAux::_odlg[] PROGMEM = R"(
+<script type="text/javascript">window.onload=function(){alert(')" AUTOCONNECT_TEXT_CONFIGOVERSIZE R"(');};</script>
+)";
+
 /**
  * Join AutoConnectConfigAux to the AutoConnect instance, and start
  * working as a custom web page.
@@ -702,6 +693,113 @@ void AutoConnectConfigAux::_join(AutoConnectExt<AutoConnectConfigExt>& ac) {
   _loadSettings();
 }
 
+/**
+ * Load the elements of the page when the page is requested for the
+ * first time. Until then, AutoConnectConfigAux holds no elements and
+ * does not parse the JSON document of the page.
+ * @param  uri  The requested uri
+ * @return A PageElement of auxiliary page.
+ */
+AutoConnectPageElement* AutoConnectConfigAux::_setupPage(const String& uri) {
+  if (uri == _uri)
+    _materialize();
+  return AutoConnectAux::_setupPage(uri);
+}
+
+/**
+ * Load the AutoConnectElements of the page from the JSON document.
+ * @return true   The elements are ready.
+ * @return false  Failed to load.
+ */
+bool AutoConnectConfigAux::_materialize(void) {
+  if (!_materialized) {
+    if (!loadElement(FPSTR(_ui), String(), 10400)) {
+      AC_DBG("Failed to load AutoConnectConfigAux\n");
+      return false;
+    }
+    _materialized = true;
+  }
+  return true;
+}
+
+/**
+ * Set the labels of the elements from the string table. They are set at
+ * each request, so the language pack selected for the request also
+ * applies to them.
+ */
+void AutoConnectConfigAux::_applyLabels(void) {
+  AutoConnectConfigAux& me = *this;
+  auto  input = [&me](const char* name, const AC_STR_t id) {
+    me[name].as<AutoConnectInput>().label = AutoConnectStrings::fstr(id);
+  };
+  auto  checkbox = [&me](const char* name, const AC_STR_t id) {
+    me[name].as<AutoConnectCheckbox>().label = AutoConnectStrings::fstr(id);
+  };
+  // The section heading of the sepN element
+  auto  heading = [&me](const char* name, const AC_STR_t id) {
+    me[name].value = String(F("<div class=\"shd\">")) + AutoConnectStrings::fstr(id) + String(F("</div>"));
+  };
+  // The label placed in front of the radio buttons or the checkboxes,
+  // which is the element suffixed with L
+  auto  caption = [&me](const char* name, const AC_STR_t id) {
+    me[String(name) + 'L'].value = String(F("<label class=\"fll\" for=\"")) + name + String(F("\">")) + AutoConnectStrings::fstr(id) + String(F("</label>"));
+  };
+
+  heading("sep1", AC_STR_PAGELABEL_SOFTAPSETTINGS);
+  input(AUTOCONNECT_CONFIGAUX_ELM_SSID, AC_STR_PAGECONFIG_SSID);
+  input(AUTOCONNECT_CONFIGAUX_ELM_PSK, AC_STR_PAGECONFIG_PASSPHRASE);
+  input(AUTOCONNECT_CONFIGAUX_ELM_CHANNEL, AC_STR_PAGESTATS_CHANNEL);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_HIDDEN, AC_STR_PAGECONFIG_HIDDENSSID);
+  input(AUTOCONNECT_CONFIGAUX_ELM_APIP, AC_STR_CONFIG_IPADDRESS);
+  input(AUTOCONNECT_CONFIGAUX_ELM_APGATEWAY, AC_STR_CONFIG_GATEWAY);
+  input(AUTOCONNECT_CONFIGAUX_ELM_APNETMASK, AC_STR_PAGESTATS_SUBNETMASK);
+  heading("sep2", AC_STR_PAGELABEL_CPCONTROL);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_AUTORISE, AC_STR_PAGECONFIG_AUTOPOPUP);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_IMMEDIATESTART, AC_STR_PAGECONFIG_IMMEDIATESTART);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_RETAINPORTAL, AC_STR_PAGECONFIG_RETAINPORTAL);
+  input(AUTOCONNECT_CONFIGAUX_ELM_PORTALTIMEOUT, AC_STR_PAGECONFIG_CPTIMEOUT);
+  heading("sep3", AC_STR_PAGELABEL_CONNECTIONCONTROL);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_PRINCIPLE, AC_STR_PAGECONFIG_PRINCIPLE);
+  input(AUTOCONNECT_CONFIGAUX_ELM_MINRSSI, AC_STR_PAGECONFIG_MINRSSI);
+  input(AUTOCONNECT_CONFIGAUX_ELM_BEGINTIMEOUT, AC_STR_PAGECONFIG_BEGINTIMEOUT);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_AUTORECONNECT, AC_STR_PAGECONFIG_AUTORECONNECT);
+  input(AUTOCONNECT_CONFIGAUX_ELM_RECONNECTINT, AC_STR_PAGECONFIG_RECONNECTINTERVAL);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_AUTOSAVE, AC_STR_PAGECONFIG_SAVECREDENTIAL);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_AUTORESTART, AC_STR_PAGECONFIG_AUTORESTART);
+  heading("sep4", AC_STR_PAGELABEL_STATIONSETTINGS);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_PRESERVEAPMODE, AC_STR_PAGECONFIG_PRESERVEAPMODE);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_ENABLEDHCP, AC_STR_PAGECONFIG_ENABLEDHCP);
+  input(AUTOCONNECT_CONFIGAUX_ELM_STAIP, AC_STR_CONFIG_IPADDRESS);
+  input(AUTOCONNECT_CONFIGAUX_ELM_STAGATEWAY, AC_STR_CONFIG_GATEWAY);
+  input(AUTOCONNECT_CONFIGAUX_ELM_STANETMASK, AC_STR_PAGESTATS_SUBNETMASK);
+  input(AUTOCONNECT_CONFIGAUX_ELM_PRIMARYDNS, AC_STR_PAGECONFIG_PRIMARYDNS);
+  input(AUTOCONNECT_CONFIGAUX_ELM_SECONDARYDNS, AC_STR_PAGECONFIG_SECONDARYDNS);
+  input(AUTOCONNECT_CONFIGAUX_ELM_HOSTNAME, AC_STR_PAGECONFIG_HOSTNAME);
+  input(AUTOCONNECT_CONFIGAUX_ELM_HOMEURI, AC_STR_PAGECONFIG_HOMEURI);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_BOOTURI, AC_STR_PAGECONFIG_ONBOOTURI);
+  heading("sep5", AC_STR_PAGELABEL_AUTHSETTINGS);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_AUTH, AC_STR_PAGECONFIG_AUTHENTICATION);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_AUTHSCOPE, AC_STR_PAGECONFIG_AUTHSCOPE);
+  input(AUTOCONNECT_CONFIGAUX_ELM_USER, AC_STR_PAGECONFIG_USERNAME);
+  input(AUTOCONNECT_CONFIGAUX_ELM_PASSWORD, AC_STR_PAGECONFIG_PASSWORD);
+  heading("sep6", AC_STR_PAGELABEL_MISCELLANEOUS);
+  input(AUTOCONNECT_CONFIGAUX_ELM_MENUTITLE, AC_STR_PAGECONFIG_MENUTITLE);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_MENU, AC_STR_PAGECONFIG_MENUSUSE);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_MENUCONFIGNEW, AC_STR_MENU_CONFIGNEW);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_MENUOPENSSIDS, AC_STR_MENU_OPENSSIDS);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_MENUDISCONNECT, AC_STR_MENU_DISCONNECT);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_MENURESET, AC_STR_MENU_RESET);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_MENUHOME, AC_STR_MENU_HOME);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_MENUUPDATE, AC_STR_MENULABEL_UPDATE);
+  caption(AUTOCONNECT_CONFIGAUX_ELM_TICKER, AC_STR_PAGECONFIG_TICKER);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_TICKER, AC_STR_PAGECONFIG_TICKERON);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_TICKERON, AC_STR_PAGECONFIG_TICKERACTIVE);
+  input(AUTOCONNECT_CONFIGAUX_ELM_TICKERPORT, AC_STR_PAGECONFIG_TICKERPORT);
+  checkbox(AUTOCONNECT_CONFIGAUX_ELM_BUILTINOTA, AC_STR_PAGECONFIG_BUILTINOTA);
+  input(AUTOCONNECT_CONFIGAUX_ELM_BOUNDARYOFFSET, AC_STR_PAGECONFIG_BOUNDARY);
+  me["apply"].value = AutoConnectStrings::fstr(AC_STR_PAGECONFIG_APPLY);
+}
+
 /**
  * Loads the current settings from AutoConnectConfig to each element of
  * the AutoConnectConfigAux page.
@@ -715,10 +813,16 @@ void AutoConnectConfigAux::_join(AutoConnectExt<AutoConnectConfigExt>& ac) {
 String AutoConnectConfigAux::_settings(AutoConnectAux& me, PageArgument& arg) {
   String  ps;
 
+  _applyLabels();
   if (arg.hasArg(AUTOCONNECT_AUXURI_PARAM)) {
     if (arg.arg(AUTOCONNECT_AUXURI_PARAM) == _indicateUri(arg)) {
-      _saveSettings(me);
-      ps = String(FPSTR(_rdlg));
+      // The reboot dialog appears only for the changes that cannot be
+      // applied on the fly.
+      const AC_SETTINGS_t rc = _saveSettings(me);
+      if (rc == AC_SETTINGS_REBOOT)
+        ps = String(FPSTR(_rdlg));
+      else if (rc == AC_SETTINGS_REJECTED)
+        ps = String(FPSTR(_odlg));
     }
   }
   else
@@ -727,19 +831,14 @@ String AutoConnectConfigAux::_settings(AutoConnectAux& me, PageArgument& arg) {
 }
 
 /**
- * Loads the persisted settings from AUTOCONNECT_CONFIGAUX_FILE into the
- * current AutoConnectConfig.
+ * Loads the persisted settings into the current AutoConnectConfig.
+ * It reads the binary snapshot and does not load the page elements.
+ * If only AUTOCONNECT_CONFIGAUX_FILE in JSON exists, it is restored
+ * through the page elements and converted to the snapshot.
  */
 void AutoConnectConfigAux::_loadSettings(void) {
   bool  bc;
-  fs::File  cf;
-
-  if (!loadElement(FPSTR(_ui), String(), 10400)) {
-    AC_DBG("Failed to load AutoConnectConfigAux\n");
-    return;
-  }
 
-  _retrieveSettings(*this);
 #if defined(ARDUINO_ARCH_ESP8266)
   FSInfo  info;
   if (AUTOCONNECT_APPLIED_FILESYSTEM.info(info))
@@ -754,57 +853,422 @@ void AutoConnectConfigAux::_loadSettings(void) {
 #endif
   if (!_fn.startsWith(String("/")))
     _fn = String("/") + _fn;
+  if (!bc) {
+    AC_DBG("Settings unavailable, assumes default assignments\n");
+    return;
+  }
+
+  // Restore from the binary snapshot without the page elements.
+  AutoConnectConfigExt  acConfig(*_ac->getConfigSnapshot());
+  if (_readSnapshot(acConfig)) {
+    _ac->config(acConfig);
+    AC_DBG("_apConfig restored\n");
+    return;
+  }
+
+  // Migrate the JSON settings saved by the former version. It requires
+  // the page elements to parse.
   AC_DBG("Settings %s ", _fn.c_str());
-  if (bc) {
-    bc = false;
-    if (AUTOCONNECT_APPLIED_FILESYSTEM.exists(_fn)) {
-      fs::File  cf = AUTOCONNECT_APPLIED_FILESYSTEM.open(_fn, "r");
-      if (cf) {
-        size_t fs = ((cf.size() + 256) / 256) * 256;
-        AC_DBG_DUMB("Json buffer %u \n", fs);
-        if (loadElement(cf, String(), fs)) {
-          _restoreSettings(*this);
-          bc = true;
-        }
-        else {
-          AC_DBG("fails to load");
+  bc = false;
+  if (AUTOCONNECT_APPLIED_FILESYSTEM.exists(_fn)) {
+    fs::File  cf = AUTOCONNECT_APPLIED_FILESYSTEM.open(_fn, "r");
+    if (cf) {
+      size_t fs = ((cf.size() + 256) / 256) * 256;
+      AC_DBG_DUMB("Json buffer %u \n", fs);
+      if (_materialize() && loadElement(cf, String(), fs)) {
+        _restoreSettings(*this);
+        _persisted = AUTOCONNECT_CONFIGAUX_ALLFIELDS;
+        // The settings that the snapshot cannot hold stay in the JSON.
+        if (_oversizeSettings(*_ac->getConfigSnapshot())) {
+          AC_DBG_DUMB("has too long strings to convert ");
         }
-        cf.close();
+        else
+          _writeSnapshot(*_ac->getConfigSnapshot(), _persisted);
+        bc = true;
       }
       else {
-        AC_DBG_DUMB("fails to open");
+        AC_DBG("fails to load");
       }
+      cf.close();
     }
     else {
-      AC_DBG_DUMB("not exists");
+      AC_DBG_DUMB("fails to open");
     }
   }
+  else {
+    AC_DBG_DUMB("not exists");
+  }
   if (!bc) {
     AC_DBG_DUMB(", assumes default assignments\n");
   }
 }
 
 /**
- * Persist by outputting the current AutoConnectConnect setting to
- * AUTOCONNECT_CONFIGAUX_FILE.
+ * Returns the file name of the binary settings snapshot. It replaces
+ * the extension of the settings file name.
+ * @return The snapshot file name.
+ */
+String AutoConnectConfigAux::_snapshotFile(void) const {
+  int ext = _fn.lastIndexOf('.');
+  return (ext > 0 ? _fn.substring(0, ext) : _fn) + String(F(AUTOCONNECT_CONFIGAUX_SNAPSHOT_EXT));
+}
+
+/**
+ * Read the binary settings snapshot and apply the contained fields
+ * to the given AutoConnectConfig. Fields not contained in the snapshot
+ * remain as they are, and the contained fields are remembered as
+ * persisted.
+ * @param  acConfig  AutoConnectConfig to be updated
+ * @return true   The snapshot is valid and applied.
+ * @return false  The snapshot does not exist or is broken.
+ */
+bool AutoConnectConfigAux::_readSnapshot(AutoConnectConfigExt& acConfig) {
+  const String  sn = _snapshotFile();
+  if (!AUTOCONNECT_APPLIED_FILESYSTEM.exists(sn))
+    return false;
+
+  bool  rc = false;
+  fs::File  sf = AUTOCONNECT_APPLIED_FILESYSTEM.open(sn, "r");
+  if (sf) {
+    const size_t  size = sf.size();
+    if (size >= AUTOCONNECT_CONFIGAUX_SNAPSHOT_HEADER + sizeof(uint32_t) && size <= AUTOCONNECT_CONFIGAUX_SNAPSHOT_MAXSIZE) {
+      std::vector<uint8_t>  buf(size);
+      if (sf.read(buf.data(), size) == size) {
+        const size_t  bodyLen = buf[6] | (buf[7] << 8);
+        const uint8_t*  cp = &buf[size - sizeof(uint32_t)];
+        const uint32_t  crc = cp[0] | (cp[1] << 8) | (cp[2] << 16) | ((uint32_t)cp[3] << 24);
+        if (memcmp_P(buf.data(), PSTR(AUTOCONNECT_CONFIGAUX_SNAPSHOT_MAGIC), 4))
+          AC_DBG("%s unknown format\n", sn.c_str());
+        else if (buf[4] > AUTOCONNECT_CONFIGAUX_SNAPSHOT_VERSION)
+          AC_DBG("%s version %u unsupported\n", sn.c_str(), buf[4]);
+        else if (AUTOCONNECT_CONFIGAUX_SNAPSHOT_HEADER + bodyLen + sizeof(uint32_t) != size)
+          AC_DBG("%s length mismatch\n", sn.c_str());
+        else if (_crc32(0, buf.data(), size - sizeof(uint32_t)) != crc)
+          AC_DBG("%s CRC error\n", sn.c_str());
+        else
+          rc = _decodeSettings(&buf[AUTOCONNECT_CONFIGAUX_SNAPSHOT_HEADER], bodyLen, acConfig, &_persisted);
+      }
+    }
+    sf.close();
+  }
+  AC_DBG("Snapshot %s %s\n", sn.c_str(), rc ? "loaded" : "ignored");
+  return rc;
+}
+
+/**
+ * Write the AutoConnectConfig as the binary settings snapshot.
+ * @param  acConfig  AutoConnectConfig to be saved
+ * @param  fields    Bit mask of AC_CFGID_t of the fields to be saved
+ * @return true   Saved.
+ * @return false  Could not write the file.
+ */
+bool AutoConnectConfigAux::_writeSnapshot(const AutoConnectConfigExt& acConfig, const uint64_t fields) {
+  std::vector<uint8_t>  buf;
+  buf.reserve(384);
+  const char* magic = AUTOCONNECT_CONFIGAUX_SNAPSHOT_MAGIC;
+  buf.insert(buf.end(), magic, magic + 4);
+  buf.push_back(AUTOCONNECT_CONFIGAUX_SNAPSHOT_VERSION);
+  buf.push_back(0);
+  buf.push_back(0);
+  buf.push_back(0);
+  _encodeSettings(acConfig, buf, fields);
+  const size_t  bodyLen = buf.size() - AUTOCONNECT_CONFIGAUX_SNAPSHOT_HEADER;
+  buf[6] = static_cast<uint8_t>(bodyLen);
+  buf[7] = static_cast<uint8_t>(bodyLen >> 8);
+  const uint32_t  crc = _crc32(0, buf.data(), buf.size());
+  for (uint8_t n = 0; n < sizeof(uint32_t); n++)
+    buf.push_back(static_cast<uint8_t>(crc >> (n * 8)));
+
+  const String  sn = _snapshotFile();
+  bool  rc = false;
+  fs::File  sf = AUTOCONNECT_APPLIED_FILESYSTEM.open(sn, "w");
+  if (sf) {
+    rc = sf.write(buf.data(), buf.size()) == buf.size();
+    sf.close();
+  }
+  AC_DBG("Snapshot %s %u bytes %s\n", sn.c_str(), buf.size(), rc ? "saved" : "failed");
+  return rc;
+}
+
+// Each field of AutoConnectConfig persisted by the snapshot. The same
+// sequence serves both the encoding and the decoding.
+template<typename C, typename V>
+void AutoConnectConfigAux::_visitSettings(C& acConfig, V& visitor) {
+  visitor.field(AutoConnectConfigAux::AC_CFGID_APID, acConfig.apid);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_PSK, acConfig.psk);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_CHANNEL, acConfig.channel);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_HIDDEN, acConfig.hidden);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_APIP, acConfig.apip);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_GATEWAY, acConfig.gateway);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_NETMASK, acConfig.netmask);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_AUTORISE, acConfig.autoRise);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_IMMEDIATESTART, acConfig.immediateStart);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_RETAINPORTAL, acConfig.retainPortal);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_PORTALTIMEOUT, acConfig.portalTimeout);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_PRINCIPLE, acConfig.principle);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_MINRSSI, acConfig.minRSSI);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_BEGINTIMEOUT, acConfig.beginTimeout);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_AUTORECONNECT, acConfig.autoReconnect);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_RECONNECTINTERVAL, acConfig.reconnectInterval);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_AUTOSAVE, acConfig.autoSave);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_AUTORESET, acConfig.autoReset);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_PRESERVEAPMODE, acConfig.preserveAPMode);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_STAIP, acConfig.staip);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_STAGATEWAY, acConfig.staGateway);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_STANETMASK, acConfig.staNetmask);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_DNS1, acConfig.dns1);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_DNS2, acConfig.dns2);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_HOSTNAME, acConfig.hostName);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_HOMEURI, acConfig.homeUri);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_BOOTURI, acConfig.bootUri);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_AUTH, acConfig.auth);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_AUTHSCOPE, acConfig.authScope);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_USERNAME, acConfig.username);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_PASSWORD, acConfig.password);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_TITLE, acConfig.title);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_MENUITEMS, acConfig.menuItems);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_TICKER, acConfig.ticker);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_TICKERON, acConfig.tickerOn);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_TICKERPORT, acConfig.tickerPort);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_OTA, acConfig.ota);
+  visitor.field(AutoConnectConfigAux::AC_CFGID_BOUNDARYOFFSET, acConfig.boundaryOffset);
+}
+
+// Visitor to append each field as a record.
+class AutoConnectConfigAuxEncoder {
+ public:
+  AutoConnectConfigAuxEncoder(std::vector<uint8_t>& buf, const uint64_t fields) : _buf(buf), _fields(fields) {}
+  // A string longer than a record can hold must have been rejected by
+  // _oversizeSettings, it would be truncated here.
+  void field(const uint8_t id, const String& v) {
+    _record(id, reinterpret_cast<const uint8_t*>(v.c_str()), std::min(v.length(), static_cast<unsigned int>(UINT8_MAX)));
+  }
+  void field(const uint8_t id, const IPAddress& v) {
+    uint8_t addr[4] = { v[0], v[1], v[2], v[3] };
+    _record(id, addr, sizeof(addr));
+  }
+  void field(const uint8_t id, const bool v) {
+    uint8_t b = v ? 1 : 0;
+    _record(id, &b, sizeof(b));
+  }
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type field(const uint8_t id, const T& v) {
+    const int32_t  n = static_cast<int32_t>(v);
+    uint8_t le[sizeof(int32_t)];
+    for (uint8_t i = 0; i < sizeof(le); i++)
+      le[i] = static_cast<uint8_t>(n >> (i * 8));
+    _record(id, le, sizeof(le));
+  }
+
+ protected:
+  void _record(const uint8_t id, const uint8_t* data, const size_t len) {
+    if (!(_fields & (1ULL << id)))
+      return;
+    _buf.push_back(id);
+    _buf.push_back(static_cast<uint8_t>(len));
+    _buf.insert(_buf.end(), data, data + len);
+  }
+  std::vector<uint8_t>& _buf;
+  const uint64_t  _fields;
+};
+
+// Visitor to store the records to the corresponding fields.
+class AutoConnectConfigAuxDecoder {
+ public:
+  AutoConnectConfigAuxDecoder(const uint8_t* buf, const size_t len) : _present(0), _valid(true) {
+    memset(_data, 0, sizeof(_data));
+    memset(_len, 0, sizeof(_len));
+    size_t  pos = 0;
+    while (pos + 2 <= len) {
+      const uint8_t id = buf[pos];
+      const uint8_t rl = buf[pos + 1];
+      if (pos + 2 + rl > len)
+        break;
+      if (id < AutoConnectConfigAux::AC_CFGID_END) {
+        _data[id] = &buf[pos + 2];
+        _len[id] = rl;
+        _present |= 1ULL << id;
+      }
+      pos += 2 + rl;
+    }
+    _valid = pos == len;
+  }
+  bool valid(void) const { return _valid; }
+  uint64_t  present(void) const { return _present; }
+  void field(const uint8_t id, String& v) {
+    if (_data[id]) {
+      char  str[UINT8_MAX + 1];
+      memcpy(str, _data[id], _len[id]);
+      str[_len[id]] = '\0';
+      v = String(str);
+    }
+  }
+  void field(const uint8_t id, IPAddress& v) {
+    if (_data[id] && _len[id] == 4)
+      v = IPAddress(_data[id][0], _data[id][1], _data[id][2], _data[id][3]);
+  }
+  void field(const uint8_t id, bool& v) {
+    if (_data[id] && _len[id] == 1)
+      v = _data[id][0] != 0;
+  }
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type field(const uint8_t id, T& v) {
+    if (_data[id] && _len[id] == sizeof(int32_t)) {
+      uint32_t  n = 0;
+      for (uint8_t i = 0; i < sizeof(int32_t); i++)
+        n |= static_cast<uint32_t>(_data[id][i]) << (i * 8);
+      v = static_cast<T>(static_cast<int32_t>(n));
+    }
+  }
+
+ protected:
+  const uint8_t*  _data[AutoConnectConfigAux::AC_CFGID_END];
+  uint8_t _len[AutoConnectConfigAux::AC_CFGID_END];
+  uint64_t  _present;
+  bool    _valid;
+};
+
+// Visitor to find the string fields that exceed the length of a record.
+class AutoConnectConfigAuxLimit {
+ public:
+  AutoConnectConfigAuxLimit() : _oversize(0) {}
+  uint64_t  oversize(void) const { return _oversize; }
+  void field(const uint8_t id, const String& v) {
+    if (v.length() > UINT8_MAX)
+      _oversize |= 1ULL << id;
+  }
+  template<typename T>
+  void field(const uint8_t id, const T& v) {
+    AC_UNUSED(id);
+    AC_UNUSED(v);
+  }
+
+ protected:
+  uint64_t  _oversize;
+};
+
+/**
+ * Encode the fields of AutoConnectConfig as the records of the snapshot.
+ * @param  acConfig  AutoConnectConfig
+ * @param  buf       The records are appended to the buf
+ * @param  fields    Bit mask of AC_CFGID_t of the fields to be encoded
+ */
+void AutoConnectConfigAux::_encodeSettings(const AutoConnectConfigExt& acConfig, std::vector<uint8_t>& buf, const uint64_t fields) {
+  AutoConnectConfigAuxEncoder encoder(buf, fields);
+  _visitSettings(acConfig, encoder);
+}
+
+/**
+ * Decode the records of the snapshot to the fields of AutoConnectConfig.
+ * @param  buf       The records
+ * @param  len       Length of the records
+ * @param  acConfig  AutoConnectConfig to be stored
+ * @param  present   Receives the bit mask of AC_CFGID_t of the decoded fields
+ * @return true   Decoded.
+ * @return false  The records are broken, acConfig is not changed.
+ */
+bool AutoConnectConfigAux::_decodeSettings(const uint8_t* buf, const size_t len, AutoConnectConfigExt& acConfig, uint64_t* present) {
+  AutoConnectConfigAuxDecoder decoder(buf, len);
+  if (!decoder.valid())
+    return false;
+  _visitSettings(acConfig, decoder);
+  if (present)
+    *present = decoder.present();
+  return true;
+}
+
+/**
+ * Compare two AutoConnectConfigs field by field. Both are encoded in
+ * the snapshot format that represents each field canonically, and the
+ * records with the same ID are compared.
+ * @param  a  AutoConnectConfig
+ * @param  b  AutoConnectConfig
+ * @return Bit mask of AC_CFGID_t of the different fields.
+ */
+uint64_t AutoConnectConfigAux::_diffSettings(const AutoConnectConfigExt& a, const AutoConnectConfigExt& b) {
+  std::vector<uint8_t>  ea, eb;
+  ea.reserve(384);
+  eb.reserve(384);
+  _encodeSettings(a, ea, AUTOCONNECT_CONFIGAUX_ALLFIELDS);
+  _encodeSettings(b, eb, AUTOCONNECT_CONFIGAUX_ALLFIELDS);
+
+  // The records appear in the same order of the IDs on both sides.
+  uint64_t  diff = 0;
+  size_t  pa = 0, pb = 0;
+  while (pa + 2 <= ea.size() && pb + 2 <= eb.size()) {
+    const uint8_t id = ea[pa];
+    const uint8_t la = ea[pa + 1];
+    const uint8_t lb = eb[pb + 1];
+    if (la != lb || memcmp(&ea[pa + 2], &eb[pb + 2], la))
+      diff |= 1ULL << id;
+    pa += 2 + la;
+    pb += 2 + lb;
+  }
+  return diff;
+}
+
+/**
+ * Find the string fields that the snapshot cannot hold. A record holds
+ * up to 255 bytes, and a longer value is rejected instead of being
+ * truncated.
+ * @param  acConfig  AutoConnectConfig
+ * @return Bit mask of AC_CFGID_t of the oversized fields.
+ */
+uint64_t AutoConnectConfigAux::_oversizeSettings(const AutoConnectConfigExt& acConfig) {
+  AutoConnectConfigAuxLimit limit;
+  _visitSettings(acConfig, limit);
+  return limit.oversize();
+}
+
+/**
+ * Calculate CRC-32 (IEEE 802.3) without the lookup table.
+ * @param  crc  CRC of the preceding data, 0 at the start
+ * @param  buf  Data
+ * @param  len  Length of the data
+ * @return CRC-32
+ */
+uint32_t AutoConnectConfigAux::_crc32(uint32_t crc, const uint8_t* buf, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (uint8_t k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+/**
+ * Reflect the settings entered on the page to the current
+ * AutoConnectConfig and persist them as the binary snapshot.
+ * Only the fields that differ from the current configuration are
+ * published and added to the snapshot. The fields that are evaluated
+ * at each request or at each handleClient, such as the menu, the
+ * ticker, the authentication and the timeouts, take effect immediately.
+ * The settings are rejected as a whole if a string is too long for the
+ * snapshot.
  * @param me  AutoConnectAux
+ * @return The result of the settings.
  */
-void AutoConnectConfigAux::_saveSettings(AutoConnectAux& me) {
-  AC_DBG("Settings %s ", _fn.c_str());
-  fs::File  cf = AUTOCONNECT_APPLIED_FILESYSTEM.open(_fn, "w");
-  if (cf) {
-    std::vector<String> elms;
-    std::transform(std::begin(_elmNames), std::end(_elmNames), std::back_inserter(elms), [](PGM_P elmName){
-      return String(FPSTR(elmName));
-    });
-    saveElement(cf, elms);
-    cf.close();
-    AC_DBG_DUMB("saved\n");
-    _restoreSettings(reinterpret_cast<AutoConnectConfigAux&>(me));
+AutoConnectConfigAux::AC_SETTINGS_t AutoConnectConfigAux::_saveSettings(AutoConnectAux& me) {
+  auto  current = _ac->getConfigSnapshot();
+  AutoConnectConfigExt  acConfig(*current);
+  _composeSettings(reinterpret_cast<AutoConnectConfigAux&>(me), acConfig);
+  const uint64_t  oversize = _oversizeSettings(acConfig);
+  if (oversize) {
+    AC_DBG("Settings rejected, too long 0x%08" PRIx32 "%08" PRIx32 "\n", static_cast<uint32_t>(oversize >> 32), static_cast<uint32_t>(oversize));
+    return AC_SETTINGS_REJECTED;
   }
-  else {
-    AC_DBG_DUMB("fails to save\n");
+  const uint64_t  diff = _diffSettings(*current, acConfig);
+  if (!diff) {
+    AC_DBG("Settings unchanged\n");
+    return AC_SETTINGS_UNCHANGED;
   }
+
+  _ac->config(acConfig);
+  _persisted |= diff;
+  _writeSnapshot(acConfig, _persisted);
+  AC_DBG("Settings changed 0x%08" PRIx32 "%08" PRIx32 "\n", static_cast<uint32_t>(diff >> 32), static_cast<uint32_t>(diff));
+  return diff & AUTOCONNECT_CONFIGAUX_REBOOTFIELDS ? AC_SETTINGS_REBOOT : AC_SETTINGS_APPLIED;
 }
 
 /**
@@ -813,8 +1277,21 @@ void AutoConnectConfigAux::_saveSettings(AutoConnectAux& me) {
  * @param me  AutoConnectAux (That is, AutoConnectConfigAux itself)
  */
 void AutoConnectConfigAux::_restoreSettings(AutoConnectConfigAux& me) {
+  // Build a new configuration from the latest snapshot and publish it.
+  AutoConnectConfigExt  acConfig(*_ac->getConfigSnapshot());
+  _composeSettings(me, acConfig);
+  _ac->config(acConfig);
+  AC_DBG("_apConfig restored\n");
+}
+
+/**
+ * Store the values of the elements of AutoConnectConfigAux to the
+ * given AutoConnectConfig.
+ * @param me        AutoConnectAux (That is, AutoConnectConfigAux itself)
+ * @param acConfig  AutoConnectConfig to be stored
+ */
+void AutoConnectConfigAux::_composeSettings(AutoConnectConfigAux& me, AutoConnectConfigExt& acConfig) {
   IPAddress univ;
-  AutoConnectConfigExt& acConfig = _ac->getConfig();
   acConfig.apid = me[AUTOCONNECT_CONFIGAUX_ELM_SSID].as<AutoConnectInput>().value;
   acConfig.psk = me[AUTOCONNECT_CONFIGAUX_ELM_PSK].as<AutoConnectInput>().value;
   acConfig.channel = me[AUTOCONNECT_CONFIGAUX_ELM_CHANNEL].as<AutoConnectInput>().value.toInt();
@@ -896,7 +1373,6 @@ void AutoConnectConfigAux::_restoreSettings(AutoConnectConfigAux& me) {
   acConfig.tickerPort = me[AUTOCONNECT_CONFIGAUX_ELM_TICKERPORT].as<AutoConnectInput>().value.toInt();
   acConfig.ota = me[AUTOCONNECT_CONFIGAUX_ELM_BUILTINOTA].as<AutoConnectCheckbox>().checked ? AC_OTA_BUILTIN : AC_OTA_EXTRA;
   acConfig.boundaryOffset = me[AUTOCONNECT_CONFIGAUX_ELM_BOUNDARYOFFSET].as<AutoConnectInput>().value.toInt();
-  AC_DBG("_apConfig restored\n");
 }
 
 /**
@@ -905,7 +1381,8 @@ void AutoConnectConfigAux::_restoreSettings(AutoConnectConfigAux& me) {
  * @param me  AutoConnectAux (That is, AutoConnectConfigAux itself)
  */
 void AutoConnectConfigAux::_retrieveSettings(AutoConnectConfigAux& me) {
-  AutoConnectConfigExt&  acConfig = _ac->getConfig();
+  auto  snapshot = _ac->getConfigSnapshot();
+  const AutoConnectConfigExt&  acConfig = *snapshot;
   me[AUTOCONNECT_CONFIGAUX_ELM_SSID].as<AutoConnectInput>().value = acConfig.apid;
   me[AUTOCONNECT_CONFIGAUX_ELM_PSK].as<AutoConnectInput>().value = acConfig.psk;
   me[AUTOCONNECT_CONFIGAUX_ELM_CHANNEL].as<AutoConnectInput>().value = String(acConfig.channel);
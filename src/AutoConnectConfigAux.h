@@ -31,12 +31,19 @@
 // Config item from the AutoConnect menu, then this page will load the
 // current settings and allows you to change any item. The applied 
 // settings will be reflected immediately in AutoConnect without calling
-// AutoConnect::config.
-// The AutoConnectConfigAux handler will check if acconfig.json exists 
-// on the default file system when you visit its custom web page. The
-// acconfig.json file is the JSON-represented persistence data for the 
-// AutoConnectConfig instance saved by the APPLY button on the 
-// AutoConnectConfigAux page.
+// AutoConnect::config. Only the fields that differ from the current
+// settings are applied, and the reboot is requested only when the
+// changes contain a field that takes effect at AutoConnect::begin,
+// such as the SoftAP and the static IP configurations.
+// The settings saved by the APPLY button on the AutoConnectConfigAux
+// page are persisted to acconfig.bin on the default file system as a
+// compact binary snapshot with a CRC. The snapshot holds only the
+// fields that have been changed on the page, and AutoConnect::begin
+// restores them from it without loading the page. The page elements
+// are loaded only when the page is visited. An acconfig.json saved by
+// the former version is read once and converted to acconfig.bin.
+// A string field of the snapshot holds up to 255 bytes, and the page
+// rejects the settings that contain a longer one.
 // To activate the AutoConnectConfigAux, follow the next procedure with
 // your sketch:
 // 1. Uncomment #define AC_USE_CONFIGAUX in AutoConnectDefs.h
@@ -56,25 +63,96 @@
 //   portal.handleClient();
 // }
 #include <type_traits>
+#include <vector>
 #include "AutoConnectAux.h"
 #include "AutoConnectLabels.h"
 
 class AutoConnectConfigAux : public AutoConnectAux {
  public:
-  explicit AutoConnectConfigAux(const char* uri = AUTOCONNECT_URI_CONFIGAUX, const char* title = AUTOCONNECT_MENULABEL_ACCONFIG, const char* fileName = AUTOCONNECT_CONFIGAUX_FILE) : AutoConnectAux(uri, title), _fn(String(fileName)) {
+  explicit AutoConnectConfigAux(const char* uri = AUTOCONNECT_URI_CONFIGAUX, const char* title = AUTOCONNECT_MENULABEL_ACCONFIG, const char* fileName = AUTOCONNECT_CONFIGAUX_FILE) : AutoConnectAux(uri, title), _fn(String(fileName)), _persisted(0), _materialized(false) {
     static_assert(std::is_same<AutoConnectElement, AutoConnectElementJson>::value, "AUTOCONNECT_USE_JSON must be defined to activate AutoConnectConfigAux");
   }
   ~AutoConnectConfigAux() {}
 
+  // Field IDs of the binary settings snapshot. The IDs are persisted,
+  // never renumber them and append a new field just before the END.
+  // The changed fields are tracked as a 64-bit mask of the IDs.
+  typedef enum {
+    AC_CFGID_NONE = 0,
+    AC_CFGID_APID,
+    AC_CFGID_PSK,
+    AC_CFGID_CHANNEL,
+    AC_CFGID_HIDDEN,
+    AC_CFGID_APIP,
+    AC_CFGID_GATEWAY,
+    AC_CFGID_NETMASK,
+    AC_CFGID_AUTORISE,
+    AC_CFGID_IMMEDIATESTART,
+    AC_CFGID_RETAINPORTAL,
+    AC_CFGID_PORTALTIMEOUT,
+    AC_CFGID_PRINCIPLE,
+    AC_CFGID_MINRSSI,
+    AC_CFGID_BEGINTIMEOUT,
+    AC_CFGID_AUTORECONNECT,
+    AC_CFGID_RECONNECTINTERVAL,
+    AC_CFGID_AUTOSAVE,
+    AC_CFGID_AUTORESET,
+    AC_CFGID_PRESERVEAPMODE,
+    AC_CFGID_STAIP,
+    AC_CFGID_STAGATEWAY,
+    AC_CFGID_STANETMASK,
+    AC_CFGID_DNS1,
+    AC_CFGID_DNS2,
+    AC_CFGID_HOSTNAME,
+    AC_CFGID_HOMEURI,
+    AC_CFGID_BOOTURI,
+    AC_CFGID_AUTH,
+    AC_CFGID_AUTHSCOPE,
+    AC_CFGID_USERNAME,
+    AC_CFGID_PASSWORD,
+    AC_CFGID_TITLE,
+    AC_CFGID_MENUITEMS,
+    AC_CFGID_TICKER,
+    AC_CFGID_TICKERON,
+    AC_CFGID_TICKERPORT,
+    AC_CFGID_OTA,
+    AC_CFGID_BOUNDARYOFFSET,
+    AC_CFGID_END
+  } AC_CFGID_t;
+
  protected:
+  // Results of the settings applied on the page.
+  typedef enum {
+    AC_SETTINGS_UNCHANGED,  /**< No field has been changed */
+    AC_SETTINGS_APPLIED,    /**< Applied without a reboot */
+    AC_SETTINGS_REBOOT,     /**< Applied, a reboot is needed */
+    AC_SETTINGS_REJECTED    /**< A string is too long to persist */
+  } AC_SETTINGS_t;
+
   void  _join(AutoConnectExt<AutoConnectConfigExt>& ac) override;
+  AutoConnectPageElement*  _setupPage(const String& uri) override;
+  void  _applyLabels(void);
   void  _loadSettings(void);
+  bool  _materialize(void);
+  bool  _readSnapshot(AutoConnectConfigExt& acConfig);
   void  _retrieveSettings(AutoConnectConfigAux& me);
+  void  _composeSettings(AutoConnectConfigAux& me, AutoConnectConfigExt& acConfig);
   void  _restoreSettings(AutoConnectConfigAux& me);
-  void  _saveSettings(AutoConnectAux& me);
+  AC_SETTINGS_t _saveSettings(AutoConnectAux& me);
   String  _settings(AutoConnectAux& me, PageArgument& arg);
+  String  _snapshotFile(void) const;
+  bool  _writeSnapshot(const AutoConnectConfigExt& acConfig, const uint64_t fields);
+  static void _encodeSettings(const AutoConnectConfigExt& acConfig, std::vector<uint8_t>& buf, const uint64_t fields);
+  static bool _decodeSettings(const uint8_t* buf, const size_t len, AutoConnectConfigExt& acConfig, uint64_t* present = nullptr);
+  static uint64_t _diffSettings(const AutoConnectConfigExt& a, const AutoConnectConfigExt& b);
+  static uint64_t _oversizeSettings(const AutoConnectConfigExt& acConfig);
+  template<typename C, typename V>
+  static void _visitSettings(C& acConfig, V& visitor);
+  static uint32_t _crc32(uint32_t crc, const uint8_t* buf, size_t len);
 
   String  _fn;              /**< AutoConnectConfig setting file name */
+  uint64_t  _persisted;     /**< Bit mask of AC_CFGID_t of the fields in the snapshot */
+  bool    _materialized;    /**< The elements of the page have been loaded */
 
  private:
   // The names of the AutoConnectElements placed on the Web page that
@@ -129,6 +207,7 @@ class AutoConnectConfigAux : public AutoConnectAux {
   static const char* const _elmNames[] PROGMEM; /**< A collection of the AutoConnectElements placed on the AutoConnectConfigAux page. */
   static const char _ui[] PROGMEM;              /**< Json Document of AutoConnectConfigAux page  */
   static const char _rdlg[] PROGMEM;            /**< Script to prompt the reset dialog */
+  static const char _odlg[] PROGMEM;            /**< Script to alert the rejected settings */
 };
 
 #endif // !AUTOCONNECT_USE_CONFIGAUX
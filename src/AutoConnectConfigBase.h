@@ -49,6 +49,8 @@ class AutoConnectConfigBase {
     preserveIP(false),
     beginTimeout(AUTOCONNECT_TIMEOUT),
     portalTimeout(AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT),
+    keepAlive(AUTOCONNECT_KEEPALIVE_TIMEOUT),
+    keepAliveMax(AUTOCONNECT_KEEPALIVE_MAX),
     menuItems(AC_MENUITEM_CONFIGNEW | AC_MENUITEM_OPENSSIDS | AC_MENUITEM_DISCONNECT | AC_MENUITEM_RESET | AC_MENUITEM_HOME),
     reconnectInterval(0),
     ticker(false),
@@ -92,6 +94,8 @@ class AutoConnectConfigBase {
     preserveIP(false),
     beginTimeout(AUTOCONNECT_TIMEOUT),
     portalTimeout(portalTimeout),
+    keepAlive(AUTOCONNECT_KEEPALIVE_TIMEOUT),
+    keepAliveMax(AUTOCONNECT_KEEPALIVE_MAX),
     menuItems(AC_MENUITEM_CONFIGNEW | AC_MENUITEM_OPENSSIDS | AC_MENUITEM_DISCONNECT | AC_MENUITEM_RESET | AC_MENUITEM_HOME),
     reconnectInterval(0),
     ticker(false),
@@ -135,6 +139,8 @@ class AutoConnectConfigBase {
     preserveIP = o.preserveIP;
     beginTimeout = o.beginTimeout;
     portalTimeout = o.portalTimeout;
+    keepAlive = o.keepAlive;
+    keepAliveMax = o.keepAliveMax;
     menuItems = o.menuItems;
     reconnectInterval = o.reconnectInterval;
     ticker = o.ticker;
@@ -160,7 +166,7 @@ class AutoConnectConfigBase {
   IPAddress netmask;            /**< SoftAP subnet mask */
   String    apid;               /**< SoftAP SSID */
   String    psk;                /**< SoftAP password */
-  uint8_t   channel;            /**< SoftAP used wifi channel */
+  uint8_t   channel;            /**< SoftAP used wifi channel, 0 is the least congested */
   uint8_t   hidden;             /**< SoftAP SSID hidden */
   int16_t   minRSSI;            /**< Lowest WiFi signal strength (RSSI) that can be connected. */
   AC_SAVECREDENTIAL_t  autoSave;  /**< Auto save credential */
@@ -177,6 +183,8 @@ class AutoConnectConfigBase {
   bool      preserveIP;         /**< IP configurations in AutoConnectConfig take precedence over the IP information contained in the stored credentials. */
   unsigned long beginTimeout;   /**< Timeout value for WiFi.begin */
   unsigned long portalTimeout;  /**< Timeout value for stay in the captive portal */
+  uint16_t  keepAlive;          /**< Idle timeout of the persistent connection [ms], 0 leaves it to the WebServer */
+  uint8_t   keepAliveMax;       /**< Maximum number of requests served over one persistent connection */
   uint16_t  menuItems;          /**< A compound value of the menu items to be attached */
   uint8_t   reconnectInterval;  /**< Auto-reconnect attempt interval uint */
   bool      ticker;             /**< Drives LED flicker according to WiFi connection status. */
@@ -15,6 +15,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <atomic>
 #include <mutex>
 #if defined(ARDUINO_ARCH_ESP8266)
 #include <ESP8266WiFi.h>
@@ -33,11 +34,35 @@ using WebServer = ESP8266WebServer;
 #include "AutoConnectDefs.h"
 #include "AutoConnectTypes.h"
 #include "AutoConnectPage.h"
+#include "AutoConnectPageElement.h"
+#include "AutoConnectStrings.h"
 #include "AutoConnectCredential.h"
 #include "AutoConnectTicker.h"
 #include "AutoConnectConfigBase.h"
 #include "AutoConnectError.h"
 #include "AutoConnectRAII.h"
+#include "AutoConnectQueue.h"
+#include "AutoConnectChannel.h"
+#include "AutoConnectRetry.h"
+#include "AutoConnectSlice.h"
+#include "AutoConnectSeek.h"
+#include "AutoConnectClients.h"
+#include "AutoConnectScanList.h"
+#include "AutoConnectSignal.h"
+#ifdef AUTOCONNECT_USE_AUTHSESSION
+#include "AutoConnectAuthSession.h"
+#endif
+#ifdef AUTOCONNECT_USE_LANGPACK
+#include "AutoConnectLangPack.h"
+#endif
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_ASSETS)
+#include "AutoConnectDeflate.h"
+#endif
+#ifdef AUTOCONNECT_USE_PORTALTASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "AutoConnectPortalTask.h"
+#endif
 
 template<typename T>
 class AutoConnectCore {
@@ -81,25 +106,24 @@ class AutoConnectCore {
   
   // Connection management
   void  disconnect(const bool wifiOff = false, const bool clearConfig = false);
-  inline void disableMenu(const uint16_t items) { 
-    std::lock_guard<std::mutex> lock(_configMutex);
-    _apConfig.menuItems &= (0xffff ^ items); 
-  }
-  inline void enableMenu(const uint16_t items) { 
-    std::lock_guard<std::mutex> lock(_configMutex);
-    _apConfig.menuItems |= items; 
-  }
+  void  disableMenu(const uint16_t items);
+  void  enableMenu(const uint16_t items);
   virtual void  end(void);
   
-  // Const-correct getters
-  const T&  getConfig(void) const { 
-    std::lock_guard<std::mutex> lock(_configMutex);
-    return _apConfig; 
-  }
-  T&  getConfig(void) { 
-    std::lock_guard<std::mutex> lock(_configMutex);
-    return _apConfig; 
-  }
+  // The working configuration that the portal refers to. It is only
+  // valid in the context that runs handleClient. Use getConfigSnapshot
+  // from the other tasks. Changes made through the reference take
+  // effect at once as before, but the next snapshot published by config,
+  // enableMenu, disableMenu or updateConfig replaces them. Use
+  // updateConfig to make a change that persists.
+  const T&  getConfig(void) const { return _apConfig; }
+  T&  getConfig(void) { _adoptConfig(); return _apConfig; }
+
+  // Immutable configuration snapshots, see AutoConnectCoreImpl.hpp
+  typedef std::shared_ptr<const T>  ConfigSnapshot_t;
+  ConfigSnapshot_t  getConfigSnapshot(void) const { return std::atomic_load(&_configSnapshot); }
+  template<typename F>
+  void  updateConfig(F modifier);
   
   bool  getCurrentCredential(station_config_t* staConfig) const;
   uint16_t  getEEPROMUsedSize(void) const;
@@ -119,11 +143,40 @@ class AutoConnectCore {
   void  onNotFound(WebServer::THandlerFunction fn);
   void  whileCaptivePortal(WhileCaptivePortalExit_ft fn);
   void  whileConnecting(WhileConnectingExit_ft fn);
+
+  /** Subscription to the exits without std::function */
+  typedef AutoConnectSignal<bool(IPAddress&)> DetectSignal_t;
+  typedef AutoConnectSignal<void(IPAddress&)> ConnectSignal_t;
+  typedef AutoConnectSignal<bool(void)>       WhileCaptivePortalSignal_t;
+  typedef AutoConnectSignal<bool(String&)>    WhileConnectingSignal_t;
+  bool  onDetect(DetectSignal_t::Handler_ft fn, void* ctx) { return _onDetectExit.subscribe(fn, ctx); }
+  bool  onConnect(ConnectSignal_t::Handler_ft fn, void* ctx) { return _onConnectExit.subscribe(fn, ctx); }
+  bool  whileCaptivePortal(WhileCaptivePortalSignal_t::Handler_ft fn, void* ctx) { return _whileCaptivePortal.subscribe(fn, ctx); }
+  bool  whileConnecting(WhileConnectingSignal_t::Handler_ft fn, void* ctx) { return _whileConnecting.subscribe(fn, ctx); }
+  template<typename H>
+  typename std::enable_if<std::is_class<H>::value, bool>::type onDetect(H* handler) { return _onDetectExit.subscribe(handler); }
+  template<typename H>
+  typename std::enable_if<std::is_class<H>::value, bool>::type onConnect(H* handler) { return _onConnectExit.subscribe(handler); }
+  template<typename H>
+  typename std::enable_if<std::is_class<H>::value, bool>::type whileCaptivePortal(H* handler) { return _whileCaptivePortal.subscribe(handler); }
+  template<typename H>
+  typename std::enable_if<std::is_class<H>::value, bool>::type whileConnecting(H* handler) { return _whileConnecting.subscribe(handler); }
+  void  unsubscribe(const void* ctx);
   template<typename U = AUTOCONNECT_APPLIED_FILECLASS>
   bool  saveCredential(const char* filename = "/" AC_IDENTIFIER, U& fs = AUTOCONNECT_APPLIED_FILESYSTEM);
   template<typename U = AUTOCONNECT_APPLIED_FILECLASS>
   bool  restoreCredential(const char* filename = "/" AC_IDENTIFIER, U& fs = AUTOCONNECT_APPLIED_FILESYSTEM);
 
+#ifdef AUTOCONNECT_USE_PORTALTASK
+  // Portal task, see AutoConnectPortalTask.h for the threading contract.
+  bool  beginTask(const char* ssid = nullptr, const char* passphrase = nullptr, unsigned long timeout = 0);
+  void  endTask(void);
+  bool  isTaskRunning(void) const { return _portalTask != nullptr; }
+  bool  postCommand(const AC_PORTALCMD_t command, const uint32_t arg = 0);
+  bool  postCommand(void (*fn)(void*), void* ctx = nullptr);
+  bool  receiveEvent(AutoConnectPortalEvent& event);
+#endif
+
  protected:
   typedef enum {
     AC_RECONNECT_SET,
@@ -134,8 +187,32 @@ class AutoConnectCore {
     AC_SEEKMODE_NEWONE,
     AC_SEEKMODE_CURRENT
   } AC_SEEKMODE_t;
+  typedef enum {
+    AC_SEEK_FOUND,
+    AC_SEEK_NOTFOUND,
+    AC_SEEK_PENDING
+  } AC_SEEK_t;
+  /**< State of the seeking that resumes across the slices */
+  typedef struct _seekState {
+    _seekState(const uint16_t offset, const AC_PRINCIPLE_t principle, const AC_SEEKMODE_t mode, const int16_t scanned, const uint16_t generation) : credential(offset), principle(principle), mode(mode), collation(principle == AC_PRINCIPLE_RSSI, scanned, generation) {}
+    AutoConnectCredential credential;   /**< Credentials being walked */
+    station_config_t  entry;    /**< The credential being collated */
+    station_config_t  found;    /**< The credential of the best access point */
+    AC_PRINCIPLE_t  principle;  /**< WiFi connection principle */
+    AC_SEEKMODE_t   mode;       /**< Seek mode */
+    AutoConnectSeek collation;  /**< The best access point found so far */
+  } AC_SEEKSTATE_t;
+  /**< Portal state of a client, kept apart from the other clients */
+  typedef struct {
+    String  uri;          /**< URI of the page built for the client */
+    std::unique_ptr<AutoConnectPageElement> page; /**< The page built for the client */
+    String  menuTitle;    /**< Menu title of the page */
+    String  redirectURI;  /**< Result of the connection requested by the client */
+  } AC_CLIENTSTATE_t;
   void  _authentication(bool allow);
   void  _authentication(bool allow, const HTTPAuthMethod method);
+  bool  _authenticate(const char* user, const char* password);
+  bool  _adoptConfig(void);
   bool  _configAP(void);
   bool  _configSTA(const IPAddress& ip, const IPAddress& gateway, const IPAddress& netmask, const IPAddress& dns1, const IPAddress& dns2);
   String _getBootUri(void);
@@ -144,14 +221,111 @@ class AutoConnectCore {
   bool  _loadCurrentCredential(char* ssid, char* password, const AC_PRINCIPLE_t principle, const bool excludeCurrent);
   void  _restoreSTA(const station_config_t& staConfig);
   bool  _seekCredential(const AC_PRINCIPLE_t principle, const AC_SEEKMODE_t mode);
+  AC_SEEK_t _resumeSeekCredential(const AC_PRINCIPLE_t principle, const AC_SEEKMODE_t mode);
+  int16_t _scanNetworks(const bool async);
+  int16_t _waitForScan(int16_t sc);
+  void  _collectHeaders(const char* headers[], const size_t count);
   void  _startWebServer(void);
   void  _startDNSServer(void);
   void  _stopDNSServer(void);
   void  _stopPortal(void);
   bool  _classifyHandle(HTTPMethod mothod, String uri);
+  void  _attachPage(void);
+  bool  _bindClient(const IPAddress& client);
+  void  _releaseClients(void);
+  void  _resolveConnect(const String& redirectURI);
   void  _handleNotFound(void);
+#ifdef AUTOCONNECT_USE_LOGGER
+  void  _handleLog(void);
+#endif
+#ifdef AUTOCONNECT_USE_ASSETS
+  /**< A static resource served apart from the pages. */
+  typedef struct {
+    PGM_P name;         /**< File name of the asset */
+    PGM_P type;         /**< Content type */
+    const PGM_P*  parts;  /**< Built-in copies to be concatenated */
+    uint8_t count;      /**< Number of the parts */
+  } Asset_t;
+  void  _attachAsset(const Asset_t* asset);
+  void  _serveAsset(const Asset_t* asset);
+#endif
+#if defined(AUTOCONNECT_USE_LOGGER) || defined(AUTOCONNECT_USE_DEFLATE)
+  /**< Print to send the chunks of the response through a small buffer */
+  class ChunkPrint : public Print {
+   public:
+    explicit ChunkPrint(WebServer& server) : _server(server), _len(0) {}
+    size_t write(uint8_t c) override {
+      if (_len >= sizeof(_buf))
+        send();
+      _buf[_len++] = static_cast<char>(c);
+      return 1;
+    }
+    void send(void) {
+      if (_len)
+        _server.sendContent(_buf, _len);
+      _len = 0;
+    }
+   private:
+    WebServer&  _server;
+    char    _buf[128];
+    size_t  _len;
+  };
+#endif
+#ifdef AUTOCONNECT_USE_DEFLATE
+  /**
+   * Print that holds the first AUTOCONNECT_DEFLATE_THRESHOLD bytes of
+   * the page, and compresses the page into the chunked response once it
+   * exceeds them. The page that ends short of them remains in the head.
+   */
+  class DeflatePrint : public Print {
+   public:
+    DeflatePrint(WebServer& server, const AutoConnectDeflate::AC_DEFLATEFORMAT_t format, String& head) : _server(server), _format(format), _head(head), _chunk(server) {}
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override {
+      if (_deflate)
+        return _deflate->write(buf, size);
+      // The handler of a token has responded and closed the connection,
+      // the rest of the page is left out.
+      if (!_server.client().connected())
+        return size;
+      const size_t  n = std::min(size, static_cast<size_t>(AUTOCONNECT_DEFLATE_THRESHOLD) - _head.length());
+      if (!_head.concat(reinterpret_cast<const char*>(buf), n))
+        return 0;
+      if (_head.length() >= AUTOCONNECT_DEFLATE_THRESHOLD) {
+        _server.sendHeader(String(F("Content-Encoding")), String(AutoConnectDeflate::encoding(_format)));
+        _server.sendHeader(String(F("Vary")), String(F("Accept-Encoding")));
+        _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _server.send(200, String(F("text/html")), String(""));
+        _deflate.reset(new AutoConnectDeflate(_chunk, _format));
+        _deflate->write(reinterpret_cast<const uint8_t*>(_head.c_str()), _head.length());
+        _head = String();
+        if (size > n)
+          _deflate->write(buf + n, size - n);
+      }
+      return size;
+    }
+    bool end(void) {
+      if (!_deflate)
+        return false;
+      _deflate->end();
+      _chunk.send();
+      _server.sendContent(String(""));
+      return true;
+    }
+   private:
+    WebServer&  _server;
+    AutoConnectDeflate::AC_DEFLATEFORMAT_t  _format;
+    String& _head;
+    ChunkPrint  _chunk;
+    std::unique_ptr<AutoConnectDeflate> _deflate;
+  };
+  AutoConnectDeflate::AC_DEFLATEFORMAT_t  _acceptDeflate(void);
+  bool  _sendDeflate(const int code, const String& type, const PGM_P* parts, const uint8_t count);
+  String  _deflatePage(PageArgument& args);
+#endif
+  void  _publishConfig(const T& config);
   void  _purgePages(void);
-  virtual PageElement*  _setupPage(String& uri);
+  virtual AutoConnectPageElement*  _setupPage(String& uri);
 
   /** Request handlers implemented by Page Builder */
   String  _induceConnect(PageArgument& args);
@@ -159,6 +333,7 @@ class AutoConnectCore {
   String  _induceReset(PageArgument& args);
   String  _invokeResult(PageArgument& args);
   String  _promptDeleteCredential(PageArgument& args);
+  String  _responseScan(PageArgument& args);
 
   /** For portal control */
   bool  _captivePortal(void);
@@ -166,9 +341,23 @@ class AutoConnectCore {
   bool  _isIP(const String& ipStr);
   bool  _isPersistent(void);
   void  _softAP(void);
+  uint8_t _selectChannel(void);
   wl_status_t _waitForConnect(unsigned long timeout);
   void  _waitForEndTransmission(void);
+  bool  _handleSession(void);
+#ifdef AUTOCONNECT_USE_TRACE
+  void  _traceRequest(HTTPMethod method, const String& uri);
+  static String _urlEncode(const String& s);
+#endif
   void  _setReconnect(const AC_STARECONNECT_t order);
+  void  _drainWiFiEvents(void);
+#ifdef AUTOCONNECT_USE_PORTALTASK
+  static void _portalTaskProc(void* pvParameters);
+  void  _runPortalTask(void);
+  bool  _serveTask(void);
+  void  _dispatchCommand(const AutoConnectPortalCommand& command);
+  void  _notifyEvent(const AC_PORTALEVT_t event, const uint32_t arg = 0);
+#endif
 
   /** Enhanced utilities with validation and safety */
   ACResult _validateSSID(const String& ssid) const;
@@ -177,6 +366,8 @@ class AutoConnectCore {
   bool _checkMemoryAvailable(size_t required) const;
   void _updateMemoryStats() const;
   String _buildHTML(const std::vector<String>& parts) const;
+  AutoConnectRetry::AC_ATTEMPT_t _attemptConnect(unsigned long timeoutMs);
+  uint32_t _retrySeed(void) const;
   
   /** Utilities */
   String              _attachMenuItem(const AC_MENUITEM_t item);
@@ -187,15 +378,14 @@ class AutoConnectCore {
   static unsigned int _toWiFiQuality(int32_t rssi);
   
   /** Thread safety */
-  mutable std::mutex  _configMutex;
   mutable std::mutex  _credentialMutex;
   mutable std::mutex  _memoryMutex;
   
   /** Callback functions */
-  ConnectExit_ft      _onConnectExit;
-  DetectExit_ft       _onDetectExit;
-  WhileCaptivePortalExit_ft _whileCaptivePortal;
-  WhileConnectingExit_ft    _whileConnecting;
+  ConnectSignal_t     _onConnectExit;
+  DetectSignal_t      _onDetectExit;
+  WhileCaptivePortalSignal_t  _whileCaptivePortal;
+  WhileConnectingSignal_t     _whileConnecting;
   WebServer::THandlerFunction  _notFoundHandler;
   
   /** Memory management */
@@ -208,45 +398,103 @@ class AutoConnectCore {
   WebserverUP _webServer = WebserverUP(nullptr, std::default_delete<WebServer>());
   std::unique_ptr<DNSServer>    _dnsServer;
 
+  /** Persistent connection being served */
+  IPAddress     _sessionPeer;         /**< Remote address of the connection */
+  uint16_t      _sessionPort = 0;     /**< Remote port, 0 for no connection */
+  uint8_t       _sessionRequests = 0; /**< Number of the requests served */
+  unsigned long _sessionActive = 0;   /**< The last time it was active */
+
   /**
    *  Dynamically hold one page of AutoConnect menu.
    *  Every time a GET/POST HTTP request occurs, an AutoConnect
    *  menu page corresponding to the URI is generated.
    */
   std::unique_ptr<PageBuilder>  _responsePage;
-  std::unique_ptr<PageElement>  _currentPageElement;
+  std::unique_ptr<AutoConnectPageElement> _currentPageElement;
+  /**
+   *  The page, the menu title and the connection result of each client.
+   *  The state of the client being served is held in _uri,
+   *  _currentPageElement and _menuTitle while it is bound, and the others
+   *  are stowed in the table.
+   */
+  AutoConnectClients<AC_CLIENTSTATE_t, AUTOCONNECT_CLIENTS_MAX> _clients;
+  String    _resultURI;         /**< Result of the last connection for a client evicted meanwhile */
+#ifdef AUTOCONNECT_USE_DEFLATE
+  std::unique_ptr<PageElement>  _deflateElement;  /**< Proxy to send the compressed page */
+#endif
 
   /** Saved configurations */
-  T _apConfig;
+  T _apConfig;                  /**< Working copy owned by the handleClient context */
+  ConfigSnapshot_t  _configSnapshot;          /**< The latest published configuration */
+  std::atomic<uint32_t> _configGeneration{0}; /**< Incremented for each publication */
+  uint32_t      _adoptedGeneration = 0;       /**< Generation reflected to the _apConfig */
   station_config_t   _credential;
-  uint8_t       _hiddenSSIDCount;
+  std::unique_ptr<AC_SEEKSTATE_t> _seek;  /**< The seeking in progress */
   int16_t       _scanCount;
+  uint16_t      _scanGeneration = 0;  /**< Advanced by each scan that AutoConnect starts */
   uint8_t       _connectCh;
   unsigned long _portalAccessPeriod;
   unsigned long _attemptPeriod;
   String        _indelibleSSID;
+  String        _authFails;     /**< The page responded to the authentication failure */
+#ifdef AUTOCONNECT_USE_AUTHSESSION
+  AutoConnectAuthSession  _authSession; /**< Sessions of the authenticated clients */
+#endif
 
   /** The control indicators */
   bool  _rfAdHocBegin = false;  /**< Specified with AutoConnect::begin */
   bool  _rfConnect = false;     /**< URI /connect requested */
   bool  _rfDisconnect = false;  /**< URI /disc requested */
   bool  _rfReset = false;       /**< URI /reset requested */
-  wl_status_t   _rsConnect;     /**< connection result */
+  bool  _rfBeginPortal = false; /**< In the captive portal loop of begin */
+  bool  _actReconnect = false;  /**< Actual autoReconnect suppressed by begin */
+  bool  _actRetainPortal = false; /**< Actual retainPortal forced by begin */
+  wl_status_t   _rsConnect = WL_IDLE_STATUS;  /**< connection result */
 #ifdef ARDUINO_ARCH_ESP32
-  WiFiEventId_t _disconnectEventId = -1;  /**< STA disconnection event handler registered id  */
+  WiFiEventId_t _disconnectEventId = 0;   /**< STA disconnection event handler registered id, 0 while not registered */
+  std::atomic<uint8_t>  _staReason{0};   /**< The last STA disconnection reason in connectToWiFi */
 #endif
+
+  /**
+   * WiFi events posted by the SDK event context and consumed by
+   * handleRequest. The event handler only pushes into the ring and
+   * everything else is deferred to the handleRequest.
+   */
+  typedef struct {
+    int32_t event;              /**< WiFiEvent_t */
+    uint8_t reason;             /**< Disconnection reason */
+  } AC_WIFIEVENT_t;
+  AutoConnectQueue<AC_WIFIEVENT_t, AUTOCONNECT_WIFIEVENT_QUEUEDEPTH>  _wifiEvents;
+  volatile bool _rfWiFiEventOverflow = false; /**< Some WiFi events were dropped */
   uint8_t       _portalStatus;  /**< Status in the portal */
 
+#ifdef AUTOCONNECT_USE_PORTALTASK
+  /** Only available with the portal task */
+  std::atomic<TaskHandle_t> _portalTask{nullptr}; /**< Running portal task */
+  std::atomic<bool>   _rfTaskStop{false};         /**< endTask requested */
+  std::atomic<bool>   _rfEventOverflow{false};    /**< Some events were dropped */
+  std::atomic<uint8_t>  _taskStatus{0};           /**< Portal status published by the task */
+  bool          _rfTaskBody = false;  /**< Running in the portal task */
+  bool          _taskConnected = false; /**< WiFi connection published by the task */
+  AutoConnectPortalCommandQueue _taskCommands;    /**< Sketch to the portal task */
+  AutoConnectPortalEventQueue   _taskEvents;      /**< Portal task to the sketch */
+  String        _taskSSID;      /**< SSID for begin in the task */
+  String        _taskPassphrase;  /**< Passphrase for begin in the task */
+  unsigned long _taskTimeout;   /**< Timeout for begin in the task */
+#endif
+
+#ifdef AUTOCONNECT_USE_TICKER
   /** Only available with ticker enabled */
   std::unique_ptr<AutoConnectTicker>  _ticker;
+#endif
 
   /** HTTP header information of the currently requested page. */
   IPAddress     _currentHostIP; /**< host IP address */
   String        _uri;           /**< Requested URI */
-  String        _redirectURI;   /**< Redirect destination */
   String        _menuTitle;     /**< Title string of the page */
 
   /** PageElements of AutoConnect site. */
+#ifndef AUTOCONNECT_ASSETS_ONFS
   static const char _CSS_BASE[] PROGMEM;
   static const char _CSS_LUXBAR_BODY[] PROGMEM;
   static const char _CSS_LUXBAR_HEADER[] PROGMEM;
@@ -254,6 +502,7 @@ class AutoConnectCore {
   static const char _CSS_LUXBAR_ANI[] PROGMEM;
   static const char _CSS_LUXBAR_MEDIA[] PROGMEM;
   static const char _CSS_LUXBAR_ITEM[] PROGMEM;
+#endif
   static const char _CSS_UL[] PROGMEM;
   static const char _CSS_ICON_LOCK[] PROGMEM;
   static const char _CSS_ICON_TRASH[] PROGMEM;
@@ -306,13 +555,11 @@ class AutoConnectCore {
   String _token_FREE_HEAP(PageArgument& args);
   String _token_GATEWAY(PageArgument& args);
   String _token_HEAD(PageArgument& args);
-  String _token_HIDDEN_COUNT(PageArgument& args);
-  String _token_LIST_SSID(PageArgument& args);
   String _token_LOCAL_IP(PageArgument& args);
   String _token_NETMASK(PageArgument& args);
   String _token_OPEN_SSID(PageArgument& args);
   String _token_SOFTAP_IP(PageArgument& args);
-  String _token_SSID_COUNT(PageArgument& args);
+  String _token_SSID_PAGER(PageArgument& args);
   String _token_STA_MAC(PageArgument& args);
   String _token_STATION_STATUS(PageArgument& args);
   String _token_SYSTEM_UPTIME(PageArgument &args);
@@ -336,6 +583,9 @@ class AutoConnectCore {
   virtual inline void _releaseAux(const String& uri) { AC_UNUSED(uri); }
   virtual inline void _saveCurrentUri(const String& uri) { AC_UNUSED(uri); }
   virtual inline String _mold_MENU_AUX(PageArgument& args) { AC_UNUSED(args); return String(""); }
+#ifdef AUTOCONNECT_USE_ASSETS
+  virtual inline void _attachAuxAssets(void) {}
+#endif
 };
 
 #endif  // _AUTOCONNECTCORE_HPP_
@@ -74,23 +74,20 @@ ACResult AutoConnectCore<T>::beginWithResult(const char* ssid, const char* passp
  */
 template<typename T>
 ACResult AutoConnectCore<T>::configWithValidation(T& config) {
-    // Basic validation - this would be expanded based on config type
-    std::lock_guard<std::mutex> lock(_configMutex);
-    
     // Check memory impact
     if (!_checkMemoryAvailable(1024)) {
         return ACResult(ACError::MEMORY_INSUFFICIENT, "Insufficient memory for configuration");
     }
     
-    // Store old config for rollback
-    T oldConfig = _apConfig;
+    // Keep the current snapshot for rollback
+    ConfigSnapshot_t oldConfig = getConfigSnapshot();
     
     // Apply new configuration
     bool success = this->config(config);
     
     if (!success) {
         // Rollback on failure
-        _apConfig = oldConfig;
+        _publishConfig(*oldConfig);
         return ACResult(ACError::INVALID_PARAMETER, "Configuration validation failed");
     }
     
@@ -99,6 +96,11 @@ ACResult AutoConnectCore<T>::configWithValidation(T& config) {
 
 /**
  * Connect to WiFi with detailed configuration
+ * The requested SSID and the saved credentials in sight are attempted
+ * in turn by AutoConnectRetry, strongest signal first. The static IP
+ * held in the config is applied before each attempt. On failure, the
+ * captive portal starts as begin does when NetworkConfig::startPortalOnFail
+ * and autoRise are both true.
  */
 template<typename T>
 ACResult AutoConnectCore<T>::connectToWiFi(const NetworkConfig& networkConfig) {
@@ -132,30 +134,192 @@ ACResult AutoConnectCore<T>::connectToWiFi(const NetworkConfig& networkConfig) {
         }
     }
     
-    // Attempt connection with retry logic
+    // Collect the candidates in sight with their signal strength. The
+    // requested SSID is always a candidate, but the retry orders it by its
+    // RSSI as well, so it is tried last when the scan missed it (-127).
+    struct Candidate {
+        String ssid;
+        String password;
+        int32_t channel;
+    };
+    std::vector<Candidate> candidates;
+    AutoConnectRetry retry(networkConfig.maxRetries, AUTOCONNECT_RETRY_BASEDELAY, AUTOCONNECT_RETRY_MAXDELAY, _retrySeed());
+    
+    if (!(WiFi.getMode() & WIFI_STA))
+        WiFi.enableSTA(true);
+    const int16_t nn = _scanNetworks(false);
+    auto inSight = [nn](const String& ssid, int8_t& rssi, int32_t& channel) {
+        bool found = false;
+        for (int16_t i = 0; i < nn; i++) {
+            if (WiFi.SSID(i) == ssid && (!found || WiFi.RSSI(i) > rssi)) {
+                rssi = static_cast<int8_t>(WiFi.RSSI(i));
+                channel = WiFi.channel(i);
+                found = true;
+            }
+        }
+        return found;
+    };
+    
+    int8_t rssi = -127;
+    int32_t channel = 0;
+    inSight(networkConfig.ssid, rssi, channel);
+    candidates.push_back({ networkConfig.ssid, networkConfig.password, channel });
+    retry.add(rssi);
+    
+    if (networkConfig.useSavedCredentials) {
+        AutoConnectCredential credential(_apConfig.boundaryOffset);
+        station_config_t entry;
+        for (uint8_t i = 0; i < credential.entries() && candidates.size() < AutoConnectRetry::MAX_CANDIDATES; i++) {
+            credential.load(i, &entry);
+            const String ssid(reinterpret_cast<const char*>(entry.ssid));
+            if (ssid == networkConfig.ssid || !inSight(ssid, rssi, channel))
+                continue;
+            candidates.push_back({ ssid, String(reinterpret_cast<const char*>(entry.password)), channel });
+            retry.add(rssi);
+        }
+    }
+    WiFi.scanDelete();
+    AC_DBG("%d candidate(s) in %d network(s)\n", (int)candidates.size(), (int)nn);
+    
+    // The static IP set by setStaticIP and setDNS is held in the config,
+    // and WiFi.config must precede each WiFi.begin to take effect.
+    ConfigSnapshot_t sta = getConfigSnapshot();
+    const bool staticIP = sta->staip.isSet();
+    
+#if defined(ARDUINO_ARCH_ESP32)
+    // The reason of the STA disconnection tells the rejection by the
+    // authentication from the other failures of the attempt.
+    const WiFiEventId_t reasonEventId = WiFi.onEvent([this](WiFiEvent_t e, WiFiEventInfo_t info) {
+        AC_UNUSED(e);
+        _staReason = static_cast<uint8_t>(info.AC_ESP_WIFIEVENTINFO_DECLARE(disconnected).reason);
+    }, WiFiEvent_t::AC_ESP_WIFIEVENT_DECLARE(STA_DISCONNECTED));
+#endif
+    
+    // Attempt the candidates in the order scheduled by the retry strategy.
+    // It waits for the backoff by delay(1), which lets the idle task run,
+    // and an access point rejecting the authentication is never retried.
     TimeoutHelper timeout(networkConfig.connectionTimeoutMs);
-    uint8_t retries = 0;
-    
-    while (retries < networkConfig.maxRetries && !timeout.isExpired()) {
-        AC_DBG("Connection attempt %d/%d\n", retries + 1, networkConfig.maxRetries);
-        
-        ACResult result = beginWithResult(networkConfig.ssid.c_str(), 
-                                         networkConfig.password.c_str(), 
-                                         networkConfig.connectionTimeoutMs);
+    int16_t connected = -1;
+    bool configured = true;
+    retry.begin(millis());
+    
+    while (!timeout.isExpired()) {
+        const int16_t id = retry.next(millis());
+        if (id == AutoConnectRetry::AC_RETRY_GIVEUP)
+            break;
+        if (id == AutoConnectRetry::AC_RETRY_WAIT) {
+            delay(1);
+            continue;
+        }
         
-        if (result) {
-            AC_DBG("WiFi connected successfully\n");
-            return result;
+        const Candidate& candidate = candidates[id];
+        AC_DBG("Connection attempt %d/%d %s ch(%d)\n", retry.attempts() + 1, networkConfig.maxRetries, candidate.ssid.c_str(), (int)candidate.channel);
+        disconnect(false, false);
+        if (staticIP && !_configSTA(sta->staip, sta->staGateway, sta->staNetmask, sta->dns1, sta->dns2)) {
+            configured = false;
+            break;
         }
+#if defined(ARDUINO_ARCH_ESP32)
+        _staReason = 0;
+#endif
+        WiFi.begin(candidate.ssid.c_str(), candidate.password.length() ? candidate.password.c_str() : nullptr, candidate.channel);
+        
+        const AutoConnectRetry::AC_ATTEMPT_t result = _attemptConnect(std::min(static_cast<unsigned long>(AUTOCONNECT_RETRY_TIMEOUT), timeout.remaining()));
+        retry.report(id, result, millis());
         
-        retries++;
-        if (retries < networkConfig.maxRetries) {
-            delay(1000); // Wait between retries
+        if (result == AutoConnectRetry::AC_ATTEMPT_CONNECTED) {
+            connected = id;
+            break;
         }
     }
     
+#if defined(ARDUINO_ARCH_ESP32)
+    WiFi.removeEvent(reasonEventId);
+#endif
+    
+    if (connected >= 0) {
+        AC_DBG("WiFi connected successfully\n");
+        _currentHostIP = WiFi.localIP();
+        _portalStatus = AC_ESTABLISHED;
+        _enableUpdate();
+        if (!_responsePage)
+            _startWebServer();
+        return ACResult(ACError::SUCCESS, String("WiFi connection established with ") + candidates[connected].ssid);
+    }
+    
+    disconnect(false, false);
+    if (!configured) {
+        return ACResult(ACError::WIFI_CONNECT_FAILED, "Failed to configure the static IP");
+    }
+    
+    if (networkConfig.startPortalOnFail && sta->autoRise) {
+        // Fall into the captive portal as begin does, skipping the first
+        // WiFi.begin since all the candidates have just failed.
+        const bool immediateStart = sta->immediateStart;
+        updateConfig([](T& c) { c.immediateStart = true; });
+        const bool cs = begin();
+        updateConfig([immediateStart](T& c) { c.immediateStart = immediateStart; });
+        if (cs) {
+            return ACResult(ACError::SUCCESS, String("WiFi connection established with ") + WiFi.SSID() + " through the captive portal");
+        }
+        if (_portalStatus & AC_TIMEOUT) {
+            return ACResult(ACError::WIFI_TIMEOUT, "Captive portal timed out");
+        }
+    }
+    if (retry.rejected()) {
+        return ACResult(ACError::WIFI_CREDENTIALS_INVALID, "Authentication failed with all candidates");
+    }
     return ACResult(ACError::WIFI_CONNECT_FAILED, 
-                   String("Failed to connect after ") + String(retries) + " attempts");
+                   String("Failed to connect after ") + String(retry.attempts()) + " attempts");
+}
+
+/**
+ * Wait for the attempt to connect and classify its result.
+ * Only the rejection by the authentication excludes the candidate, the
+ * other failures are retried with the backoff.
+ */
+template<typename T>
+AutoConnectRetry::AC_ATTEMPT_t AutoConnectCore<T>::_attemptConnect(unsigned long timeoutMs) {
+    TimeoutHelper timeout(timeoutMs);
+    wl_status_t wl = WiFi.status();
+    
+    while (!timeout.isExpired()) {
+        wl = WiFi.status();
+        if (wl == WL_CONNECTED) {
+            return AutoConnectRetry::AC_ATTEMPT_CONNECTED;
+        }
+#if defined(ARDUINO_ARCH_ESP8266)
+        if (wl == WL_WRONG_PASSWORD) {
+            return AutoConnectRetry::AC_ATTEMPT_AUTHFAIL;
+        }
+#elif defined(ARDUINO_ARCH_ESP32)
+        // The driver keeps retrying a wrong passphrase by itself, so the
+        // rejection is known from the reason rather than the status.
+        const uint8_t reason = _staReason;
+        if (reason == WIFI_REASON_AUTH_FAIL || reason == WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT || reason == WIFI_REASON_HANDSHAKE_TIMEOUT) {
+            return AutoConnectRetry::AC_ATTEMPT_AUTHFAIL;
+        }
+#endif
+        if (wl == WL_CONNECT_FAILED) {
+            return AutoConnectRetry::AC_ATTEMPT_FAILED;
+        }
+        if (wl == WL_NO_SSID_AVAIL) {
+            return AutoConnectRetry::AC_ATTEMPT_NOTFOUND;
+        }
+        delay(1);
+    }
+    return AutoConnectRetry::AC_ATTEMPT_TIMEOUT;
+}
+
+/**
+ * Seed of the retry jitter derived from the MAC address so that each
+ * device keeps its own reproducible schedule
+ */
+template<typename T>
+uint32_t AutoConnectCore<T>::_retrySeed(void) const {
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    return (static_cast<uint32_t>(mac[2]) << 24) | (static_cast<uint32_t>(mac[3]) << 16) | (static_cast<uint32_t>(mac[4]) << 8) | mac[5];
 }
 
 /**
@@ -175,23 +339,23 @@ ACResult AutoConnectCore<T>::startCaptivePortal(const PortalConfig& portalConfig
     }
     
     // Configure portal settings
-    std::lock_guard<std::mutex> lock(_configMutex);
-    
-    _apConfig.apid = portalConfig.apSSID;
-    _apConfig.psk = portalConfig.apPassword;
-    _apConfig.apip = static_cast<uint32_t>(portalConfig.apIP);
-    _apConfig.gateway = static_cast<uint32_t>(portalConfig.apGateway);
-    _apConfig.netmask = static_cast<uint32_t>(portalConfig.apSubnet);
-    _apConfig.channel = portalConfig.channel;
-    _apConfig.hidden = portalConfig.hidden ? 1 : 0;
-    _apConfig.portalTimeout = portalConfig.timeoutMs;
-    
-    // Configure authentication if enabled
-    if (portalConfig.enableAuth) {
-        _apConfig.auth = AC_AUTH_DIGEST;
-        _apConfig.username = portalConfig.authUsername;
-        _apConfig.password = portalConfig.authPassword;
-    }
+    updateConfig([&portalConfig](T& c) {
+        c.apid = portalConfig.apSSID;
+        c.psk = portalConfig.apPassword;
+        c.apip = static_cast<uint32_t>(portalConfig.apIP);
+        c.gateway = static_cast<uint32_t>(portalConfig.apGateway);
+        c.netmask = static_cast<uint32_t>(portalConfig.apSubnet);
+        c.channel = portalConfig.channel;
+        c.hidden = portalConfig.hidden ? 1 : 0;
+        c.portalTimeout = portalConfig.timeoutMs;
+        
+        // Configure authentication if enabled
+        if (portalConfig.enableAuth) {
+            c.auth = AC_AUTH_DIGEST;
+            c.username = portalConfig.authUsername;
+            c.password = portalConfig.authPassword;
+        }
+    });
     
     // Start portal
     bool success = begin();
@@ -213,8 +377,7 @@ ACResult AutoConnectCore<T>::setHostname(const String& hostname) {
     
     AC_DBG("Setting hostname: %s\n", hostname.c_str());
     
-    std::lock_guard<std::mutex> lock(_configMutex);
-    _apConfig.hostName = hostname;
+    updateConfig([&hostname](T& c) { c.hostName = hostname; });
     
     // Apply hostname to WiFi
     SET_HOSTNAME(hostname.c_str());
@@ -233,10 +396,11 @@ ACResult AutoConnectCore<T>::setStaticIP(const IPAddress& ip, const IPAddress& g
     
     AC_DBG("Setting static IP: %s\n", ip.toString().c_str());
     
-    std::lock_guard<std::mutex> lock(_configMutex);
-    _apConfig.staip = static_cast<uint32_t>(ip);
-    _apConfig.staGateway = static_cast<uint32_t>(gateway);
-    _apConfig.staNetmask = static_cast<uint32_t>(subnet);
+    updateConfig([&](T& c) {
+        c.staip = static_cast<uint32_t>(ip);
+        c.staGateway = static_cast<uint32_t>(gateway);
+        c.staNetmask = static_cast<uint32_t>(subnet);
+    });
     
     return ACResult(ACError::SUCCESS, "Static IP configured");
 }
@@ -253,11 +417,12 @@ ACResult AutoConnectCore<T>::setDNS(const IPAddress& dns1, const IPAddress& dns2
     AC_DBG("Setting DNS: %s, %s\n", dns1.toString().c_str(), 
            dns2.isSet() ? dns2.toString().c_str() : "none");
     
-    std::lock_guard<std::mutex> lock(_configMutex);
-    _apConfig.dns1 = static_cast<uint32_t>(dns1);
-    if (dns2.isSet()) {
-        _apConfig.dns2 = static_cast<uint32_t>(dns2);
-    }
+    updateConfig([&](T& c) {
+        c.dns1 = static_cast<uint32_t>(dns1);
+        if (dns2.isSet()) {
+            c.dns2 = static_cast<uint32_t>(dns2);
+        }
+    });
     
     return ACResult(ACError::SUCCESS, "DNS configured");
 }
@@ -45,6 +45,7 @@
 template<typename T>
 AutoConnectCore<T>::AutoConnectCore() : _scanCount(0), _menuTitle(_apConfig.title) {
   memset(&_credential, 0x00, sizeof(station_config_t));
+  _configSnapshot = std::make_shared<const T>(_apConfig);
 }
 
 /**
@@ -63,6 +64,9 @@ AutoConnectCore<T>::AutoConnectCore(WebServer& webServer) : AutoConnectCore() {
  */
 template<typename T>
 AutoConnectCore<T>::~AutoConnectCore() {
+#ifdef AUTOCONNECT_USE_PORTALTASK
+  endTask();
+#endif
   end();
 }
 
@@ -93,6 +97,9 @@ bool AutoConnectCore<T>::begin(const char* ssid, const char* passphrase, unsigne
   AC_ESP_LOG("wifi", ESP_LOG_VERBOSE);
   AC_ESP_LOG("dhcpc", ESP_LOG_VERBOSE);
 
+  // Reflect the configuration published before begin.
+  _adoptConfig();
+
   // Overwrite for the current timeout value.
   if (timeout == 0)
     timeout = _apConfig.beginTimeout;
@@ -125,12 +132,14 @@ bool AutoConnectCore<T>::begin(const char* ssid, const char* passphrase, unsigne
   if (_apConfig.hostName.length())
     SET_HOSTNAME(_apConfig.hostName.c_str());
 
+#ifdef AUTOCONNECT_USE_TICKER
   // Start Ticker according to the WiFi condition with Ticker is available.
   if (_apConfig.ticker) {
     _ticker.reset(new AutoConnectTicker(_apConfig.tickerPort, _apConfig.tickerOn));
     if (WiFi.status() != WL_CONNECTED)
-      _ticker->start(AUTOCONNECT_FLICKER_PERIODDC, (uint8_t)AUTOCONNECT_FLICKER_WIDTHDC);
+      _ticker->setPattern(AutoConnectTicker::AC_TICKER_CONNECTING);
   }
+#endif
 
   // If the portal is requested promptly skip the first WiFi.begin and
   // immediately start the portal.
@@ -254,7 +263,7 @@ bool AutoConnectCore<T>::begin(const char* ssid, const char* passphrase, unsigne
       _currentHostIP = WiFi.softAPIP();
 
       // Fork to the exit routine that starts captive portal.
-      cs = _onDetectExit ? _onDetectExit(_currentHostIP) : true;
+      cs = _onDetectExit.emit(_currentHostIP);
 
       // Start Web server when TCP connection is enabled.
       _startWebServer();
@@ -269,23 +278,32 @@ bool AutoConnectCore<T>::begin(const char* ssid, const char* passphrase, unsigne
         // They have the effect of avoiding unintended automatic
         // reconnection by autoReconnect within handleClient.
         // Also retainPortal too.
-        bool  actReconnect = _apConfig.autoReconnect;
-        bool  actRetainPortal = _apConfig.retainPortal;
+        // A configuration published during the captive portal will be
+        // overridden in the same way by _adoptConfig.
+        _actReconnect = _apConfig.autoReconnect;
+        _actRetainPortal = _apConfig.retainPortal;
         _apConfig.autoReconnect = false;
         _apConfig.retainPortal = true;
+        _rfBeginPortal = true;
 
         // Start the captive portal to make a new connection
         _portalAccessPeriod = millis();
         while (WiFi.status() != WL_CONNECTED && !_rfReset) {
           handleClient();
           // By an exit routine to escape from Captive portal
-          if (_whileCaptivePortal) {
-            if (!_whileCaptivePortal()) {
-              _portalStatus |= AC_INTERRUPT;
-              AC_DBG("Leaved portal\n");
-              break;
-            }
+          if (!_whileCaptivePortal.emit()) {
+            _portalStatus |= AC_INTERRUPT;
+            AC_DBG("Leaved portal\n");
+            break;
+          }
+#ifdef AUTOCONNECT_USE_PORTALTASK
+          // The portal task keeps serving the sketch while it stays in
+          // the captive portal. endTask leaves the portal open.
+          if (_rfTaskBody && !_serveTask()) {
+            AC_DBG("Portal task stop requested\n");
+            break;
           }
+#endif
           // Force execution of queued processes.
           yield();
           // Check timeout
@@ -298,14 +316,16 @@ bool AutoConnectCore<T>::begin(const char* ssid, const char* passphrase, unsigne
         cs = WiFi.status() == WL_CONNECTED;
 
         // Restore actual autoReconnect and retainPortal settings.
-        _apConfig.autoReconnect = actReconnect;
-        _apConfig.retainPortal = actRetainPortal;
+        _rfBeginPortal = false;
+        _apConfig.autoReconnect = _actReconnect;
+        _apConfig.retainPortal = _actRetainPortal;
 
         // Captive portal staying time exceeds timeout,
         // Close the portal if an option for keeping the portal is false.
         if (!cs && (_portalStatus & (AC_TIMEOUT | AC_INTERRUPT))) {
           if (_apConfig.retainPortal) {
             _purgePages();
+            _releaseClients();
             AC_DBG("Maintain portal\n");
           }
           else
@@ -332,18 +352,122 @@ bool AutoConnectCore<T>::begin(const char* ssid, const char* passphrase, unsigne
  */
 template<typename T>
 bool AutoConnectCore<T>::config(const char* ap, const char* password) {
-  _apConfig.apid = String(ap);
-  _apConfig.psk = String(password);
+  String  apid(ap);
+  String  psk(password);
+  updateConfig([&apid, &psk](T& c) {
+    c.apid = apid;
+    c.psk = psk;
+  });
   return true; //_config();
 }
 
 /**
  * Configure AutoConnect portal access point.
+ * The configuration is published as a new snapshot and takes effect
+ * at the next begin or handleClient. It is safe to call from any task.
  * @param  config AutoConnectConfig class instance.
  */
 template<typename T>
 bool AutoConnectCore<T>::config(T& config) {
-  _apConfig = config;
+  _publishConfig(config);
+  return true;
+}
+
+/**
+ * Modify the configuration in the read-copy-update manner. A copy of
+ * the latest snapshot is passed to the modifier and the modified copy
+ * is published atomically. If another writer has published in the
+ * meantime, the modification is retried on top of it. Readers never
+ * wait for a modifier to run, only for the short exchange of the
+ * pointer. std::atomic_load and std::atomic_store of shared_ptr are
+ * not lock-free; libstdc++ guards them with a small pool of mutexes.
+ * @param  modifier A callable that takes T& and modifies it.
+ */
+template<typename T>
+template<typename F>
+void AutoConnectCore<T>::updateConfig(F modifier) {
+  ConfigSnapshot_t  current = std::atomic_load(&_configSnapshot);
+  std::shared_ptr<T>  next;
+  do {
+    next = std::make_shared<T>(*current);
+    modifier(*next);
+  } while (!std::atomic_compare_exchange_weak(&_configSnapshot, &current, ConfigSnapshot_t(next)));
+  _configGeneration.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Disable the items of the AutoConnect menu. No snapshot is published
+ * when the items are already disabled, so the loop can call it on every
+ * turn without allocating the heap.
+ * @param  items  The menu items combined with AC_MENUITEM_t.
+ */
+template<typename T>
+void AutoConnectCore<T>::disableMenu(const uint16_t items) {
+  if (getConfigSnapshot()->menuItems & items)
+    updateConfig([items](T& c) { c.menuItems &= (0xffff ^ items); });
+}
+
+/**
+ * Enable the items of the AutoConnect menu. No snapshot is published
+ * when the items are already enabled.
+ * @param  items  The menu items combined with AC_MENUITEM_t.
+ */
+template<typename T>
+void AutoConnectCore<T>::enableMenu(const uint16_t items) {
+  if ((getConfigSnapshot()->menuItems & items) != items)
+    updateConfig([items](T& c) { c.menuItems |= items; });
+}
+
+/**
+ * Publish the configuration as the latest snapshot.
+ * @param  config The configuration to be published.
+ */
+template<typename T>
+void AutoConnectCore<T>::_publishConfig(const T& config) {
+  std::atomic_store(&_configSnapshot, ConfigSnapshot_t(std::make_shared<const T>(config)));
+  _configGeneration.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Reflect the latest published snapshot to the working configuration.
+ * It is called at the entry of the begin and handleClient and costs
+ * only an atomic load unless a new snapshot has been published.
+ * @return true   A new snapshot has been adopted.
+ * @return false  The working configuration is up-to-date.
+ */
+template<typename T>
+bool AutoConnectCore<T>::_adoptConfig(void) {
+  uint32_t  generation = _configGeneration.load(std::memory_order_acquire);
+  if (generation == _adoptedGeneration)
+    return false;
+
+  ConfigSnapshot_t  snapshot = std::atomic_load(&_configSnapshot);
+#ifdef AUTOCONNECT_USE_TICKER
+  const bool    ticker = _apConfig.ticker;
+  const uint8_t tickerPort = _apConfig.tickerPort;
+  const uint8_t tickerOn = _apConfig.tickerOn;
+#endif
+  _apConfig = *snapshot;
+  _adoptedGeneration = generation;
+
+#ifdef AUTOCONNECT_USE_TICKER
+  // Reconcile the ticker with the new settings without a reboot. The
+  // post-process of handleRequest starts the cycle for the WiFi state.
+  if (_ticker && (!_apConfig.ticker || _apConfig.tickerPort != tickerPort || _apConfig.tickerOn != tickerOn)) {
+    _ticker->stop();
+    _ticker.reset();
+  }
+  if (_apConfig.ticker && !_ticker && (!ticker || _apConfig.tickerPort != tickerPort || _apConfig.tickerOn != tickerOn))
+    _ticker.reset(new AutoConnectTicker(_apConfig.tickerPort, _apConfig.tickerOn));
+#endif
+  if (_rfBeginPortal) {
+    // Keep the trick of the begin during the captive portal.
+    _actReconnect = _apConfig.autoReconnect;
+    _actRetainPortal = _apConfig.retainPortal;
+    _apConfig.autoReconnect = false;
+    _apConfig.retainPortal = true;
+  }
+  AC_DBG("Config generation %" PRIu32 " adopted\n", generation);
   return true;
 }
 
@@ -478,8 +602,15 @@ bool AutoConnectCore<T>::_getConfigSTA(station_config_t* config) {
  */
 template<typename T>
 void AutoConnectCore<T>::end(void) {
-  _currentPageElement.reset();
+  _releaseClients();
+  _seek.reset();
+#ifdef AUTOCONNECT_USE_TICKER
   _ticker.reset();
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  // The event handler refers to this instance.
+  _setReconnect(AC_RECONNECT_RESET);
+#endif
 
   _stopPortal();
   _dnsServer.reset();
@@ -532,12 +663,15 @@ uint16_t AutoConnectCore<T>::getEEPROMUsedSize(void) {
  */
 template<typename T>
 void AutoConnectCore<T>::handleClient(void) {
+  // Reflect the configuration updated by the other task.
+  _adoptConfig();
+
   // Is there DNS Server process next request?
   if (_dnsServer)
     _dnsServer->processNextRequest();
   // handleClient valid only at _webServer activated.
   if (_webServer)
-    _webServer->handleClient();
+    _handleSession();
 
   handleRequest();
 }
@@ -549,6 +683,17 @@ template<typename T>
 void AutoConnectCore<T>::handleRequest(void) {
   bool  skipPostTicker;
 
+  // Reflect the configuration updated by the other task.
+  _adoptConfig();
+
+  // Process WiFi events deferred from the SDK event context.
+  _drainWiFiEvents();
+
+#ifdef AUTOCONNECT_USE_LOGGER
+  // Output the log records accumulated since the last call.
+  AutoConnectLog::handle();
+#endif
+
   // Controls reconnection and portal startup when WiFi is disconnected.
   if (WiFi.status() != WL_CONNECTED) {
     _portalStatus &= ~AC_ESTABLISHED;
@@ -568,7 +713,7 @@ void AutoConnectCore<T>::handleRequest(void) {
         _currentHostIP = WiFi.softAPIP();
       }
       if (!_dnsServer) {
-        bool  cs = _onDetectExit ? _onDetectExit(_currentHostIP) : true;
+        bool  cs = _onDetectExit.emit(_currentHostIP);
         if (cs)
           _startDNSServer();
       }
@@ -587,7 +732,7 @@ void AutoConnectCore<T>::handleRequest(void) {
         if (millis() - _attemptPeriod > ((unsigned long)_apConfig.reconnectInterval * AUTOCONNECT_UNITTIME * 1000)) {
           disconnect(false, false);
           _portalStatus &= ~(AC_AUTORECONNECT | AC_INTERRUPT | ~0xf);
-          int8_t  sn = WiFi.scanNetworks(true, true);
+          int8_t  sn = _scanNetworks(true);
           AC_DBG("autoReconnect %s\n", sn == WIFI_SCAN_RUNNING ? "running" : "failed");
           _attemptPeriod = millis();
           (void)(sn);
@@ -596,16 +741,22 @@ void AutoConnectCore<T>::handleRequest(void) {
 
       // After the background scan is complete, seek a connectable
       // access point. If it is found, it will generate a connection
-      // request inside.
+      // request inside. The seeking runs in slices across the
+      // handleClient calls, and the scan results are retained until
+      // it has finished.
       else if (sc != WIFI_SCAN_RUNNING) {
-        AC_DBG("%d network(s) found\n", (int)sc);
+        AC_SEEK_t seek = AC_SEEK_NOTFOUND;
+        if (!_seek)
+          AC_DBG("%d network(s) found\n", (int)sc);
         if (sc > 0) {
-          if (_seekCredential(_apConfig.principle, _rfAdHocBegin ? AC_SEEKMODE_CURRENT : AC_SEEKMODE_ANY)) {
+          seek = _resumeSeekCredential(_apConfig.principle, _rfAdHocBegin ? AC_SEEKMODE_CURRENT : AC_SEEKMODE_ANY);
+          if (seek == AC_SEEK_FOUND) {
             _portalStatus |= AC_AUTORECONNECT;
             _rfConnect = true;
           }
         }
-        WiFi.scanDelete();
+        if (seek != AC_SEEK_PENDING)
+          WiFi.scanDelete();
       }
     }
   }
@@ -634,7 +785,6 @@ void AutoConnectCore<T>::handleRequest(void) {
     *password_c = '\0';
     strncat(password_c, reinterpret_cast<const char*>(_credential.password), sizeof(password_c) - 1);
     AC_DBG("WiFi.begin(%s%s%s) ch(%d)", ssid_c, strlen(password_c) ? "," : "", strlen(password_c) ? password_c : "", (int)ch);
-    _redirectURI = "";
 
     // Establish a WiFi connection with the access point.
     _portalStatus &= ~AC_TIMEOUT;
@@ -644,9 +794,9 @@ void AutoConnectCore<T>::handleRequest(void) {
       // page to notify the connection result.
       // End the current session to complete a response page transmission.
       _rsConnect = _waitForConnect(_apConfig.beginTimeout);
-      do {
-        _webServer->handleClient();
-      } while (_webServer->client());
+      // The persistent connection also ends with the idle timeout.
+      while (_handleSession())
+        yield();
 
       if (_rsConnect == WL_CONNECTED) {
         // WLAN successfully connected then release the DNS server.
@@ -665,7 +815,7 @@ void AutoConnectCore<T>::handleRequest(void) {
           // Successfully conencted
           memcpy(_credential.bssid, WiFi.BSSID(), sizeof(station_config_t::bssid));
           _currentHostIP = WiFi.localIP();
-          _redirectURI = String(F(AUTOCONNECT_URI_ONSUCCESS));
+          _resolveConnect(String(F(AUTOCONNECT_URI_ONSUCCESS)));
 
           // Ensures that keeps a connection with the current AP
           // while the portal behaves.
@@ -681,7 +831,7 @@ void AutoConnectCore<T>::handleRequest(void) {
       }
       else {
         _currentHostIP = WiFi.softAPIP();
-        _redirectURI = String(F(AUTOCONNECT_URI_ONFAIL));
+        _resolveConnect(String(F(AUTOCONNECT_URI_ONFAIL)));
         // Leave station connection completely
         wl_status_t wl = WiFi.status();
         unsigned long tm = millis();
@@ -767,22 +917,26 @@ void AutoConnectCore<T>::handleRequest(void) {
   // Post-process for AutoConnectOTA
   skipPostTicker = _handleOTA();
 
+#ifdef AUTOCONNECT_USE_TICKER
   // Post-process for ticker
-  // Adjust the ticker cycle to the latest WiFi connection state.
-  if (_ticker && !skipPostTicker) {
-    uint8_t   tWidth;
-    uint32_t  tCycle = WiFi.status() == WL_CONNECTED ? 0 : AUTOCONNECT_FLICKER_PERIODDC;
-    tWidth = AUTOCONNECT_FLICKER_WIDTHDC;
-    if (WiFi.getMode() & WIFI_AP) {
-      tCycle = AUTOCONNECT_FLICKER_PERIODAP;
-      tWidth = AUTOCONNECT_FLICKER_WIDTHAP;
-    }
-    if (tCycle != _ticker->getCycle()) {
-      _ticker->stop();
-      if (tCycle)
-        _ticker->start(tCycle, tWidth);
-    }
+  // Reflect the latest WiFi connection state to the ticker pattern.
+  // The ticker ignores the same pattern, it switches to another one
+  // without restarting.
+  if (_ticker) {
+    AutoConnectTicker::AC_TICKERPATTERN_t pattern;
+    if (skipPostTicker)
+      pattern = AutoConnectTicker::AC_TICKER_OTA;
+    else if (WiFi.getMode() & WIFI_AP)
+      pattern = _rsConnect != WL_IDLE_STATUS && _rsConnect != WL_CONNECTED ? AutoConnectTicker::AC_TICKER_ERROR : AutoConnectTicker::AC_TICKER_AP;
+    else if (WiFi.status() != WL_CONNECTED)
+      pattern = AutoConnectTicker::AC_TICKER_CONNECTING;
+    else
+      pattern = AutoConnectTicker::AC_TICKER_OFF;
+    _ticker->setPattern(pattern);
   }
+#else
+  AC_UNUSED(skipPostTicker);
+#endif
 }
 
 /**
@@ -793,7 +947,7 @@ void AutoConnectCore<T>::handleRequest(void) {
  */
 template<typename T>
 void AutoConnectCore<T>::home(const String& uri) {
-  _apConfig.homeUri = uri;
+  updateConfig([&uri](T& c) { c.homeUri = uri; });
 }
 
 /**
@@ -810,7 +964,7 @@ WebServer& AutoConnectCore<T>::host(void) {
  */
 template<typename T>
 void AutoConnectCore<T>::onConnect(ConnectExit_ft fn) {
-  _onConnectExit = fn;
+  _onConnectExit.assign(fn);
 }
 
 /**
@@ -819,7 +973,7 @@ void AutoConnectCore<T>::onConnect(ConnectExit_ft fn) {
  */
 template<typename T>
 void AutoConnectCore<T>::onDetect(DetectExit_ft fn) {
-  _onDetectExit = fn;
+  _onDetectExit.assign(fn);
 }
 
 /**
@@ -881,7 +1035,7 @@ bool AutoConnectCore<T>::restoreCredential(const char* filename, U& fs) {
  */
 template<typename T>
 void AutoConnectCore<T>::whileCaptivePortal(WhileCaptivePortalExit_ft fn) {
-  _whileCaptivePortal = fn;
+  _whileCaptivePortal.assign(fn);
 }
 
 /**
@@ -890,9 +1044,225 @@ void AutoConnectCore<T>::whileCaptivePortal(WhileCaptivePortalExit_ft fn) {
  */
 template<typename T>
 void AutoConnectCore<T>::whileConnecting(WhileConnectingExit_ft fn) {
-  _whileConnecting = fn;
+  _whileConnecting.assign(fn);
 }
 
+/**
+ * Remove all the exit routines subscribed with the context from the
+ * onDetect, onConnect, whileCaptivePortal and whileConnecting.
+ * @param  ctx  The context given at the subscription.
+ */
+template<typename T>
+void AutoConnectCore<T>::unsubscribe(const void* ctx) {
+  _onDetectExit.unsubscribe(ctx);
+  _onConnectExit.unsubscribe(ctx);
+  _whileCaptivePortal.unsubscribe(ctx);
+  _whileConnecting.unsubscribe(ctx);
+}
+
+#ifdef AUTOCONNECT_USE_PORTALTASK
+/**
+ * Starts the portal task that runs AutoConnect::begin and subsequent
+ * handleClient loop on the core specified by AUTOCONNECT_PORTALTASK_CORE.
+ * This function returns immediately, the result of begin is notified
+ * with AC_PORTALEVT_BEGIN event.
+ * @param  ssid       SSID to be connected.
+ * @param  passphrase Password for connection.
+ * @param  timeout    A time out value in milliseconds for waiting connection.
+ * @return true   The portal task has been created.
+ * @return false  The task is already running or could not be created.
+ */
+template<typename T>
+bool AutoConnectCore<T>::beginTask(const char* ssid, const char* passphrase, unsigned long timeout) {
+  if (_portalTask.load()) {
+    AC_DBG("Portal task already running\n");
+    return false;
+  }
+
+  _taskSSID = ssid ? String(ssid) : _emptyString;
+  _taskPassphrase = passphrase ? String(passphrase) : _emptyString;
+  _taskTimeout = timeout;
+  _rfTaskStop.store(false);
+
+  TaskHandle_t  handle = nullptr;
+  BaseType_t  rc = xTaskCreatePinnedToCore(_portalTaskProc, "AutoConnect", AUTOCONNECT_PORTALTASK_STACKSIZE, this, AUTOCONNECT_PORTALTASK_PRIORITY, &handle, AUTOCONNECT_PORTALTASK_CORE);
+  if (rc != pdPASS) {
+    AC_DBG("Portal task creation failed\n");
+    return false;
+  }
+  _portalTask.store(handle);
+  AC_DBG("Portal task started on core %d\n", AUTOCONNECT_PORTALTASK_CORE);
+  return true;
+}
+
+/**
+ * Stops the portal task and waits for it to finish. The captive portal
+ * started by the task is maintained, the sketch can take over the
+ * handleClient loop after this function returns.
+ */
+template<typename T>
+void AutoConnectCore<T>::endTask(void) {
+  if (!_portalTask.load() || xTaskGetCurrentTaskHandle() == _portalTask.load())
+    return;
+
+  _rfTaskStop.store(true);
+  while (_portalTask.load())
+    delay(1);
+  AC_DBG("Portal task stopped\n");
+}
+
+/**
+ * Post a command to the portal task.
+ * @param  command  A command to be processed by the portal task.
+ * @param  arg      An argument depending on the command.
+ * @return true   The command was queued.
+ * @return false  The task is not running or the queue is full.
+ */
+template<typename T>
+bool AutoConnectCore<T>::postCommand(const AC_PORTALCMD_t command, const uint32_t arg) {
+  if (!_portalTask.load())
+    return false;
+  AutoConnectPortalCommand  cmd = { command, arg, nullptr, nullptr };
+  return _taskCommands.push(cmd);
+}
+
+/**
+ * Post a function call that runs in the portal task context.
+ * @param  fn   A function to be called.
+ * @param  ctx  An argument passed to the function.
+ * @return true   The command was queued.
+ * @return false  The task is not running or the queue is full.
+ */
+template<typename T>
+bool AutoConnectCore<T>::postCommand(void (*fn)(void*), void* ctx) {
+  if (!_portalTask.load() || !fn)
+    return false;
+  AutoConnectPortalCommand  cmd = { AC_PORTALCMD_INVOKE, 0, fn, ctx };
+  return _taskCommands.push(cmd);
+}
+
+/**
+ * Receive an event notified from the portal task.
+ * @param  event  Storing area for a received event.
+ * @return true   An event was received.
+ * @return false  No events queued.
+ */
+template<typename T>
+bool AutoConnectCore<T>::receiveEvent(AutoConnectPortalEvent& event) {
+  if (_taskEvents.pop(event))
+    return true;
+  // Tell the sketch that some events were lost once the queue is drained.
+  if (_rfEventOverflow.exchange(false)) {
+    event = { AC_PORTALEVT_OVERFLOW, 0, _taskStatus.load(), 0, millis() };
+    return true;
+  }
+  return false;
+}
+
+/**
+ * An entry of the portal task.
+ * @param  pvParameters AutoConnect instance that created the task.
+ */
+template<typename T>
+void AutoConnectCore<T>::_portalTaskProc(void* pvParameters) {
+  AutoConnectCore<T>* ac = static_cast<AutoConnectCore<T>*>(pvParameters);
+  ac->_runPortalTask();
+  ac->_portalTask.store(nullptr);
+  vTaskDelete(nullptr);
+}
+
+/**
+ * The portal task body. It performs begin, and then repeats the command
+ * dispatching and handleClient until endTask is requested. Changes of
+ * the WiFi connection and the portal status are notified as events.
+ */
+template<typename T>
+void AutoConnectCore<T>::_runPortalTask(void) {
+  const char* ssid = _taskSSID.length() ? _taskSSID.c_str() : nullptr;
+  const char* passphrase = _taskPassphrase.length() ? _taskPassphrase.c_str() : nullptr;
+  _rfTaskBody = true;
+  _taskStatus.store(_portalStatus);
+  _taskConnected = WiFi.status() == WL_CONNECTED;
+  bool  cs = begin(ssid, passphrase, _taskTimeout);
+  _notifyEvent(AC_PORTALEVT_BEGIN, cs);
+
+  while (_serveTask()) {
+    handleClient();
+    vTaskDelay(pdMS_TO_TICKS(AUTOCONNECT_PORTALTASK_INTERVAL));
+  }
+  _rfTaskBody = false;
+}
+
+/**
+ * Dispatch the posted commands and notify the changes of the WiFi
+ * connection and the portal status. The portal task calls it from its
+ * loop and from the captive portal loop of begin, which does not return
+ * while the portal is open.
+ * @return true   Continue the portal task.
+ * @return false  endTask is requested.
+ */
+template<typename T>
+bool AutoConnectCore<T>::_serveTask(void) {
+  AutoConnectPortalCommand  cmd;
+  while (_taskCommands.pop(cmd))
+    _dispatchCommand(cmd);
+
+  bool  connected = WiFi.status() == WL_CONNECTED;
+  if (connected != _taskConnected) {
+    _taskConnected = connected;
+    _notifyEvent(connected ? AC_PORTALEVT_CONNECTED : AC_PORTALEVT_DISCONNECTED);
+  }
+  const uint8_t lastStatus = _taskStatus.load();
+  if (_portalStatus != lastStatus) {
+    _taskStatus.store(_portalStatus);
+    _notifyEvent(AC_PORTALEVT_STATUS, lastStatus);
+  }
+  return !_rfTaskStop.load();
+}
+
+/**
+ * Dispatch a command posted from the sketch in the portal task context.
+ * @param  command  A command to be processed.
+ */
+template<typename T>
+void AutoConnectCore<T>::_dispatchCommand(const AutoConnectPortalCommand& command) {
+  switch (command.command) {
+  case AC_PORTALCMD_DISCONNECT:
+    _rfDisconnect = true;
+    break;
+  case AC_PORTALCMD_RESET:
+    _rfReset = true;
+    break;
+  case AC_PORTALCMD_ENABLEMENU:
+    enableMenu(static_cast<uint16_t>(command.arg));
+    break;
+  case AC_PORTALCMD_DISABLEMENU:
+    disableMenu(static_cast<uint16_t>(command.arg));
+    break;
+  case AC_PORTALCMD_INVOKE:
+    if (command.fn)
+      command.fn(command.ctx);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Notify an event to the sketch. If the sketch does not receive the
+ * events in time, the event is dropped and AC_PORTALEVT_OVERFLOW
+ * will be notified instead.
+ * @param  event  Kind of the event.
+ * @param  arg    An argument depending on the event.
+ */
+template<typename T>
+void AutoConnectCore<T>::_notifyEvent(const AC_PORTALEVT_t event, const uint32_t arg) {
+  AutoConnectPortalEvent  ev = { event, arg, _portalStatus, static_cast<uint32_t>(_currentHostIP), millis() };
+  if (!_taskEvents.push(ev))
+    _rfEventOverflow.store(true);
+}
+#endif
+
 /**
  * Load current available credential
  * @param  ssid       A pointer to the buffer that SSID should be stored.
@@ -926,8 +1296,10 @@ bool AutoConnectCore<T>::_loadAvailCredential(const char* ssid, const AC_PRINCIP
 
   if (credential.entries() > 0) {
     // Scan the vicinity only when the saved credentials are existing.
+    // The scan runs in the background and it sleeps until the scan has
+    // completed, rather than holding the CPU in the synchronous scan.
     if (!ssid) {
-      int8_t  nn = WiFi.scanNetworks(false, true);
+      int16_t nn = _waitForScan(_scanNetworks(true));
       AC_DBG_DUMB(", %d network(s) found", (int)nn);
       if (nn > 0)
         return _seekCredential(principle, excludeCurrent ? AC_SEEKMODE_NEWONE : AC_SEEKMODE_ANY);
@@ -955,11 +1327,16 @@ bool AutoConnectCore<T>::_loadAvailCredential(const char* ssid, const AC_PRINCIP
  */
 template<typename T>
 void AutoConnectCore<T>::_restoreSTA(const station_config_t& staConfig) {
-  _apConfig.staip = static_cast<IPAddress>(staConfig.config.sta.ip);
-  _apConfig.staGateway = static_cast<IPAddress>(staConfig.config.sta.gateway);
-  _apConfig.staNetmask = static_cast<IPAddress>(staConfig.config.sta.netmask);
-  _apConfig.dns1 = static_cast<IPAddress>(staConfig.config.sta.dns1);
-  _apConfig.dns2 = static_cast<IPAddress>(staConfig.config.sta.dns2);
+  // Publish them as a snapshot, the changes made to the working
+  // configuration would be lost at the next adoption.
+  updateConfig([&staConfig](T& c) {
+    c.staip = static_cast<IPAddress>(staConfig.config.sta.ip);
+    c.staGateway = static_cast<IPAddress>(staConfig.config.sta.gateway);
+    c.staNetmask = static_cast<IPAddress>(staConfig.config.sta.netmask);
+    c.dns1 = static_cast<IPAddress>(staConfig.config.sta.dns1);
+    c.dns2 = static_cast<IPAddress>(staConfig.config.sta.dns2);
+  });
+  _adoptConfig();
 }
 
 /**
@@ -968,71 +1345,134 @@ void AutoConnectCore<T>::_restoreSTA(const station_config_t& staConfig) {
  * follows AutoConnectConfig::principle.
  * Either BSSID or SSID of the collation key is determined at compile
  * time according to the AUTOCONNECT_APKEY_SSID definition.
+ * It runs the seeking to the end in the slices, sleeping between them.
+ * Only begin calls it since it needs the credential to connect, and
+ * handleClient resumes the seeking across its calls instead.
  * @param  principle  WiFi connection principle.
  * @param  mode   Seek mode for whether to target a specific SSID.
  * @return true   A matched credential of BSSID was loaded.
  */
 template<typename T>
 bool AutoConnectCore<T>::_seekCredential(const AC_PRINCIPLE_t principle, const AC_SEEKMODE_t mode) {
-  AutoConnectCredential credential(_apConfig.boundaryOffset);
-  station_config_t  validConfig;  // Temporary to find the strongest RSSI.
-  int32_t minRSSI = -120;         // Min value to find the strongest RSSI.
-
-  // Seek SSID
-  const char* currentSSID = WiFi.SSID().c_str();
-  for (uint8_t n = 0; n < WiFi.scanComplete(); n++) {
-    if (mode == AC_SEEKMODE_CURRENT) {
-      // It finds a specific access point that matches the SSID
-      // specified by AutoConnect::begin.
+  AC_SEEK_t rc;
+
+  while ((rc = _resumeSeekCredential(principle, mode)) == AC_SEEK_PENDING) {
+    delay(1);
+#ifdef AUTOCONNECT_USE_LOGGER
+    AutoConnectLog::handle();
+#endif
+  }
+  return rc == AC_SEEK_FOUND;
+}
+
+/**
+ * Seek a connectable access point within a slice of
+ * AUTOCONNECT_SLICE_TIME. The seeking walks the saved credentials once
+ * and collates each with all the scan results, so that the walk can
+ * pause at any credential and resume at the next call. The access point
+ * chosen is the same as the scan results are walked for each credential;
+ * the first one in the scan results with AC_PRINCIPLE_RECENT, and the
+ * strongest one with AC_PRINCIPLE_RSSI.
+ * @param  principle  WiFi connection principle.
+ * @param  mode   Seek mode for whether to target a specific SSID.
+ * @return AC_SEEK_FOUND     A matched credential was loaded.
+ * @return AC_SEEK_NOTFOUND  No credential matched.
+ * @return AC_SEEK_PENDING   The slice has been used up, call again to resume.
+ */
+template<typename T>
+typename AutoConnectCore<T>::AC_SEEK_t AutoConnectCore<T>::_resumeSeekCredential(const AC_PRINCIPLE_t principle, const AC_SEEKMODE_t mode) {
+  const int16_t nn = WiFi.scanComplete();
+
+  if (mode == AC_SEEKMODE_CURRENT) {
+    // It finds a specific access point that matches the SSID
+    // specified by AutoConnect::begin.
+    _seek.reset();
+    for (int16_t n = 0; n < nn; n++)
       if (!strcmp(WiFi.SSID(n).c_str(), reinterpret_cast<const char*>(_credential.ssid)))
-        return true;
-    }
-    else {
-      // Seek valid configuration according to the WiFi connection principle.
-      // Verify that an available SSIDs meet AC_PRINCIPLE_t requirements.
-      for (uint8_t i = 0; i < credential.entries(); i++) {
-        credential.load(i, &_credential);
-        // The access point collation key is determined at compile time
-        // according to the AUTOCONNECT_APKEY_SSID definition, which is
-        // either BSSID or SSID.
-        if (_isValidAP(_credential, n)) {
-          if ((mode == AC_SEEKMODE_NEWONE) && (strlen(currentSSID) > 0))
-            continue;
-          if ((int32_t)WiFi.RSSI(n) < _apConfig.minRSSI) {
-            // Excepts SSID that has weak RSSI under the lower limit.
-            AC_DBG("%s:%ddBm, rejected\n", reinterpret_cast<const char*>(_credential.ssid), (int)WiFi.RSSI(n));
-            continue;
-          }
-          // Determine valid credential
-          switch (principle) {
-          case AC_PRINCIPLE_RECENT:
-            // By BSSID, exit to keep the credential just loaded.
-            _restoreSTA(_credential);
-            return true;
-
-          case AC_PRINCIPLE_RSSI:
-            // Verify that most strong radio signal.
-            // Continue seeking to find the strongest WIFI signal SSID.
-            if ((int32_t)WiFi.RSSI(n) > minRSSI) {
-              minRSSI = WiFi.RSSI(n);
-              memcpy(&validConfig, &_credential, sizeof(station_config_t));
-            }
-            break;
-          }
-          break;
-        }
+        return AC_SEEK_FOUND;
+    return AC_SEEK_NOTFOUND;
+  }
+
+  // Start over if the scan results have been replaced while paused.
+  if (_seek && (_seek->collation.stale(nn, _scanGeneration) || _seek->principle != principle || _seek->mode != mode))
+    _seek.reset();
+  if (!_seek) {
+    _seek.reset(new AC_SEEKSTATE_t(_apConfig.boundaryOffset, principle, mode, nn, _scanGeneration));
+    _seek->credential.rewind();
+  }
+
+  // Seek valid configuration according to the WiFi connection principle.
+  // Verify that an available SSIDs meet AC_PRINCIPLE_t requirements.
+  const bool  newOne = (mode == AC_SEEKMODE_NEWONE) && (WiFi.SSID().length() > 0);
+  AC_SEEKSTATE_t& seek = *_seek;
+  AutoConnectSlice  slice(AUTOCONNECT_SLICE_TIME);
+  const bool  done = slice.run([&]() {
+    if (!seek.credential.next(&seek.entry))
+      return false;
+    if (newOne)
+      return true;
+    const bool  taken = seek.collation.collate([&](const int16_t n) {
+      // The access point collation key is determined at compile time
+      // according to the AUTOCONNECT_APKEY_SSID definition, which is
+      // either BSSID or SSID.
+      if (!_isValidAP(seek.entry, n))
+        return false;
+      const int32_t rssi = WiFi.RSSI(n);
+      if (rssi < _apConfig.minRSSI) {
+        // Excepts SSID that has weak RSSI under the lower limit.
+        AC_DBG("%s:%ddBm, rejected\n", reinterpret_cast<const char*>(seek.entry.ssid), (int)rssi);
+        return false;
       }
-    }
+      return true;
+    }, [](const int16_t n) { return static_cast<int32_t>(WiFi.RSSI(n)); });
+    if (taken)
+      memcpy(&seek.found, &seek.entry, sizeof(station_config_t));
+    return !seek.collation.settled();
+  }, millis);
+
+  if (!done) {
+    AC_DBG("Seeking paused after %u credential(s) in %" PRIu32 "ms\n", (unsigned int)slice.steps(), slice.elapsed());
+    return AC_SEEK_PENDING;
   }
 
-  // Increasing the minSSI will indicate the successfully sought for AC_PRINCIPLE_RSSI.
-  // Restore the credential that has maximum RSSI.
-  if (minRSSI > -120) {
-    memcpy(&_credential, &validConfig, sizeof(station_config_t));
+  // Restore the credential of the access point found.
+  AC_SEEK_t rc = AC_SEEK_NOTFOUND;
+  if (seek.collation.found()) {
+    memcpy(&_credential, &seek.found, sizeof(station_config_t));
     _restoreSTA(_credential);
-    return true;
+    rc = AC_SEEK_FOUND;
   }
-  return false;
+  _seek.reset();
+  return rc;
+}
+
+/**
+ * Start the WiFi scan including the hidden access points. Each scan
+ * advances the scan generation, which tells the paused seeking that the
+ * scan results it was walking have been replaced.
+ * @param  async  Scan in the background.
+ * @return The result of WiFi.scanNetworks.
+ */
+template<typename T>
+int16_t AutoConnectCore<T>::_scanNetworks(const bool async) {
+  _scanGeneration++;
+  return WiFi.scanNetworks(async, true);
+}
+
+/**
+ * Wait for the scan running in the background to complete. It sleeps
+ * between the polls so as not to hold the CPU as the synchronous scan
+ * does.
+ * @param  sc  The result of WiFi.scanNetworks or WiFi.scanComplete.
+ * @return The number of the access points found, or WIFI_SCAN_FAILED.
+ */
+template<typename T>
+int16_t AutoConnectCore<T>::_waitForScan(int16_t sc) {
+  while (sc == WIFI_SCAN_RUNNING) {
+    delay(1);
+    sc = WiFi.scanComplete();
+  }
+  return sc;
 }
 
 /**
@@ -1052,7 +1492,8 @@ void AutoConnectCore<T>::_softAP(void) {
   _configAP();
 #endif
 
-  WiFi.softAP(_apConfig.apid.c_str(), _apConfig.psk.c_str(), _apConfig.channel, _apConfig.hidden);
+  const uint8_t channel = _apConfig.channel ? _apConfig.channel : _selectChannel();
+  WiFi.softAP(_apConfig.apid.c_str(), _apConfig.psk.c_str(), channel, _apConfig.hidden);
   do {
     delay(100);
     yield();
@@ -1069,7 +1510,76 @@ void AutoConnectCore<T>::_softAP(void) {
     } while (WiFi.softAPIP() != _apConfig.apip);
   }
   WiFi.persistent(true);
-  AC_DBG("SoftAP %s/%s Ch(%d) IP:%s %s\n", _apConfig.apid.c_str(), _apConfig.psk.c_str(), _apConfig.channel, WiFi.softAPIP().toString().c_str(), _apConfig.hidden ? "hidden" : "");
+  AC_DBG("SoftAP %s/%s Ch(%d) IP:%s %s\n", _apConfig.apid.c_str(), _apConfig.psk.c_str(), (int)channel, WiFi.softAPIP().toString().c_str(), _apConfig.hidden ? "hidden" : "");
+}
+
+/**
+ * Choose the least congested channel for the SoftAP from the WiFi scan
+ * result. The result that remains from the scan for the credentials is
+ * reused, and the scan is performed only if there is none. The station
+ * that is connected fixes the channel since the SoftAP shares the radio.
+ * @return The channel for the SoftAP.
+ */
+template<typename T>
+uint8_t AutoConnectCore<T>::_selectChannel(void) {
+  if (WiFi.status() == WL_CONNECTED)
+    return static_cast<uint8_t>(WiFi.channel());
+
+  int16_t nn = WiFi.scanComplete();
+  const bool  scanned = nn == WIFI_SCAN_FAILED;
+  if (scanned)
+    nn = _scanNetworks(false);
+  while (nn == WIFI_SCAN_RUNNING) {
+    delay(10);
+    nn = WiFi.scanComplete();
+  }
+
+  uint8_t channel = AUTOCONNECT_AP_CH;
+  if (nn > 0) {
+    std::unique_ptr<AutoConnectChannel::AP_t[]> aps(new AutoConnectChannel::AP_t[nn]);
+    for (int16_t i = 0; i < nn; i++) {
+      aps[i].channel = static_cast<uint8_t>(WiFi.channel(i));
+      aps[i].rssi = static_cast<int8_t>(WiFi.RSSI(i));
+    }
+    channel = AutoConnectChannel::select(aps.get(), nn, AUTOCONNECT_AP_CH_MAX, AUTOCONNECT_AP_CH, AUTOCONNECT_AP_CH_APWEIGHT);
+  }
+  AC_DBG("Ch(%d) chosen from %d network(s)\n", (int)channel, (int)nn);
+  // Discard the result of its own scan so that it is not mistaken for
+  // the background scan of the autoReconnect.
+  if (scanned)
+    WiFi.scanDelete();
+  return channel;
+}
+
+/**
+ * Add the request headers to be retained by the WebServer. The
+ * WebServer::collectHeaders replaces the headers declared so far, so
+ * the headers that the sketch has declared are collected together. The
+ * WebServer adds Authorization by itself.
+ * @param  headers  Names of the headers to be added.
+ * @param  count    Number of the headers.
+ */
+template<typename T>
+void AutoConnectCore<T>::_collectHeaders(const char* headers[], const size_t count) {
+  std::vector<String> names;
+  for (int i = 0; i < _webServer->headers(); i++) {
+    const String  name = _webServer->headerName(i);
+    if (name.length() && !name.equalsIgnoreCase(F("Authorization")))
+      names.push_back(name);
+  }
+  for (size_t i = 0; i < count; i++) {
+    bool  declared = false;
+    for (const String& name : names)
+      if ((declared = name.equalsIgnoreCase(headers[i])))
+        break;
+    if (!declared)
+      names.push_back(String(headers[i]));
+  }
+  std::vector<const char*>  keys;
+  keys.reserve(names.size());
+  for (const String& name : names)
+    keys.push_back(name.c_str());
+  _webServer->collectHeaders(keys.data(), keys.size());
 }
 
 /**
@@ -1097,6 +1607,56 @@ void AutoConnectCore<T>::_startWebServer(void) {
     // AutoConnectCore component. The _registerOnUpload function is overloaded
     // in AutoConnectExt class to enable the upload handler.
     _registerOnUpload(_responsePage.get());
+#ifdef AUTOCONNECT_USE_LOGGER
+    // The log page precedes the PageBuilder to keep it out of the menu.
+    _webServer->on(String(F(AUTOCONNECT_URI_LOG)), HTTP_GET, std::bind(&AutoConnectCore<T>::_handleLog, this));
+#endif
+#ifdef AUTOCONNECT_USE_ASSETS
+    // The assets also precede the PageBuilder. The base stylesheet and
+    // the menu stylesheet stay apart, since the styles of each page come
+    // in between them.
+#ifdef AUTOCONNECT_ASSETS_ONFS
+    static const Asset_t  stylesheet = { PSTR(AUTOCONNECT_ASSET_STYLESHEET), PSTR("text/css"), nullptr, 0 };
+#ifdef AUTOCONNECT_USE_MENU
+    static const Asset_t  menusheet = { PSTR(AUTOCONNECT_ASSET_MENUSHEET), PSTR("text/css"), nullptr, 0 };
+#endif
+#else
+    static const PGM_P  styles[] = { _CSS_BASE };
+    static const Asset_t  stylesheet = { PSTR(AUTOCONNECT_ASSET_STYLESHEET), PSTR("text/css"), styles, 1 };
+#ifdef AUTOCONNECT_USE_MENU
+    static const PGM_P  menus[] = {
+      _CSS_LUXBAR_BODY,
+      _CSS_LUXBAR_HEADER,
+      _CSS_LUXBAR_BGR,
+      _CSS_LUXBAR_ANI,
+      _CSS_LUXBAR_MEDIA,
+      _CSS_LUXBAR_ITEM
+    };
+    static const Asset_t  menusheet = { PSTR(AUTOCONNECT_ASSET_MENUSHEET), PSTR("text/css"), menus, sizeof(menus) / sizeof(menus[0]) };
+#endif
+#endif
+    _attachAsset(&stylesheet);
+#ifdef AUTOCONNECT_USE_MENU
+    _attachAsset(&menusheet);
+#endif
+    _attachAuxAssets();
+#endif
+#if defined(AUTOCONNECT_USE_AUTHSESSION) || defined(AUTOCONNECT_USE_LANGPACK) || defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_ASSETS)
+    // The WebServer retains only the headers declared in advance. They
+    // are added to the headers that the sketch has declared.
+    static const char*  requestHeaders[] = {
+#ifdef AUTOCONNECT_USE_AUTHSESSION
+      "Cookie",
+#endif
+#ifdef AUTOCONNECT_USE_LANGPACK
+      "Accept-Language",
+#endif
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_ASSETS)
+      "Accept-Encoding",
+#endif
+    };
+    _collectHeaders(requestHeaders, sizeof(requestHeaders) / sizeof(requestHeaders[0]));
+#endif
     _responsePage->insert(*_webServer);
 
     _webServer->begin();
@@ -1166,6 +1726,10 @@ bool AutoConnectCore<T>::_captivePortal(void) {
     String location = String(F("http://")) + _webServer->client().localIP().toString() + _getBootUri();
     _webServer->sendHeader(String(F("Location")), location, true);
     _webServer->send(302, String(F("text/plain")), _emptyString);
+    // The connection was made for the foreign host, and the browser opens
+    // another one for the portal of the Location. Close it now rather
+    // than keep it idle, since the WebServer serves one connection at a
+    // time and the idle one would make the portal wait for keepAlive.
     _webServer->client().stop();
     return true;
   }
@@ -1215,8 +1779,12 @@ void AutoConnectCore<T>::_handleNotFound(void) {
     }
     else {
       String html404;
-      PageElement*  page404 = new PageElement(FPSTR(_PAGE_404));
+      AutoConnectPageElement* page404 = new AutoConnectPageElement();
+      page404->setMold(FPSTR(_PAGE_404));
       page404->addToken(F("HEAD"), std::bind(&AutoConnectCore<T>::_token_HEAD, this, std::placeholders::_1));
+#ifdef AUTOCONNECT_USE_LANGPACK
+      page404->addLabels();
+#endif
       page404->build(html404);
       delete page404;
       _webServer->sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")), true);
@@ -1228,6 +1796,224 @@ void AutoConnectCore<T>::_handleNotFound(void) {
   }
 }
 
+#ifdef AUTOCONNECT_USE_LOGGER
+/**
+ * Responds to the AUTOCONNECT_URI_LOG request with the log file and the
+ * records not yet output as text/plain. The content is sent in chunks
+ * through a small buffer without building the whole in the heap.
+ * It requires the credential whenever AutoConnectConfig::auth is
+ * specified regardless of the authScope because the log may contain
+ * the details of the network.
+ */
+template<typename T>
+void AutoConnectCore<T>::_handleLog(void) {
+  if (_apConfig.auth != AC_AUTH_NONE) {
+    const char* user = _apConfig.username.length() ? _apConfig.username.c_str() : _apConfig.apid.c_str();
+    const char* password = _apConfig.password.length() ? _apConfig.password.c_str() : _apConfig.psk.c_str();
+    if (!_authenticate(user, password)) {
+      HTTPAuthMethod  method = _apConfig.auth == AC_AUTH_BASIC ? HTTPAuthMethod::BASIC_AUTH : HTTPAuthMethod::DIGEST_AUTH;
+      _webServer->requestAuthentication(method, AUTOCONNECT_AUTH_REALM);
+      return;
+    }
+  }
+
+#ifdef AUTOCONNECT_USE_DEFLATE
+  // The size of the log is unknown in advance, so it is compressed
+  // whenever the client accepts.
+  const AutoConnectDeflate::AC_DEFLATEFORMAT_t  format = _acceptDeflate();
+  if (format != AutoConnectDeflate::AC_DEFLATE_NONE)
+    _webServer->sendHeader(String(F("Content-Encoding")), String(AutoConnectDeflate::encoding(format)));
+#endif
+  _webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  _webServer->send(200, "text/plain", String(""));
+  ChunkPrint  chunk(*_webServer);
+#ifdef AUTOCONNECT_USE_DEFLATE
+  std::unique_ptr<AutoConnectDeflate> deflate;
+  if (format != AutoConnectDeflate::AC_DEFLATE_NONE)
+    deflate.reset(new AutoConnectDeflate(chunk, format));
+  AutoConnectLog::dump(deflate ? static_cast<Print&>(*deflate) : static_cast<Print&>(chunk));
+  if (deflate)
+    deflate->end();
+#else
+  AutoConnectLog::dump(chunk);
+#endif
+  chunk.send();
+  _webServer->sendContent(String(""));
+}
+#endif
+
+#ifdef AUTOCONNECT_USE_ASSETS
+/**
+ * Register the asset to the web server. The asset is served at
+ * AUTOCONNECT_URI_ASSETS with its name.
+ * @param  asset  The asset to be served.
+ */
+template<typename T>
+void AutoConnectCore<T>::_attachAsset(const Asset_t* asset) {
+  String  uri = String(F(AUTOCONNECT_URI_ASSETS "/")) + String(FPSTR(asset->name));
+  _webServer->on(uri, HTTP_GET, [this, asset]() { _serveAsset(asset); });
+}
+
+/**
+ * Respond the asset. The file of the same name in AUTOCONNECT_ASSETS_PATH
+ * takes precedence over the built-in copy. The precompressed file with
+ * the .gz extension is streamed with the Content-Encoding as is, only to
+ * the client that accepts gzip. The other clients get the plain file.
+ * The response is allowed to be cached long since the links of the
+ * assets are revised by AUTOCONNECT_ASSETS_REVISION.
+ * @param  asset  The asset to be served.
+ */
+template<typename T>
+void AutoConnectCore<T>::_serveAsset(const Asset_t* asset) {
+  static const char cacheControl[] PROGMEM = "public, max-age=" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_ASSETS_MAXAGE);
+  const String  type = String(FPSTR(asset->type));
+
+  if (AutoConnectFS::_isMounted(&AUTOCONNECT_APPLIED_FILESYSTEM)) {
+    const String  path = String(F(AUTOCONNECT_ASSETS_PATH "/")) + String(FPSTR(asset->name));
+    const bool  gzip = AutoConnectDeflate::negotiate(_webServer->header(String(F("Accept-Encoding")))) == AutoConnectDeflate::AC_DEFLATE_GZIP;
+    const String  candidates[] = { gzip ? path + String(F(".gz")) : path, path };
+    for (const String& fn : candidates) {
+      if (AUTOCONNECT_APPLIED_FILESYSTEM.exists(fn)) {
+        fs::File  af = AUTOCONNECT_APPLIED_FILESYSTEM.open(fn, "r");
+        if (af) {
+          // The streamFile adds the Content-Encoding to the .gz file.
+          _webServer->sendHeader(String(F("Cache-Control")), String(FPSTR(cacheControl)));
+          _webServer->sendHeader(String(F("Vary")), String(F("Accept-Encoding")));
+          _webServer->streamFile(af, type);
+          af.close();
+          return;
+        }
+      }
+    }
+  }
+
+  if (!asset->count) {
+    // No built-in copy with AC_ASSETS_ONFS.
+    AC_DBG("%s not found in " AUTOCONNECT_ASSETS_PATH "\n", String(FPSTR(asset->name)).c_str());
+    _webServer->send(404, String(F("text/plain")), String(F("Not found")));
+    return;
+  }
+
+  _webServer->sendHeader(String(F("Cache-Control")), String(FPSTR(cacheControl)));
+#ifdef AUTOCONNECT_USE_DEFLATE
+  if (_sendDeflate(200, type, asset->parts, asset->count))
+    return;
+#endif
+  _webServer->sendHeader(String(F("Vary")), String(F("Accept-Encoding")));
+
+  // Stream the built-in copy directly from the flash.
+  size_t  len = 0;
+  for (uint8_t i = 0; i < asset->count; i++)
+    len += strlen_P(asset->parts[i]);
+  _webServer->setContentLength(len);
+  _webServer->send(200, type, _emptyString);
+  for (uint8_t i = 0; i < asset->count; i++)
+    _webServer->sendContent_P(asset->parts[i]);
+}
+#endif
+
+#ifdef AUTOCONNECT_USE_DEFLATE
+/**
+ * Determine the content coding of the response from the Accept-Encoding
+ * of the request. No coding is applied while the heap is short for the
+ * compressor.
+ * @return The format of the compressed response.
+ */
+template<typename T>
+AutoConnectDeflate::AC_DEFLATEFORMAT_t AutoConnectCore<T>::_acceptDeflate(void) {
+  // The compressor holds twice the window and the hash, and leaves the
+  // margin for the window.
+  if (ESP.getFreeHeap() < AUTOCONNECT_DEFLATE_WINDOW * 3 + (sizeof(uint16_t) << AUTOCONNECT_DEFLATE_HASHBITS)) {
+    AC_DBG("Insufficient heap to deflate\n");
+    return AutoConnectDeflate::AC_DEFLATE_NONE;
+  }
+  return AutoConnectDeflate::negotiate(_webServer->header(String(F("Accept-Encoding"))));
+}
+
+/**
+ * Send the content compressed with the coding that the client accepts.
+ * The encoded bytes are passed to the chunked response as they are
+ * generated, so the content is never compressed into the heap as a
+ * whole. The content smaller than AUTOCONNECT_DEFLATE_THRESHOLD is left
+ * to the caller.
+ * @param  code   HTTP response code
+ * @param  type   Content type
+ * @param  parts  The content to be concatenated, in PROGMEM or in RAM
+ * @param  count  Number of the parts
+ * @return true   The compressed content has been sent.
+ * @return false  The content is not compressed, the caller sends it.
+ */
+template<typename T>
+bool AutoConnectCore<T>::_sendDeflate(const int code, const String& type, const PGM_P* parts, const uint8_t count) {
+  size_t  len = 0;
+  for (uint8_t i = 0; i < count; i++)
+    len += strlen_P(parts[i]);
+  if (len < AUTOCONNECT_DEFLATE_THRESHOLD)
+    return false;
+  const AutoConnectDeflate::AC_DEFLATEFORMAT_t  format = _acceptDeflate();
+  if (format == AutoConnectDeflate::AC_DEFLATE_NONE)
+    return false;
+
+  _webServer->sendHeader(String(F("Content-Encoding")), String(AutoConnectDeflate::encoding(format)));
+  _webServer->sendHeader(String(F("Vary")), String(F("Accept-Encoding")));
+  _webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  _webServer->send(code, type, _emptyString);
+  ChunkPrint  chunk(*_webServer);
+  AutoConnectDeflate  deflate(chunk, format);
+  for (uint8_t i = 0; i < count; i++)
+    deflate.write_P(parts[i], strlen_P(parts[i]));
+  deflate.end();
+  chunk.send();
+  _webServer->sendContent(_emptyString);
+  AC_DBG("%s %u bytes deflated\n", _webServer->uri().c_str(), len);
+  return true;
+}
+
+/**
+ * The handler of the proxy element that stands in for the page to be
+ * compressed. It renders the page in the same way as the PageBuilder.
+ * The rendered page goes straight through the compressor into the
+ * chunked response once it exceeds AUTOCONNECT_DEFLATE_THRESHOLD, so only
+ * the head of the page is held in the heap. The shorter page and the
+ * page for the client that does not accept the compression return to the
+ * PageBuilder as the content of the proxy, and the page whose handler has
+ * already responded, such as the redirection, is discarded.
+ * @param  args  PageArgument of the request
+ * @return The page content if it is not compressed.
+ */
+template<typename T>
+String AutoConnectCore<T>::_deflatePage(PageArgument& args) {
+  class StringPrint : public Print {
+   public:
+    explicit StringPrint(String& s) : _s(s) {}
+    size_t write(uint8_t c) override { return _s.concat(static_cast<char>(c)) ? 1 : 0; }
+    size_t write(const uint8_t* buf, size_t size) override { return _s.concat(reinterpret_cast<const char*>(buf), size) ? size : 0; }
+   private:
+    String& _s;
+  };
+
+  String  content;
+  const AutoConnectDeflate::AC_DEFLATEFORMAT_t  format = _acceptDeflate();
+  if (format == AutoConnectDeflate::AC_DEFLATE_NONE) {
+    StringPrint sp(content);
+    _currentPageElement->render(sp, args);
+    return content;
+  }
+
+  content.reserve(AUTOCONNECT_DEFLATE_THRESHOLD);
+  DeflatePrint  dp(*_webServer, format, content);
+  const size_t  len = _currentPageElement->render(dp, args);
+  if (dp.end()) {
+    _responsePage->cancel();
+    AC_DBG("%s %u bytes deflated\n", _webServer->uri().c_str(), len);
+    return _emptyString;
+  }
+  if (!_webServer->client().connected())
+    return _emptyString;
+  return content;
+}
+#endif
+
 /**
  * Reset the ESP8266 module.
  * It is called from the PageBuilder of the disconnect page and indicates
@@ -1237,7 +2023,7 @@ template<typename T>
 String AutoConnectCore<T>::_induceReset(PageArgument& args) {
   AC_UNUSED(args);
   _rfReset = true;
-  return String(F(AUTOCONNECT_BUTTONLABEL_RESET AUTOCONNECT_TEXT_RESETINPROGRESS));
+  return AutoConnectStrings::str(AC_STR_BUTTON_RESET) + AutoConnectStrings::str(AC_STR_TEXT_RESETINPROGRESS);
 }
 
 /**
@@ -1321,7 +2107,15 @@ String AutoConnectCore<T>::_induceConnect(PageArgument& args) {
     }
   }
 
-  // Turn on the trigger to start WiFi.begin().
+  // Turn on the trigger to start WiFi.begin(). The result of the attempt
+  // is delivered to the requesting client, which is pinned in the table
+  // until then.
+  AC_CLIENTSTATE_t* client = _clients.bound();
+  if (client) {
+    client->redirectURI = String();
+    _clients.pin(static_cast<uint32_t>(_webServer->client().remoteIP()));
+  }
+  _resultURI = String();
   _rfConnect = true;
 
 // Since v0.9.7, the redirect method changed from a 302 response to the
@@ -1346,7 +2140,8 @@ String AutoConnectCore<T>::_induceConnect(PageArgument& args) {
 
 /**
  * Responds response as redirect to the connection result page.
- * A destination as _redirectURI is indicated by loop to establish connection.
+ * A destination is the result of the connection that the requesting client
+ * induced, which is indicated by loop to establish connection.
  */
 template<typename T>
 String AutoConnectCore<T>::_invokeResult(PageArgument& args) {
@@ -1365,8 +2160,16 @@ String AutoConnectCore<T>::_invokeResult(PageArgument& args) {
   // This is the specification as before.
   redirect += _currentHostIP.toString();
 #endif
-  // Request re-query due to attempt connection not completed
-  redirect += _redirectURI.length() ? _redirectURI : String(F(AUTOCONNECT_URI_RESULT));
+  // Request re-query due to attempt connection not completed. A client
+  // that has lost its own result to the eviction takes the result of the
+  // last attempt, rather than re-querying for good.
+  AC_CLIENTSTATE_t* client = _clients.bound();
+  if (client && client->redirectURI.length())
+    redirect += client->redirectURI;
+  else if (_resultURI.length())
+    redirect += _resultURI;
+  else
+    redirect += String(F(AUTOCONNECT_URI_RESULT));
   // Redirect to result page
   _webServer->sendHeader(String(F("Location")), redirect, true);
   _webServer->send(302, String(F("text/plain")), _emptyString);
@@ -1417,22 +2220,88 @@ String AutoConnectCore<T>::_promptDeleteCredential(PageArgument& args) {
   return _emptyString;
 }
 
+/**
+ * Responds a page of the scan results as JSON to the script of the
+ * Configure new AP page. The results of the most recent scan are reused
+ * so that paging the list takes no radio time, and the scan runs only if
+ * the rescan argument is given or no results remain. A scan running in
+ * the background, such as the one of autoReconnect, is waited for rather
+ * than started over. The arguments are:
+ * cursor  Position of the first access point of the page.
+ * gen     Generation of the scan that the previous page came from. The
+ *         paging restarts at the cursor 0 if the scan has been replaced.
+ * count   Number of the access points in a page.
+ * sort    "rssi" for the strongest first, which is the default, or "ssid".
+ * rescan  Scan the access points again before responding.
+ */
+template<typename T>
+String AutoConnectCore<T>::_responseScan(PageArgument& args) {
+  int16_t sc = WiFi.scanComplete();
+  if (sc != WIFI_SCAN_RUNNING && (args.hasArg(String(F("rescan"))) || sc < 0))
+    sc = _scanNetworks(true);
+  if (sc == WIFI_SCAN_RUNNING) {
+    sc = _waitForScan(sc);
+    AC_DBG("%d network(s) found\n", (int)sc);
+  }
+  _scanCount = sc > 0 ? sc : 0;
+
+  AutoConnectScanList list;
+  list.reserve(_scanCount);
+  for (int16_t i = 0; i < _scanCount; i++) {
+    const int32_t rssi = WiFi.RSSI(i);
+    list.add(WiFi.SSID(i).c_str(), rssi, AutoConnectCore<T>::_toWiFiQuality(rssi), WiFi.channel(i), WiFi.encryptionType(i) != ENC_TYPE_NONE);
+  }
+  list.sort(args.arg(String(F("sort"))) == String(F("ssid")) ? AutoConnectScanList::AC_SCANSORT_SSID : AutoConnectScanList::AC_SCANSORT_RSSI);
+
+  long  cursor = args.hasArg(String(F("cursor"))) ? args.arg(String(F("cursor"))).toInt() : 0;
+  if (args.hasArg(String(F("gen"))) && args.arg(String(F("gen"))).toInt() != static_cast<long>(_scanGeneration))
+    cursor = 0;
+  const long  count = args.hasArg(String(F("count"))) ? args.arg(String(F("count"))).toInt() : AUTOCONNECT_SSIDPAGEUNIT_LINES;
+  const size_t  lines = count > 0 ? static_cast<size_t>(count) : AUTOCONNECT_SSIDPAGEUNIT_LINES;
+  String  json;
+  json.reserve(90 + 112 * std::min(lines, list.size()));
+  list.toJson([&json](const char* s, size_t len) { json.concat(s, len); }, cursor > 0 ? static_cast<size_t>(cursor) : 0, lines, _scanGeneration);
+  _webServer->sendHeader(String(F("Cache-Control")), String(F("no-store")));
+  _webServer->send(200, String(F("application/json")), json);
+  _responsePage->cancel();
+  return _emptyString;
+}
+
 /**
  * Classify the requested URI to responsive page builder.
  * There is always only one PageBuilder instance that can exist in
  * AutoConnect for saving RAM. Invokes a subordinate function that
  * dynamically generates a response page at handleRequest. This is
  * a part of the handling of http request originated from handleClient.
+ * The page is built for each client, and the page that the requesting
+ * client has already been given is attached again without rebuilding.
  */
 template<typename T>
 bool AutoConnectCore<T>::_classifyHandle(HTTPMethod method, String uri) {
   AC_UNUSED(method);
   _portalAccessPeriod = millis();
+#ifdef AUTOCONNECT_USE_TRACE
+  _traceRequest(method, uri);
+#endif
   AC_DBG("Host:%s,%s", _webServer->hostHeader().c_str(), uri.c_str());
+  const bool  rebound = _bindClient(_webServer->client().remoteIP());
+
+  bool  relocalized = false;
+#ifdef AUTOCONNECT_USE_LANGPACK
+  // Select the language pack for this request. The page allocated for
+  // the other language is generated again along with the failure page
+  // of the authentication.
+  if (AutoConnectLangPack::select(_webServer->header(String(F("Accept-Language"))).c_str())) {
+    _authFails = String();
+    relocalized = true;
+  }
+#endif
 
   // Here, classify requested uri
-  if (uri == _uri) {
+  if (uri == _uri && !relocalized) {
     AC_DBG_DUMB(",already allocated\n");
+    if (rebound)
+      _attachPage();
     return true;  // The response page already exists.
   }
 
@@ -1452,13 +2321,91 @@ bool AutoConnectCore<T>::_classifyHandle(HTTPMethod method, String uri) {
   if (_currentPageElement) {
     AC_DBG_DUMB(",generated:%s", uri.c_str());
     _uri = uri;
-    _responsePage->addElement(*_currentPageElement);
-    _responsePage->setUri(_uri.c_str());
+    _attachPage();
   }
   AC_DBG_DUMB(",%s\n", _currentPageElement != nullptr ? " allocated" : "ignored");
   return _currentPageElement != nullptr ? true : false;
 }
 
+/**
+ * Attach the page of the bound client to the PageBuilder.
+ */
+template<typename T>
+void AutoConnectCore<T>::_attachPage(void) {
+  PageElement*  elm = _currentPageElement.get();
+  _responsePage->clearElements();
+  if (!elm)
+    return;
+#ifdef AUTOCONNECT_USE_DEFLATE
+  // The page to be compressed is rendered by the proxy instead of the
+  // PageBuilder.
+  _deflateElement.reset();
+  if (_currentPageElement->deflatable()) {
+    _deflateElement.reset(new PageElement(FPSTR("{{DEFLATE}}")));
+    _deflateElement->addToken(FPSTR("DEFLATE"), std::bind(&AutoConnectCore<T>::_deflatePage, this, std::placeholders::_1));
+    elm = _deflateElement.get();
+  }
+#endif
+  _responsePage->addElement(*elm);
+  _responsePage->setUri(_uri.c_str());
+}
+
+/**
+ * Bind the portal state of the requesting client. The state of the
+ * client bound until now is stowed in the table, and the state of the
+ * requesting client is taken out of it. A client that is not in the table
+ * takes over the state of the client idle the longest, other than the
+ * ones that wait for the result of their connection request.
+ * @param  client  Remote address of the request.
+ * @retval true  Another client has been bound.
+ * @retval false The client has been bound already.
+ */
+template<typename T>
+bool AutoConnectCore<T>::_bindClient(const IPAddress& client) {
+  const bool  rebound = _clients.bind(static_cast<uint32_t>(client), millis(), [this](AC_CLIENTSTATE_t& bound) {
+    bound.uri = _uri;
+    bound.page = std::move(_currentPageElement);
+    bound.menuTitle = _menuTitle;
+  }, [this](AC_CLIENTSTATE_t& state) {
+    // The PageBuilder must not refer to the stowed page.
+    _responsePage->clearElements();
+#ifdef AUTOCONNECT_USE_DEFLATE
+    _deflateElement.reset();
+#endif
+    _uri = state.uri;
+    _currentPageElement = std::move(state.page);
+    _menuTitle = state.menuTitle.length() ? state.menuTitle : _apConfig.title;
+  });
+  if (rebound)
+    AC_DBG_DUMB(",client %s", client.toString().c_str());
+  return rebound;
+}
+
+/**
+ * Release the portal state of all clients.
+ */
+template<typename T>
+void AutoConnectCore<T>::_releaseClients(void) {
+  _clients.clear();
+  _resultURI = String();
+  _currentPageElement.reset();
+  _uri = String("");
+}
+
+/**
+ * Deliver the result of the connection attempt to the clients that wait
+ * for it.
+ * @param  redirectURI  The destination of the result page.
+ */
+template<typename T>
+void AutoConnectCore<T>::_resolveConnect(const String& redirectURI) {
+  _resultURI = redirectURI;
+  _clients.unpin([&redirectURI](const uint32_t addr, AC_CLIENTSTATE_t& state) {
+    AC_UNUSED(addr);
+    state.redirectURI = redirectURI;
+  });
+}
+
 /**
  * Purge allocated pages. 
  */
@@ -1469,6 +2416,9 @@ void AutoConnectCore<T>::_purgePages(void) {
     _currentPageElement.reset();
     _uri = String("");
   }
+#ifdef AUTOCONNECT_USE_DEFLATE
+  _deflateElement.reset();
+#endif
 }
 
 /**
@@ -1560,6 +2510,10 @@ wl_status_t AutoConnectCore<T>::_waitForConnect(unsigned long timeout) {
   // Connection waiting
   while ((wifiStatus = WiFi.status()) != WL_CONNECTED) {
     yield();
+#ifdef AUTOCONNECT_USE_LOGGER
+    // The ring would overflow during the wait without handleClient.
+    AutoConnectLog::handle();
+#endif
     unsigned long ct = millis();
     if (timeout) {
       if (ct - wt > timeout) {
@@ -1567,12 +2521,10 @@ wl_status_t AutoConnectCore<T>::_waitForConnect(unsigned long timeout) {
         break;
       }
     }
-    if (_whileConnecting) {
-      if ((exitInterrupt = !_whileConnecting(appliedSSID))) {
-        _portalStatus |= AC_INTERRUPT;
-        AC_DBG_DUMB("interrupted\n");
-        break;
-      }
+    if ((exitInterrupt = !_whileConnecting.emit(appliedSSID))) {
+      _portalStatus |= AC_INTERRUPT;
+      AC_DBG_DUMB("interrupted\n");
+      break;
     }
     if (ct - pt > 300) {
       AC_DBG_DUMB("%c", '.');
@@ -1592,8 +2544,7 @@ wl_status_t AutoConnectCore<T>::_waitForConnect(unsigned long timeout) {
       localIP = WiFi.localIP();
     }
     AC_DBG_DUMB(" IP:%s\n", localIP.toString().c_str());
-    if (_onConnectExit)
-      _onConnectExit(localIP);
+    _onConnectExit.emit(localIP);
   }
   else if (!exitInterrupt) {
     AC_DBG_DUMB("timeout\n");
@@ -1612,15 +2563,23 @@ template<typename T>
 void AutoConnectCore<T>::_setReconnect(const AC_STARECONNECT_t order) {
 #if defined(ARDUINO_ARCH_ESP32)
   if (order == AC_RECONNECT_SET) {
-    _disconnectEventId = WiFi.onEvent([](WiFiEvent_t e, WiFiEventInfo_t info) {
-      AC_DBG("STA lost connection:%d\n", info.AC_ESP_WIFIEVENTINFO_DECLARE(disconnected).reason);
-      AC_DBG("STA connection %s\n", WiFi.reconnect() ? "restored" : "failed");
+    // The ids of WiFi.onEvent start at 1, 0 means no handler. The handler
+    // is registered only once however many times the order is given.
+    if (_disconnectEventId)
+      return;
+    // The handler runs in the event task of the SDK. It only posts the
+    // event, the reconnection is processed by handleRequest.
+    _disconnectEventId = WiFi.onEvent([this](WiFiEvent_t e, WiFiEventInfo_t info) {
+      AC_WIFIEVENT_t  ev = { static_cast<int32_t>(e), static_cast<uint8_t>(info.AC_ESP_WIFIEVENTINFO_DECLARE(disconnected).reason) };
+      if (!_wifiEvents.push(ev))
+        _rfWiFiEventOverflow = true;
     }, WiFiEvent_t::AC_ESP_WIFIEVENT_DECLARE(AP_STADISCONNECTED));
     AC_DBG("Event<%d> handler registered\n", static_cast<int>(WiFiEvent_t::AC_ESP_WIFIEVENT_DECLARE(AP_STADISCONNECTED)));
   }
   else if (order == AC_RECONNECT_RESET) {
     if (_disconnectEventId) {
       WiFi.removeEvent(_disconnectEventId);
+      _disconnectEventId = 0;
       AC_DBG("Event<%d> handler released\n", static_cast<int>(WiFiEvent_t::AC_ESP_WIFIEVENT_DECLARE(AP_STADISCONNECTED)));
     }
   }
@@ -1631,6 +2590,175 @@ void AutoConnectCore<T>::_setReconnect(const AC_STARECONNECT_t order) {
 #endif
 }
 
+/**
+ * Consume the WiFi events posted by the SDK event handler. It runs in
+ * the handleRequest context, so the state of the portal and the WiFi
+ * API can be touched without any locks.
+ */
+template<typename T>
+void AutoConnectCore<T>::_drainWiFiEvents(void) {
+  AC_WIFIEVENT_t  ev;
+
+  while (_wifiEvents.pop(ev)) {
+#if defined(ARDUINO_ARCH_ESP32)
+    if (ev.event == static_cast<int32_t>(WiFiEvent_t::AC_ESP_WIFIEVENT_DECLARE(AP_STADISCONNECTED))) {
+      AC_DBG("STA lost connection:%d\n", ev.reason);
+      // The event may be stale by the time it is drained. Leave the link
+      // alone if it has been restored in the meantime.
+      if (WiFi.status() == WL_CONNECTED)
+        AC_DBG("STA connection alive\n");
+      else {
+        // AC_DBG may be empty, so the reconnect must not be its argument.
+        const bool  rc = WiFi.reconnect();
+        AC_DBG("STA connection %s\n", rc ? "restored" : "failed");
+        (void)rc;
+      }
+    }
+#endif
+  }
+  if (_rfWiFiEventOverflow) {
+    _rfWiFiEventOverflow = false;
+    AC_DBG("WiFi events overflowed\n");
+  }
+}
+
+/**
+ * Run the web server for one round and keep track of the persistent
+ * connection. The WebServer serves only one connection at a time, and
+ * the connection that the browser keeps idle makes the others wait.
+ * So the connection is closed when it has been idle longer than
+ * AutoConnectConfig::keepAlive or has served keepAliveMax requests.
+ * The pipelined request that has already arrived is served before it.
+ * A new connection is counted as having served the first request since
+ * the WebServer accepts it and reads the request at once.
+ * It needs to run the WebServer by itself to see each request, so the
+ * Sketch that calls WebServer::handleClient and handleRequest leaves the
+ * persistent connection to the WebServer.
+ * @return true   The connection remains.
+ * @return false  No connection.
+ */
+template<typename T>
+bool AutoConnectCore<T>::_handleSession(void) {
+  // Refer to the client of the WebServer itself. A copy shares the
+  // socket on ESP32, and stopping the copy leaves the WebServer's open.
+  WiFiClient& client = _webServer->client();
+  const bool  requested = client.connected() && client.available();
+  _webServer->handleClient();
+
+  if (!client.connected()) {
+    _sessionPort = 0;
+    return false;
+  }
+  // Leave the connection to the WebServer.
+  if (!_apConfig.keepAlive)
+    return true;
+
+  const unsigned long now = millis();
+  if (client.remotePort() != _sessionPort || client.remoteIP() != _sessionPeer) {
+    _sessionPeer = client.remoteIP();
+    _sessionPort = client.remotePort();
+    _sessionRequests = 1;
+    _sessionActive = now;
+  }
+  else if (requested) {
+    if (_sessionRequests < 0xff)
+      _sessionRequests++;
+    _sessionActive = now;
+  }
+
+  if (client.available())
+    return true;
+  if (now - _sessionActive >= _apConfig.keepAlive || _sessionRequests >= _apConfig.keepAliveMax) {
+    AC_DBG("Session %s:%u closed, %u requests\n", _sessionPeer.toString().c_str(), _sessionPort, _sessionRequests);
+    client.stop();
+    _sessionPort = 0;
+    return false;
+  }
+  return true;
+}
+
+#ifdef AUTOCONNECT_USE_TRACE
+/**
+ * Trace the request for the traffic replay. The free heap size at the
+ * arrival of the request is attached to the response, and the request is
+ * printed as a TRACE line with the arguments in the urlencoded form. The
+ * values of the credentials are replaced with AUTOCONNECT_TRACE_REDACTED.
+ * @param  method  HTTP method of the request
+ * @param  uri     Requested URI
+ */
+template<typename T>
+void AutoConnectCore<T>::_traceRequest(HTTPMethod method, const String& uri) {
+  const uint32_t  heap = ESP.getFreeHeap();
+  _webServer->sendHeader(F("X-AutoConnect-Heap"), String(heap));
+
+#ifdef AC_DEBUG
+  const char* verb;
+  switch (method) {
+  case HTTP_GET:
+    verb = "GET";
+    break;
+  case HTTP_POST:
+    verb = "POST";
+    break;
+  case HTTP_PUT:
+    verb = "PUT";
+    break;
+  case HTTP_DELETE:
+    verb = "DELETE";
+    break;
+  case HTTP_HEAD:
+    verb = "HEAD";
+    break;
+  default:
+    verb = "OTHER";
+  }
+
+  // The passphrase and the other credentials are not printed. It takes
+  // the arguments whose name contains "pass", such as the Passphrase of
+  // the Configure new AP page, and the psk of AutoConnectConfigAux.
+  String  args;
+  for (int i = 0; i < _webServer->args(); i++) {
+    String  name = _webServer->argName(i);
+    if (i)
+      args += '&';
+    args += _urlEncode(name) + '=';
+    name.toLowerCase();
+    if (name.indexOf(String(F("pass"))) >= 0 || name == String(F("psk")))
+      args += String(F(AUTOCONNECT_TRACE_REDACTED));
+    else
+      args += _urlEncode(_webServer->arg(i));
+  }
+  AC_DBG("TRACE,%lu,%s,%" PRIu32 ",%s,%s\n", millis(), verb, heap, uri.c_str(), args.c_str());
+#else
+  AC_UNUSED(method);
+  AC_UNUSED(uri);
+#endif
+}
+
+/**
+ * Percent-encode the string except for the unreserved characters.
+ * @param  s  The string to be encoded
+ * @return The encoded string.
+ */
+template<typename T>
+String AutoConnectCore<T>::_urlEncode(const String& s) {
+  static const char hex[] PROGMEM = "0123456789ABCDEF";
+  String  encoded;
+  encoded.reserve(s.length());
+  for (size_t i = 0; i < s.length(); i++) {
+    const char  c = s[i];
+    if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~')
+      encoded += c;
+    else {
+      encoded += '%';
+      encoded += static_cast<char>(pgm_read_byte(&hex[(c >> 4) & 0x0f]));
+      encoded += static_cast<char>(pgm_read_byte(&hex[c & 0x0f]));
+    }
+  }
+  return encoded;
+}
+#endif
+
 /**
  * Wait for the end of transmission of the http response by closed
  * from the http client. 
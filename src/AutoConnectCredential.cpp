@@ -93,6 +93,11 @@ bool AutoConnectCredential::del(const char* ssid) {
 
   if (load(ssid, &entry) >= 0) {
     // Saved credential detected, _ep has the entry location.
+    // The byte loops below are not sliced as the seeking is. They write
+    // one entry of at most some 130 bytes into the RAM image of the
+    // EEPROM, which takes microseconds, and the commit that writes the
+    // flash sector cannot be split. An entry left half erased across the
+    // slices would also be seen by the other instances.
     _eeprom->begin(AC_HEADERSIZE + _containSize);
     _dp = _ep;
 
@@ -181,6 +186,35 @@ bool AutoConnectCredential::load(int8_t entry, station_config_t* config) {
   }
 }
 
+/**
+ *  Start walking the entries from the first one with next.
+ */
+void AutoConnectCredential::rewind(void) {
+  _cursor = 0;
+  _dp = AC_HEADERSIZE;
+}
+
+/**
+ *  Load the entry next to the one loaded last, starting from the first
+ *  after rewind. The EEPROM stays open while walking, so each entry is
+ *  read once instead of walking from the first entry as load does.
+ *  The walk must not be interleaved with other operations of the same
+ *  instance.
+ *  @param  config  A station_config structure pointer.
+ *  @retval true    The entry loaded.
+ *          false   All entries have been walked.
+ */
+bool AutoConnectCredential::next(station_config_t* config) {
+  if (_cursor >= _entries)
+    return false;
+  if (!_cursor)
+    _eeprom->begin(AC_HEADERSIZE + _containSize);
+  _retrieveEntry(config);
+  if (++_cursor >= _entries)
+    _eeprom->end();
+  return true;
+}
+
 /**
  *  Save SSID and password to EEPROM.
  *  When the same SSID already exists, it will be replaced. If the current
@@ -200,7 +234,8 @@ bool AutoConnectCredential::save(const station_config_t* config) {
   // Detect same entry for replacement.
   entry = load(reinterpret_cast<const char*>(config->ssid), &stage);
 
-  // Saving start.
+  // Saving start. The byte loops are not sliced for the same reason as
+  // del, they only touch the RAM image of the EEPROM until the commit.
   _eeprom->begin(AC_HEADERSIZE + _containSize + sizeof(station_config_t));
 
   // Determine insertion or replacement.
@@ -231,9 +266,6 @@ bool AutoConnectCredential::save(const station_config_t* config) {
     _eeprom->write(i + _offset, _entries);
   }
 
-  rc = _eeprom->commit();
-  delay(10);
-
   // Seek insertion point, evaluate capacity to insert the new entry.
   uint16_t eSize = strlen(reinterpret_cast<const char*>(config->ssid)) + strlen(reinterpret_cast<const char*>(config->password)) + sizeof(station_config_t::bssid) + sizeof(station_config_t::dhcp);
   if (config->dhcp == (uint8_t)STA_STATIC)
@@ -289,7 +321,9 @@ bool AutoConnectCredential::save(const station_config_t* config) {
     _eeprom->write(_offset + sizeof(AC_IDENTIFIER) - 1 + sizeof(uint8_t) + 1, (uint8_t)(_containSize >> 8));
   }
 
-  rc &= _eeprom->commit();
+  // The release of the replaced entry and the new entry are committed
+  // at once, which erases the flash sector only once.
+  rc = _eeprom->commit();
   delay(10);
   _eeprom->end();
 
@@ -533,6 +567,32 @@ bool AutoConnectCredential::load(int8_t entry, station_config_t* config) {
   return false;
 }
 
+/**
+ *  Start walking the entries from the first one with next. The entries
+ *  are imported from the nvs only here.
+ */
+void AutoConnectCredential::rewind(void) {
+  _entries = _import();
+  _cursor = 0;
+}
+
+/**
+ *  Load the entry next to the one loaded last from the internal
+ *  dictionary, starting from the first after rewind. It does not
+ *  import the nvs again as load does.
+ *  @param  config  A station_config structure pointer.
+ *  @retval true    The entry loaded.
+ *          false   All entries have been walked.
+ */
+bool AutoConnectCredential::next(station_config_t* config) {
+  if (_cursor >= _credit.size())
+    return false;
+  AC_CREDT_t::iterator  it = _credit.begin();
+  std::advance(it, _cursor++);
+  _obtain(it, config);
+  return true;
+}
+
 /**
  *  Save SSID and password to Preferences.
  *  When the same SSID already exists, it will be replaced. If the current
@@ -80,13 +80,15 @@ typedef struct {
 class AutoConnectCredentialBase {
  public:
   // explicit AutoConnectCredentialBase() : _entries(0), _containSize(0), _ensureFS(false) {}
-  explicit AutoConnectCredentialBase() : _entries(0), _containSize(0) {}
+  explicit AutoConnectCredentialBase() : _entries(0), _containSize(0), _cursor(0) {}
   virtual ~AutoConnectCredentialBase() {}
   virtual uint8_t entries(void) { return _entries; }
   virtual uint16_t dataSize(void) const { return sizeof(AC_IDENTIFIER) - 1 + sizeof(uint8_t) + sizeof(uint16_t) + _containSize; }
   virtual bool    del(const char* ssid) = 0;
   virtual int8_t  load(const char* ssid, station_config_t* config) = 0;
   virtual bool    load(int8_t entry, station_config_t* config) = 0;
+  virtual void    rewind(void) { _cursor = 0; }
+  virtual bool    next(station_config_t* config) { return _cursor < entries() && load(static_cast<int8_t>(_cursor++), config); }
   virtual bool    save(const station_config_t* config) = 0;
   virtual bool    backup(Stream& out) = 0;
   virtual bool    restore(Stream& in) = 0;
@@ -96,6 +98,7 @@ class AutoConnectCredentialBase {
 
   uint8_t   _entries;       /**< Count of the available entry */
   uint16_t  _containSize;   /**< Container size */
+  uint8_t   _cursor;        /**< Number of the entries walked by next */
 };
 
 #if AC_CREDENTIAL_PREFERENCES == 0
@@ -115,6 +118,8 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
   bool    save(const station_config_t* config) override;
   bool    backup(Stream& out) override;
   bool    restore(Stream& in) override;
+  void    rewind(void) override;
+  bool    next(station_config_t* config) override;
 
  protected:
   void    _allocateEntry(void) override;  /**< Initialize storage for credentials. */
@@ -137,6 +142,7 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
 #else
 // #pragma message "AutoConnectCredential applies the Preferences"
 #include <type_traits>
+#include <iterator>
 #include <map>
 #include <Preferences.h>
 #include <nvs.h>
@@ -162,6 +168,8 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
   bool    save(const station_config_t* config) override;
   bool    backup(Stream& out) override;
   bool    restore(Stream& in) override;
+  void    rewind(void) override;
+  bool    next(station_config_t* config) override;
 
  protected:
   void    _allocateEntry(void) override;  /**< Initialize storage for credentials. */
@@ -0,0 +1,338 @@
+/**
+ * AutoConnectDeflate class implementation.
+ * @file AutoConnectDeflate.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectDefs.h"
+
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_ASSETS)
+#include "AutoConnectDeflate.h"
+
+#ifdef AUTOCONNECT_USE_DEFLATE
+
+namespace {
+  // Base values of the length codes 257 to 285
+  const uint16_t  _lengthBase[] PROGMEM = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+  };
+  // Base values of the distance codes 0 to 29
+  const uint16_t  _distBase[] PROGMEM = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+  };
+  // CRC32 for each nibble
+  const uint32_t  _crcTable[] PROGMEM = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+  };
+}
+
+/**
+ * Start the compressed stream. The header of the format and the header
+ * of the single block encoded with the fixed Huffman codes are emitted.
+ * @param  out     Destination of the compressed stream
+ * @param  format  Format of the stream
+ */
+AutoConnectDeflate::AutoConnectDeflate(Print& out, const AC_DEFLATEFORMAT_t format)
+  : _out(out), _format(format), _window(new uint8_t[_WINDOW * 2]), _head(new uint16_t[_HASHSIZE]), _pos(0), _end(0), _bitBuf(0), _bitCount(0), _total(0), _outLen(0), _ended(false) {
+  for (uint16_t i = 0; i < _HASHSIZE; i++)
+    _head[i] = _NIL;
+
+  if (_format == AC_DEFLATE_GZIP) {
+    static const uint8_t  gzipHeader[] PROGMEM = { 0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff };
+    for (uint8_t i = 0; i < sizeof(gzipHeader); i++)
+      _putByte(pgm_read_byte(&gzipHeader[i]));
+    _check = 0;
+  }
+  else {
+    // CMF and FLG of the 32K window with no dictionary
+    _putByte(0x78);
+    _putByte(0x01);
+    _check = 1;
+  }
+  // BFINAL and BTYPE of the fixed Huffman codes
+  _putBits(1, 1);
+  _putBits(1, 2);
+}
+
+/**
+ * Compress the content.
+ * @param  buf   The content to be compressed
+ * @param  size  Size of the content
+ * @return Size of the content consumed.
+ */
+size_t AutoConnectDeflate::write(const uint8_t* buf, size_t size) {
+  if (_ended)
+    return 0;
+
+  // Update the check value over the original content.
+  if (_format == AC_DEFLATE_GZIP) {
+    uint32_t  crc = ~_check;
+    for (size_t i = 0; i < size; i++) {
+      crc ^= buf[i];
+      crc = (crc >> 4) ^ pgm_read_dword(&_crcTable[crc & 0x0f]);
+      crc = (crc >> 4) ^ pgm_read_dword(&_crcTable[crc & 0x0f]);
+    }
+    _check = ~crc;
+  }
+  else {
+    uint32_t  a = _check & 0xffff;
+    uint32_t  b = _check >> 16;
+    for (size_t i = 0; i < size; i++) {
+      if ((a += buf[i]) >= 65521)
+        a -= 65521;
+      if ((b += a) >= 65521)
+        b -= 65521;
+    }
+    _check = (b << 16) | a;
+  }
+  _total += size;
+
+  size_t  rest = size;
+  while (rest) {
+    const size_t  n = std::min(rest, static_cast<size_t>(_WINDOW * 2 - _end));
+    memcpy(&_window[_end], buf, n);
+    _end += n;
+    buf += n;
+    rest -= n;
+    if (_end == _WINDOW * 2) {
+      _compress(false);
+      _slide();
+    }
+  }
+  return size;
+}
+
+/**
+ * Compress the content placed in PROGMEM.
+ * @param  buf   The content in PROGMEM
+ * @param  size  Size of the content
+ * @return Size of the content consumed.
+ */
+size_t AutoConnectDeflate::write_P(PGM_P buf, size_t size) {
+  uint8_t chunk[64];
+  size_t  rest = size;
+  while (rest) {
+    const size_t  n = std::min(rest, sizeof(chunk));
+    memcpy_P(chunk, buf, n);
+    write(chunk, n);
+    buf += n;
+    rest -= n;
+  }
+  return size;
+}
+
+/**
+ * Terminate the stream. The remaining content is encoded and the trailer
+ * of the format is emitted.
+ */
+void AutoConnectDeflate::end(void) {
+  if (_ended)
+    return;
+  _compress(true);
+  // End of the block
+  _literal(256);
+  if (_bitCount)
+    _putBits(0, 8 - _bitCount);
+
+  if (_format == AC_DEFLATE_GZIP) {
+    for (uint8_t i = 0; i < 4; i++)
+      _putByte(static_cast<uint8_t>(_check >> (i * 8)));
+    for (uint8_t i = 0; i < 4; i++)
+      _putByte(static_cast<uint8_t>(_total >> (i * 8)));
+  }
+  else {
+    for (int8_t i = 3; i >= 0; i--)
+      _putByte(static_cast<uint8_t>(_check >> (i * 8)));
+  }
+  _flushOut();
+  _ended = true;
+}
+
+#endif // !AUTOCONNECT_USE_DEFLATE
+
+/**
+ * Choose the format from the Accept-Encoding. The gzip takes precedence
+ * over the deflate, and the coding with the quality value 0 is refused.
+ * @param  acceptEncoding  A value of the Accept-Encoding header
+ * @return The format to be applied.
+ */
+AutoConnectDeflate::AC_DEFLATEFORMAT_t AutoConnectDeflate::negotiate(const String& acceptEncoding) {
+  AC_DEFLATEFORMAT_t  format = AC_DEFLATE_NONE;
+  const char* cp = acceptEncoding.c_str();
+
+  while (*cp) {
+    while (*cp == ' ' || *cp == ',')
+      cp++;
+    const char* coding = cp;
+    while (*cp && *cp != ';' && *cp != ',' && *cp != ' ')
+      cp++;
+    const size_t  len = cp - coding;
+    bool  refused = false;
+    while (*cp && *cp != ',') {
+      if (*cp == 'q' && cp[1] == '=')
+        refused = atof(cp + 2) <= 0;
+      cp++;
+    }
+    if (refused)
+      continue;
+    if (len == 4 && !strncasecmp_P(coding, PSTR("gzip"), len))
+      return AC_DEFLATE_GZIP;
+    if (len == 7 && !strncasecmp_P(coding, PSTR("deflate"), len))
+      format = AC_DEFLATE_ZLIB;
+  }
+  return format;
+}
+
+/**
+ * Returns the content coding of the format.
+ * @param  format  Format of the stream
+ * @return A value of the Content-Encoding header.
+ */
+const __FlashStringHelper* AutoConnectDeflate::encoding(const AC_DEFLATEFORMAT_t format) {
+  return format == AC_DEFLATE_GZIP ? F("gzip") : format == AC_DEFLATE_ZLIB ? F("deflate") : F("identity");
+}
+
+#ifdef AUTOCONNECT_USE_DEFLATE
+/**
+ * Encode the content in the window. Unless it flushes, the lookahead of
+ * the longest match is left to the next.
+ * @param  flush  Encode all the content.
+ */
+void AutoConnectDeflate::_compress(const bool flush) {
+  const uint16_t  limit = flush ? _end : _end - _MAXMATCH;
+
+  while (_pos < limit) {
+    uint16_t  len = 0;
+    uint16_t  dist = 0;
+    if (_end - _pos >= _MINMATCH) {
+      const uint16_t  h = _hash(_pos);
+      const uint16_t  candidate = _head[h];
+      _head[h] = _pos;
+      if (candidate != _NIL) {
+        const uint16_t  most = _end - _pos < _MAXMATCH ? _end - _pos : _MAXMATCH;
+        const uint8_t*  s = &_window[candidate];
+        const uint8_t*  p = &_window[_pos];
+        uint16_t  n = 0;
+        while (n < most && s[n] == p[n])
+          n++;
+        if (n >= _MINMATCH) {
+          len = n;
+          dist = _pos - candidate;
+        }
+      }
+    }
+
+    if (len) {
+      _match(len, dist);
+      // Register the positions inside the match to the hash as well.
+      for (uint16_t i = 1; i < len && _pos + i + _MINMATCH <= _end; i++)
+        _head[_hash(_pos + i)] = _pos + i;
+      _pos += len;
+    }
+    else
+      _literal(_window[_pos++]);
+  }
+}
+
+/**
+ * Discard the older half of the window.
+ */
+void AutoConnectDeflate::_slide(void) {
+  memmove(&_window[0], &_window[_WINDOW], _WINDOW);
+  _pos -= _WINDOW;
+  _end -= _WINDOW;
+  for (uint16_t i = 0; i < _HASHSIZE; i++)
+    _head[i] = _head[i] != _NIL && _head[i] >= _WINDOW ? _head[i] - _WINDOW : _NIL;
+}
+
+/**
+ * Emit a literal or the end of the block with the fixed Huffman code.
+ * @param  c  Literal value, 256 for the end of the block
+ */
+void AutoConnectDeflate::_literal(const uint16_t c) {
+  if (c < 144)
+    _putCode(0x30 + c, 8);
+  else if (c < 256)
+    _putCode(0x190 + c - 144, 9);
+  else if (c < 280)
+    _putCode(c - 256, 7);
+  else
+    _putCode(0xc0 + c - 280, 8);
+}
+
+/**
+ * Emit a match with the length code and the distance code.
+ * @param  len   Length of the match
+ * @param  dist  Distance to the match
+ */
+void AutoConnectDeflate::_match(const uint16_t len, const uint16_t dist) {
+  uint8_t code = sizeof(_lengthBase) / sizeof(_lengthBase[0]) - 1;
+  while (pgm_read_word(&_lengthBase[code]) > len)
+    code--;
+  _literal(257 + code);
+  const uint8_t lengthExtra = code < 8 || code == 28 ? 0 : (code - 4) >> 2;
+  if (lengthExtra)
+    _putBits(len - pgm_read_word(&_lengthBase[code]), lengthExtra);
+
+  code = sizeof(_distBase) / sizeof(_distBase[0]) - 1;
+  while (pgm_read_word(&_distBase[code]) > dist)
+    code--;
+  _putCode(code, 5);
+  const uint8_t distExtra = code < 4 ? 0 : (code >> 1) - 1;
+  if (distExtra)
+    _putBits(dist - pgm_read_word(&_distBase[code]), distExtra);
+}
+
+/**
+ * Emit a Huffman code, which is packed starting with the most significant
+ * bit unlike the other values.
+ * @param  code  Huffman code
+ * @param  len   Length of the code in bits
+ */
+void AutoConnectDeflate::_putCode(const uint16_t code, const uint8_t len) {
+  uint16_t  reversed = 0;
+  for (uint8_t i = 0; i < len; i++)
+    reversed |= ((code >> i) & 1) << (len - 1 - i);
+  _putBits(reversed, len);
+}
+
+/**
+ * Emit the bits starting with the least significant bit.
+ * @param  bits  Value of the bits
+ * @param  len   Number of the bits
+ */
+void AutoConnectDeflate::_putBits(const uint32_t bits, const uint8_t len) {
+  _bitBuf |= bits << _bitCount;
+  _bitCount += len;
+  while (_bitCount >= 8) {
+    _putByte(static_cast<uint8_t>(_bitBuf));
+    _bitBuf >>= 8;
+    _bitCount -= 8;
+  }
+}
+
+void AutoConnectDeflate::_putByte(const uint8_t c) {
+  _outBuf[_outLen++] = c;
+  if (_outLen >= sizeof(_outBuf))
+    _flushOut();
+}
+
+void AutoConnectDeflate::_flushOut(void) {
+  if (_outLen)
+    _out.write(_outBuf, _outLen);
+  _outLen = 0;
+}
+
+uint16_t AutoConnectDeflate::_hash(const uint16_t pos) const {
+  const uint32_t  v = (_window[pos] << 16) | (_window[pos + 1] << 8) | _window[pos + 2];
+  return static_cast<uint16_t>(static_cast<uint32_t>(v * 2654435761UL) >> (32 - AUTOCONNECT_DEFLATE_HASHBITS));
+}
+
+#endif // !AUTOCONNECT_USE_DEFLATE
+#endif // !AUTOCONNECT_USE_DEFLATE && !AUTOCONNECT_USE_ASSETS
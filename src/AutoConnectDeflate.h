@@ -0,0 +1,74 @@
+/**
+ * Declaration of AutoConnectDeflate class.
+ * AutoConnectDeflate is a streaming compressor that encodes the content
+ * written to it into the gzip or the zlib format, and passes the encoded
+ * bytes to the output one after another. It applies LZ77 with a small
+ * window and the fixed Huffman codes of the deflate, so the memory it
+ * occupies is bounded by AUTOCONNECT_DEFLATE_WINDOW regardless of the
+ * content size.
+ * @file AutoConnectDeflate.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTDEFLATE_H_
+#define _AUTOCONNECTDEFLATE_H_
+
+#include <memory>
+#include <Arduino.h>
+#include "AutoConnectDefs.h"
+
+class AutoConnectDeflate : public Print {
+ public:
+  /**< Format of the compressed stream, it corresponds to the content coding */
+  typedef enum {
+    AC_DEFLATE_NONE,        /**< Not compressed */
+    AC_DEFLATE_GZIP,        /**< gzip, RFC1952 */
+    AC_DEFLATE_ZLIB         /**< deflate, RFC1950 */
+  } AC_DEFLATEFORMAT_t;
+
+  AutoConnectDeflate(Print& out, const AC_DEFLATEFORMAT_t format);
+  ~AutoConnectDeflate() {}
+  size_t  write(uint8_t c) override { return write(&c, 1); }
+  size_t  write(const uint8_t* buf, size_t size) override;
+  size_t  write_P(PGM_P buf, size_t size);
+  void    end(void);
+  static AC_DEFLATEFORMAT_t negotiate(const String& acceptEncoding);
+  static const __FlashStringHelper* encoding(const AC_DEFLATEFORMAT_t format);
+
+ protected:
+  static constexpr uint16_t _WINDOW = AUTOCONNECT_DEFLATE_WINDOW;
+  static constexpr uint16_t _HASHSIZE = 1 << AUTOCONNECT_DEFLATE_HASHBITS;
+  static constexpr uint16_t _MINMATCH = 3;
+  static constexpr uint16_t _MAXMATCH = 258;
+  static constexpr uint16_t _NIL = 0xffff;
+  static_assert(_WINDOW >= 512 && _WINDOW <= 16384, "AUTOCONNECT_DEFLATE_WINDOW must be in 512 to 16384");
+
+  void  _compress(const bool flush);
+  void  _slide(void);
+  void  _literal(const uint16_t c);
+  void  _match(const uint16_t len, const uint16_t dist);
+  void  _putCode(const uint16_t code, const uint8_t len);
+  void  _putBits(const uint32_t bits, const uint8_t len);
+  void  _putByte(const uint8_t c);
+  void  _flushOut(void);
+  uint16_t  _hash(const uint16_t pos) const;
+
+  Print&  _out;               /**< Destination of the compressed stream */
+  AC_DEFLATEFORMAT_t  _format;  /**< Format of the stream */
+  std::unique_ptr<uint8_t[]>  _window;  /**< History and lookahead */
+  std::unique_ptr<uint16_t[]> _head;    /**< The latest position of each hash */
+  uint16_t  _pos;             /**< Position to be encoded next */
+  uint16_t  _end;             /**< End of the written content */
+  uint32_t  _bitBuf;          /**< Pending bits */
+  uint8_t   _bitCount;        /**< Number of the pending bits */
+  uint32_t  _check;           /**< CRC32 for gzip, Adler32 for zlib */
+  uint32_t  _total;           /**< Size of the original content */
+  uint8_t   _outBuf[64];      /**< Buffer to pass to the output */
+  uint8_t   _outLen;          /**< Length of the _outBuf */
+  bool      _ended;           /**< The stream has been terminated */
+};
+
+#endif // !_AUTOCONNECTDEFLATE_H_
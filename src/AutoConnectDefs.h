@@ -17,7 +17,24 @@
 #ifndef AC_DEBUG_PORT
 #define AC_DEBUG_PORT Serial
 #endif // !AC_DEBUG_PORT
-#ifdef AC_DEBUG
+
+// Uncomment the following AC_USE_LOGGER to defer the formatting and output
+// of the debug print. AC_DBG stores only the format and the arguments into
+// a ring buffer, and AutoConnect::handleClient drains it to AC_DEBUG_PORT,
+// a log file or the AUTOCONNECT_URI_LOG page without blocking the caller.
+//#define AC_USE_LOGGER
+#ifdef AC_USE_LOGGER
+#define AUTOCONNECT_USE_LOGGER
+#endif
+
+#if defined(AC_DEBUG) && defined(AUTOCONNECT_USE_LOGGER)
+#define AC_DBG_DUMB(fmt, ...) do {AutoConnectLog::record(AC_LOG_DEBUG | AC_LOG_RAW, (PGM_P)PSTR(fmt), ## __VA_ARGS__ );} while (0)
+#ifdef AC_DEBUG_LINETRACE
+#define AC_DBG(fmt, ...) do {AutoConnectLog::record(AC_LOG_DEBUG, (PGM_P)PSTR("[%s.%d] " fmt), __FUNCTION__, __LINE__, ## __VA_ARGS__ );} while (0)
+#else
+#define AC_DBG(fmt, ...) do {AutoConnectLog::record(AC_LOG_DEBUG, (PGM_P)PSTR(fmt), ## __VA_ARGS__ );} while (0)
+#endif
+#elif defined(AC_DEBUG)
 #define AC_DBG_DUMB(fmt, ...) do {AC_DEBUG_PORT.printf_P((PGM_P)PSTR(fmt), ## __VA_ARGS__ );} while (0)
 #ifdef AC_DEBUG_LINETRACE
 #define AC_DBG(fmt, ...) do {AC_DEBUG_PORT.printf_P((PGM_P)PSTR("[AC:%s.%d] " fmt), __FUNCTION__, __LINE__, ## __VA_ARGS__ );} while (0)
@@ -29,6 +46,14 @@
 #define AC_DBG_DUMB(...) do {(void)0;} while(0)
 #endif // !AC_DEBUG
 
+// Leveled log output that is available regardless of AC_DEBUG.
+// It is effective only when AC_USE_LOGGER is enabled.
+#ifdef AUTOCONNECT_USE_LOGGER
+#define AC_LOG(level, fmt, ...) do {AutoConnectLog::record(level, (PGM_P)PSTR(fmt), ## __VA_ARGS__ );} while (0)
+#else
+#define AC_LOG(...) do {(void)0;} while(0)
+#endif // !AUTOCONNECT_USE_LOGGER
+
 // Setting ESP-IDF logging verbosity for ESP32 platform
 // This setting has no effect on the ESP8266 platform
 // Uncomment the following AC_USE_ESPIDFLOG to activate ESP_LOGV output.
@@ -42,23 +67,158 @@
 #endif // !AC_USE_ESPIDFLOG
 #endif
 
+// Feature flags of the subsystems. AutoConnectAdvancedConfig enables and
+// disables them at run time, and AC_FEATURES selects the subsystems to be
+// built. A subsystem whose flag is cleared in AC_FEATURES is removed from
+// the build along with its pages and styles. The flags of the filesystem,
+// the credentials, the portal and the debug have no effect on the build.
+#define AC_FEATURE_OTA          (1U << 0)
+#define AC_FEATURE_UPDATE       (1U << 1)
+#define AC_FEATURE_FILESYSTEM   (1U << 2)
+#define AC_FEATURE_JSON         (1U << 3)
+#define AC_FEATURE_CREDENTIALS  (1U << 4)
+#define AC_FEATURE_PORTAL       (1U << 5)
+#define AC_FEATURE_TICKER       (1U << 6)
+#define AC_FEATURE_DEBUG        (1U << 7)
+#define AC_FEATURE_UPLOAD       (1U << 8)
+#define AC_FEATURE_CONFIGAUX    (1U << 9)
+#define AC_FEATURE_MENU         (1U << 10)
+
+// Default features for most use cases
+#define AC_FEATURES_DEFAULT     (AC_FEATURE_CREDENTIALS | AC_FEATURE_PORTAL | AC_FEATURE_JSON)
+#define AC_FEATURES_MINIMAL     (AC_FEATURE_CREDENTIALS | AC_FEATURE_PORTAL)
+#define AC_FEATURES_FULL        (0x7FFU)
+
+// AC_FEATURES must be defined by the build flags such as
+// -DAC_FEATURES=0x571 since it affects the library sources.
+#ifndef AC_FEATURES
+#define AC_FEATURES             AC_FEATURES_FULL
+#endif // !AC_FEATURES
+
 // Indicator to specify that AutoConnectAux handles elements with JSON.
 // Comment out the AUTOCONNECT_USE_JSON macro to detach the ArduinoJson.
-#ifndef AUTOCONNECT_NOUSE_JSON
+#if !defined(AUTOCONNECT_NOUSE_JSON) && (AC_FEATURES & AC_FEATURE_JSON)
 #define AUTOCONNECT_USE_JSON
 
 // Indicator of whether to use the AutoConnectUpdate feature.
+#if (AC_FEATURES & AC_FEATURE_UPDATE)
 #define AUTOCONNECT_USE_UPDATE
 #endif
+#endif
+
+// Indicator of whether to build the built-in OTA, the upload handlers
+// of AutoConnectFile, the ticker and the menu.
+#if (AC_FEATURES & AC_FEATURE_OTA)
+#define AUTOCONNECT_USE_OTA
+#endif
+#if (AC_FEATURES & AC_FEATURE_UPLOAD)
+#define AUTOCONNECT_USE_UPLOAD
+#endif
+#if (AC_FEATURES & AC_FEATURE_TICKER)
+#define AUTOCONNECT_USE_TICKER
+#endif
+#if (AC_FEATURES & AC_FEATURE_MENU)
+#define AUTOCONNECT_USE_MENU
+#endif
 
 // Declaration to enable AutoConnectConfigAux.
 // AC_USE_CONFIGAUX must be enabled along with AUTOCONNECT_USE_JSON
 // to enable AutoConnectConfigAux.
 //#define AC_USE_CONFIGAUX
-#if defined(AC_USE_CONFIGAUX) && defined(AUTOCONNECT_USE_JSON)
+#if defined(AC_USE_CONFIGAUX) && defined(AUTOCONNECT_USE_JSON) && (AC_FEATURES & AC_FEATURE_CONFIGAUX)
 #define AUTOCONNECT_USE_CONFIGAUX
 #endif
 
+// Declaration to enable AutoConnect::beginTask for ESP32.
+// AC_USE_PORTALTASK allows the portal to be run by a FreeRTOS task
+// pinned to a core other than the loop. It is ignored with ESP8266.
+//#define AC_USE_PORTALTASK
+#if defined(AC_USE_PORTALTASK) && defined(ARDUINO_ARCH_ESP32)
+#define AUTOCONNECT_USE_PORTALTASK
+#endif
+
+// Declaration to enable the authenticated session.
+// AC_USE_AUTHSESSION issues a short-lived signed cookie to the client
+// that has passed the HTTP authentication, and the subsequent requests
+// with the cookie are admitted without verifying the credentials again.
+//#define AC_USE_AUTHSESSION
+#ifdef AC_USE_AUTHSESSION
+#define AUTOCONNECT_USE_AUTHSESSION
+#endif
+
+// Declaration to generate the ticker with the LEDC of ESP32.
+// AC_USE_TICKERPWM lets the hardware PWM generate the flicker patterns
+// consisting of one on-off pair without timer interrupts. It occupies
+// an LEDC channel. It is ignored with ESP8266.
+//#define AC_USE_TICKERPWM
+#if defined(AC_USE_TICKERPWM) && defined(ARDUINO_ARCH_ESP32)
+#define AUTOCONNECT_USE_TICKERPWM
+#endif
+
+// Declaration to enable the language packs.
+// AC_USE_LANGPACK replaces the labels of the string table at run time
+// with the compressed language pack that matches the Accept-Language
+// of the request. The built-in labels are used for the other languages.
+//#define AC_USE_LANGPACK
+#ifdef AC_USE_LANGPACK
+#define AUTOCONNECT_USE_LANGPACK
+#endif
+
+// Declaration to serve the static parts of the pages as the assets.
+// AC_USE_ASSETS links the common stylesheet and the scripts of the
+// pages as separate resources instead of inlining them into every page.
+// The assets are served from AUTOCONNECT_ASSETS_PATH of the file system
+// in preference, with the precompressed .gz first, and the built-in
+// copies are served unless they are found.
+//#define AC_USE_ASSETS
+#ifdef AC_USE_ASSETS
+#define AUTOCONNECT_USE_ASSETS
+#endif
+
+// AC_ASSETS_ONFS leaves out the built-in copies of the assets, which
+// are then served only from AUTOCONNECT_ASSETS_PATH of the file system.
+// The assets missing from the file system respond 404, so upload all of
+// them before enabling it. It takes effect together with AC_USE_ASSETS.
+//#define AC_ASSETS_ONFS
+#if defined(AC_USE_ASSETS) && defined(AC_ASSETS_ONFS)
+#define AUTOCONNECT_ASSETS_ONFS
+#endif
+
+// Declaration to compress the responses on the fly. AC_USE_DEFLATE
+// encodes the pages and the other dynamic responses with gzip or deflate
+// as negotiated by the Accept-Encoding of the request. The compressor
+// streams the encoded bytes into the chunked response with the memory
+// bounded by AUTOCONNECT_DEFLATE_WINDOW.
+//#define AC_USE_DEFLATE
+#ifdef AC_USE_DEFLATE
+#define AUTOCONNECT_USE_DEFLATE
+#endif
+
+// Declaration to trace the requests for the traffic replay. AC_USE_TRACE
+// attaches the free heap size at the arrival of the request to the response
+// as the X-AutoConnect-Heap header, and with AC_DEBUG it also prints each
+// request as a TRACE line that the acreplay.py can import as the trace.
+// The TRACE line leaves out the values of the passphrase and the other
+// credentials.
+//#define AC_USE_TRACE
+#ifdef AC_USE_TRACE
+#define AUTOCONNECT_USE_TRACE
+#endif
+
+// Declaration to load the custom web pages through an arena. AC_USE_JSONARENA
+// carves the JsonDocument of AutoConnectAux::load and loadElement from a
+// single buffer of the docSize which is released in one step after the
+// page is built, and with AC_DEBUG it prints the peak of the arena. The
+// peak can be given to the docSize instead of the estimate. The arena is
+// an allocator of ArduinoJson 7, and it is left out with the earlier ones.
+//#define AC_USE_JSONARENA
+#if defined(AC_USE_JSONARENA) && defined(AUTOCONNECT_USE_JSON)
+#include <ArduinoJson.h>
+#if ARDUINOJSON_VERSION_MAJOR >= 7
+#define AUTOCONNECT_USE_JSONARENA
+#endif
+#endif
+
 // The AC_USE_SPIFFS and AC_USE_LITTLEFS macros declare which filesystem
 // to apply. Their definitions are contradictory to each other and you
 // cannot activate both at the same time.
@@ -116,6 +276,17 @@
 #define AUTOCONNECT_AP_CH 1
 #endif // !AUTOCONNECT_AP_CH
 
+// The highest channel and the weight of the presence of an access point
+// to choose the least congested channel for the SoftAP, which applies
+// when AutoConnectConfig::channel is 0. Channels 12 and 13 are not allowed
+// in some regions, and the clients there cannot find the SoftAP on them.
+#ifndef AUTOCONNECT_AP_CH_MAX
+#define AUTOCONNECT_AP_CH_MAX 11
+#endif // !AUTOCONNECT_AP_CH_MAX
+#ifndef AUTOCONNECT_AP_CH_APWEIGHT
+#define AUTOCONNECT_AP_CH_APWEIGHT 20
+#endif // !AUTOCONNECT_AP_CH_APWEIGHT
+
 // AutoConnect menu root path
 #ifndef AUTOCONNECT_URI
 #define AUTOCONNECT_URI         "/_ac"
@@ -144,14 +315,17 @@
 #define AUTOCONNECT_URI_DISCON  AUTOCONNECT_URI "/disc"
 #define AUTOCONNECT_URI_FAIL    AUTOCONNECT_URI "/fail"
 #define AUTOCONNECT_URI_FETCH   AUTOCONNECT_URI "/worker"
+#define AUTOCONNECT_URI_LOG     AUTOCONNECT_URI "/log"
 #define AUTOCONNECT_URI_OPEN    AUTOCONNECT_URI "/open"
 #define AUTOCONNECT_URI_RESET   AUTOCONNECT_URI "/reset"
 #define AUTOCONNECT_URI_RESULT  AUTOCONNECT_URI "/result"
+#define AUTOCONNECT_URI_SCAN    AUTOCONNECT_URI "/scan"
 #define AUTOCONNECT_URI_SUCCESS AUTOCONNECT_URI "/success"
 #define AUTOCONNECT_URI_UPDATE  AUTOCONNECT_URI "/update"
 #define AUTOCONNECT_URI_UPDATE_ACT      AUTOCONNECT_URI "/update_act"
 #define AUTOCONNECT_URI_UPDATE_PROGRESS AUTOCONNECT_URI "/update_progress"
 #define AUTOCONNECT_URI_UPDATE_RESULT   AUTOCONNECT_URI "/update_result"
+#define AUTOCONNECT_URI_ASSETS  AUTOCONNECT_URI "/assets"
 
 // Default URI for connection successful response
 #ifndef AUTOCONNECT_URI_ONSUCCESS
@@ -182,6 +356,28 @@
 #define AUTOCONNECT_RECONNECT_DELAY   0
 #endif // !AUTOCONNECT_RECONNECT_DELAY
 
+// Time slice [ms] of the seeking of the saved credentials for the scanned
+// access points. The autoReconnect seeks within the slice in each
+// handleClient and resumes it at the next, so that the seeking over many
+// credentials neither trips the watchdog nor holds up the web server.
+#ifndef AUTOCONNECT_SLICE_TIME
+#define AUTOCONNECT_SLICE_TIME        20
+#endif // !AUTOCONNECT_SLICE_TIME
+
+// Retry strategy of AutoConnect::connectToWiFi [ms]. Each attempt to a
+// candidate access point ends with AUTOCONNECT_RETRY_TIMEOUT, and each
+// round of the candidates waits for the delay that starts with
+// AUTOCONNECT_RETRY_BASEDELAY and doubles up to AUTOCONNECT_RETRY_MAXDELAY.
+#ifndef AUTOCONNECT_RETRY_TIMEOUT
+#define AUTOCONNECT_RETRY_TIMEOUT     8000
+#endif // !AUTOCONNECT_RETRY_TIMEOUT
+#ifndef AUTOCONNECT_RETRY_BASEDELAY
+#define AUTOCONNECT_RETRY_BASEDELAY   500
+#endif // !AUTOCONNECT_RETRY_BASEDELAY
+#ifndef AUTOCONNECT_RETRY_MAXDELAY
+#define AUTOCONNECT_RETRY_MAXDELAY    8000
+#endif // !AUTOCONNECT_RETRY_MAXDELAY
+
 // Captive portal timeout value [ms]
 #ifndef AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT
 #define AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT 0
@@ -202,6 +398,24 @@
 #define AUTOCONNECT_HTTPPORT    80
 #endif // !AUTOCONNECT_HTTPPORT
 
+// Idle time to keep the persistent connection with the browser [ms]
+#ifndef AUTOCONNECT_KEEPALIVE_TIMEOUT
+#define AUTOCONNECT_KEEPALIVE_TIMEOUT 2000
+#endif // !AUTOCONNECT_KEEPALIVE_TIMEOUT
+
+// Maximum number of requests served over one persistent connection
+#ifndef AUTOCONNECT_KEEPALIVE_MAX
+#define AUTOCONNECT_KEEPALIVE_MAX     16
+#endif // !AUTOCONNECT_KEEPALIVE_MAX
+
+// Number of the clients whose portal state is held at once. Each client
+// keeps its page, menu title and the result of its connection request
+// apart from the others, and the client idle the longest gives up its
+// state to a new one.
+#ifndef AUTOCONNECT_CLIENTS_MAX
+#define AUTOCONNECT_CLIENTS_MAX       4
+#endif // !AUTOCONNECT_CLIENTS_MAX
+
 // DNS port
 #ifndef AUTOCONNECT_DNSPORT
 #define AUTOCONNECT_DNSPORT     53
@@ -262,6 +476,23 @@
 #ifndef AUTOCONNECT_FLICKER_WIDTHDC
 #define AUTOCONNECT_FLICKER_WIDTHDC   16
 #endif // !AUTOCONNECT_FLICKER_WIDTHDISCON
+// Flicker cycle during OTA update [ms]
+#ifndef AUTOCONNECT_FLICKER_PERIODOTA
+#define AUTOCONNECT_FLICKER_PERIODOTA 200
+#endif // !AUTOCONNECT_FLICKER_PERIODOTA
+// Flicker pulse width during OTA update (8bit resolution)
+#ifndef AUTOCONNECT_FLICKER_WIDTHOTA
+#define AUTOCONNECT_FLICKER_WIDTHOTA  128
+#endif // !AUTOCONNECT_FLICKER_WIDTHOTA
+// LEDC channel for the ticker, only available with AC_USE_TICKERPWM.
+// The arduino-esp32 3.x assigns a free channel and ignores it.
+#ifndef AUTOCONNECT_TICKER_LEDCCHANNEL
+#define AUTOCONNECT_TICKER_LEDCCHANNEL    7
+#endif // !AUTOCONNECT_TICKER_LEDCCHANNEL
+// Duty resolution of the LEDC for the ticker [bits]
+#ifndef AUTOCONNECT_TICKER_LEDCRESOLUTION
+#define AUTOCONNECT_TICKER_LEDCRESOLUTION 10
+#endif // !AUTOCONNECT_TICKER_LEDCRESOLUTION
 // Ticker port
 #ifndef AUTOCONNECT_TICKER_PORT
 #if defined(BUILTIN_LED) || defined(LED_BUILTIN)
@@ -286,6 +517,76 @@
 #define AUTOCONNECT_MIN_RSSI          -120  // No limit
 #endif // !AUTOCONNECT_MIN_RSSI
 
+// Number of handlers that can subscribe to each event such as onConnect
+#ifndef AUTOCONNECT_SIGNAL_SLOTS
+#define AUTOCONNECT_SIGNAL_SLOTS          4
+#endif // !AUTOCONNECT_SIGNAL_SLOTS
+
+// Number of WiFi events that can be queued from the SDK event context
+// until handleRequest consumes them (power of two)
+#ifndef AUTOCONNECT_WIFIEVENT_QUEUEDEPTH
+#define AUTOCONNECT_WIFIEVENT_QUEUEDEPTH  8
+#endif // !AUTOCONNECT_WIFIEVENT_QUEUEDEPTH
+
+// Portal task related factors, only available with AC_USE_PORTALTASK
+// Core to which the portal task is pinned. The loop of the arduino-esp32
+// runs on core 1 by default.
+#ifndef AUTOCONNECT_PORTALTASK_CORE
+#define AUTOCONNECT_PORTALTASK_CORE       0
+#endif // !AUTOCONNECT_PORTALTASK_CORE
+// Stack size of the portal task [bytes]
+#ifndef AUTOCONNECT_PORTALTASK_STACKSIZE
+#define AUTOCONNECT_PORTALTASK_STACKSIZE  8192
+#endif // !AUTOCONNECT_PORTALTASK_STACKSIZE
+// Priority of the portal task, same as the loop task by default.
+#ifndef AUTOCONNECT_PORTALTASK_PRIORITY
+#define AUTOCONNECT_PORTALTASK_PRIORITY   1
+#endif // !AUTOCONNECT_PORTALTASK_PRIORITY
+// Interval of the portal task handling cycle [ms]
+#ifndef AUTOCONNECT_PORTALTASK_INTERVAL
+#define AUTOCONNECT_PORTALTASK_INTERVAL   2
+#endif // !AUTOCONNECT_PORTALTASK_INTERVAL
+// Number of commands and events that can be queued (power of two)
+#ifndef AUTOCONNECT_PORTALTASK_QUEUEDEPTH
+#define AUTOCONNECT_PORTALTASK_QUEUEDEPTH 8
+#endif // !AUTOCONNECT_PORTALTASK_QUEUEDEPTH
+
+// Logger related factors, only available with AC_USE_LOGGER
+// Number of records that the ring buffer holds (power of two)
+#ifndef AUTOCONNECT_LOG_ENTRIES
+#define AUTOCONNECT_LOG_ENTRIES       32
+#endif // !AUTOCONNECT_LOG_ENTRIES
+
+// Bytes of the arguments that a record can hold, string arguments
+// exceeding it are truncated
+#ifndef AUTOCONNECT_LOG_PAYLOAD
+#define AUTOCONNECT_LOG_PAYLOAD       56
+#endif // !AUTOCONNECT_LOG_PAYLOAD
+
+// Maximum length of a formatted line
+#ifndef AUTOCONNECT_LOG_LINEMAX
+#define AUTOCONNECT_LOG_LINEMAX       160
+#endif // !AUTOCONNECT_LOG_LINEMAX
+
+// Number of records output by one call of handleClient
+#ifndef AUTOCONNECT_LOG_DRAINMAX
+#define AUTOCONNECT_LOG_DRAINMAX      8
+#endif // !AUTOCONNECT_LOG_DRAINMAX
+
+// Initial log level threshold, 3 is AC_LOG_DEBUG
+#ifndef AUTOCONNECT_LOG_LEVEL
+#define AUTOCONNECT_LOG_LEVEL         3
+#endif // !AUTOCONNECT_LOG_LEVEL
+
+// Log file path and its rotation size
+#ifndef AUTOCONNECT_LOG_FILE
+#define AUTOCONNECT_LOG_FILE          "/autoconnect.log"
+#endif // !AUTOCONNECT_LOG_FILE
+
+#ifndef AUTOCONNECT_LOG_FILESIZE
+#define AUTOCONNECT_LOG_FILESIZE      (64 * 1024)
+#endif // !AUTOCONNECT_LOG_FILESIZE
+
 // ArduinoJson buffer size
 #ifndef AUTOCONNECT_JSONBUFFER_SIZE
 #define AUTOCONNECT_JSONBUFFER_SIZE     256
@@ -348,6 +649,89 @@
 #define AUTOCONNECT_AUTH_REALM        "AUTOCONNECT"
 #endif // !AUTOCONNECT_AUTH_REALM
 
+// Name of the session cookie, only available with AC_USE_AUTHSESSION
+#ifndef AUTOCONNECT_AUTHSESSION_COOKIE
+#define AUTOCONNECT_AUTHSESSION_COOKIE    "ACSID"
+#endif // !AUTOCONNECT_AUTHSESSION_COOKIE
+
+// Lifetime of the authenticated session [s]
+#ifndef AUTOCONNECT_AUTHSESSION_LIFETIME
+#define AUTOCONNECT_AUTHSESSION_LIFETIME  600
+#endif // !AUTOCONNECT_AUTHSESSION_LIFETIME
+
+// Language tag of the built-in labels, it competes with the language
+// packs in the Accept-Language. Only available with AC_USE_LANGPACK
+#ifndef AUTOCONNECT_LANGPACK_BUILTIN
+#define AUTOCONNECT_LANGPACK_BUILTIN  "en"
+#endif // !AUTOCONNECT_LANGPACK_BUILTIN
+
+// Maximum number of the language packs to be registered
+#ifndef AUTOCONNECT_LANGPACK_MAX
+#define AUTOCONNECT_LANGPACK_MAX      4
+#endif // !AUTOCONNECT_LANGPACK_MAX
+
+// Number of the decompressed texts to be cached
+#ifndef AUTOCONNECT_LANGPACK_CACHE
+#define AUTOCONNECT_LANGPACK_CACHE    8
+#endif // !AUTOCONNECT_LANGPACK_CACHE
+
+// Maximum length of a decompressed text including the terminator,
+// a longer text is truncated at the character boundary
+#ifndef AUTOCONNECT_LANGPACK_TEXTLEN
+#define AUTOCONNECT_LANGPACK_TEXTLEN  96
+#endif // !AUTOCONNECT_LANGPACK_TEXTLEN
+
+// Maximum length of the language tag such as "pt-br"
+#ifndef AUTOCONNECT_LANGPACK_TAGLEN
+#define AUTOCONNECT_LANGPACK_TAGLEN   15
+#endif // !AUTOCONNECT_LANGPACK_TAGLEN
+
+// File names of the assets, only available with AC_USE_ASSETS
+#define AUTOCONNECT_ASSET_STYLESHEET  "ac.css"
+#define AUTOCONNECT_ASSET_MENUSHEET   "acmenu.css"
+#define AUTOCONNECT_ASSET_RANGEJS     "acrange.js"
+#define AUTOCONNECT_ASSET_FETCHJS     "acfetch.js"
+
+// Directory of the file system to look for the assets
+#ifndef AUTOCONNECT_ASSETS_PATH
+#define AUTOCONNECT_ASSETS_PATH       "/ac"
+#endif // !AUTOCONNECT_ASSETS_PATH
+
+// Lifetime of the assets cached by the browser [s]
+#ifndef AUTOCONNECT_ASSETS_MAXAGE
+#define AUTOCONNECT_ASSETS_MAXAGE     31536000
+#endif // !AUTOCONNECT_ASSETS_MAXAGE
+
+// Revision of the assets, it is attached to the links of the assets as
+// the query so that the browser drops the cached assets when it changes
+#ifndef AUTOCONNECT_ASSETS_REVISION
+#define AUTOCONNECT_ASSETS_REVISION   "1.4.3"
+#endif // !AUTOCONNECT_ASSETS_REVISION
+
+// Responses smaller than the threshold are sent without compression,
+// only available with AC_USE_DEFLATE [bytes]
+#ifndef AUTOCONNECT_DEFLATE_THRESHOLD
+#define AUTOCONNECT_DEFLATE_THRESHOLD 1024
+#endif // !AUTOCONNECT_DEFLATE_THRESHOLD
+
+// Value printed in place of the credentials in the TRACE line, only
+// available with AC_USE_TRACE
+#ifndef AUTOCONNECT_TRACE_REDACTED
+#define AUTOCONNECT_TRACE_REDACTED    "***"
+#endif // !AUTOCONNECT_TRACE_REDACTED
+
+// Distance that the compressor looks back for the match. It allocates
+// twice the window and the hash of AUTOCONNECT_DEFLATE_HASHBITS
+// during the compression [bytes]
+#ifndef AUTOCONNECT_DEFLATE_WINDOW
+#define AUTOCONNECT_DEFLATE_WINDOW    1024
+#endif // !AUTOCONNECT_DEFLATE_WINDOW
+
+// Number of bits of the hash to find the match
+#ifndef AUTOCONNECT_DEFLATE_HASHBITS
+#define AUTOCONNECT_DEFLATE_HASHBITS  9
+#endif // !AUTOCONNECT_DEFLATE_HASHBITS
+
 // Flename pattern that AutoConnectOTA considers to be firmware.
 // The extension used as the criterion for uploading destination is
 // fixed.
@@ -398,4 +782,8 @@ struct has_func_##func {                                    \
 #define AC_ESP_LOG(...) do {(void)0;} while(0)
 #endif
 
+#ifdef AUTOCONNECT_USE_LOGGER
+#include "AutoConnectLog.h"
+#endif
+
 #endif // _AUTOCONNECTDEFS_H_
@@ -257,17 +257,22 @@ const String AutoConnectFileBasis::toHTML(void) const {
 
 /**
  * Instantiate the upload handler with the specified store type.
+ * Without AUTOCONNECT_USE_UPLOAD, the built-in handlers are not
+ * available and only AC_File_Extern can be attached.
  * @param store An enumeration value of ACFile_t
  */
 bool AutoConnectFileBasis::attach(const ACFile_t store) {
+#ifdef AUTOCONNECT_USE_UPLOAD
   AutoConnectUploadFS*  handlerFS;
   AutoConnectUploadSD*  handlerSD;
+#endif
 
   // Release previous handler
   detach();
   _status = AutoConnectUploadHandler::AC_UPLOAD_IDLE;
   // Classify a handler type and create the corresponding handler
   switch (store) {
+#ifdef AUTOCONNECT_USE_UPLOAD
   case AC_File_FS:
     handlerFS = new AutoConnectUploadFS(AUTOCONNECT_APPLIED_FILESYSTEM);
     _upload.reset(reinterpret_cast<AutoConnectUploadHandler*>(handlerFS));
@@ -276,6 +281,12 @@ bool AutoConnectFileBasis::attach(const ACFile_t store) {
     handlerSD = new AutoConnectUploadSD(SD);
     _upload.reset(reinterpret_cast<AutoConnectUploadHandler*>(handlerSD));
     break;
+#else
+  case AC_File_FS:
+  case AC_File_SD:
+    AC_DBG("Upload stripped by AC_FEATURES\n");
+    break;
+#endif
   case AC_File_Extern:
     break;
   }
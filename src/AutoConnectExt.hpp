@@ -59,10 +59,15 @@ class AutoConnectExt : public AutoConnectCore<T> {
   void  onOTAEnd(OTAEndExit_ft fn);
   void  onOTAError(OTAErrorExit_ft fn);
   void  onOTAProgress(OTAProgressExit_ft fn);
+  bool  onOTAStart(AutoConnectUploadHandler::StartSignal_t::Handler_ft fn, void* ctx) { return _onOTAStartExit.subscribe(fn, ctx); }
+  bool  onOTAEnd(AutoConnectUploadHandler::EndSignal_t::Handler_ft fn, void* ctx) { return _onOTAEndExit.subscribe(fn, ctx); }
+  bool  onOTAError(AutoConnectUploadHandler::ErrorSignal_t::Handler_ft fn, void* ctx) { return _onOTAErrorExit.subscribe(fn, ctx); }
+  bool  onOTAProgress(AutoConnectUploadHandler::ProgressSignal_t::Handler_ft fn, void* ctx) { return _onOTAProgressExit.subscribe(fn, ctx); }
+  void  unsubscribe(const void* ctx);
 
  protected:
   void  _handleUpload(const String& requestUri, const HTTPUpload& upload);
-  PageElement*  _setupFetch(const String& uri);
+  AutoConnectPageElement*  _setupFetch(const String& uri);
 
 #ifdef AUTOCONNECT_USE_JSON
   template<typename U>
@@ -71,10 +76,10 @@ class AutoConnectExt : public AutoConnectCore<T> {
 #endif // !AUTOCONNECT_USE_JSON
 
   /** Utilities */
-  OTAStartExit_ft     _onOTAStartExit;
-  OTAEndExit_ft       _onOTAEndExit;
-  OTAErrorExit_ft     _onOTAErrorExit;
-  OTAProgressExit_ft  _onOTAProgressExit;
+  AutoConnectUploadHandler::StartSignal_t    _onOTAStartExit;
+  AutoConnectUploadHandler::EndSignal_t      _onOTAEndExit;
+  AutoConnectUploadHandler::ErrorSignal_t    _onOTAErrorExit;
+  AutoConnectUploadHandler::ProgressSignal_t _onOTAProgressExit;
   size_t              _freeHeapSize;
 
   /** Extended pages made up with AutoConnectAux */
@@ -83,8 +88,10 @@ class AutoConnectExt : public AutoConnectCore<T> {
   String        _prevUri;       /**< Previous generated page uri */
   /** Available updater, only reset by AutoConnectUpdate::attach is valid */
   std::unique_ptr<AutoConnectUpdate>  _update;
+#ifdef AUTOCONNECT_USE_OTA
   /** OTA updater */
   std::unique_ptr<AutoConnectOTA>     _ota;
+#endif
 
  private:
   // The following members are used to separate AutoConnectAux-dependent
@@ -98,6 +105,9 @@ class AutoConnectExt : public AutoConnectCore<T> {
   inline void _releaseAux(const String& uri) override;
   inline void _saveCurrentUri(const String& uri) override;
   inline String _mold_MENU_AUX(PageArgument& args) override;
+#ifdef AUTOCONNECT_USE_ASSETS
+  inline void _attachAuxAssets(void) override;
+#endif
 
   friend class AutoConnectAux;
   friend class AutoConnectUpdate;
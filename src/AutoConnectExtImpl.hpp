@@ -29,7 +29,9 @@ void AutoConnectExt<T>::end(void) {
   // _currentPageElement.reset();
   // _ticker.reset();
   _update.reset();
+#ifdef AUTOCONNECT_USE_OTA
   _ota.reset();
+#endif
 
   // _stopPortal();
   // _dnsServer.reset();
@@ -147,7 +149,7 @@ bool AutoConnectExt<T>::on(const String& uri, const AuxHandlerFunctionT handler,
  */
 template<typename T>
 void AutoConnectExt<T>::onOTAStart(OTAStartExit_ft fn) {
-  _onOTAStartExit = fn;
+  _onOTAStartExit.assign(fn);
 }
 
 /**
@@ -156,7 +158,7 @@ void AutoConnectExt<T>::onOTAStart(OTAStartExit_ft fn) {
  */
 template<typename T>
 void AutoConnectExt<T>::onOTAEnd(OTAEndExit_ft fn) {
-  _onOTAEndExit = fn;
+  _onOTAEndExit.assign(fn);
 }
 
 /**
@@ -165,7 +167,7 @@ void AutoConnectExt<T>::onOTAEnd(OTAEndExit_ft fn) {
  */
 template<typename T>
 void AutoConnectExt<T>::onOTAError(OTAErrorExit_ft fn) {
-  _onOTAErrorExit = fn;
+  _onOTAErrorExit.assign(fn);
 }
 
 /**
@@ -174,7 +176,21 @@ void AutoConnectExt<T>::onOTAError(OTAErrorExit_ft fn) {
  */
 template<typename T>
 void AutoConnectExt<T>::onOTAProgress(OTAProgressExit_ft fn) {
-  _onOTAProgressExit = fn;
+  _onOTAProgressExit.assign(fn);
+}
+
+/**
+ * Remove all the exit routines subscribed with the context including
+ * the OTA exits.
+ * @param  ctx  The context given at the subscription.
+ */
+template<typename T>
+void AutoConnectExt<T>::unsubscribe(const void* ctx) {
+  AutoConnectCore<T>::unsubscribe(ctx);
+  _onOTAStartExit.unsubscribe(ctx);
+  _onOTAEndExit.unsubscribe(ctx);
+  _onOTAErrorExit.unsubscribe(ctx);
+  _onOTAProgressExit.unsubscribe(ctx);
 }
 
 /**
@@ -185,23 +201,29 @@ void AutoConnectExt<T>::onOTAProgress(OTAProgressExit_ft fn) {
  */
 template<typename T>
 inline void AutoConnectExt<T>::_attachOTA(void) {
+#ifdef AUTOCONNECT_USE_OTA
   if (AutoConnectCore<T>::_apConfig.ota == AC_OTA_BUILTIN) {
     if (!_ota) {
       _ota.reset(new AutoConnectOTA());
       _ota->extraCaption = AutoConnectCore<T>::_apConfig.otaExtraCaption;
       _ota->attach(*this);
       _ota->authentication(AutoConnectCore<T>::_apConfig.auth);
-      _ota->setTicker(AutoConnectCore<T>::_apConfig.tickerPort, AutoConnectCore<T>::_apConfig.tickerOn);
-      if (_onOTAStartExit)
-        _ota->onStart(_onOTAStartExit);
-      if (_onOTAEndExit)
-        _ota->onEnd(_onOTAEndExit);
-      if (_onOTAErrorExit)
-        _ota->onError(_onOTAErrorExit);
-      if (_onOTAStartExit)
-        _ota->onProgress(_onOTAProgressExit);
+      // The ticker of AutoConnect indicates the OTA progress with its
+      // own pattern, then the OTA does not need to flick the port.
+      if (!AutoConnectCore<T>::_apConfig.ticker)
+        _ota->setTicker(AutoConnectCore<T>::_apConfig.tickerPort, AutoConnectCore<T>::_apConfig.tickerOn);
+      // Relay to the exits held by this so that subscriptions made after
+      // the OTA instantiation also take effect.
+      _ota->onStart(&AutoConnectUploadHandler::StartSignal_t::relay, &_onOTAStartExit);
+      _ota->onEnd(&AutoConnectUploadHandler::EndSignal_t::relay, &_onOTAEndExit);
+      _ota->onError(&AutoConnectUploadHandler::ErrorSignal_t::relay, &_onOTAErrorExit);
+      _ota->onProgress(&AutoConnectUploadHandler::ProgressSignal_t::relay, &_onOTAProgressExit);
     }
   }
+#else
+  if (AutoConnectCore<T>::_apConfig.ota == AC_OTA_BUILTIN)
+    AC_DBG("OTA stripped by AC_FEATURES\n");
+#endif
 }
 
 /**
@@ -225,12 +247,14 @@ inline void AutoConnectExt<T>::_enableUpdate(void) {
  * @return  Registered PageElement of the handler returning the endpoint response.
  */
 template<typename T>
-PageElement* AutoConnectExt<T>::_setupFetch(const String& uri) {
+AutoConnectPageElement* AutoConnectExt<T>::_setupFetch(const String& uri) {
   AC_UNUSED(uri);
-  PageElement*  endpointElement = new PageElement();
+  AutoConnectPageElement*  endpointElement = new AutoConnectPageElement();
 
   endpointElement->setMold(FPSTR("{{RES}}"));
   endpointElement->addToken(FPSTR("RES"), std::bind(&AutoConnectAux::_fetchEndpoint, _aux, std::placeholders::_1));
+  // The endpoint sends the response by itself.
+  endpointElement->setDeflatable(false);
   return endpointElement;
 }
 
@@ -246,6 +270,7 @@ template<typename T>
 inline bool AutoConnectExt<T>::_handleOTA(void) {
   bool  ignoreTicker = false;
 
+#ifdef AUTOCONNECT_USE_OTA
   if (_ota) {
     if (_ota->status() == AutoConnectOTA::AC_OTA_RIP) {
       // Indicate the reboot at the next handleClient turn
@@ -265,6 +290,7 @@ inline bool AutoConnectExt<T>::_handleOTA(void) {
     // AutoConnectOTA page
     _ota->menu(AutoConnectCore<T>::_apConfig.menuItems & AC_MENUITEM_UPDATE);
   }
+#endif
   return ignoreTicker;
 }
 
@@ -362,7 +388,7 @@ void AutoConnectExt<T>::_saveCurrentUri(const String& uri) {
  */
 template<typename T> template<typename U>
 bool AutoConnectExt<T>::_parseJson(U in) {
-  ArduinoJsonBuffer jsonBuffer(AUTOCONNECT_JSONBUFFER_PRIMITIVE_SIZE);
+  ArduinoJsonLoadBuffer jsonBuffer(AUTOCONNECT_JSONBUFFER_PRIMITIVE_SIZE);
   JsonVariant jv;
 #if ARDUINOJSON_VERSION_MAJOR<=5
   jv = jsonBuffer.parse(in);
@@ -478,4 +504,29 @@ String AutoConnectExt<T>::_mold_MENU_AUX(PageArgument& args) {
   return menuItem;
 }
 
+#ifdef AUTOCONNECT_USE_ASSETS
+/**
+ * Register the scripts of AutoConnectAux as the assets, and the page
+ * loads them with the script elements in place of the inline.
+ */
+template<typename T>
+inline void AutoConnectExt<T>::_attachAuxAssets(void) {
+#ifdef AUTOCONNECT_ASSETS_ONFS
+  static const typename AutoConnectCore<T>::Asset_t assets[] = {
+    { PSTR(AUTOCONNECT_ASSET_RANGEJS), PSTR("text/javascript"), nullptr, 0 },
+    { PSTR(AUTOCONNECT_ASSET_FETCHJS), PSTR("text/javascript"), nullptr, 0 }
+  };
+#else
+  static const PGM_P  range[] = { AutoConnectAux::_PAGE_SCRIPT_MA };
+  static const PGM_P  fetch[] = { AutoConnectAux::_PAGE_SCRIPT_FE };
+  static const typename AutoConnectCore<T>::Asset_t assets[] = {
+    { PSTR(AUTOCONNECT_ASSET_RANGEJS), PSTR("text/javascript"), range, 1 },
+    { PSTR(AUTOCONNECT_ASSET_FETCHJS), PSTR("text/javascript"), fetch, 1 }
+  };
+#endif
+  for (const typename AutoConnectCore<T>::Asset_t& asset : assets)
+    AutoConnectCore<T>::_attachAsset(&asset);
+}
+#endif
+
 #endif // !_AUTOCONNECTEXTIMPL_HPP_
@@ -0,0 +1,206 @@
+/**
+ * Declaration of the arena allocator for the JsonDocument of ArduinoJson 7.
+ * @file AutoConnectJsonArena.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTJSONARENA_H_
+#define _AUTOCONNECTJSONARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ArduinoJson.h>
+#if defined(BOARD_HAS_PSRAM) && defined(ESP32)
+#include <esp_heap_caps.h>
+#endif
+
+/**
+ * An allocator of ArduinoJson 7 that carves the pools and the strings of
+ * a JsonDocument from a single buffer. The buffer is taken at the first
+ * allocation and everything carved from it is given back in one step by
+ * reset or release, so a load does not leave the small blocks of the
+ * document scattered over the heap.
+ * A block freed at the top of the arena is reclaimed at once, which
+ * covers the strings that the deserializer grows and shrinks as it reads.
+ * An allocation that does not fit in the buffer spills to the heap.
+ * The arena records the peak of the bytes carved, including those that
+ * spilled. It is the capacity with which the same load does not spill.
+ * This header depends only on ArduinoJson and the C library so that the
+ * peak can be measured on the host.
+ */
+class AutoConnectJsonArena : public ArduinoJson::Allocator {
+ public:
+  explicit AutoConnectJsonArena(const size_t capacity = 0) : _buf(nullptr), _capacity(_align(capacity)), _top(0), _last(_NONE), _heap(0), _peak(0), _spilled(0) {}
+  ~AutoConnectJsonArena() { release(); }
+  AutoConnectJsonArena(const AutoConnectJsonArena&) = delete;
+  AutoConnectJsonArena& operator=(const AutoConnectJsonArena&) = delete;
+
+  /**
+   * Carve a block from the arena, or from the heap if it does not fit.
+   * @param  size  Size of the block.
+   * @return The block, nullptr if the heap is also exhausted.
+   */
+  void* allocate(size_t size) override {
+    const size_t  need = sizeof(_block_t) + _align(size);
+    if (!_buf && _capacity) {
+      _buf = static_cast<uint8_t*>(_reserve(_capacity));
+      if (!_buf)
+        _capacity = 0;
+    }
+    if (_buf && _top + need <= _capacity) {
+      _block_t* blk = reinterpret_cast<_block_t*>(_buf + _top);
+      blk->size = static_cast<uint32_t>(size);
+      blk->prev = _last;
+      _last = static_cast<uint32_t>(_top);
+      _top += need;
+      _track();
+      return blk + 1;
+    }
+    _block_t* blk = static_cast<_block_t*>(malloc(need));
+    if (!blk)
+      return nullptr;
+    blk->size = static_cast<uint32_t>(size);
+    blk->prev = _NONE;
+    _heap += need;
+    _track();
+    return blk + 1;
+  }
+
+  /**
+   * Give back a block. A block in the arena is only marked free unless
+   * it is at the top; the rest are reclaimed by reset.
+   * @param  ptr  The block to be freed.
+   */
+  void  deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    _block_t* blk = static_cast<_block_t*>(ptr) - 1;
+    if (!_inArena(ptr)) {
+      _heap -= sizeof(_block_t) + _align(blk->size);
+      free(blk);
+      return;
+    }
+    blk->size |= _FREE;
+    // Pop the top of the arena as long as it is free.
+    while (_last != _NONE) {
+      _block_t* top = reinterpret_cast<_block_t*>(_buf + _last);
+      if (!(top->size & _FREE))
+        break;
+      _top = _last;
+      _last = top->prev;
+    }
+  }
+
+  /**
+   * Resize a block. The block at the top of the arena and a block that
+   * shrinks stay in place.
+   * @param  ptr   The block to be resized.
+   * @param  size  New size of the block.
+   * @return The resized block, nullptr if it cannot be resized.
+   */
+  void* reallocate(void* ptr, size_t size) override {
+    if (!ptr)
+      return allocate(size);
+    _block_t* blk = static_cast<_block_t*>(ptr) - 1;
+    if (!_inArena(ptr)) {
+      const size_t  was = sizeof(_block_t) + _align(blk->size);
+      const size_t  need = sizeof(_block_t) + _align(size);
+      _block_t* grown = static_cast<_block_t*>(realloc(blk, need));
+      if (!grown)
+        return nullptr;
+      grown->size = static_cast<uint32_t>(size);
+      _heap = _heap - was + need;
+      _track();
+      return grown + 1;
+    }
+    const size_t  offset = static_cast<uint8_t*>(ptr) - _buf - sizeof(_block_t);
+    if (offset == _last && offset + sizeof(_block_t) + _align(size) <= _capacity) {
+      blk->size = static_cast<uint32_t>(size);
+      _top = offset + sizeof(_block_t) + _align(size);
+      _track();
+      return ptr;
+    }
+    if (_align(size) <= _align(blk->size)) {
+      blk->size = static_cast<uint32_t>(size);
+      return ptr;
+    }
+    void* moved = allocate(size);
+    if (moved) {
+      memcpy(moved, ptr, blk->size);
+      deallocate(ptr);
+    }
+    return moved;
+  }
+
+  /**
+   * Rewind the arena in one step and start a new measurement of the peak.
+   * The buffer is kept for the next load. It must be called after the
+   * JsonDocument has been cleared or destroyed.
+   */
+  void  reset(void) {
+    if (_peak)
+      _lastPeak() = _peak;
+    _top = 0;
+    _last = _NONE;
+    _peak = _heap;
+    _spilled = _heap;
+  }
+
+  /**
+   * Rewind the arena and free its buffer.
+   */
+  void  release(void) {
+    reset();
+    if (_buf) {
+      free(_buf);
+      _buf = nullptr;
+    }
+  }
+
+  size_t  capacity(void) const { return _capacity; }   /**< Size of the buffer */
+  size_t  used(void) const { return _top + _heap; }    /**< Bytes carved now */
+  size_t  peak(void) const { return _peak; }           /**< The most bytes carved at once */
+  size_t  spilled(void) const { return _spilled; }     /**< The most bytes spilled to the heap at once */
+  static size_t lastPeak(void) { return _lastPeak(); } /**< Peak of the arena that was reset last */
+
+ private:
+  typedef struct {
+    uint32_t  size;   /**< Size of the block, with _FREE once it is freed */
+    uint32_t  prev;   /**< Offset of the block below, _NONE at the bottom */
+  } _block_t;
+  static constexpr uint32_t _FREE = 0x80000000UL;
+  static constexpr uint32_t _NONE = 0xffffffffUL;
+
+  static size_t _align(const size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+  static size_t&  _lastPeak(void) { static size_t peak = 0; return peak; }
+  static void*  _reserve(const size_t size) {
+#if defined(BOARD_HAS_PSRAM) && defined(ESP32)
+    void* buf = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buf)
+      return buf;
+#endif
+    return malloc(size);
+  }
+  bool  _inArena(const void* ptr) const { return _buf && ptr >= _buf && ptr < _buf + _capacity; }
+  void  _track(void) {
+    if (_top + _heap > _peak)
+      _peak = _top + _heap;
+    if (_heap > _spilled)
+      _spilled = _heap;
+  }
+
+  uint8_t*  _buf;       /**< The arena, nullptr until the first allocation */
+  size_t    _capacity;  /**< Size of the arena */
+  size_t    _top;       /**< Offset of the free space of the arena */
+  uint32_t  _last;      /**< Offset of the block at the top */
+  size_t    _heap;      /**< Bytes spilled to the heap now */
+  size_t    _peak;      /**< The most bytes carved at once */
+  size_t    _spilled;   /**< The most bytes spilled at once */
+};
+
+#endif // !_AUTOCONNECTJSONARENA_H_
@@ -76,6 +76,26 @@ using ArduinoJsonBuffer = JsonDocument;
 #define AUTOCONNECT_JSONBUFFER_PRIMITIVE_SIZE AUTOCONNECT_JSONDOCUMENT_SIZE
 #endif
 
+// JsonDocument to load the custom web pages
+#ifdef AUTOCONNECT_USE_JSONARENA
+#include "AutoConnectJsonArena.h"
+/**
+ * A JsonDocument that carves from its own arena. The arena is released
+ * in one step along with the document, and its peak is reported then.
+ * The arena is declared first so that it outlives the document.
+ */
+class ArduinoJsonArenaBuffer : private AutoConnectJsonArena, public JsonDocument {
+public:
+    explicit ArduinoJsonArenaBuffer(size_t capacity) : AutoConnectJsonArena(capacity), JsonDocument(static_cast<ArduinoJson::Allocator*>(this)) {}
+    ~ArduinoJsonArenaBuffer() {
+        AC_DBG("JSON arena peak %u/%u, spilled %u\n", (unsigned int)AutoConnectJsonArena::peak(), (unsigned int)AutoConnectJsonArena::capacity(), (unsigned int)AutoConnectJsonArena::spilled());
+    }
+};
+using ArduinoJsonLoadBuffer = ArduinoJsonArenaBuffer;
+#else
+using ArduinoJsonLoadBuffer = ArduinoJsonBuffer;
+#endif
+
 // Size calculation helpers for ArduinoJson 7
 // v7 doesn't need precise size calculations, but we provide estimates
 #define JSON_OBJECT_SIZE(pairs) (24 + (pairs) * 32)  // Rough estimate for v7
@@ -497,6 +497,11 @@
 #define AUTOCONNECT_TEXT_RESETINPROGRESS " in progress..."
 #endif // !AUTOCONNECT_TEXT_RESETINPROGRESS
 
+// Page AutoConnectConfigAux text: The settings rejected
+#ifndef AUTOCONNECT_TEXT_CONFIGOVERSIZE
+#define AUTOCONNECT_TEXT_CONFIGOVERSIZE "Not applied, a setting exceeds 255 characters."
+#endif // !AUTOCONNECT_TEXT_CONFIGOVERSIZE
+
 // Menu Text: Connecting
 #ifndef AUTOCONNECT_MENUTEXT_CONNECTING
 #define AUTOCONNECT_MENUTEXT_CONNECTING "Connecting"
@@ -0,0 +1,333 @@
+/**
+ * AutoConnectLangPack class implementation.
+ * @file AutoConnectLangPack.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectDefs.h"
+
+#ifdef AUTOCONNECT_USE_LANGPACK
+#include <algorithm>
+#include "AutoConnectLangPack.h"
+
+AutoConnectLangPack::Pack_t   AutoConnectLangPack::_packs[AUTOCONNECT_LANGPACK_MAX];
+uint8_t AutoConnectLangPack::_count = 0;
+int8_t  AutoConnectLangPack::_active = -1;
+AutoConnectLangPack::Cache_t  AutoConnectLangPack::_cache[AUTOCONNECT_LANGPACK_CACHE] = {};
+uint32_t  AutoConnectLangPack::_tick = 0;
+
+/**
+ * Register the language pack placed in PROGMEM.
+ * @param  pack  The image of the language pack in PROGMEM
+ * @param  size  Size of the image
+ * @return true   The pack is registered.
+ * @return false  Invalid image or no room for the pack.
+ */
+bool AutoConnectLangPack::add(const uint8_t* pack, const size_t size) {
+  if (_count >= AUTOCONNECT_LANGPACK_MAX)
+    return false;
+  Pack_t& p = _packs[_count];
+  p.image = pack;
+  p.fs = nullptr;
+  p.path = String();
+  p.size = size;
+  if (!_load(p, nullptr))
+    return false;
+  AC_DBG("Language pack %s registered\n", p.tag);
+  _count++;
+  return true;
+}
+
+/**
+ * Register the language pack stored in the file system. The file is
+ * read every time a text missing in the cache is decompressed, so it
+ * needs to remain as long as the pack is registered.
+ * @param  fs    The file system containing the pack
+ * @param  path  Path of the pack file
+ * @return true   The pack is registered.
+ * @return false  Invalid file or no room for the pack.
+ */
+bool AutoConnectLangPack::add(fs::FS& fs, const char* path) {
+  if (_count >= AUTOCONNECT_LANGPACK_MAX)
+    return false;
+  File  file = fs.open(path, "r");
+  if (!file) {
+    AC_DBG("Language pack %s could not open\n", path);
+    return false;
+  }
+  Pack_t& p = _packs[_count];
+  p.image = nullptr;
+  p.fs = &fs;
+  p.path = String(path);
+  p.size = file.size();
+  const bool  rc = _load(p, &file);
+  file.close();
+  if (!rc)
+    return false;
+  AC_DBG("Language pack %s registered from %s\n", p.tag, path);
+  _count++;
+  return true;
+}
+
+/**
+ * Unregister all language packs, and the built-in labels come back.
+ */
+void AutoConnectLangPack::clear(void) {
+  for (uint8_t i = 0; i < _count; i++)
+    _packs[i].path = String();
+  for (Cache_t& c : _cache)
+    c.used = 0;
+  _count = 0;
+  _active = -1;
+}
+
+/**
+ * Select the language pack that best matches the language ranges of the
+ * Accept-Language. The ranges are weighted with the quality value and
+ * the earlier range takes precedence at the same weight. A range matches
+ * the language tag of the pack exactly or by the primary subtag, such
+ * as "ja-JP" matches with "ja". The built-in labels compete with the
+ * packs as AUTOCONNECT_LANGPACK_BUILTIN and they are selected when no
+ * range matches.
+ * @param  acceptLanguage  A value of the Accept-Language header
+ * @return true   The selected pack has changed.
+ * @return false  The same pack as before is selected.
+ */
+bool AutoConnectLangPack::select(const char* acceptLanguage) {
+  int8_t  selected = -1;
+  int     weight = 0;
+
+  const char* cp = acceptLanguage ? acceptLanguage : "";
+  while (*cp && _count) {
+    while (*cp == ' ' || *cp == ',')
+      cp++;
+    const char* range = cp;
+    while (*cp && *cp != ';' && *cp != ',' && *cp != ' ')
+      cp++;
+    const size_t  len = cp - range;
+
+    // The quality value is parsed into the thousandths.
+    int q = 1000;
+    while (*cp && *cp != ',') {
+      if (*cp == 'q' && cp[1] == '=') {
+        cp += 2;
+        q = atoi(cp) * 1000;
+        if (*cp == '0' && cp[1] == '.') {
+          cp += 2;
+          for (int scale = 100; scale && isdigit(*cp); scale /= 10)
+            q += (*cp++ - '0') * scale;
+        }
+        continue;
+      }
+      cp++;
+    }
+
+    if (len && q > weight) {
+      const int8_t  pack = _match(range, len);
+      if (pack >= -1) {
+        selected = pack;
+        weight = q;
+      }
+    }
+  }
+
+  if (selected == _active)
+    return false;
+  _active = selected;
+  AC_DBG("Language %s selected\n", language());
+  return true;
+}
+
+/**
+ * Returns the language tag of the selected pack.
+ * @return The language tag.
+ */
+const char* AutoConnectLangPack::language(void) {
+  return _active >= 0 ? _packs[_active].tag : AUTOCONNECT_LANGPACK_BUILTIN;
+}
+
+/**
+ * Returns the text of the selected pack. The text is decompressed into
+ * the cache at the first reference, and the least recently used text is
+ * evicted for it. The returned pointer is valid until the cache is
+ * filled with the other texts, so the caller should not retain it
+ * beyond the construction of one response.
+ * @param  id  AC_STR_t
+ * @return A pointer to the text in the cache. nullptr if the built-in
+ * labels are selected or the pack does not translate the text.
+ */
+PGM_P AutoConnectLangPack::get(const AC_STR_t id) {
+  if (_active < 0 || id >= AC_STR_END)
+    return nullptr;
+
+  Cache_t*  victim = &_cache[0];
+  for (Cache_t& c : _cache) {
+    if (c.used && c.pack == _active && c.id == id) {
+      c.used = ++_tick;
+      return c.text[0] ? c.text : nullptr;
+    }
+    if (c.used < victim->used)
+      victim = &c;
+  }
+
+  const Pack_t& p = _packs[_active];
+  File  file;
+  if (p.fs)
+    file = p.fs->open(p.path.c_str(), "r");
+  // An untranslated text is also cached as empty to avoid decoding
+  // it again.
+  if (!_decode(p, p.fs ? &file : nullptr, id, victim->text))
+    victim->text[0] = '\0';
+  if (file)
+    file.close();
+  victim->pack = _active;
+  victim->id = static_cast<uint16_t>(id);
+  victim->used = ++_tick;
+  return victim->text[0] ? victim->text : nullptr;
+}
+
+/**
+ * Load the header of the language pack and verify it.
+ * @param  pack  The pack to be loaded
+ * @param  file  The file of the pack, nullptr for the image in PROGMEM
+ * @return true   The header is valid.
+ * @return false  Not a language pack or a different version.
+ */
+bool AutoConnectLangPack::_load(Pack_t& pack, File* file) {
+  uint8_t head[6 + AUTOCONNECT_LANGPACK_TAGLEN + 3];
+  const size_t  len = _read(pack, file, 0, head, sizeof(head));
+  if (len < 9 || memcmp(head, "ACLP", 4) || head[4] != _VERSION || head[5] > AUTOCONNECT_LANGPACK_TAGLEN || len < 9U + head[5]) {
+    AC_DBG("Language pack is invalid\n");
+    return false;
+  }
+  const uint8_t tagLen = head[5];
+  for (uint8_t i = 0; i < tagLen; i++)
+    pack.tag[i] = tolower(head[6 + i]);
+  pack.tag[tagLen] = '\0';
+  const uint8_t*  cp = &head[6 + tagLen];
+  pack.entries = cp[0] | (cp[1] << 8);
+  pack.tokens = cp[2];
+  pack.entryTable = 9 + tagLen;
+  pack.tokenTable = pack.entryTable + pack.entries * 2;
+  if (pack.entries > AC_STR_END)
+    pack.entries = AC_STR_END;
+  return static_cast<size_t>(pack.tokenTable + pack.tokens * 2) <= pack.size;
+}
+
+/**
+ * Read the part of the language pack.
+ * @param  pack    The language pack
+ * @param  file    The file of the pack, nullptr for the image in PROGMEM
+ * @param  offset  Offset in the pack
+ * @param  buf     Buffer to store
+ * @param  len     Number of bytes to read
+ * @return Number of bytes read, it is limited at the end of the pack.
+ */
+size_t AutoConnectLangPack::_read(const Pack_t& pack, File* file, const size_t offset, uint8_t* buf, const size_t len) {
+  if (offset >= pack.size)
+    return 0;
+  const size_t  n = std::min(len, pack.size - offset);
+  if (!file) {
+    memcpy_P(buf, pack.image + offset, n);
+    return n;
+  }
+  if (!file->seek(offset))
+    return 0;
+  return file->read(buf, n);
+}
+
+/**
+ * Decompress the text of the ID. The text longer than the cache is
+ * truncated at the boundary of the UTF-8 character.
+ * @param  pack  The language pack
+ * @param  file  The file of the pack, nullptr for the image in PROGMEM
+ * @param  id    AC_STR_t
+ * @param  text  Buffer of AUTOCONNECT_LANGPACK_TEXTLEN to store the text
+ * @return true   Decompressed.
+ * @return false  The pack does not translate the text.
+ */
+bool AutoConnectLangPack::_decode(const Pack_t& pack, File* file, const AC_STR_t id, char* text) {
+  uint8_t ofs[2];
+  if (id >= pack.entries || _read(pack, file, pack.entryTable + id * 2, ofs, 2) != 2)
+    return false;
+  const uint16_t  entry = ofs[0] | (ofs[1] << 8);
+  if (!entry)
+    return false;
+
+  // A token reference is shorter than the token, so the encoded bytes
+  // of the text that fits in the cache never exceed the cache size.
+  uint8_t src[AUTOCONNECT_LANGPACK_TEXTLEN];
+  const size_t  srcLen = _read(pack, file, entry, src, sizeof(src));
+  const size_t  limit = AUTOCONNECT_LANGPACK_TEXTLEN - 1;
+  size_t  n = 0;
+  bool    truncated = false;
+
+  for (size_t i = 0; i < srcLen && src[i] && !truncated; i++) {
+    if (src[i] != _TOKENREF) {
+      if (n < limit)
+        text[n++] = src[i];
+      else
+        truncated = true;
+      continue;
+    }
+    if (++i >= srcLen || src[i] >= pack.tokens)
+      break;
+    if (_read(pack, file, pack.tokenTable + src[i] * 2, ofs, 2) != 2)
+      break;
+    const uint16_t  token = ofs[0] | (ofs[1] << 8);
+    uint8_t tokenLen;
+    if (_read(pack, file, token, &tokenLen, 1) != 1)
+      break;
+    if (tokenLen > limit - n) {
+      tokenLen = limit - n;
+      truncated = true;
+    }
+    n += _read(pack, file, token + 1, reinterpret_cast<uint8_t*>(&text[n]), tokenLen);
+  }
+
+  if (truncated) {
+    // Drop the last character if its bytes are incomplete.
+    size_t  lead = n;
+    while (lead && (text[lead - 1] & 0xc0) == 0x80)
+      lead--;
+    if (lead && (text[lead - 1] & 0x80)) {
+      const uint8_t c = text[lead - 1];
+      const size_t  width = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : 2;
+      if (lead - 1 + width > n)
+        n = lead - 1;
+    }
+  }
+  text[n] = '\0';
+  return true;
+}
+
+/**
+ * Find the language pack that matches the language range.
+ * @param  range  A language range of the Accept-Language
+ * @param  len    Length of the range
+ * @return Index of the pack, -1 for the built-in labels and -2 for no
+ * match.
+ */
+int8_t AutoConnectLangPack::_match(const char* range, const size_t len) {
+  auto  primary = [](const char* tag, const size_t tagLen) -> size_t {
+    const char* dp = static_cast<const char*>(memchr(tag, '-', tagLen));
+    return dp ? dp - tag : tagLen;
+  };
+  const size_t  rangePrimary = primary(range, len);
+  int8_t  found = -2;
+
+  for (int8_t i = -1; i < static_cast<int8_t>(_count); i++) {
+    const char* tag = i < 0 ? AUTOCONNECT_LANGPACK_BUILTIN : _packs[i].tag;
+    const size_t  tagLen = strlen(tag);
+    if (tagLen == len && !strncasecmp(tag, range, len))
+      return i;
+    if (found == -2 && primary(tag, tagLen) == rangePrimary && !strncasecmp(tag, range, rangePrimary))
+      found = i;
+  }
+  return found;
+}
+
+#endif // !AUTOCONNECT_USE_LANGPACK
@@ -0,0 +1,83 @@
+/**
+ * Declaration of AutoConnectLangPack class.
+ * AutoConnectLangPack replaces the texts of the string table at run time
+ * with the language pack that best matches the Accept-Language of each
+ * request. The packs are compressed images placed in PROGMEM or in a
+ * file system, and the texts are decompressed on demand into a small
+ * LRU cache.
+ * @file AutoConnectLangPack.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTLANGPACK_H_
+#define _AUTOCONNECTLANGPACK_H_
+
+#include <Arduino.h>
+#include <FS.h>
+#include "AutoConnectDefs.h"
+#include "AutoConnectStrings.h"
+
+/**
+ * Layout of the language pack image. The multi-byte values are little
+ * endian and the offsets are relative to the beginning of the image.
+ *   "ACLP"                   Magic
+ *   uint8_t                  Version
+ *   uint8_t  + char[]        Length of the language tag and the tag
+ *   uint16_t                 Number of the entries
+ *   uint8_t                  Number of the tokens
+ *   uint16_t[entries]        Offset of each entry, 0 for the untranslated
+ *   uint16_t[tokens]         Offset of each token
+ *   uint8_t  + uint8_t[]     Length of the token and the token
+ *   uint8_t[] + '\0'         Entries
+ * An entry is a sequence of the literal bytes and the references to the
+ * token that consist of _TOKENREF and the index.
+ * The entries are indexed by AC_STR_t.
+ */
+class AutoConnectLangPack {
+ public:
+  static bool add(const uint8_t* pack, const size_t size);
+  static bool add(fs::FS& fs, const char* path);
+  static void clear(void);
+  static bool select(const char* acceptLanguage);
+  static const char*  language(void);
+  static PGM_P  get(const AC_STR_t id);
+
+ protected:
+  static constexpr uint8_t  _VERSION = 1;
+  static constexpr uint8_t  _TOKENREF = 0x01;
+
+  typedef struct {
+    const uint8_t*  image;  /**< Image in PROGMEM, nullptr for the file */
+    fs::FS*   fs;           /**< File system containing the pack */
+    String    path;         /**< Path of the pack file */
+    size_t    size;         /**< Size of the image */
+    char      tag[AUTOCONNECT_LANGPACK_TAGLEN + 1]; /**< Language tag */
+    uint16_t  entries;      /**< Number of the entries */
+    uint8_t   tokens;       /**< Number of the tokens */
+    uint16_t  entryTable;   /**< Offset of the entry offsets */
+    uint16_t  tokenTable;   /**< Offset of the token offsets */
+  } Pack_t;
+
+  typedef struct {
+    int8_t    pack;         /**< Index of the pack */
+    uint16_t  id;           /**< AC_STR_t of the text */
+    uint32_t  used;         /**< Last used tick, 0 for the vacant */
+    char      text[AUTOCONNECT_LANGPACK_TEXTLEN];  /**< Decompressed text */
+  } Cache_t;
+
+  static bool   _load(Pack_t& pack, File* file);
+  static size_t _read(const Pack_t& pack, File* file, const size_t offset, uint8_t* buf, const size_t len);
+  static bool   _decode(const Pack_t& pack, File* file, const AC_STR_t id, char* text);
+  static int8_t _match(const char* range, const size_t len);
+
+  static Pack_t   _packs[AUTOCONNECT_LANGPACK_MAX]; /**< Registered packs */
+  static uint8_t  _count;   /**< Number of the registered packs */
+  static int8_t   _active;  /**< Selected pack, -1 for the built-in */
+  static Cache_t  _cache[AUTOCONNECT_LANGPACK_CACHE]; /**< Decompressed texts */
+  static uint32_t _tick;    /**< Clock of the LRU */
+};
+
+#endif // !_AUTOCONNECTLANGPACK_H_
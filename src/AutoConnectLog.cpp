@@ -0,0 +1,346 @@
+/**
+ * AutoConnectLog class implementation.
+ * @file AutoConnectLog.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectDefs.h"
+
+#ifdef AUTOCONNECT_USE_LOGGER
+#include <algorithm>
+#include "AutoConnectLog.h"
+#include "AutoConnectFS.h"
+
+static_assert((AUTOCONNECT_LOG_ENTRIES & (AUTOCONNECT_LOG_ENTRIES - 1)) == 0, "AUTOCONNECT_LOG_ENTRIES must be a power of two");
+static_assert(AUTOCONNECT_LOG_PAYLOAD <= 255, "AUTOCONNECT_LOG_PAYLOAD must be less than 256");
+
+// The lap of the ring corresponding to the position, doubled to
+// represent the slot state.
+#define AC_LOG_LAP(p) (((p) / AUTOCONNECT_LOG_ENTRIES) << 1)
+
+AutoConnectLog::Entry_t AutoConnectLog::_ring[AUTOCONNECT_LOG_ENTRIES];
+std::atomic<uint32_t> AutoConnectLog::_head(0);
+uint32_t  AutoConnectLog::_tail = 0;
+size_t    AutoConnectLog::_sent = 0;
+bool      AutoConnectLog::_filed = false;
+std::atomic<uint32_t> AutoConnectLog::_dropped(0);
+uint8_t   AutoConnectLog::_level = AUTOCONNECT_LOG_LEVEL;
+bool      AutoConnectLog::_toSerial = true;
+bool      AutoConnectLog::_toFile = false;
+bool      AutoConnectLog::_timestamp = true;
+String    AutoConnectLog::_path(AUTOCONNECT_LOG_FILE);
+size_t    AutoConnectLog::_maxSize = AUTOCONNECT_LOG_FILESIZE;
+
+/**
+ * Specifies the log file as the output destination. When the file size
+ * exceeds maxSize, the file is renamed with the suffix ".1" and a new
+ * file will be started.
+ * @param  enable   Enables the file output.
+ * @param  path     Path of the log file.
+ * @param  maxSize  Threshold size to rotate the file.
+ */
+void AutoConnectLog::file(const bool enable, const char* path, const size_t maxSize) {
+  _toFile = enable;
+  _path = String(path);
+  _maxSize = maxSize;
+}
+
+/**
+ * Output the stored records to the destinations. It outputs as much as
+ * the serial transmit buffer can accept without waiting. A line that
+ * does not fit is sent in pieces over the later calls, and the file
+ * receives each line once as a whole regardless of the serial.
+ */
+void AutoConnectLog::handle(void) {
+  char  line[AUTOCONNECT_LOG_LINEMAX];
+  File  lf;
+
+  for (uint8_t n = 0; n < AUTOCONNECT_LOG_DRAINMAX; n++) {
+    Entry_t&  entry = _ring[_tail & (AUTOCONNECT_LOG_ENTRIES - 1)];
+    const uint32_t  lap = AC_LOG_LAP(_tail);
+    if (entry.seq.load(std::memory_order_acquire) != lap + 1)
+      break;
+    _format(entry, line, sizeof(line));
+    const size_t  len = strlen(line);
+    if (!_filed) {
+      if (_toFile && !lf && _path.length() && AutoConnectFS::_isMounted(&AUTOCONNECT_APPLIED_FILESYSTEM))
+        lf = AUTOCONNECT_APPLIED_FILESYSTEM.open(_path, "a");
+      if (lf)
+        lf.write(reinterpret_cast<const uint8_t*>(line), len);
+      _filed = true;
+    }
+    // Hold the rest of the line for the next if the UART is full.
+    if (_toSerial && _sent < len) {
+      const int room = AC_DEBUG_PORT.availableForWrite();
+      if (room > 0) {
+        const size_t  chunk = std::min(static_cast<size_t>(room), len - _sent);
+        AC_DEBUG_PORT.write(reinterpret_cast<const uint8_t*>(line + _sent), chunk);
+        _sent += chunk;
+      }
+      if (_sent < len)
+        break;
+    }
+    _sent = 0;
+    _filed = false;
+    entry.seq.store(lap + 2, std::memory_order_release);
+    _tail++;
+  }
+
+  if (lf) {
+    size_t  fileSize = lf.size();
+    lf.close();
+    // Rotate the log file
+    if (fileSize > _maxSize) {
+      String  rotated = _path + String(F(".1"));
+      AUTOCONNECT_APPLIED_FILESYSTEM.remove(rotated);
+      AUTOCONNECT_APPLIED_FILESYSTEM.rename(_path, rotated);
+    }
+  }
+}
+
+/**
+ * Output the log file and the records not yet output to the stream.
+ * The records remain in the ring buffer.
+ * @param  out  Output destination
+ */
+void AutoConnectLog::dump(Print& out) {
+  char  line[AUTOCONNECT_LOG_LINEMAX];
+
+  if (_toFile && AutoConnectFS::_isMounted(&AUTOCONNECT_APPLIED_FILESYSTEM)) {
+    String  rotated = _path + String(F(".1"));
+    const String* files[] = { &rotated, &_path };
+    for (const String* path : files) {
+      File  lf = AUTOCONNECT_APPLIED_FILESYSTEM.open(*path, "r");
+      if (lf) {
+        size_t  len;
+        while ((len = lf.read(reinterpret_cast<uint8_t*>(line), sizeof(line))) > 0)
+          out.write(reinterpret_cast<const uint8_t*>(line), len);
+        lf.close();
+      }
+    }
+  }
+
+  for (uint32_t pos = _tail; ; pos++) {
+    const Entry_t&  entry = _ring[pos & (AUTOCONNECT_LOG_ENTRIES - 1)];
+    if (entry.seq.load(std::memory_order_acquire) != AC_LOG_LAP(pos) + 1)
+      break;
+    _format(entry, line, sizeof(line));
+    out.print(line);
+  }
+  if (_dropped.load())
+    out.printf_P(PSTR("(%" PRIu32 " records dropped)\n"), _dropped.load());
+}
+
+/**
+ * Reserve a slot of the ring buffer. Multiple producers can reserve
+ * simultaneously without locks, the record is dropped if the ring
+ * buffer is full.
+ * @param  pos  Reserved position.
+ * @return A pointer to the reserved slot, nullptr if the ring is full.
+ */
+AutoConnectLog::Entry_t* AutoConnectLog::_reserve(uint32_t& pos) {
+  pos = _head.load(std::memory_order_relaxed);
+  for (;;) {
+    Entry_t*  entry = &_ring[pos & (AUTOCONNECT_LOG_ENTRIES - 1)];
+    const uint32_t  seq = entry->seq.load(std::memory_order_acquire);
+    const int32_t   diff = static_cast<int32_t>(seq - AC_LOG_LAP(pos));
+    if (diff == 0) {
+      if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        return entry;
+    }
+    else if (diff < 0) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    else
+      pos = _head.load(std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Make the reserved slot visible to the output side.
+ * @param  entry  The reserved slot.
+ * @param  pos    Reserved position.
+ */
+void AutoConnectLog::_commit(Entry_t* entry, const uint32_t pos) {
+  entry->seq.store(AC_LOG_LAP(pos) + 1, std::memory_order_release);
+}
+
+/**
+ * Append a tagged argument to the payload. If the payload overflows,
+ * the argument is discarded and the conversion will be output as is.
+ * @param  entry  The record.
+ * @param  tag    Argument type.
+ * @param  data   Binary image of the argument.
+ * @param  size   Size of the data.
+ */
+void AutoConnectLog::_put(Entry_t* entry, const char tag, const void* data, const size_t size) {
+  if (entry->len + sizeof(char) + size > sizeof(Entry_t::payload))
+    return;
+  entry->payload[entry->len++] = static_cast<uint8_t>(tag);
+  if (size) {
+    memcpy(&entry->payload[entry->len], data, size);
+    entry->len += size;
+  }
+}
+
+/**
+ * Append a string argument. The string is copied with the terminator
+ * and will be truncated to fit the payload.
+ * @param  entry  The record.
+ * @param  str    A string.
+ */
+void AutoConnectLog::_putString(Entry_t* entry, const char* str) {
+  size_t  room = sizeof(Entry_t::payload) - entry->len;
+  if (room < sizeof(char) * 2)
+    return;
+  room -= sizeof(char) * 2;
+  size_t  len = str ? strnlen(str, room) : 0;
+  entry->payload[entry->len++] = static_cast<uint8_t>('s');
+  if (len) {
+    memcpy(&entry->payload[entry->len], str, len);
+    entry->len += len;
+  }
+  entry->payload[entry->len++] = '\0';
+}
+
+/**
+ * Format a record to a line. Each conversion specification of the
+ * format string is formatted by snprintf with the corresponding tagged
+ * argument.
+ * @param  entry  The record.
+ * @param  line   Output buffer.
+ * @param  size   Size of the output buffer.
+ * @return true   Formatted.
+ * @return false  The line was truncated.
+ */
+bool AutoConnectLog::_format(const Entry_t& entry, char* line, const size_t size) {
+  size_t  n = 0;
+  size_t  ap = 0;
+  PGM_P   fp = entry.fmt;
+  char    spec[20];
+
+  if (!(entry.level & AC_LOG_RAW)) {
+    if (_timestamp)
+      n += snprintf_P(line + n, size - n, PSTR("%8" PRIu32 " "), entry.timestamp);
+    n += snprintf_P(line + n, size - n, PSTR("[AC] "));
+  }
+
+  char  c;
+  while ((c = static_cast<char>(pgm_read_byte(fp++))) != '\0' && n < size - 1) {
+    if (c != '%') {
+      line[n++] = c;
+      continue;
+    }
+    // Extract a conversion specification
+    size_t  sl = 0;
+    spec[sl++] = c;
+    while ((c = static_cast<char>(pgm_read_byte(fp))) != '\0' && sl < sizeof(spec) - 1) {
+      spec[sl++] = c;
+      fp++;
+      if (strchr("diouxXcsfFeEgGp%", c))
+        break;
+    }
+    spec[sl] = '\0';
+    const char  conv = spec[sl - 1];
+    if (conv == '%') {
+      line[n++] = '%';
+      continue;
+    }
+    // Deploy the width and precision given by the argument such as %.*s
+    if (strchr(spec, '*')) {
+      char  deployed[sizeof(spec)];
+      size_t  dl = 0;
+      for (const char* sp = spec; *sp && dl < sizeof(deployed) - 1; sp++) {
+        if (*sp == '*' && ap < entry.len && entry.payload[ap] == 'i') {
+          int32_t v;
+          memcpy(&v, &entry.payload[ap + 1], sizeof(v));
+          ap += sizeof(char) + sizeof(v);
+          int dn = snprintf_P(deployed + dl, sizeof(deployed) - dl, PSTR("%" PRId32), v);
+          if (dn > 0)
+            dl = std::min(dl + static_cast<size_t>(dn), sizeof(deployed) - 1);
+        }
+        else
+          deployed[dl++] = *sp;
+      }
+      deployed[dl] = '\0';
+      strcpy(spec, deployed);
+    }
+
+    // Retrieve the corresponding argument
+    const char  tag = ap < entry.len ? static_cast<char>(entry.payload[ap++]) : '\0';
+    const uint8_t*  dp = &entry.payload[ap];
+    int rc = 0;
+    switch (tag) {
+    case 'i': {
+      uint32_t  v;
+      memcpy(&v, dp, sizeof(v));
+      ap += sizeof(v);
+      if (strchr("fFeEgG", conv))
+        rc = snprintf(line + n, size - n, spec, static_cast<double>(static_cast<int32_t>(v)));
+      else if (strstr(spec, "ll"))
+        rc = snprintf(line + n, size - n, spec, static_cast<long long>(static_cast<int32_t>(v)));
+      else if (strchr(spec, 'l'))
+        rc = snprintf(line + n, size - n, spec, static_cast<unsigned long>(v));
+      else if (conv == 's' || conv == 'p')
+        rc = snprintf_P(line + n, size - n, PSTR("%" PRIu32), v);
+      else
+        rc = snprintf(line + n, size - n, spec, static_cast<unsigned int>(v));
+      break;
+    }
+    case 'l': {
+      int64_t v;
+      memcpy(&v, dp, sizeof(v));
+      ap += sizeof(v);
+      if (strstr(spec, "ll"))
+        rc = snprintf(line + n, size - n, spec, static_cast<long long>(v));
+      else if (conv == 's' || conv == 'p' || strchr("fFeEgG", conv))
+        rc = snprintf_P(line + n, size - n, PSTR("%lld"), static_cast<long long>(v));
+      else
+        rc = snprintf(line + n, size - n, spec, static_cast<long>(v));
+      break;
+    }
+    case 'd': {
+      double  v;
+      memcpy(&v, dp, sizeof(v));
+      ap += sizeof(v);
+      if (strchr("fFeEgG", conv))
+        rc = snprintf(line + n, size - n, spec, v);
+      else
+        rc = snprintf_P(line + n, size - n, PSTR("%f"), v);
+      break;
+    }
+    case 's': {
+      const char* v = reinterpret_cast<const char*>(dp);
+      ap += strlen(v) + sizeof('\0');
+      if (conv == 's')
+        rc = snprintf(line + n, size - n, spec, v);
+      else
+        rc = snprintf_P(line + n, size - n, PSTR("%s"), v);
+      break;
+    }
+    case 'p': {
+      const void* v;
+      memcpy(&v, dp, sizeof(v));
+      ap += sizeof(v);
+      rc = snprintf_P(line + n, size - n, PSTR("%p"), v);
+      break;
+    }
+    default:
+      // No argument available, output the specification as is.
+      rc = snprintf(line + n, size - n, "%s", spec);
+      break;
+    }
+    if (rc > 0)
+      n += static_cast<size_t>(rc);
+    if (n >= size)
+      n = size - 1;
+  }
+  line[n] = '\0';
+  return n < size - 1;
+}
+
+#endif // !AUTOCONNECT_USE_LOGGER
@@ -0,0 +1,139 @@
+/**
+ * Declaration of AutoConnectLog class.
+ * AutoConnectLog is a deferred-format logger. The recording side stores
+ * only the pointer of the format string and the binary image of the
+ * arguments into a fixed-size ring buffer in RAM, and the formatting and
+ * output are performed later by AutoConnectLog::handle, which is called
+ * from AutoConnect::handleRequest.
+ * @file AutoConnectLog.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTLOG_H_
+#define _AUTOCONNECTLOG_H_
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+#include <FS.h>
+#include "AutoConnectDefs.h"
+
+/**< Log levels, compatible with DebugConfig::logLevel. */
+typedef enum AC_LOGLEVEL {
+  AC_LOG_ERROR = 0,
+  AC_LOG_WARN  = 1,
+  AC_LOG_INFO  = 2,
+  AC_LOG_DEBUG = 3,
+  AC_LOG_TRACE = 4
+} AC_LOGLEVEL_t;
+
+// Modifier to output a record without the prefix.
+#define AC_LOG_RAW  0x80
+
+class AutoConnectLog {
+ public:
+  /**
+   * Store a log record. The format string must be a static string
+   * such as PSTR since only its pointer is kept. String arguments
+   * are copied into the record because they may be temporary.
+   * It is lock-free and callable from any task context.
+   * @param  level  Log level, optionally with AC_LOG_RAW.
+   * @param  fmt    A format string in the printf manner.
+   * @param  args   Arguments of the format.
+   */
+  template<typename... Args>
+  static void record(const uint8_t level, PGM_P fmt, Args... args) {
+    if ((level & ~AC_LOG_RAW) > _level)
+      return;
+    uint32_t  pos;
+    Entry_t*  entry = _reserve(pos);
+    if (!entry)
+      return;
+    entry->level = level;
+    entry->fmt = fmt;
+    entry->timestamp = millis();
+    entry->len = 0;
+    _pack(entry, args...);
+    _commit(entry, pos);
+  }
+
+  static void   handle(void);
+  static void   dump(Print& out);
+  static size_t dropped(void) { return _dropped.load(std::memory_order_relaxed); }
+  static void   level(const uint8_t level) { _level = level; }
+  static void   serial(const bool enable) { _toSerial = enable; }
+  static void   file(const bool enable, const char* path = AUTOCONNECT_LOG_FILE, const size_t maxSize = AUTOCONNECT_LOG_FILESIZE);
+  static void   timestamp(const bool enable) { _timestamp = enable; }
+
+ protected:
+  // The slot state is the seq value. For the lap L of the ring, 2L
+  // means free, 2L+1 means committed and waiting for output.
+  typedef struct {
+    std::atomic<uint32_t> seq;  /**< Sequence of the slot state */
+    uint32_t  timestamp;        /**< millis at recording */
+    PGM_P     fmt;              /**< Format string */
+    uint8_t   level;            /**< Log level */
+    uint8_t   len;              /**< Used length of the payload */
+    uint8_t   payload[AUTOCONNECT_LOG_PAYLOAD]; /**< Tagged arguments */
+  } Entry_t;
+
+  static Entry_t* _reserve(uint32_t& pos);
+  static void     _commit(Entry_t* entry, const uint32_t pos);
+  static bool     _format(const Entry_t& entry, char* line, const size_t size);
+  static void     _put(Entry_t* entry, const char tag, const void* data, const size_t size);
+  static void     _putString(Entry_t* entry, const char* str);
+
+  static void _pack(Entry_t* entry) { AC_UNUSED(entry); }
+  template<typename A, typename... Args>
+  static void _pack(Entry_t* entry, A arg, Args... args) {
+    _packArg(entry, arg);
+    _pack(entry, args...);
+  }
+  static void _packArg(Entry_t* entry, const char* str) { _putString(entry, str); }
+  static void _packArg(Entry_t* entry, char* str) { _putString(entry, str); }
+  template<typename A>
+  static typename std::enable_if<std::is_integral<A>::value || std::is_enum<A>::value>::type _packArg(Entry_t* entry, A arg) {
+    if (sizeof(A) > sizeof(uint32_t)) {
+      int64_t v = static_cast<int64_t>(arg);
+      _put(entry, 'l', &v, sizeof(v));
+    }
+    else {
+      uint32_t  v = static_cast<uint32_t>(arg);
+      _put(entry, 'i', &v, sizeof(v));
+    }
+  }
+  template<typename A>
+  static typename std::enable_if<std::is_floating_point<A>::value>::type _packArg(Entry_t* entry, A arg) {
+    double  v = static_cast<double>(arg);
+    _put(entry, 'd', &v, sizeof(v));
+  }
+  template<typename A>
+  static typename std::enable_if<std::is_pointer<A>::value>::type _packArg(Entry_t* entry, A arg) {
+    const void* v = static_cast<const void*>(arg);
+    _put(entry, 'p', &v, sizeof(v));
+  }
+  template<typename A>
+  static typename std::enable_if<std::is_class<A>::value>::type _packArg(Entry_t* entry, const A& arg) {
+    // Objects cannot be formatted by printf, keep the position only.
+    AC_UNUSED(arg);
+    _put(entry, '?', nullptr, 0);
+  }
+
+  static Entry_t  _ring[AUTOCONNECT_LOG_ENTRIES]; /**< Record storage */
+  static std::atomic<uint32_t>  _head;    /**< Next position to reserve */
+  static uint32_t _tail;                  /**< Next position to output */
+  static size_t   _sent;                  /**< Bytes of the tail line sent to the serial */
+  static bool     _filed;                 /**< The tail line has been written to the file */
+  static std::atomic<uint32_t>  _dropped; /**< Number of lost records */
+  static uint8_t  _level;                 /**< Level threshold to record */
+  static bool     _toSerial;              /**< Output to AC_DEBUG_PORT */
+  static bool     _toFile;                /**< Output to the file */
+  static bool     _timestamp;             /**< Prefix with millis */
+  static String   _path;                  /**< Log file path */
+  static size_t   _maxSize;               /**< Rotation threshold of the log file */
+};
+
+#endif // !_AUTOCONNECTLOG_H_
@@ -7,6 +7,10 @@
  * @copyright MIT license.
  */
 
+#include "AutoConnectDefs.h"
+
+#ifdef AUTOCONNECT_USE_OTA
+
 #include <functional>
 #include <stdio.h>
 #if defined(ARDUINO_ARCH_ESP8266)
@@ -329,11 +333,11 @@ String AutoConnectOTA::_updated(AutoConnectAux& result, PageArgument& args) {
   if (_otaStatus == AC_OTA_SUCCESS) {
     // Notify to the handleClient of loop() thread that it can reboot.
     _otaStatus = AC_OTA_RIP;
-    st = _dest == OTA_DEST_FIRM ? String(F(AUTOCONNECT_TEXT_OTASUCCESS)) : String(F(AUTOCONNECT_TEXT_OTAUPLOADED));
+    st = _dest == OTA_DEST_FIRM ? AutoConnectStrings::str(AC_STR_TEXT_OTASUCCESS) : AutoConnectStrings::str(AC_STR_TEXT_OTAUPLOADED);
     ccScheme = PSTR("#3d7e9a");
   }
   else {
-    st = String(F(AUTOCONNECT_TEXT_OTAFAILURE)) + _err;
+    st = AutoConnectStrings::str(AC_STR_TEXT_OTAFAILURE) + _err;
     ccScheme = PSTR("#e66157");
   }
   result["bin"].as<AutoConnectText>().value = _binName;
@@ -376,6 +380,7 @@ void AutoConnectOTA::_setError(const char* err) {
   _otaStatus = AC_OTA_FAIL;
   if (err)
     _err = String(err);
-  if (_cbError)
-    _cbError(Update.getError());
+  _cbError.emit(Update.getError());
 }
+
+#endif // !AUTOCONNECT_USE_OTA
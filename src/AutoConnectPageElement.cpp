@@ -0,0 +1,123 @@
+/**
+ * AutoConnectPageElement class implementation.
+ * @file AutoConnectPageElement.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectPageElement.h"
+
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_LANGPACK)
+/**
+ * Scan the {{TOKEN}} at the position of the mold.
+ * @param  cp    The position of the mold in PROGMEM
+ * @param  name  Buffer of _TOKENLEN + 1 bytes that receives the token name
+ * @return Length of the token including the braces, 0 if the position is
+ * not a token.
+ */
+size_t AutoConnectPageElement::_scanToken(PGM_P cp, char* name) const {
+  if (pgm_read_byte(cp) != '{' || pgm_read_byte(cp + 1) != '{')
+    return 0;
+  PGM_P ep = cp + 2;
+  char  c;
+  while (isalnum(c = pgm_read_byte(ep)) || c == '_')
+    ep++;
+  const size_t  len = ep - (cp + 2);
+  if (!len || len > _TOKENLEN || c != '}' || pgm_read_byte(ep + 1) != '}')
+    return 0;
+  memcpy_P(name, cp + 2, len);
+  name[len] = '\0';
+  return len + 4;
+}
+#endif
+
+#ifdef AUTOCONNECT_USE_LANGPACK
+/**
+ * Register the handlers of the labels that AC_MOLDLABEL places in the
+ * mold. Each label is taken from the string table at the rendering, so
+ * the language pack selected for the request replaces it. Call it after
+ * setMold.
+ */
+void AutoConnectPageElement::addLabels(void) {
+  if (!_mold)
+    return;
+  std::vector<bool> added(AC_STR_END, false);
+  char  name[_TOKENLEN + 1];
+
+  for (PGM_P cp = _mold; pgm_read_byte(cp); ) {
+    const size_t  len = _scanToken(cp, name);
+    if (!len) {
+      cp++;
+      continue;
+    }
+    PGM_P token;
+    const AC_STR_t  id = AutoConnectStrings::find(name, &token);
+    if (id < AC_STR_END && !added[id]) {
+      addToken(FPSTR(token), [id](PageArgument& args) {
+        AC_UNUSED(args);
+        return AutoConnectStrings::str(id);
+      });
+      added[id] = true;
+    }
+    cp += len;
+  }
+}
+#endif
+
+#ifdef AUTOCONNECT_USE_DEFLATE
+/**
+ * Render the page to the output. The {{TOKEN}} in the mold is replaced
+ * with the result of the handler in the same manner as the PageBuilder,
+ * and the token that has no handler is left as it is.
+ * @param  out   Destination of the page
+ * @param  args  PageArgument of the request to be passed to the handlers
+ * @return Size of the rendered page.
+ */
+size_t AutoConnectPageElement::render(Print& out, PageArgument& args) {
+  size_t  size = 0;
+  PGM_P   literal = _mold;
+  PGM_P   cp = _mold;
+  char    name[_TOKENLEN + 1];
+
+  while (pgm_read_byte(cp)) {
+    const size_t  len = _scanToken(cp, name);
+    if (!len) {
+      cp++;
+      continue;
+    }
+    for (Token_t& token : _tokens) {
+      if (!strcmp_P(name, token.name)) {
+        size += _write_P(out, literal, cp - literal);
+        const String  value = token.handler(args);
+        size += out.write(reinterpret_cast<const uint8_t*>(value.c_str()), value.length());
+        literal = cp + len;
+        break;
+      }
+    }
+    cp += len;
+  }
+  size += _write_P(out, literal, cp - literal);
+  return size;
+}
+
+/**
+ * Write the part of the mold in PROGMEM through a small buffer.
+ * @param  out  Destination of the page
+ * @param  s    The part of the mold
+ * @param  len  Length of the part
+ * @return Size written.
+ */
+size_t AutoConnectPageElement::_write_P(Print& out, PGM_P s, const size_t len) {
+  uint8_t buf[64];
+  size_t  size = 0;
+  while (size < len) {
+    const size_t  n = std::min(len - size, sizeof(buf));
+    memcpy_P(buf, s + size, n);
+    out.write(buf, n);
+    size += n;
+  }
+  return size;
+}
+#endif // !AUTOCONNECT_USE_DEFLATE
@@ -0,0 +1,77 @@
+/**
+ * Declaration of AutoConnectPageElement class.
+ * AutoConnectPageElement is the PageElement of the pages that AutoConnect
+ * generates. With AC_USE_DEFLATE, it also retains the mold and the tokens
+ * so that AutoConnect can render the page by itself and send it with the
+ * content coding, which the PageBuilder does not provide. With
+ * AC_USE_LANGPACK, it resolves the labels that AC_MOLDLABEL places in the
+ * mold from the string table.
+ * @file AutoConnectPageElement.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTPAGEELEMENT_H_
+#define _AUTOCONNECTPAGEELEMENT_H_
+
+#include <Arduino.h>
+#include <PageBuilder.h>
+#include "AutoConnectDefs.h"
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_LANGPACK)
+#include <vector>
+#include <functional>
+#endif
+#ifdef AUTOCONNECT_USE_LANGPACK
+#include "AutoConnectStrings.h"
+#endif
+
+class AutoConnectPageElement : public PageElement {
+ public:
+  AutoConnectPageElement() : PageElement(), _deflatable(true) {}
+  ~AutoConnectPageElement() {}
+  void  setDeflatable(const bool deflatable) { _deflatable = deflatable; }
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_LANGPACK)
+  // The setMold hides that of the PageElement to retain the mold.
+  void  setMold(const __FlashStringHelper* mold) {
+    _mold = reinterpret_cast<PGM_P>(mold);
+    PageElement::setMold(mold);
+  }
+#endif
+#ifdef AUTOCONNECT_USE_LANGPACK
+  void  addLabels(void);
+#endif
+#ifdef AUTOCONNECT_USE_DEFLATE
+  bool  deflatable(void) const { return _deflatable && _mold; }
+  size_t  render(Print& out, PageArgument& args);
+
+  // The addToken hides that of the PageElement to retain the tokens.
+  template<typename F>
+  void  addToken(const __FlashStringHelper* token, F handler) {
+    _tokens.push_back({ reinterpret_cast<PGM_P>(token), handler });
+    PageElement::addToken(token, handler);
+  }
+
+ protected:
+  typedef struct {
+    PGM_P name;                                   /**< Token name */
+    std::function<String(PageArgument&)> handler; /**< Token handler */
+  } Token_t;
+
+  size_t  _write_P(Print& out, PGM_P s, const size_t len);
+
+  std::vector<Token_t>  _tokens;  /**< Tokens of the page */
+#endif
+
+ protected:
+#if defined(AUTOCONNECT_USE_DEFLATE) || defined(AUTOCONNECT_USE_LANGPACK)
+  size_t  _scanToken(PGM_P cp, char* name) const;
+
+  static constexpr size_t _TOKENLEN = 47; /**< Maximum length of the token name */
+  PGM_P _mold = nullptr;          /**< Mold of the page */
+#endif
+  bool  _deflatable;              /**< The page is allowed to compress */
+};
+
+#endif // !_AUTOCONNECTPAGEELEMENT_H_
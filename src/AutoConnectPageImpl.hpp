@@ -21,6 +21,7 @@ extern "C" {
 #define ENC_TYPE_NONE WIFI_AUTH_OPEN
 #endif
 
+#ifndef AUTOCONNECT_ASSETS_ONFS
 /**< Basic CSS common to all pages */
 template<typename T>
 const char AutoConnectCore<T>::_CSS_BASE[] PROGMEM = {
@@ -98,6 +99,7 @@ const char AutoConnectCore<T>::_CSS_BASE[] PROGMEM = {
     "z-index:1001"
   "}"
 };
+#endif // !AUTOCONNECT_ASSETS_ONFS
 
 /**< non-marked list for UL */
 template<typename T>
@@ -351,6 +353,7 @@ const char AutoConnectCore<T>::_CSS_SPINNER[] PROGMEM = {
   "}"
 };
 
+#ifndef AUTOCONNECT_ASSETS_ONFS
 /**< Common menu bar. This style quotes LuxBar. */
 /**< balzss/luxbar is licensed under the MIT License https://github.com/balzss/luxbar */
 template<typename T>
@@ -560,6 +563,7 @@ const char AutoConnectCore<T>::_CSS_LUXBAR_ITEM[] PROGMEM = {
     "background-color:" AUTOCONNECT_MENUCOLOR_TEXT
   "}"
 };
+#endif // !AUTOCONNECT_ASSETS_ONFS
 
 /**< Common html document header. */
 template<typename T>
@@ -593,7 +597,7 @@ const char  AutoConnectCore<T>::_ELM_MENU_POST[] PROGMEM = {
       "</ul>"
     "</div>"
     "<div class=\"lap\" id=\"rdlg\"><a href=\"#reset\" class=\"overlap\"></a>"
-      "<div class=\"modal_button\"><h2><a href=\"" AUTOCONNECT_URI_RESET "\" class=\"modal_button\">" AUTOCONNECT_BUTTONLABEL_RESET "</a></h2></div>"
+      "<div class=\"modal_button\"><h2><a href=\"" AUTOCONNECT_URI_RESET "\" class=\"modal_button\">BUTTON_RESET</a></h2></div>"
     "</div>"
   "</header>"
 };
@@ -602,7 +606,7 @@ const char  AutoConnectCore<T>::_ELM_MENU_POST[] PROGMEM = {
 template<typename T>
 const char  AutoConnectCore<T>::_PAGE_404[] PROGMEM = {
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_NOTFOUND "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_NOTFOUND) "</title>"
   "</head>"
   "<body>"
     "404 Not found"
@@ -615,7 +619,7 @@ template<typename T>
 const char  AutoConnectCore<T>::_PAGE_RESETTING[] PROGMEM = {
   "{{HEAD}}"
     "<meta http-equiv=\"refresh\" content=\"{{UPTIME}};url={{BOOTURI}}\">"
-    "<title>" AUTOCONNECT_PAGETITLE_RESETTING "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_RESETTING) "</title>"
   "</head>"
   "<body>"
     "<h3><div style=\"display:inline-block\"><span>{{RESET}}</span><span id=\"cd\"></span></div></h3>"
@@ -632,7 +636,7 @@ const char  AutoConnectCore<T>::_PAGE_RESETTING[] PROGMEM = {
 template<typename T>
 const char  AutoConnectCore<T>::_PAGE_STAT[] PROGMEM = {
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_STATISTICS "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_STATISTICS) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_TABLE}}"
@@ -654,63 +658,63 @@ const char  AutoConnectCore<T>::_PAGE_STAT[] PROGMEM = {
         "<table class=\"info\" style=\"border:none;\">"
           "<tbody>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_ESTABLISHEDCONNECTION "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_ESTABLISHEDCONNECTION) "</td>"
             "<td>{{ESTAB_SSID}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_MODE "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_MODE) "</td>"
             "<td>{{WIFI_MODE}}({{WIFI_STATUS}})</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_IP "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_IP) "</td>"
             "<td>{{LOCAL_IP}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_GATEWAY "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_GATEWAY) "</td>"
             "<td>{{GATEWAY}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_SUBNETMASK "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_SUBNETMASK) "</td>"
             "<td>{{NETMASK}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_SOFTAPIP "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_SOFTAPIP) "</td>"
             "<td>{{SOFTAP_IP}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_APMAC "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_APMAC) "</td>"
             "<td>{{AP_MAC}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_STAMAC "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_STAMAC) "</td>"
             "<td>{{STA_MAC}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_CHANNEL "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_CHANNEL) "</td>"
             "<td>{{CHANNEL}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_DBM "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_DBM) "</td>"
             "<td>{{DBM}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_CHIPID "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_CHIPID) "</td>"
             "<td>{{CHIP_ID}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_CPUFREQ "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_CPUFREQ) "</td>"
             "<td>{{CPU_FREQ}}MHz</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_FLASHSIZE "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_FLASHSIZE) "</td>"
             "<td>{{FLASH_SIZE}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_FREEMEM "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_FREEMEM) "</td>"
             "<td>{{FREE_HEAP}}</td>"
           "</tr>"
           "<tr>"
-          "<td>" AUTOCONNECT_PAGESTATS_SYSTEM_UPTIME "</td>"
+          "<td>" AC_MOLDLABEL(PAGESTATS_SYSTEM_UPTIME) "</td>"
           "<td>{{SYSTEM_UPTIME}}</td>"
           "</tr>"
           "</tbody>"
@@ -725,7 +729,7 @@ const char  AutoConnectCore<T>::_PAGE_STAT[] PROGMEM = {
 template<typename T>
 const char  AutoConnectCore<T>::_PAGE_CONFIGNEW[] PROGMEM = {
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_CONFIG "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_CONFIG) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_ICON_LOCK}}"
@@ -749,23 +753,24 @@ const char  AutoConnectCore<T>::_PAGE_CONFIGNEW[] PROGMEM = {
       "<div class=\"base-panel\">"
         "<form action=\"" AUTOCONNECT_URI_CONNECT "\" method=\"post\">"
           "<button style=\"width:0;height:0;padding:0;border:0;margin:0\" aria-hidden=\"true\" tabindex=\"-1\" type=\"submit\" name=\"apply\" value=\"apply\"></button>"
-          "{{LIST_SSID}}"
-          "<div style=\"margin:16px 0 8px 0;border-bottom:solid 1px #263238;\">" AUTOCONNECT_PAGECONFIG_TOTAL "{{SSID_COUNT}} " AUTOCONNECT_PAGECONFIG_HIDDEN "{{HIDDEN_COUNT}}</div>"
+          "<div id=\"sl\"></div>"
+          "{{SSID_PAGER}}"
+          "<div style=\"margin:16px 0 8px 0;border-bottom:solid 1px #263238;\">" AC_MOLDLABEL(PAGECONFIG_TOTAL) "<span id=\"st\"></span> " AC_MOLDLABEL(PAGECONFIG_HIDDEN) "<span id=\"sh\"></span></div>"
           "<ul class=\"noorder\">"
             "<li>"
-              "<label for=\"ssid\">" AUTOCONNECT_PAGECONFIG_SSID "</label>"
-              "<input id=\"ssid\" type=\"text\" name=\"" AUTOCONNECT_PARAMID_SSID "\" placeholder=\"" AUTOCONNECT_PAGECONFIG_SSID "\">"
+              "<label for=\"ssid\">" AC_MOLDLABEL(PAGECONFIG_SSID) "</label>"
+              "<input id=\"ssid\" type=\"text\" name=\"" AUTOCONNECT_PARAMID_SSID "\" placeholder=\"" AC_MOLDLABEL(PAGECONFIG_SSID) "\">"
             "</li>"
             "<li>"
-              "<label for=\"passphrase\">" AUTOCONNECT_PAGECONFIG_PASSPHRASE "</label>"
-              "<input id=\"passphrase\" type=\"password\" name=\"" AUTOCONNECT_PARAMID_PASS "\" placeholder=\"" AUTOCONNECT_PAGECONFIG_PASSPHRASE "\">"
+              "<label for=\"passphrase\">" AC_MOLDLABEL(PAGECONFIG_PASSPHRASE) "</label>"
+              "<input id=\"passphrase\" type=\"password\" name=\"" AUTOCONNECT_PARAMID_PASS "\" placeholder=\"" AC_MOLDLABEL(PAGECONFIG_PASSPHRASE) "\">"
             "</li>"
             "<li>"
-              "<label for=\"dhcp\">" AUTOCONNECT_PAGECONFIG_ENABLEDHCP "</label>"
+              "<label for=\"dhcp\">" AC_MOLDLABEL(PAGECONFIG_ENABLEDHCP) "</label>"
               "<input id=\"dhcp\" type=\"checkbox\" name=\"dhcp\" value=\"en\" checked onclick=\"vsw(this.checked);\">"
             "</li>"
             "{{CONFIG_IP}}"
-            "<li><input type=\"submit\" name=\"apply\" value=\"" AUTOCONNECT_PAGECONFIG_APPLY "\"></li>"
+            "<li><input type=\"submit\" name=\"apply\" value=\"" AC_MOLDLABEL(PAGECONFIG_APPLY) "\"></li>"
           "</ul>"
         "</form>"
       "</div>"
@@ -774,10 +779,26 @@ const char  AutoConnectCore<T>::_PAGE_CONFIGNEW[] PROGMEM = {
     "window.onload=function(){"
       "['" AUTOCONNECT_PARAMID_STAIP "','" AUTOCONNECT_PARAMID_GTWAY "','" AUTOCONNECT_PARAMID_NTMSK "','" AUTOCONNECT_PARAMID_DNS1 "','" AUTOCONNECT_PARAMID_DNS2 "'].forEach(function(n,o,t){"
         "io=document.getElementById(n),io.placeholder='0.0.0.0',io.pattern='^(?:(?:25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)\\.){3}(?:25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)$'});"
-      "vsw(true)};"
+      "vsw(true),scan(0,1)};"
+    "var g=-1;"
     "function onFocus(e){"
       "document.getElementById('ssid').value=e,document.getElementById('passphrase').focus()"
     "}"
+    "function scan(c,r){"
+      "fetch('" AUTOCONNECT_URI_SCAN "?cursor='+c+'&count=" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_SSIDPAGEUNIT_LINES) "'+(r?'&rescan=1':'&gen='+g)).then(function(e){return e.json()}).then(function(d){"
+        "var l=document.getElementById('sl');l.textContent='',g=d.gen;"
+        "d.aps.forEach(function(a){"
+          "var b=document.createElement('input'),q=document.createElement('label');"
+          "b.type='button',b.value=a.ssid,b.onclick=function(){onFocus(a.ssid)},q.className='slist',q.innerHTML=a.quality+'&#037;&ensp;Ch.'+a.ch,l.append(b,q);"
+          "if(a.lock){var k=document.createElement('span');k.className='img-lock',l.append(k)}"
+          "l.append(document.createElement('br'))"
+        "}),"
+        "pg('pv',d.prev),pg('nx',d.next),document.getElementById('st').textContent=d.total,document.getElementById('sh').textContent=d.hidden"
+      "})"
+    "}"
+    "function pg(i,c){"
+      "var e=document.getElementById(i);e.value=c,e.style.display=c<0?'none':''"
+    "}"
     "function vsw(e){"
       "var t;t=e?'none':'table-row';for(const n of document.getElementsByClassName('exp'))n.style.display=t,n.getElementsByTagName('input')[0].disabled=e;e||document.getElementById('sip').focus()"
     "}"
@@ -790,7 +811,7 @@ const char  AutoConnectCore<T>::_PAGE_CONFIGNEW[] PROGMEM = {
 template<typename T>
 const char  AutoConnectCore<T>::_PAGE_OPENCREDT[] PROGMEM = {
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_CREDENTIALS "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_CREDENTIALS) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_ICON_LOCK}}"
@@ -817,7 +838,7 @@ const char  AutoConnectCore<T>::_PAGE_OPENCREDT[] PROGMEM = {
       "</div>"
     "</div>"
     "<script type=\"text/javascript\">"
-      "function crdel(e){if(confirm(`${e} " AUTOCONNECT_TEXT_DELETECREDENTIAL "`)){var t=document.getElementById('_sid');t.setAttribute('action','" AUTOCONNECT_URI_DELETE "');var i=document.createElement('input');i.setAttribute('type','hidden'),i.setAttribute('name','del'),i.setAttribute('value',e),t.appendChild(i),t.submit()}}"
+      "function crdel(e){if(confirm(`${e} " AC_MOLDLABEL(TEXT_DELETECREDENTIAL) "`)){var t=document.getElementById('_sid');t.setAttribute('action','" AUTOCONNECT_URI_DELETE "');var i=document.createElement('input');i.setAttribute('type','hidden'),i.setAttribute('name','del'),i.setAttribute('value',e),t.appendChild(i),t.submit()}}"
     "</script>"
   "</body>"
   "</html>"
@@ -828,7 +849,7 @@ template<typename T>
 const char  AutoConnectCore<T>::_PAGE_CONNECTING[] PROGMEM = {
   "{{REQ}}"
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_CONNECTING "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_CONNECTING) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_SPINNER}}"
@@ -863,7 +884,7 @@ const char  AutoConnectCore<T>::_PAGE_CONNECTING[] PROGMEM = {
 template<typename T>
 const char  AutoConnectCore<T>::_PAGE_SUCCESS[] PROGMEM = {
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_STATISTICS "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_STATISTICS) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_TABLE}}"
@@ -885,30 +906,30 @@ const char  AutoConnectCore<T>::_PAGE_SUCCESS[] PROGMEM = {
         "<table class=\"info\" style=\"border:none;\">"
           "<tbody>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_ESTABLISHEDCONNECTION "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_ESTABLISHEDCONNECTION) "</td>"
             "<td>{{ESTAB_SSID}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_MODE "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_MODE) "</td>"
             "<td>{{WIFI_MODE}}({{WIFI_STATUS}})</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_IP "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_IP) "</td>"
             "<td>{{LOCAL_IP}}</td>"
           "</tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_GATEWAY "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_GATEWAY) "</td>"
             "<td>{{GATEWAY}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_SUBNETMASK "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_SUBNETMASK) "</td>"
             "<td>{{NETMASK}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_CHANNEL "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_CHANNEL) "</td>"
             "<td>{{CHANNEL}}</td>"
           "</tr>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGESTATS_DBM "</td>"
+            "<td>" AC_MOLDLABEL(PAGESTATS_DBM) "</td>"
             "<td>{{DBM}}</td>"
           "</tr>"
           "</tbody>"
@@ -923,7 +944,7 @@ const char  AutoConnectCore<T>::_PAGE_SUCCESS[] PROGMEM = {
 template<typename T>
 const char  AutoConnectCore<T>::_PAGE_FAIL[] PROGMEM = {
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_CONNECTIONFAILED "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_CONNECTIONFAILED) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_TABLE}}"
@@ -945,7 +966,7 @@ const char  AutoConnectCore<T>::_PAGE_FAIL[] PROGMEM = {
         "<table class=\"info\" style=\"border:none;\">"
           "<tbody>"
           "<tr>"
-            "<td>" AUTOCONNECT_PAGECONNECTIONFAILED_CONNECTIONFAILED "</td>"
+            "<td>" AC_MOLDLABEL(PAGECONNECTIONFAILED_CONNECTIONFAILED) "</td>"
             "<td>{{STATION_STATUS}}</td>"
           "</tr>"
           "</tbody>"
@@ -961,7 +982,7 @@ template<typename T>
 const char  AutoConnectCore<T>::_PAGE_DISCONN[] PROGMEM = {
   "{{DISCONNECT}}"
   "{{HEAD}}"
-    "<title>" AUTOCONNECT_PAGETITLE_DISCONNECTED "</title>"
+    "<title>" AC_MOLDLABEL(PAGETITLE_DISCONNECTED) "</title>"
     "<style type=\"text/css\">"
       "{{CSS_BASE}}"
       "{{CSS_LUXBAR_BODY}}"
@@ -1023,7 +1044,13 @@ String AutoConnectCore<T>::_getSystemUptime() {
 template <typename T>
 String AutoConnectCore<T>::_token_CSS_BASE(PageArgument &args) {
   AC_UNUSED(args);
+#ifdef AUTOCONNECT_USE_ASSETS
+  // The CSS_BASE leads the style block of every page, so it can import
+  // the base stylesheet of the assets in place of the inline part.
+  return String(F("@import url(\"" AUTOCONNECT_URI_ASSETS "/" AUTOCONNECT_ASSET_STYLESHEET "?v=" AUTOCONNECT_ASSETS_REVISION "\");"));
+#else
   return String(FPSTR(_CSS_BASE));
+#endif
 }
 
 template<typename T>
@@ -1053,37 +1080,77 @@ String AutoConnectCore<T>::_token_CSS_INPUT_TEXT(PageArgument& args) {
 template<typename T>
 String AutoConnectCore<T>::_token_CSS_LUXBAR_BODY(PageArgument& args) {
   AC_UNUSED(args);
+#if !defined(AUTOCONNECT_USE_MENU)
+  // Stripped along with the menu.
+  return _emptyString;
+#elif defined(AUTOCONNECT_USE_ASSETS)
+  // An @import is only allowed at the top of the style block, so the menu
+  // stylesheet is linked in between the style blocks instead. It keeps
+  // the menu after the styles that precede it in the page as inlined.
+  return String(F("</style><link rel=\"stylesheet\" href=\"" AUTOCONNECT_URI_ASSETS "/" AUTOCONNECT_ASSET_MENUSHEET "?v=" AUTOCONNECT_ASSETS_REVISION "\"><style type=\"text/css\">"));
+#else
   return String(FPSTR(_CSS_LUXBAR_BODY));
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_CSS_LUXBAR_HEADER(PageArgument& args) {
   AC_UNUSED(args);
+#if defined(AUTOCONNECT_USE_ASSETS) || !defined(AUTOCONNECT_USE_MENU)
+  // Bundled into the menu stylesheet linked by the CSS_LUXBAR_BODY, or
+  // stripped along with the menu.
+  return _emptyString;
+#else
   return String(FPSTR(_CSS_LUXBAR_HEADER));
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_CSS_LUXBAR_BGR(PageArgument& args) {
   AC_UNUSED(args);
+#if defined(AUTOCONNECT_USE_ASSETS) || !defined(AUTOCONNECT_USE_MENU)
+  // Bundled into the menu stylesheet linked by the CSS_LUXBAR_BODY, or
+  // stripped along with the menu.
+  return _emptyString;
+#else
   return String(FPSTR(_CSS_LUXBAR_BGR));
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_CSS_LUXBAR_ANI(PageArgument& args) {
   AC_UNUSED(args);
+#if defined(AUTOCONNECT_USE_ASSETS) || !defined(AUTOCONNECT_USE_MENU)
+  // Bundled into the menu stylesheet linked by the CSS_LUXBAR_BODY, or
+  // stripped along with the menu.
+  return _emptyString;
+#else
   return String(FPSTR(_CSS_LUXBAR_ANI));
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_CSS_LUXBAR_MEDIA(PageArgument& args) {
   AC_UNUSED(args);
+#if defined(AUTOCONNECT_USE_ASSETS) || !defined(AUTOCONNECT_USE_MENU)
+  // Bundled into the menu stylesheet linked by the CSS_LUXBAR_BODY, or
+  // stripped along with the menu.
+  return _emptyString;
+#else
   return String(FPSTR(_CSS_LUXBAR_MEDIA));
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_CSS_LUXBAR_ITEM(PageArgument& args) {
   AC_UNUSED(args);
+#if defined(AUTOCONNECT_USE_ASSETS) || !defined(AUTOCONNECT_USE_MENU)
+  // Bundled into the menu stylesheet linked by the CSS_LUXBAR_BODY, or
+  // stripped along with the menu.
+  return _emptyString;
+#else
   return String(FPSTR(_CSS_LUXBAR_ITEM));
+#endif
 }
 
 template<typename T>
@@ -1106,11 +1173,20 @@ String AutoConnectCore<T>::_token_CSS_UL(PageArgument& args) {
 
 template<typename T>
 String AutoConnectCore<T>::_token_MENU_AUX(PageArgument& args) {
+#ifdef AUTOCONNECT_USE_MENU
   return _mold_MENU_AUX(args);
+#else
+  AC_UNUSED(args);
+  return _emptyString;
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_MENU_PRE(PageArgument& args) {
+  AC_UNUSED(args);
+#ifndef AUTOCONNECT_USE_MENU
+  return _emptyString;
+#else
   String  currentMenu = FPSTR(_ELM_MENU_PRE);
   currentMenu.replace(F("BOOT_URI"), _getBootUri());
   currentMenu.replace(F("MENU_TITLE"), _menuTitle);
@@ -1118,10 +1194,15 @@ String AutoConnectCore<T>::_token_MENU_PRE(PageArgument& args) {
   currentMenu.replace(F("PORTAL"), isPortalAvailable() ? String(F(AUTOCONNECT_PORTAL_LINK)) : String());
 #endif
   return currentMenu;
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_MENU_LIST(PageArgument& args) {
+#ifndef AUTOCONNECT_USE_MENU
+  AC_UNUSED(args);
+  return _emptyString;
+#else
   String  menuItems = _attachMenuItem(AC_MENUITEM_CONFIGNEW) +
                       _attachMenuItem(AC_MENUITEM_OPENSSIDS) +
                       _attachMenuItem(AC_MENUITEM_DISCONNECT) +
@@ -1129,16 +1210,22 @@ String AutoConnectCore<T>::_token_MENU_LIST(PageArgument& args) {
   if (menuItems.indexOf(F("{{CUR_SSID}}")))
     menuItems.replace(F("{{CUR_SSID}}"), _token_ESTAB_SSID(args));
   return menuItems;
+#endif
 }
 
 template<typename T>
 String AutoConnectCore<T>::_token_MENU_POST(PageArgument& args) {
   AC_UNUSED(args);
+#ifndef AUTOCONNECT_USE_MENU
+  return _emptyString;
+#else
   String  postMenu = FPSTR(_ELM_MENU_POST);
+  postMenu.replace(F("BUTTON_RESET"), AC_FSTR(BUTTON_RESET));
   postMenu.replace(F("MENU_HOME"), _attachMenuItem(AC_MENUITEM_HOME));
   postMenu.replace(F("HOME_URI"), _apConfig.homeUri);
   postMenu.replace(F("MENU_DEVINFO"), _attachMenuItem(AC_MENUITEM_DEVINFO));
   return postMenu;
+#endif
 }
 
 template<typename T>
@@ -1175,15 +1262,17 @@ String AutoConnectCore<T>::_token_CONFIG_STAIP(PageArgument& args) {
     "<label for=\"%s\">%s</label>"
     "<input id=\"%s\" type=\"text\" name=\"%s\" value=\"%s\">"
     "</li>";
+  // The labels are retrieved at each rendering since the language pack
+  // may replace them per request.
   struct _reps {
     PGM_P lid;
-    PGM_P lbl;
+    AC_STR_t  lbl;
   } static const reps[]  = {
-    { PSTR(AUTOCONNECT_PARAMID_STAIP), PSTR(AUTOCONNECT_PAGECONFIG_IPADDRESS) },
-    { PSTR(AUTOCONNECT_PARAMID_GTWAY), PSTR(AUTOCONNECT_PAGECONFIG_GATEWAY) },
-    { PSTR(AUTOCONNECT_PARAMID_NTMSK), PSTR(AUTOCONNECT_PAGECONFIG_NETMASK) },
-    { PSTR(AUTOCONNECT_PARAMID_DNS1), PSTR(AUTOCONNECT_PAGECONFIG_DNS1) },
-    { PSTR(AUTOCONNECT_PARAMID_DNS2), PSTR(AUTOCONNECT_PAGECONFIG_DNS2) }
+    { PSTR(AUTOCONNECT_PARAMID_STAIP), AC_STR_CONFIG_IPADDRESS },
+    { PSTR(AUTOCONNECT_PARAMID_GTWAY), AC_STR_CONFIG_GATEWAY },
+    { PSTR(AUTOCONNECT_PARAMID_NTMSK), AC_STR_CONFIG_NETMASK },
+    { PSTR(AUTOCONNECT_PARAMID_DNS1), AC_STR_CONFIG_DNS1 },
+    { PSTR(AUTOCONNECT_PARAMID_DNS2), AC_STR_CONFIG_DNS2 }
   };
   char  liCont[600];
   char* liBuf = liCont;
@@ -1201,7 +1290,7 @@ String AutoConnectCore<T>::_token_CONFIG_STAIP(PageArgument& args) {
     else if (i == 4)
       ip = &_apConfig.dns2;
     String  ipStr = ip != nullptr ? ip->toString() : String(F("0.0.0.0"));
-    snprintf_P(liBuf, sizeof(liCont) - (liBuf - liCont), (PGM_P)_configIPList, reps[i].lid, reps[i].lbl, reps[i].lid, reps[i].lid, ipStr.c_str());
+    snprintf_P(liBuf, sizeof(liCont) - (liBuf - liCont), (PGM_P)_configIPList, reps[i].lid, AutoConnectStrings::get(reps[i].lbl), reps[i].lid, reps[i].lid, ipStr.c_str());
     liBuf += strlen(liBuf);
   }
   return String(liCont);
@@ -1260,83 +1349,6 @@ String AutoConnectCore<T>::_token_HEAD(PageArgument& args) {
   return String(FPSTR(_ELM_HTML_HEAD));
 }
 
-template<typename T>
-String AutoConnectCore<T>::_token_HIDDEN_COUNT(PageArgument& args) {
-  AC_UNUSED(args);
-  return String(_hiddenSSIDCount);
-}
-
-template<typename T>
-String AutoConnectCore<T>::_token_LIST_SSID(PageArgument& args) {
-  // Obtain the page number to display.
-  // When the display request is the first page, it will be obtained
-  // from the scan results of the WiFiScan class if it has already been
-  // scanned.
-  uint8_t page = 0;
-  if (args.hasArg(String(F("page"))))
-    page = args.arg("page").toInt();
-  else {
-    // Scan at a first time
-    _scanCount = WiFi.scanNetworks(false, true);
-    AC_DBG("%d network(s) found, ", (int)_scanCount);
-  }
-  // Prepare SSID list content building buffer
-  size_t  bufSize = sizeof('\0') + 192 * (_scanCount > AUTOCONNECT_SSIDPAGEUNIT_LINES ? AUTOCONNECT_SSIDPAGEUNIT_LINES : _scanCount);
-  bufSize += 88 * (_scanCount > AUTOCONNECT_SSIDPAGEUNIT_LINES ? (_scanCount > (AUTOCONNECT_SSIDPAGEUNIT_LINES * 2) ? 2 : 1) : 0);
-  AC_DBG_DUMB("%d buf", bufSize);
-  char* ssidList = (char*)malloc(bufSize);
-  if (!ssidList) {
-    AC_DBG_DUMB(" alloc. failed\n");
-    WiFi.scanDelete();
-    return _emptyString;
-  }
-  AC_DBG_DUMB("\n");
-  // Locate to the page and build SSD list content.
-  static const char _ssidList[] PROGMEM =
-    "<input type=\"button\" onClick=\"onFocus(this.getAttribute('value'))\" value=\"%s\">"
-    "<label class=\"slist\">%d&#037;&ensp;Ch.%d</label>%s<br>";
-  static const char _ssidEnc[] PROGMEM =
-    "<span class=\"img-lock\"></span>";
-  static const char _ssidPage[] PROGMEM =
-    "<button type=\"submit\" name=\"page\" value=\"%d\" formaction=\"" AUTOCONNECT_URI_CONFIG "\">%s</button>&emsp;";
-  _hiddenSSIDCount = 0;
-  uint8_t validCount = 0;
-  uint8_t dispCount = 0;
-  char* slBuf = ssidList;
-  *slBuf = '\0';
-  for (uint8_t i = 0; i < _scanCount; i++) {
-    String ssid = WiFi.SSID(i);
-    if (ssid.length() > 0) {
-      // An available SSID may be listed.
-      // AUTOCONNECT_SSIDPAGEUNIT_LINES determines the number of lines
-      // per page in the available SSID list.
-      if (validCount >= page * AUTOCONNECT_SSIDPAGEUNIT_LINES && validCount <= (page + 1) * AUTOCONNECT_SSIDPAGEUNIT_LINES - 1) {
-        if (++dispCount <= AUTOCONNECT_SSIDPAGEUNIT_LINES) {
-          snprintf_P(slBuf, bufSize - (slBuf - ssidList), (PGM_P)_ssidList, ssid.c_str(), AutoConnectCore<T>::_toWiFiQuality((int32_t)WiFi.RSSI(i)), WiFi.channel(i), WiFi.encryptionType(i) != ENC_TYPE_NONE ? (PGM_P)_ssidEnc : "");
-          slBuf += strlen(slBuf);
-        }
-      }
-      // The validCount counts the found SSIDs that is not the Hidden
-      // attribute to determines the next button should be displayed.
-      validCount++;
-    }
-    else
-      _hiddenSSIDCount++;
-  }
-  // Prepare perv. button
-  if (page >= 1) {
-    snprintf_P(slBuf, bufSize - (slBuf - ssidList), (PGM_P)_ssidPage, page - 1, PSTR(AUTOCONNECT_PAGECONFIG_PREVIOUS));
-    slBuf = ssidList + strlen(ssidList);
-  }
-  // Prepare next button
-  if (validCount > (page + 1) * AUTOCONNECT_SSIDPAGEUNIT_LINES) {
-    snprintf_P(slBuf, bufSize - (slBuf - ssidList), (PGM_P)_ssidPage, page + 1, PSTR(AUTOCONNECT_PAGECONFIG_NEXT));
-  }
-  String ssidListStr = String(ssidList);
-  free(ssidList);
-  return ssidListStr;
-}
-
 template<typename T>
 String AutoConnectCore<T>::_token_LOCAL_IP(PageArgument& args) {
   AC_UNUSED(args);
@@ -1352,7 +1364,6 @@ String AutoConnectCore<T>::_token_NETMASK(PageArgument& args) {
 template<typename T>
 String AutoConnectCore<T>::_token_OPEN_SSID(PageArgument& args) {
   AC_UNUSED(args);
-  static const char _ssidUndeleted[] PROGMEM = "<div style=\"color:red\">%s " AUTOCONNECT_TEXT_COULDNOTDELETED "</div>";
   static const char _ssidList[] PROGMEM = "<input id=\"sb\" type=\"submit\" name=\"%s\" value=\"%s\"><label class=\"slist\">%s</label>%s%s<br>";
   static const char _ssidRssi[] PROGMEM = "%d&#037;&ensp;Ch.%d";
   static const char _ssidNA[]   PROGMEM = "N/A";
@@ -1367,18 +1378,22 @@ String AutoConnectCore<T>::_token_OPEN_SSID(PageArgument& args) {
   AutoConnectCredential credit(_apConfig.boundaryOffset);
 
   if (_indelibleSSID.length()) {
-    char  indelible[82];
-
-    snprintf_P(indelible, sizeof(indelible), _ssidUndeleted, _indelibleSSID.c_str());
-    ssidList = String(indelible);
+    ssidList = String(F("<div style=\"color:red\">")) + _indelibleSSID + ' ' + AC_FSTR(TEXT_COULDNOTDELETED) + String(F("</div>"));
     _indelibleSSID.clear();
   }
 
+  // The scan runs in the background and it sleeps until completed. A
+  // scan already running, such as the one of autoReconnect, is waited for.
   uint8_t creEntries = credit.entries();
-  if (creEntries > 0)
-    _scanCount = WiFi.scanNetworks(false, true);
+  if (creEntries > 0) {
+    int16_t sc = WiFi.scanComplete();
+    if (sc != WIFI_SCAN_RUNNING)
+      sc = _scanNetworks(true);
+    sc = _waitForScan(sc);
+    _scanCount = sc > 0 ? sc : 0;
+  }
   else
-    ssidList += String(F("<p><b>" AUTOCONNECT_TEXT_NOSAVEDCREDENTIALS "</b></p>"));
+    ssidList += String(F("<p><b>")) + AC_FSTR(TEXT_NOSAVEDCREDENTIALS) + String(F("</b></p>"));
 
   for (uint8_t i = 0; i < creEntries; i++) {
     rssiCont[0] = '\0';
@@ -1415,9 +1430,18 @@ String AutoConnectCore<T>::_token_SOFTAP_IP(PageArgument& args) {
 }
 
 template<typename T>
-String AutoConnectCore<T>::_token_SSID_COUNT(PageArgument& args) {
+String AutoConnectCore<T>::_token_SSID_PAGER(PageArgument& args) {
   AC_UNUSED(args);
-  return String(_scanCount);
+  // The buttons to page the SSID list are shown by the script according
+  // to the cursors of the scan results.
+  static const char _ssidPage[] PROGMEM =
+    "<button type=\"submit\" id=\"%s\" style=\"display:none\" onclick=\"scan(this.value);return false\">%s</button>&emsp;";
+  char  pager[sizeof(_ssidPage) + 48];
+  snprintf_P(pager, sizeof(pager), (PGM_P)_ssidPage, "pv", AC_PSTR(CONFIG_PREVIOUS));
+  String  pagerStr = String(pager);
+  snprintf_P(pager, sizeof(pager), (PGM_P)_ssidPage, "nx", AC_PSTR(CONFIG_NEXT));
+  pagerStr += String(pager);
+  return pagerStr;
 }
 
 template<typename T>
@@ -1561,28 +1585,28 @@ String AutoConnectCore<T>::_attachMenuItem(const AC_MENUITEM_t item) {
   switch (static_cast<AC_MENUITEM_t>(_apConfig.menuItems & static_cast<uint16_t>(item))) {
   case AC_MENUITEM_CONFIGNEW:
     link = PSTR(AUTOCONNECT_URI_CONFIG);
-    label = PSTR(AUTOCONNECT_MENULABEL_CONFIGNEW);
+    label = AC_PSTR(MENU_CONFIGNEW);
     break;
   case AC_MENUITEM_OPENSSIDS:
     link = PSTR(AUTOCONNECT_URI_OPEN);
-    label = PSTR(AUTOCONNECT_MENULABEL_OPENSSIDS);
+    label = AC_PSTR(MENU_OPENSSIDS);
     break;
   case AC_MENUITEM_DISCONNECT:
     link = PSTR(AUTOCONNECT_URI_DISCON);
-    label = PSTR(AUTOCONNECT_MENULABEL_DISCONNECT);
+    label = AC_PSTR(MENU_DISCONNECT);
     break;
   case AC_MENUITEM_RESET:
     id = PSTR(" id=\"reset\"");
     link = PSTR("#rdlg");
-    label = PSTR(AUTOCONNECT_MENULABEL_RESET);
+    label = AC_PSTR(MENU_RESET);
     break;
   case AC_MENUITEM_HOME:
     link = PSTR("HOME_URI");
-    label = PSTR(AUTOCONNECT_MENULABEL_HOME);
+    label = AC_PSTR(MENU_HOME);
     break;
   case AC_MENUITEM_DEVINFO:
     link = PSTR(AUTOCONNECT_URI);
-    label = PSTR(AUTOCONNECT_MENULABEL_DEVINFO);
+    label = AC_PSTR(MENU_DEVINFO);
     break;
   default:
     id = nullptr;
@@ -1590,10 +1614,16 @@ String AutoConnectCore<T>::_attachMenuItem(const AC_MENUITEM_t item) {
     label = nullptr;
     break;
   }
-  char  li[128] = { '\0' };
-  if (!!id && !!link && !!label)
-    snprintf(li, sizeof(li), (PGM_P)_liTempl, id, link, label);
-  return String(li);
+  String  li;
+  if (!!id && !!link && !!label) {
+    // A label of the language pack may be longer than the built-in one,
+    // so the buffer is sized for the texts.
+    const size_t  len = sizeof(_liTempl) + strlen_P(id) + strlen_P(link) + strlen_P(label);
+    std::unique_ptr<char[]> buf(new char[len]);
+    snprintf(buf.get(), len, (PGM_P)_liTempl, id, link, label);
+    li = String(buf.get());
+  }
+  return li;
 }
 
 /**
@@ -1605,8 +1635,8 @@ String AutoConnectCore<T>::_attachMenuItem(const AC_MENUITEM_t item) {
  *  @retval false Requested uri is not defined.
  */
 template<typename T>
-PageElement* AutoConnectCore<T>::_setupPage(String& uri) {
-  PageElement *elm = new PageElement();
+AutoConnectPageElement* AutoConnectCore<T>::_setupPage(String& uri) {
+  AutoConnectPageElement* elm = new AutoConnectPageElement();
   bool  reqAuth = false;
 
   // Restore menu title
@@ -1670,16 +1700,21 @@ PageElement* AutoConnectCore<T>::_setupPage(String& uri) {
     elm->addToken(FPSTR("MENU_LIST"), std::bind(&AutoConnectCore<T>::_token_MENU_LIST, this, std::placeholders::_1));
     elm->addToken(FPSTR("MENU_AUX"), std::bind(&AutoConnectCore<T>::_token_MENU_AUX, this, std::placeholders::_1));
     elm->addToken(FPSTR("MENU_POST"), std::bind(&AutoConnectCore<T>::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(FPSTR("LIST_SSID"), std::bind(&AutoConnectCore<T>::_token_LIST_SSID, this, std::placeholders::_1));
-    elm->addToken(FPSTR("SSID_COUNT"), std::bind(&AutoConnectCore<T>::_token_SSID_COUNT, this, std::placeholders::_1));
-    elm->addToken(FPSTR("HIDDEN_COUNT"), std::bind(&AutoConnectCore<T>::_token_HIDDEN_COUNT, this, std::placeholders::_1));
+    elm->addToken(FPSTR("SSID_PAGER"), std::bind(&AutoConnectCore<T>::_token_SSID_PAGER, this, std::placeholders::_1));
     elm->addToken(FPSTR("CONFIG_IP"), std::bind(&AutoConnectCore<T>::_token_CONFIG_STAIP, this, std::placeholders::_1));
   }
+  else if (uri == String(AUTOCONNECT_URI_SCAN) && (_apConfig.menuItems & AC_MENUITEM_CONFIGNEW)) {
+
+    // Setup /_ac/scan
+    reqAuth = true;
+    elm->setMold(FPSTR("{{SCAN}}"));
+    elm->addToken(FPSTR("SCAN"), std::bind(&AutoConnectCore<T>::_responseScan, this, std::placeholders::_1));
+  }
   else if (uri == String(AUTOCONNECT_URI_CONNECT) && (_apConfig.menuItems & AC_MENUITEM_CONFIGNEW || _apConfig.menuItems & AC_MENUITEM_OPENSSIDS)) {
 
     // Setup /_ac/connect
     reqAuth = true;
-    _menuTitle = FPSTR(AUTOCONNECT_MENUTEXT_CONNECTING);
+    _menuTitle = AC_FSTR(MENUTEXT_CONNECTING);
     elm->setMold(FPSTR(_PAGE_CONNECTING));
     elm->addToken(FPSTR("REQ"), std::bind(&AutoConnectCore<T>::_induceConnect, this, std::placeholders::_1));
     elm->addToken(FPSTR("HEAD"), std::bind(&AutoConnectCore<T>::_token_HEAD, this, std::placeholders::_1));
@@ -1728,7 +1763,7 @@ PageElement* AutoConnectCore<T>::_setupPage(String& uri) {
   else if (uri == String(AUTOCONNECT_URI_DISCON) && (_apConfig.menuItems & AC_MENUITEM_DISCONNECT)) {
 
     // Setup /_ac/disc
-    _menuTitle = FPSTR(AUTOCONNECT_MENUTEXT_DISCONNECT);
+    _menuTitle = AC_FSTR(MENUTEXT_DISCONNECT);
     elm->setMold(FPSTR(_PAGE_DISCONN));
     elm->addToken(FPSTR("DISCONNECT"), std::bind(&AutoConnectCore<T>::_induceDisconnect, this, std::placeholders::_1));
     elm->addToken(FPSTR("HEAD"), std::bind(&AutoConnectCore<T>::_token_HEAD, this, std::placeholders::_1));
@@ -1788,7 +1823,7 @@ PageElement* AutoConnectCore<T>::_setupPage(String& uri) {
   else if (uri == String(AUTOCONNECT_URI_FAIL)) {
 
     // Setup /_ac/fail
-    _menuTitle = FPSTR(AUTOCONNECT_MENUTEXT_FAILED);
+    _menuTitle = AC_FSTR(MENUTEXT_FAILED);
     elm->setMold(FPSTR(_PAGE_FAIL));
     elm->addToken(FPSTR("HEAD"), std::bind(&AutoConnectCore<T>::_token_HEAD, this, std::placeholders::_1));
     elm->addToken(FPSTR("CSS_BASE"), std::bind(&AutoConnectCore<T>::_token_CSS_BASE, this, std::placeholders::_1));
@@ -1810,6 +1845,12 @@ PageElement* AutoConnectCore<T>::_setupPage(String& uri) {
     elm = nullptr;
   }
 
+#ifdef AUTOCONNECT_USE_LANGPACK
+  // The labels of the mold are taken from the string table.
+  if (elm)
+    elm->addLabels();
+#endif
+
   // Regiter authentication
   // Determine the necessity of authentication from the AutoConnectConfig settings
   if (elm) {
@@ -1848,7 +1889,6 @@ template<typename T>
 void AutoConnectCore<T>::_authentication(bool allow, const HTTPAuthMethod method) {
   const char* user = nullptr;
   const char* password = nullptr;
-  String  fails;
 
   // Enable authentication by setting of AC_AUTHSCOPE_DISCONNECTED even if WiFi is not connected.
   String  accUrl = _webServer->hostHeader();
@@ -1862,8 +1902,46 @@ void AutoConnectCore<T>::_authentication(bool allow, const HTTPAuthMethod method
     // Regiter authentication method
     user = _apConfig.username.length() ? _apConfig.username.c_str() : _apConfig.apid.c_str();
     password = _apConfig.password.length() ? _apConfig.password.c_str() : _apConfig.psk.c_str();
-    fails = String(FPSTR(AutoConnectCore<T>::_ELM_HTML_HEAD)) + String(F("</head><body>" AUTOCONNECT_TEXT_AUTHFAILED "</body></html>"));
+#ifdef AUTOCONNECT_USE_AUTHSESSION
+    // The request that is authenticated here by the session cookie or
+    // by the credentials does not need the PageBuilder to verify again.
+    if (_authenticate(user, password)) {
+      user = nullptr;
+      password = nullptr;
+      allow = false;
+    }
+#endif
+  }
+  if (allow) {
+    // The failure page is invariant, build it only once.
+    if (!_authFails.length())
+      _authFails = String(FPSTR(AutoConnectCore<T>::_ELM_HTML_HEAD)) + String(F("</head><body>")) + AutoConnectStrings::str(AC_STR_TEXT_AUTHFAILED) + String(F("</body></html>"));
     AC_DBG_DUMB(",%s+%s/%s", method == HTTPAuthMethod::BASIC_AUTH ? "BASIC" : "DIGEST", user, password);
   }
-  _responsePage->authentication(user, password, method, AUTOCONNECT_AUTH_REALM, fails);
+  _responsePage->authentication(user, password, method, AUTOCONNECT_AUTH_REALM, allow ? _authFails : String());
+}
+
+/**
+ *  Verify the current request with the credentials. With the
+ *  AC_USE_AUTHSESSION, a request carrying the valid session cookie
+ *  passes without the verification, and a newly authenticated request
+ *  receives the session cookie with the response.
+ *  @param user      User name
+ *  @param password  Password
+ *  @return true   The request is authenticated.
+ *  @return false  Not authenticated, the sender should request it.
+ */
+template<typename T>
+bool AutoConnectCore<T>::_authenticate(const char* user, const char* password) {
+#ifdef AUTOCONNECT_USE_AUTHSESSION
+  const IPAddress client = _webServer->client().remoteIP();
+  if (_authSession.verify(_webServer->header(String(F("Cookie"))), user, password, client))
+    return true;
+  if (!_webServer->authenticate(user, password))
+    return false;
+  _webServer->sendHeader(String(F("Set-Cookie")), _authSession.issue(user, password, client));
+  return true;
+#else
+  return _webServer->authenticate(user, password);
+#endif
 }
@@ -0,0 +1,82 @@
+/**
+ * Declaration of the message types exchanged between the sketch and the
+ * AutoConnect portal task.
+ * @file AutoConnectPortalTask.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTPORTALTASK_H_
+#define _AUTOCONNECTPORTALTASK_H_
+
+#include <stdint.h>
+#include "AutoConnectDefs.h"
+#include "AutoConnectQueue.h"
+
+/**
+ * Threading contract of the portal task.
+ * AutoConnect::beginTask creates a FreeRTOS task pinned to
+ * AUTOCONNECT_PORTALTASK_CORE. From then on, the portal task exclusively
+ * owns the WebServer, the DNSServer, the WiFi connection state machine,
+ * and the AutoConnectConfig held by AutoConnect until endTask returns.
+ * - The sketch must not call begin, handleClient, handleRequest,
+ *   disconnect and getConfig while the task is running. Request them
+ *   via postCommand instead. config, enableMenu, disableMenu and
+ *   updateConfig publish a new configuration snapshot and are safe to
+ *   call from the sketch, getConfigSnapshot reads it safely from any
+ *   task. These are thread-safe but not lock-free, the shared_ptr
+ *   atomics take a short internal lock.
+ * - Exit routines registered with onDetect, onConnect, whileConnecting,
+ *   whileCaptivePortal, custom web page handlers of AutoConnectAux and
+ *   the handlers added to the hosted WebServer are called in the portal
+ *   task context. They must not block indefinitely and must not touch
+ *   sketch data that the loop modifies without its own synchronization.
+ * - postCommand is callable from one producer context only, usually the
+ *   loop. receiveEvent is callable from one consumer context only.
+ *   Both are wait-free and never allocate heap.
+ * - A command of AC_PORTALCMD_INVOKE runs an arbitrary function in the
+ *   portal task context. It is the way to access the AutoConnect
+ *   instance safely from the sketch while the task is running.
+ */
+
+/**< Commands that the sketch posts to the portal task. */
+typedef enum AC_PORTALCMD {
+  AC_PORTALCMD_NONE,
+  AC_PORTALCMD_DISCONNECT,  /**< Disconnect from the current AP like as the menu does */
+  AC_PORTALCMD_RESET,       /**< Reset the module */
+  AC_PORTALCMD_ENABLEMENU,  /**< Enable menu items specified with arg */
+  AC_PORTALCMD_DISABLEMENU, /**< Disable menu items specified with arg */
+  AC_PORTALCMD_INVOKE       /**< Call fn(ctx) in the portal task context */
+} AC_PORTALCMD_t;
+
+/**< Events that the portal task notifies to the sketch. */
+typedef enum AC_PORTALEVT {
+  AC_PORTALEVT_NONE,
+  AC_PORTALEVT_BEGIN,       /**< AutoConnect::begin completed, arg has its result */
+  AC_PORTALEVT_CONNECTED,   /**< WiFi connection established */
+  AC_PORTALEVT_DISCONNECTED,/**< WiFi connection lost */
+  AC_PORTALEVT_STATUS,      /**< The portal status has changed */
+  AC_PORTALEVT_OVERFLOW     /**< Events were lost because the sketch did not receive them */
+} AC_PORTALEVT_t;
+
+typedef struct {
+  AC_PORTALCMD_t  command;  /**< Kind of the command */
+  uint32_t  arg;            /**< Argument depending on the command */
+  void  (*fn)(void*);       /**< Function for AC_PORTALCMD_INVOKE */
+  void* ctx;                /**< Context passed to the fn */
+} AutoConnectPortalCommand;
+
+typedef struct {
+  AC_PORTALEVT_t  event;    /**< Kind of the event */
+  uint32_t  arg;            /**< Argument depending on the event */
+  uint8_t   portalStatus;   /**< AutoConnect::portalStatus at the event */
+  uint32_t  ip;             /**< Current host IP */
+  uint32_t  timestamp;      /**< millis at the event */
+} AutoConnectPortalEvent;
+
+typedef AutoConnectQueue<AutoConnectPortalCommand, AUTOCONNECT_PORTALTASK_QUEUEDEPTH> AutoConnectPortalCommandQueue;
+typedef AutoConnectQueue<AutoConnectPortalEvent, AUTOCONNECT_PORTALTASK_QUEUEDEPTH>   AutoConnectPortalEventQueue;
+
+#endif // !_AUTOCONNECTPORTALTASK_H_
@@ -0,0 +1,80 @@
+/**
+ * Declaration of AutoConnectQueue class template.
+ * A fixed-capacity lock-free ring buffer for single-producer and
+ * single-consumer use across tasks or between an interrupt context and
+ * the loop. It does not allocate heap and has no mutex.
+ * @file AutoConnectQueue.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTQUEUE_H_
+#define _AUTOCONNECTQUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Single-producer single-consumer ring buffer.
+ * Only one context may call push and only one context may call pop
+ * at any time. The producer owns _head and the consumer owns _tail,
+ * each index is published with release semantics and observed with
+ * acquire semantics so that the element copy is visible before the
+ * index update.
+ * @param  T  Element type. It should be trivially copyable.
+ * @param  N  Capacity. It must be a power of two.
+ */
+template<typename T, size_t N>
+class AutoConnectQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "AutoConnectQueue capacity must be a power of two");
+
+ public:
+  AutoConnectQueue() : _head(0), _tail(0) {}
+  ~AutoConnectQueue() {}
+
+  /**
+   * Store an element at the end of the queue. Call it from the producer
+   * context only.
+   * @param  item  An element to be stored.
+   * @return true  The element was stored.
+   * @return false The queue is full, the element was discarded.
+   */
+  bool push(const T& item) {
+    const size_t  head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= N)
+      return false;
+    _ring[head & (N - 1)] = item;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Retrieve an element from the front of the queue. Call it from the
+   * consumer context only.
+   * @param  item  Storing area for the retrieved element.
+   * @return true  An element was retrieved.
+   * @return false The queue is empty.
+   */
+  bool pop(T& item) {
+    const size_t  tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire))
+      return false;
+    item = _ring[tail & (N - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool   empty(void) const { return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire); }
+  size_t size(void) const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+  static constexpr size_t capacity(void) { return N; }
+
+ protected:
+  T _ring[N];                   /**< Element storage */
+  std::atomic<size_t> _head;    /**< Next position to be written by the producer */
+  std::atomic<size_t> _tail;    /**< Next position to be read by the consumer */
+};
+
+#endif // !_AUTOCONNECTQUEUE_H_
@@ -0,0 +1,155 @@
+/**
+ * AutoConnectRetry class implementation.
+ * @file AutoConnectRetry.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include "AutoConnectRetry.h"
+
+/**
+ * @param  maxAttempts  Limit of the attempts over all the candidates
+ * @param  baseDelay    Delay after the first round in ms
+ * @param  maxDelay     Upper limit of the delay in ms
+ * @param  seed         Seed of the jitter, which must not be zero
+ */
+AutoConnectRetry::AutoConnectRetry(const uint8_t maxAttempts, const uint32_t baseDelay, const uint32_t maxDelay, const uint32_t seed)
+  : _count(0), _cursor(0), _round(0), _attempts(0), _maxAttempts(maxAttempts), _connected(false), _baseDelay(baseDelay), _maxDelay(maxDelay), _due(0), _seed(seed ? seed : 1) {}
+
+/**
+ * Add a candidate. The candidate is identified by the order of the
+ * addition, starting with 0.
+ * @param  rssi  The last signal strength of the candidate
+ * @return false  No more candidates can be added.
+ */
+bool AutoConnectRetry::add(const int8_t rssi) {
+  if (_count >= MAX_CANDIDATES)
+    return false;
+  _candidates[_count] = { _count, rssi, false };
+  _count++;
+  return true;
+}
+
+/**
+ * Start the schedule. The candidates are ordered by the signal strength,
+ * and the candidates with the same strength keep the order of addition.
+ * @param  now  Current time in ms
+ */
+void AutoConnectRetry::begin(const uint32_t now) {
+  for (uint8_t i = 1; i < _count; i++) {
+    const Candidate_t c = _candidates[i];
+    uint8_t j = i;
+    for (; j > 0 && _candidates[j - 1].rssi < c.rssi; j--)
+      _candidates[j] = _candidates[j - 1];
+    _candidates[j] = c;
+  }
+  _cursor = 0;
+  _round = 0;
+  _attempts = 0;
+  _connected = false;
+  _due = now;
+}
+
+/**
+ * Returns the candidate to be attempted now.
+ * @param  now  Current time in ms
+ * @return The id of the candidate, AC_RETRY_WAIT if the next attempt is
+ * not due yet or AC_RETRY_GIVEUP if no more attempts remain.
+ */
+int16_t AutoConnectRetry::next(const uint32_t now) const {
+  if (_connected || _attempts >= _maxAttempts)
+    return AC_RETRY_GIVEUP;
+  const int16_t pos = _seek(_cursor);
+  if (pos < 0)
+    return AC_RETRY_GIVEUP;
+  if (static_cast<int32_t>(now - _due) < 0)
+    return AC_RETRY_WAIT;
+  return _candidates[pos].id;
+}
+
+/**
+ * Report the result of the attempt and schedule the next. The next
+ * candidate is attempted at once within a round, and the next round
+ * waits for the backoff.
+ * @param  id      The id of the candidate attempted
+ * @param  result  Result of the attempt
+ * @param  now     Current time in ms
+ */
+void AutoConnectRetry::report(const uint8_t id, const AC_ATTEMPT_t result, const uint32_t now) {
+  int16_t pos = -1;
+  for (uint8_t i = 0; i < _count; i++)
+    if (_candidates[i].id == id)
+      pos = i;
+  if (pos < 0)
+    return;
+
+  _attempts++;
+  if (result == AC_ATTEMPT_CONNECTED) {
+    _connected = true;
+    return;
+  }
+  if (result == AC_ATTEMPT_AUTHFAIL)
+    _candidates[pos].excluded = true;
+
+  const int16_t following = _seek(pos + 1);
+  if (following > pos) {
+    _cursor = following;
+    _due = now;
+  }
+  else {
+    _cursor = 0;
+    _round++;
+    _due = now + _backoff();
+  }
+}
+
+/**
+ * Whether all the candidates were rejected by the authentication.
+ * @return true  No candidate remains due to the authentication.
+ */
+bool AutoConnectRetry::rejected(void) const {
+  return _count && _seek(0) < 0;
+}
+
+/**
+ * Find the candidate to be attempted from the position in the order.
+ * The search wraps around to the first candidate.
+ * @param  from  The position to start the search
+ * @return The position of the candidate, -1 if all are excluded.
+ */
+int16_t AutoConnectRetry::_seek(const uint8_t from) const {
+  for (uint8_t i = 0; i < _count; i++) {
+    const uint8_t pos = (from + i) % _count;
+    if (!_candidates[pos].excluded)
+      return pos;
+  }
+  return -1;
+}
+
+/**
+ * The delay after the round, which doubles for each round up to the
+ * upper limit. Its latter half is randomized so that the devices that
+ * lost the same access point do not retry at the same time.
+ * @return The delay in ms.
+ */
+uint32_t AutoConnectRetry::_backoff(void) {
+  uint32_t  delay = _maxDelay;
+  if (_round <= 31 && (_baseDelay << (_round - 1)) >> (_round - 1) == _baseDelay)
+    delay = _baseDelay << (_round - 1);
+  if (delay > _maxDelay)
+    delay = _maxDelay;
+  const uint32_t  half = delay / 2;
+  return half + _random() % (delay - half + 1);
+}
+
+/**
+ * Xorshift32 for the jitter.
+ */
+uint32_t AutoConnectRetry::_random(void) {
+  _seed ^= _seed << 13;
+  _seed ^= _seed >> 17;
+  _seed ^= _seed << 5;
+  return _seed;
+}
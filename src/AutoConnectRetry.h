@@ -0,0 +1,72 @@
+/**
+ * Declaration of AutoConnectRetry class.
+ * AutoConnectRetry schedules the attempts to connect to the candidate
+ * access points. It interleaves the candidates in the order of the signal
+ * strength, and spaces each round of the candidates with the exponential
+ * backoff with jitter. It depends only on the time and the results given
+ * by the caller, not on the WiFi driver, so the same seed reproduces the
+ * same schedule.
+ * @file AutoConnectRetry.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTRETRY_H_
+#define _AUTOCONNECTRETRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+class AutoConnectRetry {
+ public:
+  /**< Result of an attempt */
+  typedef enum {
+    AC_ATTEMPT_CONNECTED,   /**< Connected */
+    AC_ATTEMPT_AUTHFAIL,    /**< Rejected by the authentication, never retried */
+    AC_ATTEMPT_FAILED,      /**< Failed for other reasons, retried after the backoff */
+    AC_ATTEMPT_NOTFOUND,    /**< The access point was not found */
+    AC_ATTEMPT_TIMEOUT      /**< Not connected within the time */
+  } AC_ATTEMPT_t;
+
+  static constexpr int16_t  AC_RETRY_WAIT = -1;    /**< The next attempt is not due */
+  static constexpr int16_t  AC_RETRY_GIVEUP = -2;  /**< No more attempts */
+  static constexpr uint8_t  MAX_CANDIDATES = 8;    /**< Capacity of the candidates */
+
+  AutoConnectRetry(const uint8_t maxAttempts, const uint32_t baseDelay, const uint32_t maxDelay, const uint32_t seed = 1);
+  ~AutoConnectRetry() {}
+  bool  add(const int8_t rssi);
+  void  begin(const uint32_t now);
+  int16_t next(const uint32_t now) const;
+  void  report(const uint8_t id, const AC_ATTEMPT_t result, const uint32_t now);
+  uint8_t attempts(void) const { return _attempts; }
+  uint8_t candidates(void) const { return _count; }
+  uint32_t  due(void) const { return _due; }
+  bool  rejected(void) const;
+
+ protected:
+  typedef struct {
+    uint8_t id;             /**< Order of the addition */
+    int8_t  rssi;           /**< The last signal strength */
+    bool    excluded;       /**< Never retried */
+  } Candidate_t;
+
+  int16_t   _seek(const uint8_t from) const;
+  uint32_t  _backoff(void);
+  uint32_t  _random(void);
+
+  Candidate_t _candidates[MAX_CANDIDATES];  /**< Candidates in the order of the attempts */
+  uint8_t   _count;         /**< Number of the candidates */
+  uint8_t   _cursor;        /**< Position of the candidate to be attempted */
+  uint8_t   _round;         /**< Number of the rounds completed */
+  uint8_t   _attempts;      /**< Number of the attempts made */
+  uint8_t   _maxAttempts;   /**< Limit of the attempts */
+  bool      _connected;     /**< Connection established */
+  uint32_t  _baseDelay;     /**< Delay after the first round in ms */
+  uint32_t  _maxDelay;      /**< Upper limit of the delay in ms */
+  uint32_t  _due;           /**< Time of the next attempt */
+  uint32_t  _seed;          /**< State of the jitter */
+};
+
+#endif // !_AUTOCONNECTRETRY_H_
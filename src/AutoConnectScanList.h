@@ -0,0 +1,160 @@
+/**
+ * Declaration of AutoConnectScanList class.
+ * AutoConnectScanList holds a copy of the scan results that is sorted
+ * and sliced into the pages of the JSON response for the Configure new
+ * AP page. It depends only on the entries given by the caller, so the
+ * responses are verified on the host against a canned scan.
+ * @file AutoConnectScanList.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTSCANLIST_H_
+#define _AUTOCONNECTSCANLIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+class AutoConnectScanList {
+ public:
+  typedef enum {
+    AC_SCANSORT_RSSI,   /**< The strongest signal first */
+    AC_SCANSORT_SSID    /**< In the order of SSID, then the strongest first */
+  } AC_SCANSORT_t;
+  typedef struct {
+    char      ssid[33]; /**< SSID terminated with NUL */
+    int16_t   rssi;     /**< Signal strength in dBm */
+    uint8_t   quality;  /**< Signal quality in percent */
+    uint8_t   channel;  /**< Channel */
+    bool      secure;   /**< The access point requires a passphrase */
+    uint8_t   index;    /**< Index in the scan results */
+  } AC_SCANENTRY_t;
+
+  AutoConnectScanList() : _total(0), _hidden(0) {}
+  ~AutoConnectScanList() {}
+  void  reserve(const size_t count) { _entries.reserve(count); }
+
+  /**
+   * Add an access point of the scan results. An access point with the
+   * hidden SSID is only counted.
+   * @param  ssid     SSID.
+   * @param  rssi     Signal strength in dBm.
+   * @param  quality  Signal quality in percent.
+   * @param  channel  Channel.
+   * @param  secure   The access point requires a passphrase.
+   */
+  void  add(const char* ssid, const int32_t rssi, const unsigned int quality, const int32_t channel, const bool secure) {
+    const uint8_t index = static_cast<uint8_t>(_total++);
+    if (!ssid || !*ssid) {
+      _hidden++;
+      return;
+    }
+    AC_SCANENTRY_t  entry;
+    entry.ssid[0] = '\0';
+    strncat(entry.ssid, ssid, sizeof(entry.ssid) - 1);
+    entry.rssi = static_cast<int16_t>(rssi);
+    entry.quality = static_cast<uint8_t>(quality);
+    entry.channel = static_cast<uint8_t>(channel);
+    entry.secure = secure;
+    entry.index = index;
+    _entries.push_back(entry);
+  }
+
+  /**
+   * Sort the access points. The equivalent ones keep the order of the
+   * scan results, so the pages of the same scan do not overlap.
+   * @param  order  Sort order.
+   */
+  void  sort(const AC_SCANSORT_t order) {
+    if (order == AC_SCANSORT_SSID)
+      std::sort(_entries.begin(), _entries.end(), [](const AC_SCANENTRY_t& a, const AC_SCANENTRY_t& b) {
+        const int c = strcmp(a.ssid, b.ssid);
+        return c ? c < 0 : _stronger(a, b);
+      });
+    else
+      std::sort(_entries.begin(), _entries.end(), _stronger);
+  }
+
+  /**
+   * Write a page of the access points as a JSON object such as:
+   * {"gen":3,"total":7,"hidden":1,"cursor":0,"prev":-1,"next":5,"aps":[{"ssid":"AP","rssi":-60,"quality":80,"ch":6,"lock":true},...]}
+   * The gen tells the scan that the page comes from, so that the pages
+   * of another scan are not taken as the continuation. The total and the
+   * hidden count all the scanned access points, and the aps lists the
+   * ones from the cursor. The prev and the next are the cursors of the
+   * adjacent pages, -1 if there is no page.
+   * @param  write   Callable that takes a string and its length.
+   * @param  cursor  Position of the first access point of the page.
+   * @param  count   Number of the access points in a page.
+   * @param  generation  Generation of the scan.
+   */
+  template<typename W>
+  void  toJson(W write, size_t cursor, size_t count, const uint16_t generation) const {
+    char  buf[96];
+    const size_t  size = _entries.size();
+    if (!count)
+      count = 1;
+    if (cursor > size)
+      cursor = size;
+    const size_t  end = cursor + std::min(count, size - cursor);
+    const long  prev = cursor ? static_cast<long>(cursor > count ? cursor - count : 0) : -1L;
+    const long  next = end < size ? static_cast<long>(end) : -1L;
+    int len = snprintf(buf, sizeof(buf), "{\"gen\":%u,\"total\":%u,\"hidden\":%u,\"cursor\":%u,\"prev\":%ld,\"next\":%ld,\"aps\":[", static_cast<unsigned int>(generation), _total, _hidden, static_cast<unsigned int>(cursor), prev, next);
+    write(buf, static_cast<size_t>(len));
+    for (size_t i = cursor; i < end; i++) {
+      const AC_SCANENTRY_t& entry = _entries[i];
+      write(i == cursor ? "{\"ssid\":\"" : ",{\"ssid\":\"", i == cursor ? 9 : 10);
+      _escape(write, entry.ssid);
+      len = snprintf(buf, sizeof(buf), "\",\"rssi\":%d,\"quality\":%u,\"ch\":%u,\"lock\":%s}", entry.rssi, entry.quality, entry.channel, entry.secure ? "true" : "false");
+      write(buf, static_cast<size_t>(len));
+    }
+    write("]}", 2);
+  }
+
+  size_t  size(void) const { return _entries.size(); }  /**< Number of the listed access points */
+  unsigned int  total(void) const { return _total; }    /**< Number of the scanned access points */
+  unsigned int  hidden(void) const { return _hidden; }  /**< Number of the hidden access points */
+  const AC_SCANENTRY_t& operator[](const size_t i) const { return _entries[i]; }
+
+ protected:
+  static bool _stronger(const AC_SCANENTRY_t& a, const AC_SCANENTRY_t& b) {
+    return a.rssi != b.rssi ? a.rssi > b.rssi : a.index < b.index;
+  }
+
+  /** Write the string escaped as the JSON string. */
+  template<typename W>
+  static void _escape(W write, const char* s) {
+    static const char hex[] = "0123456789abcdef";
+    const char* run = s;
+    for (; *s; s++) {
+      const unsigned char c = static_cast<unsigned char>(*s);
+      if (c >= 0x20 && c != '"' && c != '\\')
+        continue;
+      if (s > run)
+        write(run, static_cast<size_t>(s - run));
+      if (c < 0x20) {
+        const char  esc[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+        write(esc, sizeof(esc));
+      }
+      else {
+        const char  esc[] = { '\\', static_cast<char>(c) };
+        write(esc, sizeof(esc));
+      }
+      run = s + 1;
+    }
+    if (s > run)
+      write(run, static_cast<size_t>(s - run));
+  }
+
+  unsigned int  _total;   /**< Number of the scanned access points */
+  unsigned int  _hidden;  /**< Number of the hidden access points */
+  std::vector<AC_SCANENTRY_t> _entries; /**< The listed access points */
+};
+
+#endif // !_AUTOCONNECTSCANLIST_H_
@@ -0,0 +1,95 @@
+/**
+ * Declaration of AutoConnectSeek class.
+ * AutoConnectSeek collates the saved credentials with the scan results one
+ * credential at a time, and holds the best access point found so far, so
+ * that the seeking can pause at any credential and resume at the next
+ * slice. It depends only on the callables given by the caller, so a fake
+ * scan verifies the collation on the host.
+ * @file AutoConnectSeek.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTSEEK_H_
+#define _AUTOCONNECTSEEK_H_
+
+#include <stdint.h>
+
+class AutoConnectSeek {
+ public:
+  /**
+   * @param  strongest  Take the strongest access point, otherwise the
+   * first one in the scan results.
+   * @param  scanned    Number of the scan results to be walked.
+   * @param  generation Generation of the scan results to be walked.
+   */
+  AutoConnectSeek(const bool strongest, const int16_t scanned, const uint16_t generation) : _strongest(strongest), _scanned(scanned), _generation(generation), _ap(-1), _rssi(-120) {}
+  ~AutoConnectSeek() {}
+
+  /**
+   * Tells whether the scan results have been replaced since the seeking
+   * started. A rescan may find as many access points as before in another
+   * order, so the generation tells it rather than the count. The count
+   * still catches a scan that the sketch started by itself.
+   * @param  scanned    Number of the current scan results.
+   * @param  generation Generation of the current scan results.
+   * @return true   The seeking must start over.
+   */
+  bool  stale(const int16_t scanned, const uint16_t generation) const {
+    return generation != _generation || scanned != _scanned;
+  }
+
+  /**
+   * Collate a credential with all the scan results. The earlier credential
+   * holds the access point on a tie, and the strongest ones of the same
+   * RSSI are taken in the order of the scan results.
+   * @param  match  Callable that takes the index of a scan result and
+   * returns whether the credential can connect to it.
+   * @param  rssi   Callable that returns the RSSI of the scan result of
+   * the index.
+   * @return true   The credential holds the best access point now.
+   */
+  template<typename M, typename R>
+  bool  collate(M match, R rssi) {
+    bool  taken = false;
+    for (int16_t n = 0; n < _scanned; n++) {
+      if (!match(n))
+        continue;
+      const int32_t level = rssi(n);
+      bool  better = _ap < 0;
+      if (!better) {
+        if (_strongest)
+          better = level > _rssi || (level == _rssi && n < _ap);
+        else
+          better = n < _ap;
+      }
+      if (better) {
+        _ap = n;
+        _rssi = level;
+        taken = true;
+      }
+    }
+    return taken;
+  }
+
+  /**
+   * No credential can precede the first access point of the scan results
+   * unless the strongest one is sought, so the seeking can end there.
+   */
+  bool  settled(void) const { return !_strongest && _ap == 0; }
+
+  bool    found(void) const { return _ap >= 0; }  /**< An access point has been found */
+  int16_t ap(void) const { return _ap; }          /**< Index of the best access point, -1 if none */
+  int32_t rssi(void) const { return _rssi; }      /**< Signal strength of the best access point */
+
+ protected:
+  bool      _strongest;   /**< Take the strongest access point */
+  int16_t   _scanned;     /**< Number of the scan results being walked */
+  uint16_t  _generation;  /**< Generation of the scan results being walked */
+  int16_t   _ap;          /**< Index of the best access point, -1 if none */
+  int32_t   _rssi;        /**< Signal strength of the best access point */
+};
+
+#endif // !_AUTOCONNECTSEEK_H_
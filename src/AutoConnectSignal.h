@@ -0,0 +1,192 @@
+/**
+ * Declaration of AutoConnectSignal class template.
+ * A fixed-capacity multi-subscriber event dispatcher. Each subscriber is
+ * a pair of a plain function pointer and an opaque context, so neither
+ * registration nor invocation allocates heap or goes through the type
+ * erasure of std::function.
+ * @file AutoConnectSignal.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTSIGNAL_H_
+#define _AUTOCONNECTSIGNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <type_traits>
+#include "AutoConnectDefs.h"
+
+template<typename Sig, size_t N = AUTOCONNECT_SIGNAL_SLOTS>
+class AutoConnectSignal;
+
+/**
+ * A dispatcher for the handlers with the signature R(Args...).
+ * R must be void or bool. A bool signal returns true when all the
+ * subscribers return true, or when there are no subscribers, so a
+ * single false vetoes the event in the same way as the exit routines
+ * of AutoConnect.
+ * The std::function slot exists for the compatibility with the
+ * conventional registration functions, it occupies one subscriber
+ * position only while a function is assigned.
+ * @param  R     Return type of the handler.
+ * @param  Args  Argument types of the handler.
+ * @param  N     Maximum number of subscribers.
+ */
+template<typename R, typename... Args, size_t N>
+class AutoConnectSignal<R(Args...), N> {
+  static_assert(std::is_void<R>::value || std::is_same<R, bool>::value, "AutoConnectSignal handler must return void or bool");
+
+ public:
+  typedef R (*Handler_ft)(void* ctx, Args... args);
+  typedef std::function<R(Args...)> Function_ft;
+
+  AutoConnectSignal() : _count(0) {}
+  ~AutoConnectSignal() {}
+  // A subscriber of the assigned function refers to this instance.
+  AutoConnectSignal(const AutoConnectSignal&) = delete;
+  AutoConnectSignal& operator=(const AutoConnectSignal&) = delete;
+
+  /**
+   * Add a subscriber. The same pair of fn and ctx is registered only once.
+   * @param  fn   A function to be called with ctx and the arguments.
+   * @param  ctx  An opaque pointer passed to fn as is.
+   * @return true  Subscribed.
+   * @return false No free slot, fn is not registered.
+   */
+  bool subscribe(Handler_ft fn, void* ctx = nullptr) {
+    if (!fn)
+      return false;
+    if (_find(fn, ctx) >= 0)
+      return true;
+    if (_count >= N)
+      return false;
+    _slots[_count].fn = fn;
+    _slots[_count++].ctx = ctx;
+    return true;
+  }
+
+  /**
+   * Add an object of a class that has operator()(Args...) as a
+   * subscriber. The object must outlive the subscription.
+   * @param  handler  A pointer to the handler object.
+   * @return true  Subscribed.
+   * @return false No free slot.
+   */
+  template<typename H>
+  typename std::enable_if<std::is_class<H>::value, bool>::type subscribe(H* handler) {
+    return subscribe(&AutoConnectSignal::_invokeObject<H>, static_cast<void*>(handler));
+  }
+
+  /**
+   * Remove a subscriber.
+   * @param  fn   Registered function.
+   * @param  ctx  Registered context.
+   * @return true  Removed.
+   * @return false Not subscribed.
+   */
+  bool unsubscribe(Handler_ft fn, void* ctx) {
+    const int i = _find(fn, ctx);
+    if (i < 0)
+      return false;
+    _remove(static_cast<size_t>(i));
+    return true;
+  }
+
+  /**
+   * Remove all subscribers registered with the context.
+   * @param  ctx  Registered context.
+   */
+  void unsubscribe(const void* ctx) {
+    for (size_t i = _count; i > 0; i--)
+      if (_slots[i - 1].ctx == ctx)
+        _remove(i - 1);
+  }
+
+  /**
+   * Replace the std::function subscriber. It keeps the behavior of the
+   * registration functions that hold a single exit routine.
+   * @param  fn  A function, an empty function removes the subscriber.
+   * @return true  Assigned.
+   * @return false No free slot.
+   */
+  bool assign(const Function_ft& fn) {
+    _function = fn;
+    if (!fn) {
+      unsubscribe(&AutoConnectSignal::_invokeFunction, static_cast<void*>(&_function));
+      return true;
+    }
+    return subscribe(&AutoConnectSignal::_invokeFunction, static_cast<void*>(&_function));
+  }
+
+  /**
+   * A handler that relays the event to another signal given as ctx.
+   * It chains the subscribers of a signal owned by a lazily created
+   * object without copying them.
+   */
+  static R relay(void* ctx, Args... args) {
+    return static_cast<const AutoConnectSignal*>(ctx)->emit(args...);
+  }
+
+  void  clear(void) { _count = 0; _function = nullptr; }
+  size_t  count(void) const { return _count; }
+  explicit operator bool() const { return _count > 0; }
+
+  /**
+   * Call all subscribers in the order of the subscription.
+   * @param  args  Arguments passed to the subscribers.
+   * @return The conjunction of the results for a bool signal.
+   */
+  R emit(Args... args) const {
+    return _emit(std::is_void<R>(), args...);
+  }
+
+ protected:
+  typedef struct {
+    Handler_ft  fn;   /**< Subscriber function */
+    void* ctx;        /**< Context passed to the fn */
+  } Slot_t;
+
+  int _find(Handler_ft fn, const void* ctx) const {
+    for (size_t i = 0; i < _count; i++)
+      if (_slots[i].fn == fn && _slots[i].ctx == ctx)
+        return static_cast<int>(i);
+    return -1;
+  }
+
+  void _remove(const size_t i) {
+    for (size_t n = i + 1; n < _count; n++)
+      _slots[n - 1] = _slots[n];
+    _count--;
+  }
+
+  void _emit(std::true_type, Args... args) const {
+    for (size_t i = 0; i < _count; i++)
+      _slots[i].fn(_slots[i].ctx, args...);
+  }
+
+  bool _emit(std::false_type, Args... args) const {
+    bool  rc = true;
+    for (size_t i = 0; i < _count; i++)
+      rc &= _slots[i].fn(_slots[i].ctx, args...);
+    return rc;
+  }
+
+  template<typename H>
+  static R _invokeObject(void* ctx, Args... args) {
+    return (*static_cast<H*>(ctx))(args...);
+  }
+
+  static R _invokeFunction(void* ctx, Args... args) {
+    return (*static_cast<Function_ft*>(ctx))(args...);
+  }
+
+  Slot_t  _slots[N];      /**< Subscribers */
+  uint8_t _count;         /**< Number of subscribers */
+  Function_ft _function;  /**< A function assigned by the conventional interface */
+};
+
+#endif // !_AUTOCONNECTSIGNAL_H_
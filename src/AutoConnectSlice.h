@@ -0,0 +1,57 @@
+/**
+ * Declaration of AutoConnectSlice class.
+ * AutoConnectSlice bounds the time of a resumable operation that is
+ * driven by handleClient. It runs the steps of the operation until the
+ * operation finishes or the slice is used up, and the operation resumes
+ * from the next step at the next slice. It depends only on the clock
+ * given by the caller, so a mocked clock verifies the slices on the host.
+ * @file AutoConnectSlice.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTSLICE_H_
+#define _AUTOCONNECTSLICE_H_
+
+#include <stdint.h>
+
+class AutoConnectSlice {
+ public:
+  explicit AutoConnectSlice(const uint32_t duration) : _duration(duration), _elapsed(0), _steps(0) {}
+  ~AutoConnectSlice() {}
+
+  /**
+   * Run the steps within the slice. At least one step runs in a slice,
+   * so a slice lasts the duration plus one step at the longest.
+   * @param  step   Callable that performs a step and returns false when
+   * the operation has finished.
+   * @param  clock  Callable that returns the time in milliseconds.
+   * @return true   The operation has finished.
+   * @return false  The slice has been used up before the operation finishes.
+   */
+  template<typename S, typename C>
+  bool  run(S step, C clock) {
+    const uint32_t  start = clock();
+    bool  cont;
+    _steps = 0;
+    do {
+      cont = step();
+      _steps++;
+      _elapsed = clock() - start;
+    } while (cont && _elapsed < _duration);
+    return !cont;
+  }
+
+  uint32_t  duration(void) const { return _duration; }  /**< Time allotted to a slice */
+  uint32_t  elapsed(void) const { return _elapsed; }    /**< Time taken by the last slice */
+  uint16_t  steps(void) const { return _steps; }        /**< Steps run in the last slice */
+
+ protected:
+  uint32_t  _duration;  /**< Time allotted to a slice in ms */
+  uint32_t  _elapsed;   /**< Time taken by the last slice in ms */
+  uint16_t  _steps;     /**< Steps run in the last slice */
+};
+
+#endif // !_AUTOCONNECTSLICE_H_
@@ -0,0 +1,85 @@
+/**
+ * AutoConnectStrings class implementation.
+ * @file AutoConnectStrings.cpp
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#include <stddef.h>
+#include "AutoConnectDefs.h"
+#include "AutoConnectStrings.h"
+#ifdef AUTOCONNECT_USE_LANGPACK
+#include "AutoConnectLangPack.h"
+#endif
+
+// The pool is a structure of the character arrays sized to each text,
+// so that the offsets of the texts are determined at compile time
+// without padding.
+#define AC_STRING_MEMBER(id, text)  char id[sizeof(text)];
+struct AutoConnectStringPool {
+  AUTOCONNECT_STRINGTABLE(AC_STRING_MEMBER)
+};
+#undef AC_STRING_MEMBER
+
+#define AC_STRING_TEXT(id, text)  text,
+static const AutoConnectStringPool _pool PROGMEM = {
+  AUTOCONNECT_STRINGTABLE(AC_STRING_TEXT)
+};
+#undef AC_STRING_TEXT
+
+#define AC_STRING_OFFSET(id, text)  offsetof(AutoConnectStringPool, id),
+static const uint16_t _offset[] PROGMEM = {
+  AUTOCONNECT_STRINGTABLE(AC_STRING_OFFSET)
+};
+#undef AC_STRING_OFFSET
+
+#ifdef AUTOCONNECT_USE_LANGPACK
+// The names of the tokens that AC_MOLDLABEL places in the page molds,
+// which are the IDs prefixed with STR_ and separated by '\0'.
+#define AC_STRING_NAME(id, text)  "STR_" #id "\0"
+static const char _names[] PROGMEM = AUTOCONNECT_STRINGTABLE(AC_STRING_NAME);
+#undef AC_STRING_NAME
+#endif
+
+static_assert(sizeof(_offset) / sizeof(_offset[0]) == AC_STR_END, "AUTOCONNECT_STRINGTABLE is inconsistent");
+static_assert(sizeof(AutoConnectStringPool) <= UINT16_MAX, "AUTOCONNECT_STRINGTABLE is too large");
+
+/**
+ * Returns the text of the ID. With AC_USE_LANGPACK, the text of the
+ * language pack selected for the current request takes precedence.
+ * @param  id  AC_STR_t
+ * @return A pointer to the text in PROGMEM, an empty text for an unknown ID.
+ */
+PGM_P AutoConnectStrings::get(const AC_STR_t id) {
+  if (id >= AC_STR_END)
+    return PSTR("");
+#ifdef AUTOCONNECT_USE_LANGPACK
+  PGM_P text = AutoConnectLangPack::get(id);
+  if (text)
+    return text;
+#endif
+  return reinterpret_cast<PGM_P>(&_pool) + pgm_read_word(&_offset[id]);
+}
+
+#ifdef AUTOCONNECT_USE_LANGPACK
+/**
+ * Returns the ID of the token that AC_MOLDLABEL places in the page molds.
+ * @param  token  The token name without the braces
+ * @param  name   Returns the token name in PROGMEM that persists, which
+ * the token handler of the PageElement can be registered with.
+ * @return AC_STR_t of the token, AC_STR_END for an unknown token.
+ */
+AC_STR_t AutoConnectStrings::find(const char* token, PGM_P* name) {
+  PGM_P cp = _names;
+  for (uint16_t id = 0; id < AC_STR_END; id++) {
+    if (!strcmp_P(token, cp)) {
+      *name = cp;
+      return static_cast<AC_STR_t>(id);
+    }
+    cp += strlen_P(cp) + 1;
+  }
+  return AC_STR_END;
+}
+#endif
@@ -0,0 +1,171 @@
+/**
+ * Declaration of AutoConnectStrings class.
+ * AutoConnectStrings holds the labels that AutoConnect refers to in one
+ * PROGMEM pool, and they are looked up by ID. Each label is stored only
+ * once regardless of how many places refer to it. The labels spliced
+ * into the page molds enter the pool only with AC_USE_LANGPACK, which
+ * replaces them in the molds with the tokens of the table.
+ * @file AutoConnectStrings.h
+ * @author hieromon@gmail.com
+ * @version 1.4.3
+ * @date 2025-08-30
+ * @copyright MIT license.
+ */
+
+#ifndef _AUTOCONNECTSTRINGS_H_
+#define _AUTOCONNECTSTRINGS_H_
+
+#include <Arduino.h>
+#include "AutoConnectDefs.h"
+#include "AutoConnectLabels.h"
+
+// The labels that only the AutoConnectConfigAux page or only the page
+// molds refer to occupy the pool only when they are used. Otherwise they
+// are left empty to keep the IDs, that is, the positions in the table
+// that the language packs refer to, in any build.
+#ifdef AUTOCONNECT_USE_CONFIGAUX
+#define AC_STRING_CONFIGAUX(text) text
+#else
+#define AC_STRING_CONFIGAUX(text) ""
+#endif
+#ifdef AUTOCONNECT_USE_LANGPACK
+#define AC_STRING_MOLD(text)      text
+#else
+#define AC_STRING_MOLD(text)      ""
+#endif
+
+/**
+ * The string table. Each entry is X(ID, text), and the table generates
+ * the AC_STR_t enumeration and the pool. The texts follow the label
+ * macros, so the label replacement header specified with AC_LABELS
+ * swaps the table for another language at compile time. The language
+ * packs refer to the entries by their position, so the new entries are
+ * appended to the end. The IDs of the entries after the first ones are
+ * the names of their label macros without the AUTOCONNECT_ prefix, which
+ * AC_MOLDLABEL relies on.
+ */
+#define AUTOCONNECT_STRINGTABLE(X) \
+  X(MENU_CONFIGNEW, AUTOCONNECT_MENULABEL_CONFIGNEW) \
+  X(MENU_OPENSSIDS, AUTOCONNECT_MENULABEL_OPENSSIDS) \
+  X(MENU_DISCONNECT, AUTOCONNECT_MENULABEL_DISCONNECT) \
+  X(MENU_RESET, AUTOCONNECT_MENULABEL_RESET) \
+  X(MENU_HOME, AUTOCONNECT_MENULABEL_HOME) \
+  X(MENU_DEVINFO, AUTOCONNECT_MENULABEL_DEVINFO) \
+  X(MENUTEXT_CONNECTING, AUTOCONNECT_MENUTEXT_CONNECTING) \
+  X(MENUTEXT_DISCONNECT, AUTOCONNECT_MENUTEXT_DISCONNECT) \
+  X(MENUTEXT_FAILED, AUTOCONNECT_MENUTEXT_FAILED) \
+  X(BUTTON_RESET, AUTOCONNECT_BUTTONLABEL_RESET) \
+  X(CONFIG_IPADDRESS, AUTOCONNECT_PAGECONFIG_IPADDRESS) \
+  X(CONFIG_GATEWAY, AUTOCONNECT_PAGECONFIG_GATEWAY) \
+  X(CONFIG_NETMASK, AUTOCONNECT_PAGECONFIG_NETMASK) \
+  X(CONFIG_DNS1, AUTOCONNECT_PAGECONFIG_DNS1) \
+  X(CONFIG_DNS2, AUTOCONNECT_PAGECONFIG_DNS2) \
+  X(CONFIG_PREVIOUS, AUTOCONNECT_PAGECONFIG_PREVIOUS) \
+  X(CONFIG_NEXT, AUTOCONNECT_PAGECONFIG_NEXT) \
+  X(TEXT_RESETINPROGRESS, AUTOCONNECT_TEXT_RESETINPROGRESS) \
+  X(TEXT_AUTHFAILED, AUTOCONNECT_TEXT_AUTHFAILED) \
+  X(TEXT_OTASUCCESS, AUTOCONNECT_TEXT_OTASUCCESS) \
+  X(TEXT_OTAUPLOADED, AUTOCONNECT_TEXT_OTAUPLOADED) \
+  X(TEXT_OTAFAILURE, AUTOCONNECT_TEXT_OTAFAILURE) \
+  X(TEXT_COULDNOTDELETED, AUTOCONNECT_TEXT_COULDNOTDELETED) \
+  X(TEXT_NOSAVEDCREDENTIALS, AUTOCONNECT_TEXT_NOSAVEDCREDENTIALS) \
+  X(PAGECONFIG_SSID, AUTOCONNECT_PAGECONFIG_SSID) \
+  X(PAGECONFIG_PASSPHRASE, AUTOCONNECT_PAGECONFIG_PASSPHRASE) \
+  X(PAGECONFIG_ENABLEDHCP, AUTOCONNECT_PAGECONFIG_ENABLEDHCP) \
+  X(PAGECONFIG_APPLY, AUTOCONNECT_PAGECONFIG_APPLY) \
+  X(PAGESTATS_CHANNEL, AUTOCONNECT_PAGESTATS_CHANNEL) \
+  X(PAGESTATS_SUBNETMASK, AUTOCONNECT_PAGESTATS_SUBNETMASK) \
+  X(PAGELABEL_SOFTAPSETTINGS, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGELABEL_SOFTAPSETTINGS)) \
+  X(PAGECONFIG_HIDDENSSID, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_HIDDENSSID)) \
+  X(PAGELABEL_CPCONTROL, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGELABEL_CPCONTROL)) \
+  X(PAGECONFIG_AUTOPOPUP, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_AUTOPOPUP)) \
+  X(PAGECONFIG_IMMEDIATESTART, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_IMMEDIATESTART)) \
+  X(PAGECONFIG_RETAINPORTAL, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_RETAINPORTAL)) \
+  X(PAGECONFIG_CPTIMEOUT, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_CPTIMEOUT)) \
+  X(PAGELABEL_CONNECTIONCONTROL, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGELABEL_CONNECTIONCONTROL)) \
+  X(PAGECONFIG_PRINCIPLE, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_PRINCIPLE)) \
+  X(PAGECONFIG_MINRSSI, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_MINRSSI)) \
+  X(PAGECONFIG_BEGINTIMEOUT, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_BEGINTIMEOUT)) \
+  X(PAGECONFIG_AUTORECONNECT, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_AUTORECONNECT)) \
+  X(PAGECONFIG_RECONNECTINTERVAL, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_RECONNECTINTERVAL)) \
+  X(PAGECONFIG_SAVECREDENTIAL, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_SAVECREDENTIAL)) \
+  X(PAGECONFIG_AUTORESTART, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_AUTORESTART)) \
+  X(PAGELABEL_STATIONSETTINGS, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGELABEL_STATIONSETTINGS)) \
+  X(PAGECONFIG_PRESERVEAPMODE, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_PRESERVEAPMODE)) \
+  X(PAGECONFIG_PRIMARYDNS, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_PRIMARYDNS)) \
+  X(PAGECONFIG_SECONDARYDNS, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_SECONDARYDNS)) \
+  X(PAGECONFIG_HOSTNAME, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_HOSTNAME)) \
+  X(PAGECONFIG_HOMEURI, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_HOMEURI)) \
+  X(PAGECONFIG_ONBOOTURI, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_ONBOOTURI)) \
+  X(PAGELABEL_AUTHSETTINGS, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGELABEL_AUTHSETTINGS)) \
+  X(PAGECONFIG_AUTHENTICATION, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_AUTHENTICATION)) \
+  X(PAGECONFIG_AUTHSCOPE, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_AUTHSCOPE)) \
+  X(PAGECONFIG_USERNAME, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_USERNAME)) \
+  X(PAGECONFIG_PASSWORD, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_PASSWORD)) \
+  X(PAGELABEL_MISCELLANEOUS, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGELABEL_MISCELLANEOUS)) \
+  X(PAGECONFIG_MENUTITLE, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_MENUTITLE)) \
+  X(PAGECONFIG_MENUSUSE, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_MENUSUSE)) \
+  X(MENULABEL_UPDATE, AC_STRING_CONFIGAUX(AUTOCONNECT_MENULABEL_UPDATE)) \
+  X(PAGECONFIG_TICKER, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_TICKER)) \
+  X(PAGECONFIG_TICKERON, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_TICKERON)) \
+  X(PAGECONFIG_TICKERACTIVE, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_TICKERACTIVE)) \
+  X(PAGECONFIG_TICKERPORT, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_TICKERPORT)) \
+  X(PAGECONFIG_BUILTINOTA, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_BUILTINOTA)) \
+  X(PAGECONFIG_BOUNDARY, AC_STRING_CONFIGAUX(AUTOCONNECT_PAGECONFIG_BOUNDARY)) \
+  X(PAGETITLE_NOTFOUND, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_NOTFOUND)) \
+  X(PAGETITLE_RESETTING, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_RESETTING)) \
+  X(PAGETITLE_STATISTICS, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_STATISTICS)) \
+  X(PAGESTATS_ESTABLISHEDCONNECTION, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_ESTABLISHEDCONNECTION)) \
+  X(PAGESTATS_MODE, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_MODE)) \
+  X(PAGESTATS_IP, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_IP)) \
+  X(PAGESTATS_GATEWAY, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_GATEWAY)) \
+  X(PAGESTATS_SOFTAPIP, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_SOFTAPIP)) \
+  X(PAGESTATS_APMAC, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_APMAC)) \
+  X(PAGESTATS_STAMAC, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_STAMAC)) \
+  X(PAGESTATS_DBM, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_DBM)) \
+  X(PAGESTATS_CHIPID, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_CHIPID)) \
+  X(PAGESTATS_CPUFREQ, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_CPUFREQ)) \
+  X(PAGESTATS_FLASHSIZE, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_FLASHSIZE)) \
+  X(PAGESTATS_FREEMEM, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_FREEMEM)) \
+  X(PAGESTATS_SYSTEM_UPTIME, AC_STRING_MOLD(AUTOCONNECT_PAGESTATS_SYSTEM_UPTIME)) \
+  X(PAGETITLE_CONFIG, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_CONFIG)) \
+  X(PAGECONFIG_TOTAL, AC_STRING_MOLD(AUTOCONNECT_PAGECONFIG_TOTAL)) \
+  X(PAGECONFIG_HIDDEN, AC_STRING_MOLD(AUTOCONNECT_PAGECONFIG_HIDDEN)) \
+  X(PAGETITLE_CREDENTIALS, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_CREDENTIALS)) \
+  X(TEXT_DELETECREDENTIAL, AC_STRING_MOLD(AUTOCONNECT_TEXT_DELETECREDENTIAL)) \
+  X(PAGETITLE_CONNECTING, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_CONNECTING)) \
+  X(PAGETITLE_CONNECTIONFAILED, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_CONNECTIONFAILED)) \
+  X(PAGECONNECTIONFAILED_CONNECTIONFAILED, AC_STRING_MOLD(AUTOCONNECT_PAGECONNECTIONFAILED_CONNECTIONFAILED)) \
+  X(PAGETITLE_DISCONNECTED, AC_STRING_MOLD(AUTOCONNECT_PAGETITLE_DISCONNECTED))
+
+#define AC_STRING_ID(id, text)  AC_STR_##id,
+typedef enum {
+  AUTOCONNECT_STRINGTABLE(AC_STRING_ID)
+  AC_STR_END
+} AC_STR_t;
+#undef AC_STRING_ID
+
+class AutoConnectStrings {
+ public:
+  static PGM_P  get(const AC_STR_t id);
+  static const __FlashStringHelper* fstr(const AC_STR_t id) { return reinterpret_cast<const __FlashStringHelper*>(get(id)); }
+  static String str(const AC_STR_t id) { return String(fstr(id)); }
+#ifdef AUTOCONNECT_USE_LANGPACK
+  static AC_STR_t find(const char* token, PGM_P* name);
+#endif
+};
+
+// Shorthands to refer to the string table with the ID without prefix.
+#define AC_PSTR(id)   AutoConnectStrings::get(AC_STR_##id)
+#define AC_FSTR(id)   AutoConnectStrings::fstr(AC_STR_##id)
+
+// The label of the ID in a page mold. With AC_USE_LANGPACK, it is the
+// token that AutoConnectPageElement::addLabels resolves from the table,
+// otherwise the literal of the label macro itself.
+#ifdef AUTOCONNECT_USE_LANGPACK
+#define AC_MOLDLABEL(id)  "{{STR_" #id "}}"
+#else
+#define AC_MOLDLABEL(id)  AUTOCONNECT_##id
+#endif
+
+#endif // !_AUTOCONNECTSTRINGS_H_
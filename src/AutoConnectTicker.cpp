@@ -4,13 +4,15 @@
  *  connection status. 
  *  @file   AutoConnectTicker.cpp
  *  @author hieromon@gmail.com
- *  @version    1.4.2
- *  @date   2023-01-23
+ *  @version    1.4.3
+ *  @date   2025-08-30
  *  @copyright  MIT license.
  */
 
 #include "AutoConnectTicker.h"
 
+#ifdef AUTOCONNECT_USE_TICKER
+
 // Support for Ticker Longer delays with ESP8266.
 // Details for https://github.com/esp8266/Arduino/pull/8625
 #define AC_TICKER_CALLBACK_ARG_T  <AutoConnectTicker*>
@@ -22,6 +24,54 @@
 #endif
 #endif
 
+// Phases of the status patterns. The patterns of AP and the disconnection
+// follow the flicker cycle and the pulse width settings.
+#define AC_TICKER_PHASES(c, w)  (uint16_t)(((uint32_t)(c) * (w)) >> 8), (uint16_t)((c) - (((uint32_t)(c) * (w)) >> 8))
+static const uint16_t _phasesAP[] = { AC_TICKER_PHASES(AUTOCONNECT_FLICKER_PERIODAP, AUTOCONNECT_FLICKER_WIDTHAP) };
+static const uint16_t _phasesDC[] = { AC_TICKER_PHASES(AUTOCONNECT_FLICKER_PERIODDC, AUTOCONNECT_FLICKER_WIDTHDC) };
+static const uint16_t _phasesOTA[] = { AC_TICKER_PHASES(AUTOCONNECT_FLICKER_PERIODOTA, AUTOCONNECT_FLICKER_WIDTHOTA) };
+static const uint16_t _phasesError[] = { 100, 150, 100, 150, 100, 1400 };
+
+// Indexed by AC_TICKERPATTERN_t
+static const AutoConnectTicker::Pattern_t _patterns[] = {
+  { nullptr, 0 },
+  { _phasesAP, sizeof(_phasesAP) / sizeof(_phasesAP[0]) },
+  { _phasesDC, sizeof(_phasesDC) / sizeof(_phasesDC[0]) },
+  { _phasesOTA, sizeof(_phasesOTA) / sizeof(_phasesOTA[0]) },
+  { _phasesError, sizeof(_phasesError) / sizeof(_phasesError[0]) }
+};
+
+/**
+ * Switch the flicker to the status pattern. A running flicker moves
+ * to the new pattern at the end of the current phase without
+ * restarting the timer, and the same pattern has no effect. Turning
+ * off the flicker that is already off leaves the port untouched, so the
+ * sketch can use it while the ticker is off.
+ * @param  pattern  A status pattern
+ */
+void AutoConnectTicker::setPattern(const AC_TICKERPATTERN_t pattern) {
+  if (pattern == AC_TICKER_OFF) {
+    if (_pattern || _current || _hw)
+      stop();
+  }
+  else if (pattern == AC_TICKER_CUSTOM)
+    start();
+  else if (_pattern != &_patterns[pattern])
+    _apply(&_patterns[pattern]);
+}
+
+/**
+ * Returns the current status pattern.
+ * @return A status pattern
+ */
+AutoConnectTicker::AC_TICKERPATTERN_t AutoConnectTicker::getPattern(void) const {
+  if (!_pattern)
+    return AC_TICKER_OFF;
+  if (_pattern == &_customPattern)
+    return AC_TICKER_CUSTOM;
+  return static_cast<AC_TICKERPATTERN_t>(_pattern - _patterns);
+}
+
 /**
  * Start ticker cycle
  * @param cycle Cycle time in [ms]
@@ -38,30 +88,143 @@ void AutoConnectTicker::start(const uint32_t cycle, const uint32_t duty) {
  * Start ticker cycle
  */
 void AutoConnectTicker::start(void) {
-  pinMode(_port, OUTPUT);
+  if (!_cycle) {
+    stop();
+    return;
+  }
+  _custom[0] = static_cast<uint16_t>(_duty);
+  _custom[1] = static_cast<uint16_t>(_cycle - _duty);
+  _apply(&_customPattern);
+}
+
+/**
+ * Stop the flicker and turn off the signal.
+ */
+void AutoConnectTicker::stop(void) {
+  _pattern = nullptr;
+  _period.detach();
   _pulse.detach();
-  _period.attach_ms AC_TICKER_CALLBACK_ARG_T(_cycle, AutoConnectTicker::_onPeriod, this);
+  _current = nullptr;
+  if (_hw)
+    _detachPWM();
+  digitalWrite(_port, !_turnOn);
+  _cycle = 0;
+  _duty = 0;
 }
 
 /**
- * Turn on the flicker signal and reserves a ticker to turn off the
- * signal. This behavior will perform every cycle to generate the
- * pseudo-PWM signal.
- * If the function is registered, call the callback function at the
- * end of one cycle.
- * @param  t  Its own address
+ * Output the pattern. The hardware PWM generates a pattern of one
+ * on-off pair if it is available, otherwise a single one-shot timer
+ * steps through the phases.
+ * @param  pattern  A pattern to be output
  */
-void AutoConnectTicker::_onPeriod(AutoConnectTicker* t) {
-  digitalWrite(t->_port, t->_turnOn);
-  t->_pulse.once_ms AC_TICKER_CALLBACK_ARG_T(t->_duty, AutoConnectTicker::_onPulse, t);
-  if (t->_callback)
-    t->_callback();
+void AutoConnectTicker::_apply(const Pattern_t* pattern) {
+  _cycle = 0;
+  for (uint8_t i = 0; i < pattern->count; i++)
+    _cycle += pattern->phases[i];
+  _duty = pattern->phases[0];
+
+  if (_attachPWM(pattern)) {
+    _pattern = pattern;
+    _period.detach();
+    _pulse.detach();
+    _current = nullptr;
+    return;
+  }
+  if (_hw)
+    _detachPWM();
+  _pattern = pattern;
+  // The timer that is running will pick up the new pattern.
+  if (!_current) {
+    pinMode(_port, OUTPUT);
+    _onPhase(this);
+  }
 }
 
+#ifdef AUTOCONNECT_USE_TICKERPWM
 /**
- * Turn off the flicker signal
+ * Let the LEDC generate the pattern. The period must be an integral
+ * fraction of one second since the LEDC frequency is an integer.
+ * @param  pattern  A pattern to be output
+ * @return true   The LEDC generates the pattern.
+ * @return false  The pattern cannot be generated by the LEDC.
+ */
+bool AutoConnectTicker::_attachPWM(const Pattern_t* pattern) {
+  if (pattern->count != 2 || _callback || !_cycle || (1000 % _cycle))
+    return false;
+
+  const uint32_t  freq = 1000 / _cycle;
+  const uint32_t  on = _turnOn == HIGH ? pattern->phases[0] : pattern->phases[1];
+  const uint32_t  duty = (on << AUTOCONNECT_TICKER_LEDCRESOLUTION) / _cycle;
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+  if (_hw) {
+    if (!ledcChangeFrequency(_port, freq, AUTOCONNECT_TICKER_LEDCRESOLUTION))
+      return false;
+  }
+  else if (!ledcAttach(_port, freq, AUTOCONNECT_TICKER_LEDCRESOLUTION))
+    return false;
+  ledcWrite(_port, duty);
+#else
+  if (!ledcSetup(AUTOCONNECT_TICKER_LEDCCHANNEL, freq, AUTOCONNECT_TICKER_LEDCRESOLUTION))
+    return false;
+  if (!_hw)
+    ledcAttachPin(_port, AUTOCONNECT_TICKER_LEDCCHANNEL);
+  ledcWrite(AUTOCONNECT_TICKER_LEDCCHANNEL, duty);
+#endif
+  _hw = true;
+  return true;
+}
+
+/**
+ * Release the pin from the LEDC.
+ */
+void AutoConnectTicker::_detachPWM(void) {
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcDetach(_port);
+#else
+  ledcDetachPin(_port);
+#endif
+  pinMode(_port, OUTPUT);
+  _hw = false;
+}
+
+#else
+bool AutoConnectTicker::_attachPWM(const Pattern_t* pattern) {
+  AC_UNUSED(pattern);
+  return false;
+}
+
+void AutoConnectTicker::_detachPWM(void) {
+  _hw = false;
+}
+#endif // !AUTOCONNECT_USE_TICKERPWM
+
+/**
+ * Output the signal of the current phase and reserve the next phase
+ * with the one-shot timer. The two timers take turns so that a timer
+ * is never re-armed from its own callback, only one of them is armed
+ * at a time and fires once per phase.
+ * If the function is registered, call the callback function at the
+ * end of one cycle.
  * @param  t  Its own address
  */
-void AutoConnectTicker::_onPulse(AutoConnectTicker* t) {
-  digitalWrite(t->_port, !(t->_turnOn));
+void AutoConnectTicker::_onPhase(AutoConnectTicker* t) {
+  if (t->_current != t->_pattern) {
+    t->_current = t->_pattern;
+    t->_phase = 0;
+  }
+  const Pattern_t*  pattern = t->_current;
+  if (!pattern)
+    return;
+
+  const uint8_t phase = t->_phase;
+  digitalWrite(t->_port, phase & 1 ? !(t->_turnOn) : t->_turnOn);
+  t->_phase = phase + 1 < pattern->count ? phase + 1 : 0;
+  t->_alternate = !t->_alternate;
+  Ticker& next = t->_alternate ? t->_pulse : t->_period;
+  next.once_ms AC_TICKER_CALLBACK_ARG_T(pattern->phases[phase], AutoConnectTicker::_onPhase, t);
+  if (phase == 0 && t->_callback)
+    t->_callback();
 }
+
+#endif // !AUTOCONNECT_USE_TICKER
@@ -2,8 +2,8 @@
  *  Declaration of AutoConnectTicker class.
  *  @file   AutoConnectTicker.h
  *  @author hieromon@gmail.com
- *  @version    1.4.2
- *  @date   2023-01-23
+ *  @version    1.4.3
+ *  @date   2025-08-30
  *  @copyright  MIT license.
  */
 
@@ -22,7 +22,27 @@
 
 class AutoConnectTicker {
  public:
-	explicit AutoConnectTicker(const uint8_t port = AUTOCONNECT_TICKER_PORT, const uint8_t active = LOW, const uint32_t cycle = 0, uint32_t duty = 0) : _cycle(cycle), _duty(duty), _port(port), _turnOn(active), _callback(nullptr) {
+  /**< Status patterns of the flicker. */
+  typedef enum {
+    AC_TICKER_OFF,          /**< Turned off */
+    AC_TICKER_AP,           /**< SoftAP is active */
+    AC_TICKER_CONNECTING,   /**< WiFi is not connected */
+    AC_TICKER_OTA,          /**< OTA update in progress */
+    AC_TICKER_ERROR,        /**< The last connection attempt failed */
+    AC_TICKER_CUSTOM        /**< Specified by the cycle and the duty */
+  } AC_TICKERPATTERN_t;
+
+  /**
+   * A pattern is a sequence of the durations [ms] that alternates the
+   * turning on and off, starting with on. A pattern consisting of only
+   * two phases can be generated by the hardware PWM.
+   */
+  typedef struct {
+    const uint16_t* phases; /**< Durations of each phase */
+    uint8_t count;          /**< Number of phases, it must be even */
+  } Pattern_t;
+
+	explicit AutoConnectTicker(const uint8_t port = AUTOCONNECT_TICKER_PORT, const uint8_t active = LOW, const uint32_t cycle = 0, uint32_t duty = 0) : _cycle(cycle), _duty(duty), _port(port), _turnOn(active), _callback(nullptr), _pattern(nullptr), _current(nullptr), _phase(0), _alternate(false), _hw(false) {
     if (_duty > _cycle)
       _duty = _cycle;
   }
@@ -31,26 +51,37 @@ class AutoConnectTicker {
   typedef std::function<void(void)> Callback_ft;
   void setCycle(const uint32_t cycle) { _cycle = cycle; }
   void setDuty(const uint32_t duty) { _duty = duty <= _cycle ? duty : _duty; }
+  void setPattern(const AC_TICKERPATTERN_t pattern);
   void start(const uint32_t cycle, const uint32_t duty);
   void start(const uint32_t cycle, const uint8_t width) { start(cycle, (uint32_t)((cycle * width) >> 8)); }
   void start(void);
-  void stop(void) { _period.detach(); _pulse.detach(); digitalWrite(_port, !_turnOn); _cycle = 0; _duty = 0; }
+  void stop(void);
   void onPeriod(Callback_ft cb) { _callback = cb ;}
   uint32_t getCycle(void) const { return _cycle; }
   uint32_t getDuty(void) const { return _duty; }
+  AC_TICKERPATTERN_t  getPattern(void) const;
 
  protected:
-  Ticker    _period;        /**< Ticker for flicking cycle */
-  Ticker    _pulse;         /**< Ticker for pulse width generating */
+  void  _apply(const Pattern_t* pattern);
+  bool  _attachPWM(const Pattern_t* pattern);
+  void  _detachPWM(void);
+  Ticker    _period;        /**< Ticker to step the phases */
+  Ticker    _pulse;         /**< Ticker taking turns with the _period */
   uint32_t  _cycle;         /**< Cycle time in [ms] */
   uint32_t  _duty;          /**< Pulse width in [ms] */
 
  private:
-  static void _onPeriod(AutoConnectTicker* t);
-  static void _onPulse(AutoConnectTicker* t);
+  static void _onPhase(AutoConnectTicker* t);
   uint8_t     _port;        /**< Port to output signal */
   uint8_t     _turnOn;      /**< Signal to turn on */
   Callback_ft _callback;    /**< An exit by every cycle */
+  const Pattern_t* volatile _pattern; /**< The pattern to be output */
+  const Pattern_t*  _current;         /**< The pattern the timer is stepping */
+  uint8_t     _phase;       /**< Current phase of the _current */
+  bool        _alternate;   /**< The _pulse is armed */
+  bool        _hw;          /**< Generated by the hardware PWM */
+  uint16_t    _custom[2];   /**< Phases of the AC_TICKER_CUSTOM */
+  Pattern_t   _customPattern = { _custom, 2 };
 };
 
 #endif // !_AUTOCONNECTTICKER_H_
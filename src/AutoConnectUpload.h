@@ -19,6 +19,7 @@
 #include <WiFi.h>
 #include <WebServer.h>
 #endif
+#include "AutoConnectSignal.h"
 
 /**
  * Uploader base class. This class is a wrapper for the AutoConnectUpload
@@ -41,12 +42,21 @@ class AutoConnectUploadHandler {
   typedef std::function<void(uint8_t)>  ErrorExit_ft;
   typedef std::function<void(unsigned int, unsigned int)> ProgressExit_ft;
 
-  explicit AutoConnectUploadHandler() : _cbStart(NULL), _cbEnd(NULL), _cbError(NULL), _cbProgress(NULL), _status(AC_UPLOAD_IDLE), _ulAmount(0) {}
+  typedef AutoConnectSignal<void(void)>    StartSignal_t;
+  typedef AutoConnectSignal<void(void)>    EndSignal_t;
+  typedef AutoConnectSignal<void(uint8_t)> ErrorSignal_t;
+  typedef AutoConnectSignal<void(unsigned int, unsigned int)> ProgressSignal_t;
+
+  explicit AutoConnectUploadHandler() : _status(AC_UPLOAD_IDLE), _ulAmount(0) {}
   virtual ~AutoConnectUploadHandler() {}
-  AutoConnectUploadHandler& onStart(StartExit_ft fn) { _cbStart = fn; return *this; };          /**< Register a callback for OTA start */
-  AutoConnectUploadHandler& onEnd(EndExit_ft fn) { _cbEnd = fn; return *this; };                /**< Register a callback for OTA end */
-  AutoConnectUploadHandler& onError(ErrorExit_ft fn) { _cbError = fn; return *this; };          /**< Register a callback for OTA error */
-  AutoConnectUploadHandler& onProgress(ProgressExit_ft fn) { _cbProgress = fn; return *this; }  /**< Register a callback for OTA in progress */
+  AutoConnectUploadHandler& onStart(StartExit_ft fn) { _cbStart.assign(fn); return *this; };          /**< Register a callback for OTA start */
+  AutoConnectUploadHandler& onEnd(EndExit_ft fn) { _cbEnd.assign(fn); return *this; };                /**< Register a callback for OTA end */
+  AutoConnectUploadHandler& onError(ErrorExit_ft fn) { _cbError.assign(fn); return *this; };          /**< Register a callback for OTA error */
+  AutoConnectUploadHandler& onProgress(ProgressExit_ft fn) { _cbProgress.assign(fn); return *this; }  /**< Register a callback for OTA in progress */
+  AutoConnectUploadHandler& onStart(StartSignal_t::Handler_ft fn, void* ctx) { _cbStart.subscribe(fn, ctx); return *this; }           /**< Subscribe to OTA start */
+  AutoConnectUploadHandler& onEnd(EndSignal_t::Handler_ft fn, void* ctx) { _cbEnd.subscribe(fn, ctx); return *this; }                 /**< Subscribe to OTA end */
+  AutoConnectUploadHandler& onError(ErrorSignal_t::Handler_ft fn, void* ctx) { _cbError.subscribe(fn, ctx); return *this; }           /**< Subscribe to OTA error */
+  AutoConnectUploadHandler& onProgress(ProgressSignal_t::Handler_ft fn, void* ctx) { _cbProgress.subscribe(fn, ctx); return *this; }  /**< Subscribe to OTA in progress */
   virtual void upload(const String& requestUri, const HTTPUpload& upload);
   AC_UPLOADStatus_t status(void) { return _status; }
 
@@ -57,10 +67,10 @@ protected:
   virtual void    _setError(const char* err);
 
   // Callback functions to notify the upload status
-  StartExit_ft    _cbStart;
-  EndExit_ft      _cbEnd;
-  ErrorExit_ft    _cbError;
-  ProgressExit_ft _cbProgress;  
+  StartSignal_t     _cbStart;
+  EndSignal_t       _cbEnd;
+  ErrorSignal_t     _cbError;
+  ProgressSignal_t  _cbProgress;
 
   AC_UPLOADStatus_t _status;
   size_t  _ulAmount;              /**< Cumulative amount uploaded */
@@ -52,8 +52,7 @@ void AutoConnectUploadHandler::upload(const String& requestUri, const HTTPUpload
   case UPLOAD_FILE_START: {
     _status = AC_UPLOAD_IDLE;
     _ulAmount = 0;
-    if (_cbStart)   // Notify an OTA status change
-      _cbStart();
+    _cbStart.emit();  // Notify an OTA status change
     String  absFilename = "/" + upload.filename;
     if (!_open(absFilename.c_str(), "w")) {
       _status = AC_UPLOAD_ERROR_OPEN;
@@ -65,8 +64,7 @@ void AutoConnectUploadHandler::upload(const String& requestUri, const HTTPUpload
     size_t  wsz = _write(upload.buf, upload.currentSize);
     if ((int)wsz != -1) {
       _ulAmount += wsz;
-      if (_cbProgress)
-        _cbProgress(_ulAmount, wsz);
+      _cbProgress.emit(_ulAmount, wsz);
     }
     else {
       _status = AC_UPLOAD_ERROR_WRITE;
@@ -85,8 +83,7 @@ void AutoConnectUploadHandler::upload(const String& requestUri, const HTTPUpload
       else
         _status = AC_UPLOAD_END;
     }
-    if (_cbEnd)
-      _cbEnd();
+    _cbEnd.emit();
     break;
   }
 }
@@ -100,8 +97,7 @@ void AutoConnectUploadHandler::_setError(const char* err) {
     AC_DBG("ACFile err: %s\n", err);
     _err = String(err);
   }
-  if (_cbError)
-    _cbError((uint8_t)_status);
+  _cbError.emit((uint8_t)_status);
 } 
 
 // Default handler for uploading to the standard SPIFFS class embedded in the core.